@@ -5,6 +5,7 @@
 #include "../../engine/GameBase.h"
 #include "../../engine/ControllerManager.h"
 #include "../../engine/config.h"
+#include "../../engine/Raster.h"
 #include "../../component/SmallFont.h"
 #include "../../engine/Settings.h"
 #include "../../engine/UserProfiles.h"
@@ -23,7 +24,9 @@
  * Notes:
  * - We reserve a small HUD band at the top for score/lives.
  * - World wraps horizontally and vertically within the playfield area.
- * - Rendering uses simple vector primitives (pixels/lines/circles) for speed.
+ * - Rendering uses simple vector primitives (pixels/lines) for speed; asteroid
+ *   outlines come from precomputed span tables (see AsteroidsGameSprites.h).
+ * - Collisions use a wrap-aware sort-and-sweep broad phase on X.
  */
 class AsteroidsGame : public GameBase {
 private:
@@ -51,6 +54,10 @@ private:
     static constexpr uint16_t TRIGGER_THRESHOLD = AsteroidsGameConfig::TRIGGER_THRESHOLD; // analog trigger threshold
 
     static constexpr uint8_t MAX_ASTEROIDS = AsteroidsGameConfig::MAX_ASTEROIDS;
+    static constexpr uint8_t WAVE_MAX_LARGE = AsteroidsGameConfig::WAVE_MAX_LARGE;
+
+    // Vertical wrap period of the playfield (see wrapY()).
+    static constexpr int PLAY_H = (PANEL_RES_Y - 1) - HUD_H;
 
     // ---------------------------------------------------------
     // Entities
@@ -81,10 +88,20 @@ private:
         float vy;
         uint8_t size;   // 2=large, 1=medium, 0=small
         uint8_t radius; // pixels
+        uint8_t shape;  // outline variant of its size (see OUTLINE_FIRST)
         bool alive;
         uint16_t color;
     };
 
+    // Broad-phase entry: X interval of one asteroid (or of its wrap ghost).
+    struct SweepEntry {
+        float minX;
+        float maxX;
+        float x;     // center X for this copy (shifted by +/-PANEL_RES_X for ghosts)
+        uint8_t idx; // asteroid slot
+    };
+    static constexpr int MAX_SWEEP = MAX_ASTEROIDS * 2;
+
     // ---------------------------------------------------------
     // State
     // ---------------------------------------------------------
@@ -92,6 +109,12 @@ private:
     Bullet bullets[MAX_BULLETS];
     Asteroid asteroids[MAX_ASTEROIDS];
 
+    // Sort-and-sweep state (rebuilt once per tick after asteroids move).
+    SweepEntry sweep[MAX_SWEEP];
+    uint8_t sweepCount = 0;
+    // Slot order from the previous tick, so the insertion sort sees almost-sorted input.
+    uint8_t sweepOrder[MAX_ASTEROIDS];
+
     bool gameOver = false;
     int score = 0;
     int lives = 3;
@@ -106,43 +129,6 @@ private:
     // ---------------------------------------------------------
     // Helpers (math / wrapping)
     // ---------------------------------------------------------
-    // We don't currently use analog sticks elsewhere in this repo, and Bluepad32
-    // may expose slightly different names depending on version/controller.
-    // These helpers use SFINAE to pick whichever API exists at compile time.
-    struct InputDetail {
-        template <typename T>
-        static auto axisX(T* c, int) -> decltype(c->axisX(), int16_t()) { return (int16_t)c->axisX(); }
-        template <typename T>
-        static int16_t axisX(T*, ...) { return 0; }
-
-        template <typename T>
-        static auto axisY(T* c, int) -> decltype(c->axisY(), int16_t()) { return (int16_t)c->axisY(); }
-        template <typename T>
-        static int16_t axisY(T*, ...) { return 0; }
-
-        template <typename T>
-        static auto axisRX(T* c, int) -> decltype(c->axisRX(), int16_t()) { return (int16_t)c->axisRX(); }
-        template <typename T>
-        static int16_t axisRX(T*, ...) { return 0; }
-
-        template <typename T>
-        static auto axisRY(T* c, int) -> decltype(c->axisRY(), int16_t()) { return (int16_t)c->axisRY(); }
-        template <typename T>
-        static int16_t axisRY(T*, ...) { return 0; }
-
-        // Right trigger (preferred analog): Bluepad32 commonly maps this to throttle().
-        template <typename T>
-        static auto throttle(T* c, int) -> decltype(c->throttle(), uint16_t()) { return (uint16_t)c->throttle(); }
-        template <typename T>
-        static uint16_t throttle(T*, ...) { return 0; }
-
-        // Fallback digital R2.
-        template <typename T>
-        static auto r2(T* c, int) -> decltype(c->r2(), bool()) { return (bool)c->r2(); }
-        template <typename T>
-        static bool r2(T*, ...) { return false; }
-    };
-
     static inline float clampf(float v, float lo, float hi) { return (v < lo) ? lo : (v > hi) ? hi : v; }
     static inline float randf(float lo, float hi) {
         const float t = (float)random(0, 10000) / 10000.0f;
@@ -165,9 +151,19 @@ private:
         outY = deadzone01(y, STICK_DEADZONE);
     }
 
-    static inline float dist2(float ax, float ay, float bx, float by) {
-        const float dx = ax - bx;
-        const float dy = ay - by;
+    // Shortest signed Y distance across the vertical wrap seam.
+    static inline float wrapDeltaY(float d) {
+        const float h = (float)PLAY_H;
+        if (d > h * 0.5f) d -= h;
+        else if (d < -h * 0.5f) d += h;
+        return d;
+    }
+
+    static inline float wrapDist2(float ax, float ay, float bx, float by) {
+        float dx = ax - bx;
+        if (dx > PANEL_RES_X * 0.5f) dx -= PANEL_RES_X;
+        else if (dx < -PANEL_RES_X * 0.5f) dx += PANEL_RES_X;
+        const float dy = wrapDeltaY(ay - by);
         return dx * dx + dy * dy;
     }
 
@@ -192,6 +188,19 @@ private:
         invulnUntilMs = now + RESPAWN_INVULN_MS;
     }
 
+    void initAsteroid(Asteroid& a, float x, float y, float vx, float vy, uint8_t size) {
+        a.x = x;
+        a.y = y;
+        a.vx = vx;
+        a.vy = vy;
+        a.size = size;
+        a.radius = AsteroidsGameConfig::OUTLINE_RADIUS[size];
+        // Small rocks only have the round outline worth drawing; bigger ones get a random silhouette.
+        a.shape = (uint8_t)random(0, AsteroidsGameConfig::OUTLINE_VARIANTS[size]);
+        a.alive = true;
+        a.color = COLOR_WHITE;
+    }
+
     void spawnWave(uint32_t now) {
         (void)now;
         for (int i = 0; i < MAX_ASTEROIDS; i++) asteroids[i].alive = false;
@@ -199,9 +208,9 @@ private:
 
         // Smooth difficulty curve:
         // - Level 1 starts with exactly 1 large asteroid.
-        // - Add one extra large asteroid every 2 levels, capped to keep gameplay readable on 64x64.
+        // - Add one extra large asteroid every 2 levels, capped at WAVE_MAX_LARGE (late waves).
         // - Increase drift speed slowly to avoid "instant chaos".
-        const int count = (int)min(5, 1 + ((level - 1) / 2));
+        const int count = (int)min((int)WAVE_MAX_LARGE, 1 + ((level - 1) / 2));
         const float baseSpeed = min(0.80f, 0.22f + (level * 0.03f));
 
         for (int i = 0; i < count; i++) {
@@ -209,8 +218,8 @@ private:
             float ax = randf(0.0f, (float)(PANEL_RES_X - 1));
             float ay = randf((float)HUD_H, (float)(PANEL_RES_Y - 1));
 
-            // Ensure some distance from ship center.
-            if (dist2(ax, ay, ship.x, ship.y) < 18.0f * 18.0f) {
+            // Ensure some distance from ship center (across the wrap seams too).
+            if (wrapDist2(ax, ay, ship.x, ship.y) < 18.0f * 18.0f) {
                 ax = fmodf(ax + 24.0f, (float)PANEL_RES_X);
                 ay = clampf(ay + 14.0f, (float)HUD_H, (float)(PANEL_RES_Y - 1));
             }
@@ -222,15 +231,7 @@ private:
             // Allocate an asteroid slot.
             for (int ai = 0; ai < MAX_ASTEROIDS; ai++) {
                 if (asteroids[ai].alive) continue;
-                Asteroid& a = asteroids[ai];
-                a.x = ax;
-                a.y = ay;
-                a.vx = vx;
-                a.vy = vy;
-                a.size = 2;
-                a.radius = 6;
-                a.alive = true;
-                a.color = COLOR_WHITE;
+                initAsteroid(asteroids[ai], ax, ay, vx, vy, 2);
                 break;
             }
         }
@@ -258,20 +259,82 @@ private:
             const float nvy = a.vy * 0.65f + sinf(ang) * sp;
             for (int ai = 0; ai < MAX_ASTEROIDS; ai++) {
                 if (asteroids[ai].alive) continue;
-                Asteroid& c = asteroids[ai];
-                c.x = a.x;
-                c.y = a.y;
-                c.vx = nvx;
-                c.vy = nvy;
-                c.size = childSize;
-                c.radius = (childSize == 2) ? 6 : (childSize == 1) ? 4 : 2;
-                c.alive = true;
-                c.color = COLOR_WHITE;
+                initAsteroid(asteroids[ai], a.x, a.y, nvx, nvy, childSize);
                 break;
             }
         }
     }
 
+    // ---------------------------------------------------------
+    // Collision broad phase (sort-and-sweep on X, wrap-aware)
+    // ---------------------------------------------------------
+    void pushSweep(float cx, float r, uint8_t idx) {
+        if (sweepCount >= MAX_SWEEP) return;
+        SweepEntry& e = sweep[sweepCount++];
+        e.minX = cx - r;
+        e.maxX = cx + r;
+        e.x = cx;
+        e.idx = idx;
+    }
+
+    void buildBroadPhase() {
+        sweepCount = 0;
+        for (int k = 0; k < MAX_ASTEROIDS; k++) {
+            const uint8_t ai = sweepOrder[k];
+            const Asteroid& a = asteroids[ai];
+            if (!a.alive) continue;
+            const float r = (float)a.radius;
+            pushSweep(a.x, r, ai);
+            // Rocks within reach of the left/right seam also exist on the other
+            // side, so queries never have to wrap X themselves. The reach includes
+            // the query radius: a ship at x=1 must still see a rock at x=62.
+            const float reach = r + AsteroidsGameConfig::MAX_HIT_RADIUS;
+            if (a.x - reach < 0.0f) pushSweep(a.x + PANEL_RES_X, r, ai);
+            else if (a.x + reach >= PANEL_RES_X) pushSweep(a.x - PANEL_RES_X, r, ai);
+        }
+
+        // Insertion sort by minX. Asteroids drift slowly and we start from last
+        // tick's order, so this is close to linear in practice.
+        for (int i = 1; i < sweepCount; i++) {
+            const SweepEntry e = sweep[i];
+            int j = i - 1;
+            while (j >= 0 && sweep[j].minX > e.minX) {
+                sweep[j + 1] = sweep[j];
+                j--;
+            }
+            sweep[j + 1] = e;
+        }
+
+        // Remember the sorted slot order for next tick (dead slots go last).
+        bool placed[MAX_ASTEROIDS] = {};
+        int n = 0;
+        for (int i = 0; i < sweepCount; i++) {
+            const uint8_t ai = sweep[i].idx;
+            if (placed[ai]) continue;
+            placed[ai] = true;
+            sweepOrder[n++] = ai;
+        }
+        for (int ai = 0; ai < MAX_ASTEROIDS; ai++) {
+            if (!placed[ai]) sweepOrder[n++] = (uint8_t)ai;
+        }
+    }
+
+    // Returns the first live asteroid overlapping a circle at (px,py) with radius pr, or -1.
+    int findAsteroidHit(float px, float py, float pr) const {
+        for (int i = 0; i < sweepCount; i++) {
+            const SweepEntry& e = sweep[i];
+            if (e.minX > px + pr) break; // sorted: nothing further right can overlap
+            if (e.maxX < px - pr) continue;
+            const Asteroid& a = asteroids[e.idx];
+            if (!a.alive) continue; // already split earlier this tick
+            const float dx = px - e.x;
+            const float dy = wrapDeltaY(py - a.y);
+            const float r = (float)a.radius + pr;
+            if (dx * dx + dy * dy <= r * r) return e.idx;
+        }
+        return -1;
+    }
+
     bool allAsteroidsCleared() const {
         for (int i = 0; i < MAX_ASTEROIDS; i++) if (asteroids[i].alive) return false;
         return true;
@@ -317,6 +380,43 @@ private:
         lastShotMs = now;
     }
 
+    // ---------------------------------------------------------
+    // Asteroid rendering (table-driven outlines)
+    // ---------------------------------------------------------
+    static inline void drawSpanClipped(MatrixPanel_I2S_DMA* display, int x0, int x1, int y, uint16_t color) {
+        if (x0 < 0) x0 = 0;
+        if (x1 > PANEL_RES_X - 1) x1 = PANEL_RES_X - 1;
+        if (x1 < x0) return;
+        display->drawFastHLine(x0, y, x1 - x0 + 1, color);
+    }
+
+    static void drawOutlineAt(MatrixPanel_I2S_DMA* display, int cx, int cy, const Asteroid& a) {
+        const int8_t (*rows)[4] = AsteroidsGameConfig::OUTLINE_SPANS[AsteroidsGameConfig::OUTLINE_FIRST[a.size] + a.shape];
+        const int r = (int)a.radius;
+        for (int row = 0; row <= 2 * r; row++) {
+            const int y = cy - r + row;
+            if (y < HUD_H || y > PANEL_RES_Y - 1) continue; // keep the HUD clean
+            const int8_t* s = rows[row];
+            drawSpanClipped(display, cx + s[0], cx + s[1], y, a.color);
+            if (s[2] != s[0]) drawSpanClipped(display, cx + s[2], cx + s[3], y, a.color);
+        }
+    }
+
+    static void drawAsteroid(MatrixPanel_I2S_DMA* display, const Asteroid& a) {
+        const int cx = (int)a.x;
+        const int cy = (int)a.y;
+        const int r = (int)a.radius;
+        // Rocks crossing a seam are drawn on both sides (matches the collision model).
+        const int gx = (cx - r < 0) ? cx + PANEL_RES_X : (cx + r >= PANEL_RES_X) ? cx - PANEL_RES_X : cx;
+        const int gy = (cy - r < HUD_H) ? cy + PLAY_H : (cy + r > PANEL_RES_Y - 1) ? cy - PLAY_H : cy;
+        drawOutlineAt(display, cx, cy, a);
+        if (gx != cx) drawOutlineAt(display, gx, cy, a);
+        if (gy != cy) {
+            drawOutlineAt(display, cx, gy, a);
+            if (gx != cx) drawOutlineAt(display, gx, gy, a);
+        }
+    }
+
 public:
     AsteroidsGame() {}
 
@@ -336,6 +436,9 @@ public:
         respawnAtMs = 0;
         invulnUntilMs = 0;
 
+        for (int i = 0; i < MAX_ASTEROIDS; i++) sweepOrder[i] = (uint8_t)i;
+        sweepCount = 0;
+
         resetShipToCenter(now);
         spawnWave(now);
     }
@@ -359,15 +462,15 @@ public:
         }
 
         // 1) Input
-        ControllerPtr p1 = input->getController(0);
-        if (p1 && p1->isConnected()) {
+        const PadState& p1 = input->pad(0);
+        if (p1.connected) {
             // Left stick: movement (twin-stick).
             float lx = 0.0f, ly = 0.0f;
-            normalizeStick(InputDetail::axisX(p1, 0), InputDetail::axisY(p1, 0), lx, ly);
+            normalizeStick(p1.axisX, p1.axisY, lx, ly);
 
             // Right stick: aim direction (twin-stick).
             float rx = 0.0f, ry = 0.0f;
-            normalizeStick(InputDetail::axisRX(p1, 0), InputDetail::axisRY(p1, 0), rx, ry);
+            normalizeStick(p1.axisRX, p1.axisRY, rx, ry);
 
             // If the right stick is moved, update ship angle.
             const float aimMag2 = rx * rx + ry * ry;
@@ -377,13 +480,12 @@ public:
             }
 
             // Hyperspace on A (keeps B reserved for "back to menu" by the engine).
-            if (p1->a()) {
+            if (p1.held(PadState::BTN_A)) {
                 doHyperspace(now);
             }
 
             // Right trigger: shoot (prefer analog throttle, otherwise digital R2).
-            const uint16_t rt = InputDetail::throttle(p1, 0);
-            const bool rtPressed = (rt >= TRIGGER_THRESHOLD) || InputDetail::r2(p1, 0);
+            const bool rtPressed = (p1.throttle >= TRIGGER_THRESHOLD) || p1.held(PadState::BTN_R2);
             if (rtPressed) {
                 fire(now);
             }
@@ -422,44 +524,33 @@ public:
             wrapX(a.x);
             wrapY(a.y);
         }
+        buildBroadPhase();
 
         // 5) Bullet vs asteroid collisions
+        // Children spawned by a split join the broad phase on the next tick.
         for (int bi = 0; bi < MAX_BULLETS; bi++) {
             Bullet& b = bullets[bi];
             if (!b.active) continue;
-            for (int ai = 0; ai < MAX_ASTEROIDS; ai++) {
-                Asteroid& a = asteroids[ai];
-                if (!a.alive) continue;
-                const float r = (float)a.radius;
-                if (dist2(b.x, b.y, a.x, a.y) <= (r * r)) {
-                    splitAsteroid(ai, now);
-                    b.active = false;
-                    break;
-                }
+            const int ai = findAsteroidHit(b.x, b.y, AsteroidsGameConfig::BULLET_HIT_RADIUS);
+            if (ai >= 0) {
+                splitAsteroid(ai, now);
+                b.active = false;
             }
         }
 
         // 6) Ship vs asteroid collisions (unless invulnerable)
-        if ((int32_t)(invulnUntilMs - now) <= 0) {
-            for (int ai = 0; ai < MAX_ASTEROIDS; ai++) {
-                const Asteroid& a = asteroids[ai];
-                if (!a.alive) continue;
-                const float r = (float)a.radius;
-                // Ship approximated as a small circle.
-                if (dist2(ship.x, ship.y, a.x, a.y) <= (r + 2.5f) * (r + 2.5f)) {
-                    lives--;
-                    for (int bi = 0; bi < MAX_BULLETS; bi++) bullets[bi].active = false;
-
-                    if (lives <= 0) {
-                        gameOver = true;
-                    } else {
-                        // Short delay before respawn so impact is visible.
-                        respawnAtMs = now + 350;
-                        invulnUntilMs = now + RESPAWN_INVULN_MS;
-                        ship.vx = ship.vy = 0.0f;
-                    }
-                    break;
-                }
+        // Ship approximated as a small circle.
+        if ((int32_t)(invulnUntilMs - now) <= 0 && findAsteroidHit(ship.x, ship.y, AsteroidsGameConfig::SHIP_HIT_RADIUS) >= 0) {
+            lives--;
+            for (int bi = 0; bi < MAX_BULLETS; bi++) bullets[bi].active = false;
+
+            if (lives <= 0) {
+                gameOver = true;
+            } else {
+                // Short delay before respawn so impact is visible.
+                respawnAtMs = now + 350;
+                invulnUntilMs = now + RESPAWN_INVULN_MS;
+                ship.vx = ship.vy = 0.0f;
             }
         }
 
@@ -479,7 +570,7 @@ public:
         SmallFont::drawStringF(display, 34, 6, COLOR_CYAN, "L:%d", lives);
 
         // Divider line under HUD
-        for (int x = 0; x < PANEL_RES_X; x += 2) display->drawPixel(x, HUD_H, COLOR_BLUE);
+        Raster::dashedHLine(display, 0, HUD_H, PANEL_RES_X, COLOR_BLUE);
 
         if (gameOver) {
             char tag[4];
@@ -492,7 +583,7 @@ public:
         for (int ai = 0; ai < MAX_ASTEROIDS; ai++) {
             const Asteroid& a = asteroids[ai];
             if (!a.alive) continue;
-            display->drawCircle((int)a.x, (int)a.y, (int)a.radius, a.color);
+            drawAsteroid(display, a);
         }
 
         // Bullets
@@ -521,9 +612,9 @@ public:
             const int x2 = (int)(ship.x + rx * 3.0f);
             const int y2 = (int)(ship.y + ry * 3.0f);
 
-            display->drawLine(x0, y0, x1, y1, ship.color);
-            display->drawLine(x1, y1, x2, y2, ship.color);
-            display->drawLine(x2, y2, x0, y0, ship.color);
+            Raster::line(display, x0, y0, x1, y1, ship.color);
+            Raster::line(display, x1, y1, x2, y2, ship.color);
+            Raster::line(display, x2, y2, x0, y0, ship.color);
             display->drawPixel((int)ship.x, (int)ship.y, COLOR_WHITE);
         }
     }
@@ -539,6 +630,99 @@ public:
     const char* leaderboardId() const override { return "asteroids"; }
     const char* leaderboardName() const override { return "Asteroid"; }
     uint32_t leaderboardScore() const override { return (score > 0) ? (uint32_t)score : 0u; }
+
+    // ------------------------------
+    // Self-check (DEBUG_INVARIANTS)
+    // ------------------------------
+    const char* checkInvariants() const override {
+        if (lives < 0) return "negative lives";
+        for (int i = 0; i < MAX_ASTEROIDS; i++) {
+            const Asteroid& a = asteroids[i];
+            if (!a.alive) continue;
+            if (a.size >= AsteroidsGameConfig::OUTLINE_SIZES) return "asteroid size out of range";
+            if (a.shape >= AsteroidsGameConfig::OUTLINE_VARIANTS[a.size]) return "asteroid outline out of range";
+            if (a.radius != AsteroidsGameConfig::OUTLINE_RADIUS[a.size]) return "asteroid radius does not match size";
+            if (!(a.x >= 0.0f && a.x < PANEL_RES_X && a.y >= HUD_H && a.y <= PANEL_RES_Y - 1)) return "asteroid outside the wrapped field";
+        }
+        // The broad phase keeps a permutation of slots and a minX-sorted sweep.
+        bool seen[MAX_ASTEROIDS] = {};
+        for (int k = 0; k < MAX_ASTEROIDS; k++) {
+            const uint8_t ai = sweepOrder[k];
+            if (ai >= MAX_ASTEROIDS || seen[ai]) return "sweep order is not a permutation";
+            seen[ai] = true;
+        }
+        if (sweepCount > MAX_SWEEP) return "sweep overflow";
+        for (int i = 1; i < sweepCount; i++) {
+            if (sweep[i - 1].minX > sweep[i].minX) return "sweep not sorted";
+        }
+        return nullptr;
+    }
+
+#if DEBUG_GAME_STATS
+    // Saturated broad-phase benchmark: every pool slot alive (the worst-case
+    // wave mix), one tick's worth of queries (all bullets + the ship) at random
+    // spots, sort-and-sweep vs the brute-force wrapped-distance scan. Prints
+    // microseconds per tick and how often the two disagree (must be 0).
+    static void benchmarkBroadPhase(uint16_t ticks = 600) {
+        static AsteroidsGame g;
+        for (int i = 0; i < MAX_ASTEROIDS; i++) {
+            const uint8_t size = (i < WAVE_MAX_LARGE) ? 2 : (i < WAVE_MAX_LARGE * 3) ? 1 : 0;
+            g.initAsteroid(g.asteroids[i], randf(0.0f, PANEL_RES_X), randf(HUD_H, PANEL_RES_Y - 1),
+                           randf(-0.6f, 0.6f), randf(-0.6f, 0.6f), size);
+            g.sweepOrder[i] = (uint8_t)i;
+        }
+
+        uint32_t sweepCycles = 0, bruteCycles = 0, sweepMax = 0, bruteMax = 0, mismatches = 0, hits = 0;
+        for (uint16_t t = 0; t < ticks; t++) {
+            for (int ai = 0; ai < MAX_ASTEROIDS; ai++) {
+                Asteroid& a = g.asteroids[ai];
+                a.x += a.vx;
+                a.y += a.vy;
+                wrapX(a.x);
+                wrapY(a.y);
+            }
+            float qx[MAX_BULLETS + 1], qy[MAX_BULLETS + 1], qr[MAX_BULLETS + 1];
+            for (int q = 0; q <= MAX_BULLETS; q++) {
+                qx[q] = randf(0.0f, PANEL_RES_X);
+                qy[q] = randf(HUD_H, PANEL_RES_Y - 1);
+                qr[q] = (q == MAX_BULLETS) ? AsteroidsGameConfig::SHIP_HIT_RADIUS : AsteroidsGameConfig::BULLET_HIT_RADIUS;
+            }
+
+            int sweepHit[MAX_BULLETS + 1];
+            uint32_t t0 = ESP.getCycleCount();
+            g.buildBroadPhase();
+            for (int q = 0; q <= MAX_BULLETS; q++) sweepHit[q] = g.findAsteroidHit(qx[q], qy[q], qr[q]);
+            const uint32_t sc = ESP.getCycleCount() - t0;
+
+            int bruteHit[MAX_BULLETS + 1];
+            t0 = ESP.getCycleCount();
+            for (int q = 0; q <= MAX_BULLETS; q++) {
+                bruteHit[q] = -1;
+                for (int ai = 0; ai < MAX_ASTEROIDS; ai++) {
+                    const Asteroid& a = g.asteroids[ai];
+                    const float r = (float)a.radius + qr[q];
+                    if (a.alive && wrapDist2(qx[q], qy[q], a.x, a.y) <= r * r) { bruteHit[q] = ai; break; }
+                }
+            }
+            const uint32_t bc = ESP.getCycleCount() - t0;
+
+            for (int q = 0; q <= MAX_BULLETS; q++) {
+                if ((sweepHit[q] >= 0) != (bruteHit[q] >= 0)) mismatches++;
+                if (bruteHit[q] >= 0) hits++;
+            }
+            sweepCycles += sc;
+            bruteCycles += bc;
+            if (sc > sweepMax) sweepMax = sc;
+            if (bc > bruteMax) bruteMax = bc;
+        }
+
+        const uint32_t mhz = (uint32_t)getCpuFrequencyMhz();
+        Serial.printf("[Asteroids] broad phase, %d rocks, %u ticks: sweep %lu us/tick (max %lu), brute %lu us/tick (max %lu), hits %lu, mismatches %lu\n",
+                      (int)MAX_ASTEROIDS, (unsigned)ticks, (unsigned long)(sweepCycles / ticks / mhz),
+                      (unsigned long)(sweepMax / mhz), (unsigned long)(bruteCycles / ticks / mhz),
+                      (unsigned long)(bruteMax / mhz), (unsigned long)hits, (unsigned long)mismatches);
+    }
+#endif
 };
 
 
@@ -31,13 +31,24 @@ static constexpr uint32_t BULLET_LIFE_MS = 700;
 static constexpr uint8_t MAX_BULLETS = 6;
 static constexpr float BULLET_SPEED = 3.2f;
 
+// Collision radii for things tested against rocks. The broad phase pads its
+// seam ghosts by the largest of these, so keep it in sync if one grows.
+static constexpr float BULLET_HIT_RADIUS = 0.0f;
+static constexpr float SHIP_HIT_RADIUS = 2.5f;
+static constexpr float MAX_HIT_RADIUS = (SHIP_HIT_RADIUS > BULLET_HIT_RADIUS) ? SHIP_HIT_RADIUS : BULLET_HIT_RADIUS;
+
 // Respawn / hyperspace
 static constexpr uint32_t RESPAWN_INVULN_MS = 1500;
 static constexpr uint32_t HYPERSPACE_COOLDOWN_MS = 1200;
 
-// Asteroids pool: enough for 5 large at once + splits (each large -> 2 med -> 4 small).
-// Worst-case simultaneously alive ~= 5*(1+2+4)=35. Cap to keep CPU stable.
-static constexpr uint8_t MAX_ASTEROIDS = 36;
+// Wave sizing: level 1 starts with 1 large asteroid, +1 every 2 levels up to this cap.
+static constexpr uint8_t WAVE_MAX_LARGE = 9;
+
+// Asteroids pool: enough for WAVE_MAX_LARGE large at once + splits
+// (each large -> 2 med -> 4 small). Worst-case alive = 9*(1+2+4) = 63.
+// Collisions use a sorted broad phase and outlines are table-driven, so the
+// late-wave cap no longer needs to be kept artificially low.
+static constexpr uint8_t MAX_ASTEROIDS = WAVE_MAX_LARGE * 7;
 
 #include "AsteroidsGameSprites.h"
 
@@ -1,6 +1,6 @@
 // AsteroidsGameSprites.h
 // -----------------------------------------------------------------------------
-// Sprite/visual tables for Asteroids (kept minimal; Asteroids is vector-style).
+// Sprite/visual tables for Asteroids (vector-style, so "sprites" are outlines).
 //
 // NOTE:
 // - This header is intended to be included from inside `namespace AsteroidsGameConfig`
@@ -8,6 +8,46 @@
 // -----------------------------------------------------------------------------
 #pragma once
 
-// No bitmap sprites required right now.
+#include <Arduino.h>
 
+// Precomputed asteroid outlines (replaces per-frame `drawCircle()` midpoint math).
+//
+// Layout: OUTLINE_SPANS[OUTLINE_FIRST[size] + variant][row][4]
+// - size: 0=small (r=2), 1=medium (r=4), 2=large (r=6) (matches Asteroid::size)
+// - variant: 0..OUTLINE_VARIANTS[size]-1
+// - row: dy = row - radius, for rows 0..(2*radius)
+// - each row holds two horizontal spans relative to the asteroid center:
+//   {leftStart, leftEnd, rightStart, rightEnd}. If both spans are identical the
+//   row is a single run (top/bottom caps). An empty span has end < start.
+// - variant 0 is a plain circle; variants 1..3 are jagged rocks for variety
+//   (small rocks are too tiny to read as jagged, so they stay round).
+static inline constexpr uint8_t OUTLINE_SIZES = 3;
+static inline constexpr uint8_t OUTLINE_SHAPES = 9;
+static inline constexpr uint8_t OUTLINE_MAX_ROWS = 13;
+static inline constexpr uint8_t OUTLINE_RADIUS[OUTLINE_SIZES] = { 2, 4, 6 };
+static inline constexpr uint8_t OUTLINE_VARIANTS[OUTLINE_SIZES] = { 1, 4, 4 };
+static inline constexpr uint8_t OUTLINE_FIRST[OUTLINE_SIZES] = { 0, 1, 5 };
 
+static inline constexpr int8_t OUTLINE_SPANS[OUTLINE_SHAPES][OUTLINE_MAX_ROWS][4] = {
+    // size 0: small (r=2)
+    // variant 0 (round)
+    {{-1,1,-1,1}, {-2,-2,2,2}, {-2,-2,2,2}, {-2,-2,2,2}, {-1,1,-1,1}, {0,-1,0,-1}, {0,-1,0,-1}, {0,-1,0,-1}, {0,-1,0,-1}, {0,-1,0,-1}, {0,-1,0,-1}, {0,-1,0,-1}, {0,-1,0,-1}},
+    // size 1: medium (r=4)
+    // variant 0 (round)
+    {{-1,1,-1,1}, {-3,-2,2,3}, {-3,-3,3,3}, {-4,-4,4,4}, {-4,-4,4,4}, {-4,-4,4,4}, {-3,-3,3,3}, {-3,-2,2,3}, {-1,1,-1,1}, {0,-1,0,-1}, {0,-1,0,-1}, {0,-1,0,-1}, {0,-1,0,-1}},
+    // variant 1 (jagged)
+    {{-1,0,-1,0}, {-3,-2,1,2}, {-3,-3,3,3}, {-3,-3,4,4}, {-3,-3,4,4}, {-3,-3,4,4}, {-3,-3,3,3}, {-2,-2,2,2}, {-1,1,-1,1}, {0,-1,0,-1}, {0,-1,0,-1}, {0,-1,0,-1}, {0,-1,0,-1}},
+    // variant 2 (jagged)
+    {{-1,1,-1,1}, {-2,-2,2,2}, {-3,-3,3,3}, {-3,-3,3,3}, {-4,-4,3,3}, {-4,-4,3,3}, {-3,-3,3,3}, {-3,3,-3,3}, {0,-1,0,-1}, {0,-1,0,-1}, {0,-1,0,-1}, {0,-1,0,-1}, {0,-1,0,-1}},
+    // variant 3 (jagged)
+    {{0,-1,0,-1}, {-2,3,-2,3}, {-3,-3,3,3}, {-3,-3,4,4}, {-3,-3,4,4}, {-3,-3,4,4}, {-3,-3,3,3}, {-3,2,-3,2}, {0,-1,0,-1}, {0,-1,0,-1}, {0,-1,0,-1}, {0,-1,0,-1}, {0,-1,0,-1}},
+    // size 2: large (r=6)
+    // variant 0 (round)
+    {{-2,2,-2,2}, {-3,-3,3,3}, {-4,-4,4,4}, {-5,-5,5,5}, {-6,-6,6,6}, {-6,-6,6,6}, {-6,-6,6,6}, {-6,-6,6,6}, {-6,-6,6,6}, {-5,-5,5,5}, {-4,-4,4,4}, {-3,-3,3,3}, {-2,2,-2,2}},
+    // variant 1 (jagged)
+    {{0,-1,0,-1}, {-3,2,-3,2}, {-4,-4,3,3}, {-5,-5,4,4}, {-5,-5,5,5}, {-5,-5,6,6}, {-4,-4,6,6}, {-5,-5,6,6}, {-5,-5,5,5}, {-4,-4,4,4}, {-4,-4,3,3}, {-3,-2,2,2}, {-1,1,-1,1}},
+    // variant 2 (jagged)
+    {{-1,1,-1,1}, {-2,-2,2,3}, {-3,-3,4,4}, {-4,-4,5,5}, {-5,-5,5,5}, {-5,-5,5,5}, {-5,-5,5,5}, {-5,-5,5,5}, {-5,-5,5,5}, {-5,-5,5,5}, {-4,-4,4,4}, {-3,3,-3,3}, {0,-1,0,-1}},
+    // variant 3 (jagged)
+    {{0,-1,0,-1}, {-2,3,-2,3}, {-4,-3,4,4}, {-4,-4,5,5}, {-5,-5,6,6}, {-5,-5,6,6}, {-5,-5,6,6}, {-5,-5,6,6}, {-5,-5,5,5}, {-5,-5,5,5}, {-4,-4,3,4}, {-3,2,-3,2}, {0,-1,0,-1}},
+};
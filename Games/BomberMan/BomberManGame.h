@@ -3,9 +3,13 @@
 #include <ESP32-HUB75-MatrixPanel-I2S-DMA.h>
 
 #include "../../engine/GameBase.h"
+#include "../../engine/Snapshot.h"
 #include "../../engine/ControllerManager.h"
 #include "../../engine/config.h"
+#include "../../engine/Raster.h"
+#include "../../engine/Pixel565.h"
 #include "../../engine/UserProfiles.h"
+#include "../../engine/Trace.h"
 #include "../../component/SmallFont.h"
 #include "../../component/GameOverLeaderboardView.h"
 
@@ -31,6 +35,11 @@
  * - Exactly one per level, hidden under a brick
  * - Opens when all enemies are defeated
  * - Any alive player reaching the open gate clears the level
+ *
+ * Bots:
+ * - Empty player slots get CPU bombers (allies) until BOT_FILL_TO riders play
+ * - A pad connecting on a bot's slot takes that rider over
+ * - The run ends when no human is left alive
  */
 class BomberManGame : public GameBase {
 private:
@@ -83,6 +92,7 @@ private:
     struct Player {
         bool active = false;
         bool everConnected = false;
+        bool isBot = false;         // CPU-controlled (slot without a pad)
         bool alive = false;
         uint8_t pad = 0;
         uint8_t gx = 1, gy = 1;     // grid position (derived from px/py)
@@ -121,6 +131,14 @@ private:
     uint8_t breakT[Cfg::GRID_H][Cfg::GRID_W];     // 0 none, else intensity for break animation
     uint8_t explT[Cfg::GRID_H][Cfg::GRID_W];      // 0 none, else intensity for explosion
 
+    // Danger map (shared by the bots): millis() at which the first bomb whose blast
+    // reaches the tile goes off, chains included; DANGER_NONE if none does.
+    // Kept up to date as bombs come and go (stampBomb / updateBombs), never
+    // rebuilt per bot or per tick.
+    static constexpr uint32_t DANGER_NONE = 0;
+    uint32_t dangerMs[Cfg::GRID_H][Cfg::GRID_W];
+    uint32_t bombDueMs[Cfg::MAX_BOMBS];           // per bomb, lowered when a chain reaches it
+
     bool gateHidden = false;
     bool gateRevealed = false;
     bool gateOpen = false;
@@ -145,18 +163,6 @@ private:
     static inline bool dRight(uint8_t d) { return (d & 0x04) != 0; }
     static inline bool dLeft(uint8_t d) { return (d & 0x08) != 0; }
 
-    static inline uint16_t dim565(uint16_t c, uint8_t amount /*0..255*/) {
-        // Linear dimming in RGB565 space (cheap + good enough for LED panel UI).
-        // amount=255 -> unchanged; amount=0 -> black.
-        const uint16_t r = (uint16_t)((c >> 11) & 0x1F);
-        const uint16_t g = (uint16_t)((c >> 5) & 0x3F);
-        const uint16_t b = (uint16_t)(c & 0x1F);
-        const uint16_t rr = (uint16_t)((r * amount) / 255);
-        const uint16_t gg = (uint16_t)((g * amount) / 255);
-        const uint16_t bb = (uint16_t)((b * amount) / 255);
-        return (uint16_t)((rr << 11) | (gg << 5) | bb);
-    }
-
     static inline int toPx(int g) { return g * Cfg::CELL; }
 
     bool inBounds(int x, int y) const {
@@ -198,11 +204,92 @@ private:
         return explT[gy][gx] != 0;
     }
 
+    // -----------------------------------------------------
+    // Danger map
+    // -----------------------------------------------------
+    // Tiles a bomb at (gx,gy) would hit right now; same walk as detonateBomb().
+    template <typename Fn>
+    void forEachBlastTile(uint8_t gx, uint8_t gy, uint8_t range, Fn&& fn) const {
+        fn((int)gx, (int)gy);
+        const int dx[4] = { 0, 0, -1, 1 };
+        const int dy[4] = { -1, 1, 0, 0 };
+        for (int dir = 0; dir < 4; dir++) {
+            int x = (int)gx;
+            int y = (int)gy;
+            for (int step = 0; step < (int)range; step++) {
+                x += dx[dir];
+                y += dy[dir];
+                if (!inBounds(x, y)) break;
+                if (tiles[y][x] == TILE_SOLID) break;
+                fn(x, y);
+                if (tiles[y][x] == TILE_BRICK) break;
+            }
+        }
+    }
+
+    static inline bool dueBefore(uint32_t a, uint32_t b) { return (int32_t)(a - b) < 0; }
+    static inline uint32_t dueStamp(uint32_t ms) { return (ms == DANGER_NONE) ? 1 : ms; }
+
+    uint32_t bombDue(const Bomb& b, uint32_t now) const {
+        // plantedMs == 0: caught in a chain, goes off on the next updateBombs().
+        return dueStamp((b.plantedMs == 0) ? now : b.plantedMs + Cfg::BOMB_FUSE_MS);
+    }
+
+    int bombAt(int gx, int gy) const {
+        for (int i = 0; i < Cfg::MAX_BOMBS; i++) {
+            if (bombs[i].active && bombs[i].gx == gx && bombs[i].gy == gy) return i;
+        }
+        return -1;
+    }
+
+    // Stamp bomb `first`'s blast into the danger map. Bombs inside the blast go
+    // off with it, so their due time drops and their own blast is restamped.
+    void stampBomb(int first) {
+        static_assert(Cfg::MAX_BOMBS <= 16, "pending set is a uint16_t");
+        uint16_t pending = (uint16_t)(1u << first);
+        while (pending) {
+            const int i = __builtin_ctz(pending);
+            pending &= (uint16_t)(pending - 1);
+            const Bomb& b = bombs[i];
+            if (!b.active) continue;
+            const uint32_t due = bombDueMs[i];
+            forEachBlastTile(b.gx, b.gy, b.range, [&](int x, int y) {
+                uint32_t& d = dangerMs[y][x];
+                if (d == DANGER_NONE || dueBefore(due, d)) d = due;
+                const int j = bombAt(x, y);
+                if (j >= 0 && j != i && dueBefore(due, bombDueMs[j])) {
+                    bombDueMs[j] = due;
+                    pending |= (uint16_t)(1u << j);
+                }
+            });
+        }
+    }
+
+    void onBombPlanted(int i, uint32_t now) {
+        bombDueMs[i] = bombDue(bombs[i], now);
+        stampBomb(i);
+    }
+
+    // Full rebuild; only for loading a snapshot (bombDueMs is not saved).
+    void rebuildDangerMap(uint32_t now) {
+        memset(dangerMs, 0, sizeof(dangerMs));
+        for (int i = 0; i < Cfg::MAX_BOMBS; i++) {
+            if (bombs[i].active) bombDueMs[i] = bombDue(bombs[i], now);
+        }
+        for (int i = 0; i < Cfg::MAX_BOMBS; i++) {
+            if (bombs[i].active) stampBomb(i);
+        }
+    }
+
     void clearArrays() {
         memset(tiles, 0, sizeof(tiles));
         memset(breakT, 0, sizeof(breakT));
         memset(explT, 0, sizeof(explT));
+        memset(dangerMs, 0, sizeof(dangerMs));
         for (auto &b : bombs) b.active = false;
+        // Players carry over between levels: bombs still ticking when the gate
+        // was reached are gone now, so give their capacity back.
+        for (auto &p : players) p.bombsActive = 0;
         for (auto &p : pickups) p.active = false;
         for (auto &e : enemies) e.alive = false;
     }
@@ -409,6 +496,7 @@ private:
             bombs[i].plantedMs = now;
             bombs[i].range = p.range;
             p.bombsActive++;
+            onBombPlanted(i, now);
             return;
         }
     }
@@ -544,6 +632,7 @@ private:
             bombs[i].plantedMs = now;
             // Enemies use moderate range, scales a bit with level.
             bombs[i].range = (uint8_t)min(4, 2 + (int)level / 3);
+            onBombPlanted(i, now);
             // Cooldown
             e.nextBombMs = now + (uint32_t)random(1500, 2600);
             return;
@@ -551,12 +640,24 @@ private:
     }
 
     void updateBombs(uint32_t now) {
+        bool detonated = false;
         for (int i = 0; i < Cfg::MAX_BOMBS; i++) {
             if (!bombs[i].active) continue;
             if ((uint32_t)(now - bombs[i].plantedMs) >= Cfg::BOMB_FUSE_MS || bombs[i].plantedMs == 0) {
+                // Its blast leaves the danger map (walked before bricks break, so
+                // exactly the tiles it stamped); overlapping bombs restamp below.
+                forEachBlastTile(bombs[i].gx, bombs[i].gy, bombs[i].range,
+                                 [&](int x, int y) { dangerMs[y][x] = DANGER_NONE; });
                 detonateBomb(i, now);
+                detonated = true;
             }
         }
+        if (!detonated) return;
+        // Remaining bombs restamp their blasts: this refills tiles they shared with
+        // the detonated ones and reaches past bricks that just broke.
+        for (int i = 0; i < Cfg::MAX_BOMBS; i++) {
+            if (bombs[i].active) stampBomb(i);
+        }
     }
 
     void updateExplosions(uint32_t now) {
@@ -617,6 +718,7 @@ private:
     }
 
     void updateEnemies(uint32_t now) {
+        TRACE_SCOPE("Bomber.updateEnemies");
         // helper: find nearest alive player tile
         auto nearestPlayer = [&](uint8_t ex, uint8_t ey, uint8_t& outX, uint8_t& outY) -> bool {
             int bestD = 9999;
@@ -634,9 +736,12 @@ private:
         auto bfsNextStep = [&](uint8_t sx, uint8_t sy, uint8_t tx, uint8_t ty, int8_t& stepDx, int8_t& stepDy) -> bool {
             stepDx = 0; stepDy = 0;
             if (sx == tx && sy == ty) return false;
+            // Each tile is enqueued at most once (prevDir marks it first), so the
+            // queue can never hold more than the grid; the guard below keeps it so.
+            static constexpr int QCAP = Cfg::GRID_W * Cfg::GRID_H;
             static int8_t prevDir[Cfg::GRID_H][Cfg::GRID_W];
-            static uint8_t qx[Cfg::GRID_W * Cfg::GRID_H];
-            static uint8_t qy[Cfg::GRID_W * Cfg::GRID_H];
+            static uint8_t qx[QCAP];
+            static uint8_t qy[QCAP];
             for (int y = 0; y < Cfg::GRID_H; y++) for (int x = 0; x < Cfg::GRID_W; x++) prevDir[y][x] = -1;
             int qh = 0, qt = 0;
             qx[qt] = sx; qy[qt] = sy; qt++;
@@ -653,6 +758,7 @@ private:
                     if (!inBounds(nx, ny)) continue;
                     if (prevDir[ny][nx] != -1) continue;
                     if (isBlocked(nx, ny)) continue;
+                    if (qt >= QCAP) return false;
                     prevDir[ny][nx] = (int8_t)dir;
                     qx[qt] = (uint8_t)nx; qy[qt] = (uint8_t)ny; qt++;
                     if ((uint8_t)nx == tx && (uint8_t)ny == ty) {
@@ -746,12 +852,209 @@ private:
         }
     }
 
+    // -----------------------------------------------------
+    // CPU bomber bots
+    // -----------------------------------------------------
+    struct BotMove {
+        int8_t dx = 0;
+        int8_t dy = 0;
+        bool plant = false;
+    };
+
+    // A tile that burns at `due` is unsafe from BOT_SAFETY_MS before the blast
+    // until BOT_SAFETY_MS after its flames are gone.
+    static bool burnsDuring(uint32_t due, uint32_t t0, uint32_t t1) {
+        if (due == DANGER_NONE) return false;
+        const uint32_t from = due - Cfg::BOT_SAFETY_MS;
+        const uint32_t to = due + Cfg::EXPLOSION_MS + Cfg::BOT_SAFETY_MS;
+        return (int32_t)(t1 - from) >= 0 && (int32_t)(to - t0) >= 0;
+    }
+
+    bool enemyAt(int gx, int gy) const {
+        for (int i = 0; i < Cfg::MAX_ENEMIES; i++) {
+            if (enemies[i].alive && enemies[i].gx == gx && enemies[i].gy == gy) return true;
+        }
+        return false;
+    }
+
+    // An enemy on the tile or one step away (it can walk in before we leave).
+    bool enemyNear(int gx, int gy) const {
+        for (int i = 0; i < Cfg::MAX_ENEMIES; i++) {
+            if (!enemies[i].alive) continue;
+            if (abs((int)enemies[i].gx - gx) + abs((int)enemies[i].gy - gy) <= 1) return true;
+        }
+        return false;
+    }
+
+    bool pickupAt(int gx, int gy) const {
+        for (int i = 0; i < Cfg::MAX_PICKUPS; i++) {
+            const Pickup& pu = pickups[i];
+            if (pu.active && pu.revealed && pu.type != PU_GATE && pu.gx == gx && pu.gy == gy) return true;
+        }
+        return false;
+    }
+
+    /**
+     * One bot decision, made whenever the bot may take a step.
+     * A BFS (at most BOT_SEARCH_DEPTH steps) over tiles the bot can walk through
+     * without being there while they burn, timed at `stepMs` per tile against
+     * the danger map. Among reached tiles no bomb will hit:
+     * - in danger: the nearest one;
+     * - otherwise the best of: open gate, pickup, a spot whose blast would hit
+     *   enemies or bricks (plant there), minus a cost per step.
+     * A bomb is only planted when a safe tile is reachable before it goes off.
+     */
+    BotMove thinkBot(const Player& p, uint32_t now, uint32_t stepMs) {
+        static constexpr int QCAP = Cfg::GRID_W * Cfg::GRID_H;
+        static constexpr uint8_t UNSEEN = 0xFF;
+        static uint8_t dist[Cfg::GRID_H][Cfg::GRID_W];
+        static uint8_t firstDir[Cfg::GRID_H][Cfg::GRID_W];
+        static uint8_t qx[QCAP];
+        static uint8_t qy[QCAP];
+        const int dx[4] = { 0, 0, -1, 1 };
+        const int dy[4] = { -1, 1, 0, 0 };
+
+        memset(dist, UNSEEN, sizeof(dist));
+        int qh = 0, qt = 0;
+        qx[qt] = p.gx; qy[qt] = p.gy; qt++;
+        dist[p.gy][p.gx] = 0;
+        firstDir[p.gy][p.gx] = 4;
+        while (qh < qt) {
+            const uint8_t x = qx[qh];
+            const uint8_t y = qy[qh];
+            qh++;
+            const uint8_t d = dist[y][x];
+            if (d >= Cfg::BOT_SEARCH_DEPTH) continue;
+            const uint32_t arrive = now + (uint32_t)(d + 1) * stepMs;
+            for (int dir = 0; dir < 4; dir++) {
+                const int nx = (int)x + dx[dir];
+                const int ny = (int)y + dy[dir];
+                if (!inBounds(nx, ny) || dist[ny][nx] != UNSEEN) continue;
+                if (isBlocked(nx, ny) || explT[ny][nx] != 0) continue;
+                if ((d < 2) ? enemyNear(nx, ny) : enemyAt(nx, ny)) continue;
+                if (burnsDuring(dangerMs[ny][nx], arrive, arrive + stepMs)) continue;
+                dist[ny][nx] = (uint8_t)(d + 1);
+                firstDir[ny][nx] = (d == 0) ? (uint8_t)dir : firstDir[y][x];
+                qx[qt] = (uint8_t)nx; qy[qt] = (uint8_t)ny; qt++;
+            }
+        }
+
+        const bool inDanger = dangerMs[p.gy][p.gx] != DANGER_NONE || explT[p.gy][p.gx] != 0;
+        const bool canPlant = !inDanger && p.bombsActive < p.bombsCap;
+        int bestScore = 0;
+        int best = -1;
+        bool bestPlant = false;
+        for (int i = 0; i < qt; i++) {
+            const int x = qx[i];
+            const int y = qy[i];
+            if (dangerMs[y][x] != DANGER_NONE) continue; // never settle where a bomb will hit
+            if (i > 0 && enemyNear(x, y)) continue;
+            int value = 0;
+            bool plant = false;
+            if (inDanger) {
+                value = 1;
+            } else {
+                if (gateOpen && x == gateX && y == gateY) value = 100;
+                else if (pickupAt(x, y)) value = 40;
+                if (canPlant && bombAt(x, y) < 0) {
+                    int hits = 0;
+                    bool hitsHuman = false;
+                    forEachBlastTile((uint8_t)x, (uint8_t)y, p.range, [&](int bx, int by) {
+                        if (tiles[by][bx] == TILE_BRICK) hits += 20;
+                        else if (enemyAt(bx, by)) hits += 60;
+                        for (int pi = 0; pi < Cfg::MAX_PLAYERS; pi++) {
+                            const Player& o = players[pi];
+                            if (o.alive && !o.isBot && o.gx == bx && o.gy == by) hitsHuman = true;
+                        }
+                    });
+                    if (!hitsHuman && hits > value) { value = hits; plant = true; }
+                }
+            }
+            if (value == 0) continue;
+            const int score = value * 4 - (int)dist[y][x] * 6;
+            if (best < 0 || score > bestScore) { bestScore = score; best = i; bestPlant = plant; }
+        }
+
+        BotMove m;
+        if (best < 0) {
+            // Nothing worth doing: drift to a random safe neighbour now and then.
+            if (!inDanger && random(0, 100) < 25) {
+                const int dir = (int)random(0, 4);
+                const int nx = (int)p.gx + dx[dir];
+                const int ny = (int)p.gy + dy[dir];
+                if (inBounds(nx, ny) && dist[ny][nx] == 1 && dangerMs[ny][nx] == DANGER_NONE) {
+                    m.dx = (int8_t)dx[dir];
+                    m.dy = (int8_t)dy[dir];
+                }
+            }
+            return m;
+        }
+
+        const int tx = qx[best];
+        const int ty = qy[best];
+        if (tx != p.gx || ty != p.gy) {
+            const uint8_t dir = firstDir[ty][tx];
+            m.dx = (int8_t)dx[dir];
+            m.dy = (int8_t)dy[dir];
+            return m;
+        }
+        if (!bestPlant) return m;
+
+        // Plant only with a way out: a reached tile outside this blast and every
+        // other, reachable with BOT_SAFETY_MS to spare before the fuse runs out.
+        static bool inBlast[Cfg::GRID_H][Cfg::GRID_W];
+        memset(inBlast, 0, sizeof(inBlast));
+        forEachBlastTile(p.gx, p.gy, p.range, [&](int x, int y) { inBlast[y][x] = true; });
+        for (int i = 1; i < qt; i++) {
+            const int x = qx[i];
+            const int y = qy[i];
+            if (inBlast[y][x] || dangerMs[y][x] != DANGER_NONE) continue;
+            if ((uint32_t)dist[y][x] * stepMs + Cfg::BOT_SAFETY_MS < Cfg::BOMB_FUSE_MS) {
+                m.plant = true;
+                break;
+            }
+        }
+        return m;
+    }
+
+    // Empty slots become bots (once per run) while a human plays, up to BOT_FILL_TO riders.
+    void assignBots(ControllerManager* input) {
+        if (Cfg::BOT_FILL_TO == 0 || !input) return;
+        int humans = 0;
+        int bots = 0;
+        for (int i = 0; i < Cfg::MAX_PLAYERS; i++) {
+            if (input->pad(i).connected) humans++;
+            else if (players[i].isBot) bots++;
+        }
+        if (humans == 0) return;
+        const uint8_t spawnX[Cfg::MAX_PLAYERS] = { 1, (uint8_t)(Cfg::GRID_W - 2), 1, (uint8_t)(Cfg::GRID_W - 2) };
+        const uint8_t spawnY[Cfg::MAX_PLAYERS] = { 1, 1, (uint8_t)(Cfg::GRID_H - 2), (uint8_t)(Cfg::GRID_H - 2) };
+        for (int i = Cfg::MAX_PLAYERS - 1; i >= 0 && humans + bots < (int)Cfg::BOT_FILL_TO; i--) {
+            Player& p = players[i];
+            if (p.everConnected || input->pad(i).connected) continue;
+            p.isBot = true;
+            p.everConnected = true;
+            spawnPlayerAt(p, spawnX[i], spawnY[i]);
+            bots++;
+        }
+    }
+
     void updatePlayers(ControllerManager* input, uint32_t now) {
+        TRACE_SCOPE("Bomber.updatePlayers");
+        assignBots(input);
+        static uint32_t lastMoveMs[Cfg::MAX_PLAYERS] = {0,0,0,0};
+        static uint32_t botIdleMs[Cfg::MAX_PLAYERS] = {0,0,0,0};  // last decision that left the bot in place
         for (int i = 0; i < Cfg::MAX_PLAYERS; i++) {
             Player& p = players[i];
-            ControllerPtr ctl = input ? input->getController(i) : nullptr;
-            const bool connected = (ctl && ctl->isConnected());
-            p.active = connected;
+            const PadState& pad = input ? input->pad(i) : PadState();
+            const bool connected = pad.connected;
+            if (connected && p.isBot) {
+                // A pad joined on this slot: the human takes the rider over
+                // (or gets a fresh spawn if the bot was already out).
+                p.isBot = false;
+                if (!p.alive) p.everConnected = false;
+            }
+            p.active = connected || p.isBot;
             if (connected && !p.everConnected) {
                 p.everConnected = true;
                 // spawn at corner
@@ -759,48 +1062,64 @@ private:
                 const uint8_t spawnY[Cfg::MAX_PLAYERS] = { 1, 1, (uint8_t)(Cfg::GRID_H - 2), (uint8_t)(Cfg::GRID_H - 2) };
                 spawnPlayerAt(p, spawnX[i], spawnY[i]);
             }
-            if (!connected) continue;
+            if (!p.active) continue;
             if (!p.alive) continue;
 
             // Explosion damage
             if (anyExplosionAt(p.gx, p.gy)) hitPlayer(p, now);
 
-            // Movement (discrete grid-step, input-driven)
-            const uint8_t d = ctl->dpad();
+            const uint32_t interval = (uint32_t)max(60, 230 - (int)p.speed * 22);
+            const bool moveReady = (uint32_t)(now - lastMoveMs[i]) >= interval;
+
             int dx = 0, dy = 0;
-            if (dUp(d)) dy = -1;
-            else if (dDown(d)) dy = 1;
-            else if (dLeft(d)) dx = -1;
-            else if (dRight(d)) dx = 1;
+            bool bombPress = false;
+            if (p.isBot) {
+                // Bots decide when they can act; between steps there is nothing to choose.
+                // A bot that stayed put (idle or blocked) waits one step interval
+                // before searching again instead of re-running the BFS every tick.
+                if (!moveReady || (uint32_t)(now - botIdleMs[i]) < interval) continue;
+                const BotMove m = thinkBot(p, now, interval);
+                dx = m.dx;
+                dy = m.dy;
+                bombPress = m.plant;
+            } else {
+                // Movement (discrete grid-step, input-driven)
+                const uint8_t d = pad.dpad;
+                if (dUp(d)) dy = -1;
+                else if (dDown(d)) dy = 1;
+                else if (dLeft(d)) dx = -1;
+                else if (dRight(d)) dx = 1;
+
+                // Place bomb (A edge)
+                const bool aNow = pad.held(PadState::BTN_A);
+                bombPress = aNow && !p.lastA;
+                p.lastA = aNow;
+            }
 
-            if (dx != 0 || dy != 0) {
+            bool moved = false;
+            if ((dx != 0 || dy != 0) && moveReady) {
                 const int nx = (int)p.gx + dx;
                 const int ny = (int)p.gy + dy;
-                static uint32_t lastMoveMs[Cfg::MAX_PLAYERS] = {0,0,0,0};
-                const uint32_t interval = (uint32_t)max(60, 230 - (int)p.speed * 22);
-                if ((uint32_t)(now - lastMoveMs[i]) >= interval) {
-                    if (!isBlocked(nx, ny)) {
-                        p.gx = (uint8_t)nx;
-                        p.gy = (uint8_t)ny;
-                        p.px = (int16_t)toPx(p.gx);
-                        p.py = (int16_t)toPx(p.gy);
-                        lastMoveMs[i] = now;
-                    }
+                if (!isBlocked(nx, ny)) {
+                    p.gx = (uint8_t)nx;
+                    p.gy = (uint8_t)ny;
+                    p.px = (int16_t)toPx(p.gx);
+                    p.py = (int16_t)toPx(p.gy);
+                    lastMoveMs[i] = now;
+                    moved = true;
                 }
             }
+            // After planting the bot replans on the next tick (it has to run).
+            if (p.isBot && !moved && !bombPress) botIdleMs[i] = now;
 
-            // Place bomb (A edge)
-            const bool aNow = (bool)ctl->a();
-            const bool aEdge = aNow && !p.lastA;
-            p.lastA = aNow;
             // Debounce bomb placement right after spawn/connect (prevents "random" bombs).
-            if (aEdge && (uint32_t)(now - p.spawnMs) > 250) plantBomb(p, now);
+            if (bombPress && (uint32_t)(now - p.spawnMs) > 250) plantBomb(p, now);
         }
     }
 
-    int alivePlayers() const {
+    int aliveHumans() const {
         int n = 0;
-        for (int i = 0; i < Cfg::MAX_PLAYERS; i++) if (players[i].alive) n++;
+        for (int i = 0; i < Cfg::MAX_PLAYERS; i++) if (players[i].alive && !players[i].isBot) n++;
         return n;
     }
 
@@ -823,13 +1142,16 @@ private:
                 if (p.gx == gateX && p.gy == gateY) {
                     score += Cfg::SCORE_LEVEL_CLEAR;
                     level++;
+                    // generateLevel() marks every rider dead; remember who made it.
+                    bool survived[Cfg::MAX_PLAYERS];
+                    for (int pi = 0; pi < Cfg::MAX_PLAYERS; pi++) survived[pi] = players[pi].alive;
                     generateLevel(now);
                     // reset players positions but keep powerups
                     const uint8_t spawnX[Cfg::MAX_PLAYERS] = { 1, (uint8_t)(Cfg::GRID_W - 2), 1, (uint8_t)(Cfg::GRID_W - 2) };
                     const uint8_t spawnY[Cfg::MAX_PLAYERS] = { 1, 1, (uint8_t)(Cfg::GRID_H - 2), (uint8_t)(Cfg::GRID_H - 2) };
                     for (int pi = 0; pi < Cfg::MAX_PLAYERS; pi++) {
                         if (!players[pi].everConnected) continue;
-                        if (!players[pi].alive) continue;
+                        if (!survived[pi]) continue;
                         spawnPlayerAt(players[pi], spawnX[pi], spawnY[pi]);
                     }
                     return;
@@ -849,6 +1171,7 @@ public:
         for (int i = 0; i < Cfg::MAX_PLAYERS; i++) {
             players[i].active = false;
             players[i].everConnected = false;
+            players[i].isBot = false;
             players[i].alive = false;
         }
     }
@@ -870,11 +1193,12 @@ public:
         updatePickups();
         updateGate(now);
 
-        // Game over when no players alive (but at least one controller was connected)
-        if (alivePlayers() == 0) {
+        // Game over when no human is alive (but at least one controller was connected);
+        // bots alone do not carry on the run.
+        if (aliveHumans() == 0) {
             bool anyConnected = false;
             for (int i = 0; i < Cfg::MAX_PLAYERS; i++) {
-                if (input && input->getController(i) && input->getController(i)->isConnected()) { anyConnected = true; break; }
+                if (input && input->pad(i).connected) { anyConnected = true; break; }
             }
             if (anyConnected) {
                 gameOver = true;
@@ -897,74 +1221,95 @@ public:
         SmallFont::drawString(display, 2, 6, "BOMBER", COLOR_CYAN);
         SmallFont::drawStringF(display, 36, 6, COLOR_YELLOW, "L%u", (unsigned)level);
         SmallFont::drawStringF(display, 52, 6, COLOR_YELLOW, "%lu", (unsigned long)score);
-        for (int x = 0; x < PANEL_RES_X; x += 2) display->drawPixel(x, Cfg::HUD_H - 1, COLOR_BLUE);
-
-        // Tiles
+        Raster::dashedHLine(display, 0, Cfg::HUD_H - 1, PANEL_RES_X, COLOR_BLUE);
+
+        // Tiles: one layer over the grid (runs of equal cells become single spans)
+        static const TileGfx::TileSet cellSet = { CELL_TILES_PACKED.rows, Cfg::CELL, Cfg::CELL, 3 };
+        static constexpr uint16_t CELL_PALETTE[4] = { 0, Cfg::COL_SOLID, Cfg::COL_BRICK, 0 };
+        static_assert(TILE_EMPTY == 0 && TILE_SOLID == 1 && TILE_BRICK == 2, "CELL_TILES_4 is indexed by Tile");
+        if (Cfg::COL_FLOOR != COLOR_BLACK) {
+            display->fillRect(Cfg::ORIGIN_X, Cfg::ORIGIN_Y, Cfg::GRID_W * Cfg::CELL, Cfg::GRID_H * Cfg::CELL, Cfg::COL_FLOOR);
+        }
+        TileGfx::TileLayer grid;
+        grid.set = &cellSet;
+        grid.map = reinterpret_cast<const uint8_t*>(&tiles[0][0]);
+        grid.mapW = Cfg::GRID_W;
+        grid.mapH = Cfg::GRID_H;
+        grid.viewX = Cfg::ORIGIN_X;
+        grid.viewY = Cfg::ORIGIN_Y;
+        grid.viewW = Cfg::GRID_W * Cfg::CELL;
+        grid.viewH = Cfg::GRID_H * Cfg::CELL;
+        grid.palette = CELL_PALETTE;
+        grid.draw(display);
+
+        // Cell overlays. Each stays inside its own cell, so drawing them in
+        // passes keeps the per-cell stacking (debris, gate, pickup, explosion).
         for (int gy = 0; gy < Cfg::GRID_H; gy++) {
             for (int gx = 0; gx < Cfg::GRID_W; gx++) {
                 const int px = Cfg::ORIGIN_X + gx * Cfg::CELL;
                 const int py = Cfg::ORIGIN_Y + gy * Cfg::CELL;
 
-                uint16_t c = Cfg::COL_FLOOR;
-                if (tiles[gy][gx] == TILE_SOLID) c = Cfg::COL_SOLID;
-                else if (tiles[gy][gx] == TILE_BRICK) c = Cfg::COL_BRICK;
-                display->fillRect(px, py, Cfg::CELL, Cfg::CELL, c);
-
                 // Break animation overlay (debris)
                 if (breakT[gy][gx] != 0) {
                     // Simple debris: 3 frames based on intensity
                     const uint8_t bt = breakT[gy][gx];
-                    const uint16_t dc1 = (bt > 170) ? COLOR_YELLOW : (bt > 90) ? COLOR_ORANGE : dim565(COLOR_ORANGE, 140);
+                    const uint16_t dc1 = (bt > 170) ? COLOR_YELLOW : (bt > 90) ? COLOR_ORANGE : Pixel565::scale(COLOR_ORANGE, 140);
                     display->drawPixel(px + 1, py + 1, dc1);
                     if (bt > 120) display->drawPixel(px + 2, py + 1, dc1);
                     if (bt > 70)  display->drawPixel(px + 1, py + 2, dc1);
                     if (bt > 150) display->drawPixel(px + 2, py + 2, dc1);
                 }
+            }
+        }
 
-                // Gate
-                if (gateRevealed && gx == gateX && gy == gateY) {
-                    const uint16_t gc = gateOpen ? Cfg::COL_GATE_OPEN : Cfg::COL_GATE_LOCKED;
-                    display->drawRect(px, py, Cfg::CELL, Cfg::CELL, gc);
-                }
+        // Gate
+        if (gateRevealed && inBounds(gateX, gateY)) {
+            const uint16_t gc = gateOpen ? Cfg::COL_GATE_OPEN : Cfg::COL_GATE_LOCKED;
+            Raster::rect(display, Cfg::ORIGIN_X + gateX * Cfg::CELL, Cfg::ORIGIN_Y + gateY * Cfg::CELL, Cfg::CELL, Cfg::CELL, gc);
+        }
 
-                // Pickup (revealed)
-                for (int i = 0; i < Cfg::MAX_PICKUPS; i++) {
-                    if (!pickups[i].active || !pickups[i].revealed) continue;
-                    if (pickups[i].gx != gx || pickups[i].gy != gy) continue;
-                    if (pickups[i].type == PU_GATE) break; // gate is drawn via gate state
-
-                    const uint8_t (*spr)[4] = PU_BOOT_4;
-                    uint16_t pc = COLOR_WHITE;
-                    if (pickups[i].type == PU_BOOT) { spr = PU_BOOT_4; pc = COLOR_WHITE; }
-                    if (pickups[i].type == PU_BOMB) { spr = PU_BOMB_4; pc = COLOR_YELLOW; }
-                    if (pickups[i].type == PU_FLAME) { spr = PU_FLAME_4; pc = COLOR_ORANGE; }
-                    if (pickups[i].type == PU_SHIELD) { spr = PU_SHIELD_4; pc = COLOR_CYAN; }
-
-                    for (int yy = 0; yy < 4; yy++) {
-                        for (int xx = 0; xx < 4; xx++) {
-                            if (!spr[yy][xx]) continue;
-                            display->drawPixel(px + xx, py + yy, pc);
-                        }
-                    }
+        // Pickups (revealed)
+        for (int i = 0; i < Cfg::MAX_PICKUPS; i++) {
+            if (!pickups[i].active || !pickups[i].revealed) continue;
+            if (pickups[i].type == PU_GATE) continue; // gate is drawn via gate state
+            const int px = Cfg::ORIGIN_X + pickups[i].gx * Cfg::CELL;
+            const int py = Cfg::ORIGIN_Y + pickups[i].gy * Cfg::CELL;
+
+            const uint8_t (*spr)[4] = PU_BOOT_4;
+            uint16_t pc = COLOR_WHITE;
+            if (pickups[i].type == PU_BOOT) { spr = PU_BOOT_4; pc = COLOR_WHITE; }
+            if (pickups[i].type == PU_BOMB) { spr = PU_BOMB_4; pc = COLOR_YELLOW; }
+            if (pickups[i].type == PU_FLAME) { spr = PU_FLAME_4; pc = COLOR_ORANGE; }
+            if (pickups[i].type == PU_SHIELD) { spr = PU_SHIELD_4; pc = COLOR_CYAN; }
+
+            for (int yy = 0; yy < 4; yy++) {
+                for (int xx = 0; xx < 4; xx++) {
+                    if (!spr[yy][xx]) continue;
+                    display->drawPixel(px + xx, py + yy, pc);
                 }
+            }
+        }
 
-                // Explosion overlay (animated)
-                if (explT[gy][gx] != 0) {
-                    // Animate by intensity: bright -> full fill, mid -> plus, low -> sparks
-                    const uint8_t et = explT[gy][gx];
-                    if (et > 170) {
-                        display->fillRect(px, py, Cfg::CELL, Cfg::CELL, Cfg::COL_EXPLO1);
-                    } else if (et > 90) {
-                        display->fillRect(px, py, Cfg::CELL, Cfg::CELL, Cfg::COL_EXPLO2);
-                        // plus highlight
-                        display->drawPixel(px + 1, py + 1, Cfg::COL_EXPLO1);
-                        display->drawPixel(px + 2, py + 1, Cfg::COL_EXPLO1);
-                        display->drawPixel(px + 1, py + 2, Cfg::COL_EXPLO1);
-                        display->drawPixel(px + 2, py + 2, Cfg::COL_EXPLO1);
-                    } else {
-                        display->drawPixel(px + 1, py + 1, Cfg::COL_EXPLO2);
-                        display->drawPixel(px + 2, py + 2, Cfg::COL_EXPLO1);
-                    }
+        // Explosion overlay (animated)
+        for (int gy = 0; gy < Cfg::GRID_H; gy++) {
+            for (int gx = 0; gx < Cfg::GRID_W; gx++) {
+                if (explT[gy][gx] == 0) continue;
+                const int px = Cfg::ORIGIN_X + gx * Cfg::CELL;
+                const int py = Cfg::ORIGIN_Y + gy * Cfg::CELL;
+                // Animate by intensity: bright -> full fill, mid -> plus, low -> sparks
+                const uint8_t et = explT[gy][gx];
+                if (et > 170) {
+                    display->fillRect(px, py, Cfg::CELL, Cfg::CELL, Cfg::COL_EXPLO1);
+                } else if (et > 90) {
+                    display->fillRect(px, py, Cfg::CELL, Cfg::CELL, Cfg::COL_EXPLO2);
+                    // plus highlight
+                    display->drawPixel(px + 1, py + 1, Cfg::COL_EXPLO1);
+                    display->drawPixel(px + 2, py + 1, Cfg::COL_EXPLO1);
+                    display->drawPixel(px + 1, py + 2, Cfg::COL_EXPLO1);
+                    display->drawPixel(px + 2, py + 2, Cfg::COL_EXPLO1);
+                } else {
+                    display->drawPixel(px + 1, py + 1, Cfg::COL_EXPLO2);
+                    display->drawPixel(px + 2, py + 2, Cfg::COL_EXPLO1);
                 }
             }
         }
@@ -1002,7 +1347,7 @@ public:
             const int px = Cfg::ORIGIN_X + p.gx * Cfg::CELL;
             const int py = Cfg::ORIGIN_Y + p.gy * Cfg::CELL;
             display->fillRect(px + 1, py + 1, Cfg::CELL - 2, Cfg::CELL - 2, p.color);
-            if (p.shield) display->drawRect(px, py, Cfg::CELL, Cfg::CELL, COLOR_CYAN);
+            if (p.shield) Raster::rect(display, px, py, Cfg::CELL, Cfg::CELL, COLOR_CYAN);
         }
     }
 
@@ -1013,6 +1358,207 @@ public:
     const char* leaderboardId() const override { return "bomber"; }
     const char* leaderboardName() const override { return "Bomber"; }
     uint32_t leaderboardScore() const override { return score; }
+
+    // Self-check (DEBUG_INVARIANTS)
+    const char* checkInvariants() const override {
+        uint8_t owned[Cfg::MAX_PLAYERS] = { 0 };
+        for (int i = 0; i < Cfg::MAX_BOMBS; i++) {
+            const Bomb& b = bombs[i];
+            if (!b.active) continue;
+            if (!inBounds(b.gx, b.gy)) return "bomb off grid";
+            if (tiles[b.gy][b.gx] == TILE_SOLID) return "bomb inside a solid tile";
+            if (b.ownerIsEnemy) {
+                if (b.ownerEnemyIndex >= Cfg::MAX_ENEMIES) return "enemy bomb owner out of range";
+            } else {
+                if (b.owner >= Cfg::MAX_PLAYERS) return "bomb owner out of range";
+                owned[b.owner]++;
+            }
+        }
+        for (int i = 0; i < Cfg::MAX_PLAYERS; i++) {
+            const Player& p = players[i];
+            if (p.bombsActive != owned[i]) return "player bombsActive != bombs on the field";
+            if (!p.alive) continue;
+            if (!inBounds(p.gx, p.gy)) return "player off grid";
+            if (tiles[p.gy][p.gx] == TILE_SOLID) return "player inside a solid tile";
+        }
+        for (int i = 0; i < Cfg::MAX_ENEMIES; i++) {
+            const Enemy& e = enemies[i];
+            if (!e.alive) continue;
+            if (!inBounds(e.gx, e.gy)) return "enemy off grid";
+            if (tiles[e.gy][e.gx] == TILE_SOLID || tiles[e.gy][e.gx] == TILE_BRICK) return "enemy inside a wall";
+            if (e.dir > 3) return "enemy dir out of range";
+        }
+        for (int i = 0; i < Cfg::MAX_PICKUPS; i++) {
+            if (pickups[i].active && !inBounds(pickups[i].gx, pickups[i].gy)) return "pickup off grid";
+        }
+        // The danger map is maintained incrementally: it must cover exactly the live blasts.
+        bool covered[Cfg::GRID_H][Cfg::GRID_W] = {};
+        for (int i = 0; i < Cfg::MAX_BOMBS; i++) {
+            if (!bombs[i].active) continue;
+            forEachBlastTile(bombs[i].gx, bombs[i].gy, bombs[i].range, [&](int x, int y) { covered[y][x] = true; });
+        }
+        for (int y = 0; y < Cfg::GRID_H; y++) {
+            for (int x = 0; x < Cfg::GRID_W; x++) {
+                if (covered[y][x] != (dangerMs[y][x] != DANGER_NONE)) return "danger map out of sync with bombs";
+            }
+        }
+        return nullptr;
+    }
+
+    // Snapshots (engine/Snapshot.h). Inactive pool entries are a single 0 byte.
+    uint8_t snapshotVersion() const override { return 2; }
+
+    void saveSnapshot(SnapshotWriter& w) const override {
+        w.boolean(gameOver);
+        w.u32(score);
+        w.u16(level);
+        w.time(lastTickMs);
+
+        w.rle(reinterpret_cast<const uint8_t*>(&tiles[0][0]), sizeof(tiles));
+        w.rle(&breakT[0][0], sizeof(breakT));
+        w.rle(&explT[0][0], sizeof(explT));
+        w.boolean(gateHidden);
+        w.boolean(gateRevealed);
+        w.boolean(gateOpen);
+        w.u8(gateX);
+        w.u8(gateY);
+
+        for (const Player& p : players) {
+            w.bits(p.active, 1);
+            w.bits(p.everConnected, 1);
+            w.bits(p.isBot, 1);
+            w.bits(p.alive, 1);
+            w.bits(p.shield, 1);
+            w.bits(p.lastA, 1);
+            w.u8(p.pad);
+            w.u8(p.gx);
+            w.u8(p.gy);
+            w.i16(p.px);
+            w.i16(p.py);
+            w.u8(p.bombsCap);
+            w.u8(p.bombsActive);
+            w.u8(p.range);
+            w.u8(p.speed);
+            w.u16(p.color);
+            w.time(p.respawnUntilMs);
+            w.time(p.spawnMs);
+            w.u8((uint8_t)p.dirX);
+            w.u8((uint8_t)p.dirY);
+            w.u8((uint8_t)p.wishX);
+            w.u8((uint8_t)p.wishY);
+        }
+        for (const Enemy& e : enemies) {
+            w.boolean(e.alive);
+            if (!e.alive) continue;
+            w.u8(e.type);
+            w.u8(e.gx);
+            w.u8(e.gy);
+            w.u8(e.dir);
+            w.time(e.nextTurnMs);
+            w.u32(e.moveIntervalMs);
+            w.time(e.nextBombMs);
+        }
+        for (const Bomb& b : bombs) {
+            w.boolean(b.active);
+            if (!b.active) continue;
+            w.boolean(b.ownerIsEnemy);
+            w.u8(b.owner);
+            w.u8(b.ownerEnemyIndex);
+            w.u8(b.gx);
+            w.u8(b.gy);
+            w.time(b.plantedMs);
+            w.u8(b.range);
+        }
+        for (const Pickup& pu : pickups) {
+            w.boolean(pu.active);
+            if (!pu.active) continue;
+            w.boolean(pu.revealed);
+            w.u8(pu.gx);
+            w.u8(pu.gy);
+            w.u8((uint8_t)pu.type);
+        }
+    }
+
+    bool loadSnapshot(SnapshotReader& r) override {
+        gameOver = r.boolean();
+        score = r.u32();
+        level = r.u16();
+        lastTickMs = r.time();
+
+        r.rle(reinterpret_cast<uint8_t*>(&tiles[0][0]), sizeof(tiles));
+        r.rle(&breakT[0][0], sizeof(breakT));
+        r.rle(&explT[0][0], sizeof(explT));
+        for (int y = 0; y < Cfg::GRID_H; y++) {
+            for (int x = 0; x < Cfg::GRID_W; x++) {
+                if (tiles[y][x] > TILE_BRICK) return false;
+            }
+        }
+        gateHidden = r.boolean();
+        gateRevealed = r.boolean();
+        gateOpen = r.boolean();
+        gateX = r.below(Cfg::GRID_W);
+        gateY = r.below(Cfg::GRID_H);
+
+        for (Player& p : players) {
+            p.active = r.bits(1);
+            p.everConnected = r.bits(1);
+            p.isBot = r.bits(1);
+            p.alive = r.bits(1);
+            p.shield = r.bits(1);
+            p.lastA = r.bits(1);
+            p.pad = r.below(Cfg::MAX_PLAYERS);
+            p.gx = r.below(Cfg::GRID_W);
+            p.gy = r.below(Cfg::GRID_H);
+            p.px = r.i16();
+            p.py = r.i16();
+            p.bombsCap = r.u8();
+            p.bombsActive = r.u8();
+            p.range = r.u8();
+            p.speed = r.u8();
+            p.color = r.u16();
+            p.respawnUntilMs = r.time();
+            p.spawnMs = r.time();
+            p.dirX = (int8_t)r.u8();
+            p.dirY = (int8_t)r.u8();
+            p.wishX = (int8_t)r.u8();
+            p.wishY = (int8_t)r.u8();
+        }
+        for (Enemy& e : enemies) {
+            e = Enemy();
+            e.alive = r.boolean();
+            if (!e.alive) continue;
+            e.type = r.u8();
+            e.gx = r.below(Cfg::GRID_W);
+            e.gy = r.below(Cfg::GRID_H);
+            e.dir = r.below(4);
+            e.nextTurnMs = r.time();
+            e.moveIntervalMs = r.u32();
+            e.nextBombMs = r.time();
+        }
+        for (Bomb& b : bombs) {
+            b = Bomb();
+            b.active = r.boolean();
+            if (!b.active) continue;
+            b.ownerIsEnemy = r.boolean();
+            b.owner = r.below(Cfg::MAX_PLAYERS);
+            b.ownerEnemyIndex = r.below(Cfg::MAX_ENEMIES);
+            b.gx = r.below(Cfg::GRID_W);
+            b.gy = r.below(Cfg::GRID_H);
+            b.plantedMs = r.time();
+            b.range = r.u8();
+        }
+        for (Pickup& pu : pickups) {
+            pu = Pickup();
+            pu.active = r.boolean();
+            if (!pu.active) continue;
+            pu.revealed = r.boolean();
+            pu.gx = r.below(Cfg::GRID_W);
+            pu.gy = r.below(Cfg::GRID_H);
+            pu.type = (PickupType)r.below(PU_GATE + 1);
+        }
+        rebuildDangerMap((uint32_t)millis());
+        return r.ok();
+    }
 };
 
 
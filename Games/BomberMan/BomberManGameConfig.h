@@ -42,6 +42,11 @@ static constexpr uint8_t WALL_BRICK = 2;
 static constexpr uint8_t CHANCE_POWERUP = 24;
 static constexpr uint8_t CHANCE_GATE = 6;      // picked once; gate forced to exist
 
+// CPU bomber bots: allies in empty player slots (see BomberManGame::thinkBot)
+static constexpr uint8_t BOT_FILL_TO = 2;         // bots join until humans + bots = this (0 = off)
+static constexpr uint8_t BOT_SEARCH_DEPTH = 10;   // BFS steps per decision
+static constexpr uint32_t BOT_SAFETY_MS = 160;    // keep this clear of a tile's blast window
+
 // Scoring
 static constexpr uint16_t SCORE_KILL_ENEMY = 50;
 static constexpr uint16_t SCORE_BREAK_BRICK = 5;
@@ -1,5 +1,6 @@
 #pragma once
 #include <Arduino.h>
+#include "../../engine/TileLayer.h"
 
 /**
  * 4x4 sprites (1 = pixel on).
@@ -50,4 +51,11 @@ inline constexpr uint8_t ENEMY_CHASER_4[4][4] = {
     {0,1,1,0},
 };
 
-
+// Map cells for the tile layer, indexed by the game's Tile enum
+// (empty, solid, brick). Value = palette entry; the floor is transparent.
+inline constexpr uint8_t CELL_TILES_4[3][4][4] = {
+    { {0,0,0,0}, {0,0,0,0}, {0,0,0,0}, {0,0,0,0} },
+    { {1,1,1,1}, {1,1,1,1}, {1,1,1,1}, {1,1,1,1} },
+    { {2,2,2,2}, {2,2,2,2}, {2,2,2,2}, {2,2,2,2} },
+};
+inline constexpr TileGfx::PackedTiles<3, 4, 4> CELL_TILES_PACKED(CELL_TILES_4);
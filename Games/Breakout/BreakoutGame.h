@@ -4,6 +4,8 @@
 #include "../../engine/GameBase.h"
 #include "../../engine/ControllerManager.h"
 #include "../../engine/config.h"
+#include "../../engine/Raster.h"
+#include "../../engine/Pixel565.h"
 #include "../../engine/AudioManager.h"
 #include "../../component/SmallFont.h"
 #include "../../engine/Settings.h"
@@ -30,16 +32,6 @@
  */
 class BreakoutGame : public GameBase {
 private:
-    // ---------------------------------------------------------
-    // Analog helpers (Bluepad32 API varies across versions/controllers)
-    // ---------------------------------------------------------
-    struct InputDetail {
-        template <typename T>
-        static auto axisX(T* c, int) -> decltype(c->axisX(), int16_t()) { return (int16_t)c->axisX(); }
-        template <typename T>
-        static int16_t axisX(T*, ...) { return 0; }
-    };
-
     static inline float clampf(float v, float lo, float hi) { return (v < lo) ? lo : (v > hi) ? hi : v; }
     static inline float deadzone01(float v, float dz) {
         const float a = fabsf(v);
@@ -205,24 +197,10 @@ private:
     // ---------------------------------------------------------
     // Small helpers
     // ---------------------------------------------------------
-    static inline uint16_t dimColor(uint16_t c, uint8_t mul /*0..255*/) {
-        uint8_t r = (uint8_t)((c >> 11) & 0x1F);
-        uint8_t g = (uint8_t)((c >> 5) & 0x3F);
-        uint8_t b = (uint8_t)(c & 0x1F);
-        r = (uint8_t)((r * mul) / 255);
-        g = (uint8_t)((g * mul) / 255);
-        b = (uint8_t)((b * mul) / 255);
-        return (uint16_t)((r << 11) | (g << 5) | b);
-    }
-
-    static inline uint16_t brightenColor(uint16_t c, uint8_t add /*0..63-ish*/) {
-        int r = (int)((c >> 11) & 0x1F);
-        int g = (int)((c >> 5) & 0x3F);
-        int b = (int)(c & 0x1F);
-        r = min(31, r + (int)min<uint8_t>(31, add / 2));
-        g = min(63, g + (int)min<uint8_t>(63, add));
-        b = min(31, b + (int)min<uint8_t>(31, add / 2));
-        return (uint16_t)((r << 11) | (g << 5) | b);
+    // Lift each channel by about `add` (green in 6-bit steps, red/blue half that).
+    static constexpr uint16_t brightenColor(uint16_t c, uint8_t add /*0..63-ish*/) {
+        return Pixel565::addSat(c, Pixel565::pack(Pixel565::clampTo(add / 2, 31), Pixel565::clampTo(add, 63),
+                                                  Pixel565::clampTo(add / 2, 31)));
     }
 
     static inline int bricksStartX() {
@@ -435,10 +413,21 @@ private:
         return palette[col % (sizeof(palette) / sizeof(palette[0]))];
     }
 
-    void spawnBrickRow(float y) {
+    // A row is placed whole or not at all: a pool that runs dry mid-row would
+    // leave a gap the player can't see a reason for. Returns false if skipped.
+    bool spawnBrickRow(float y) {
+        int freeSlots = 0;
+        for (int i = 0; i < MAX_BRICKS && freeSlots < BRICK_COLS; i++) if (!bricks[i].active) freeSlots++;
+        if (freeSlots < BRICK_COLS) return false;
+
+        // Never stack a row on top of one that hasn't scrolled clear yet.
+        const float clearBelow = y + (float)(BRICK_HEIGHT + BRICK_SPACING);
+        for (int i = 0; i < MAX_BRICKS; i++) {
+            if (bricks[i].active && bricks[i].y > y - (float)(BRICK_HEIGHT + BRICK_SPACING) && bricks[i].y < clearBelow) return false;
+        }
+
         for (int col = 0; col < BRICK_COLS; col++) {
             const int slot = allocBrickSlot();
-            if (slot < 0) break;
             Brick& br = bricks[slot];
             br.active = true;
             br.exploding = false;
@@ -449,6 +438,7 @@ private:
             br.maxHp = brickHpForSpawn();
             br.hp = br.maxHp;
         }
+        return true;
     }
 
     void spawnInitialBricks() {
@@ -761,13 +751,13 @@ private:
         for (int i = 0; i < MAX_GAMEPADS; i++) {
             Player& p = players[i];
             if (!p.enabled || p.lives <= 0) continue;
-            ControllerPtr ctl = input ? input->getController(i) : nullptr;
-            if (!(ctl && ctl->isConnected())) continue;
+            const PadState& pad = input ? input->pad(i) : PadState();
+            if (!pad.connected) continue;
 
-            const float raw = clampf((float)InputDetail::axisX(ctl, 0) / (float)AXIS_DIVISOR, -1.0f, 1.0f);
+            const float raw = clampf((float)pad.axisX / (float)AXIS_DIVISOR, -1.0f, 1.0f);
             float sx = deadzone01(raw, STICK_DEADZONE);
             if (sx == 0.0f) {
-                const uint8_t dpad = ctl->dpad();
+                const uint8_t dpad = pad.dpad;
                 if (dpad & 0x08) sx = -1.0f;
                 else if (dpad & 0x04) sx = 1.0f;
             }
@@ -783,9 +773,9 @@ private:
         for (int i = 0; i < MAX_GAMEPADS; i++) {
             const Player& p = players[i];
             if (!p.enabled || p.lives <= 0) continue;
-            ControllerPtr ctl = input ? input->getController(i) : nullptr;
-            if (!(ctl && ctl->isConnected())) continue;
-            if (ctl->a()) {
+            const PadState& pad = input ? input->pad(i) : PadState();
+            if (!pad.connected) continue;
+            if (pad.held(PadState::BTN_A)) {
                 // Release exactly one attached ball for this player.
                 const bool launched = launchOneAttachedBall((uint8_t)i, false);
                 if (launched) {
@@ -925,8 +915,8 @@ private:
             moveBricksDownOnePixel();
         }
         if ((uint32_t)(now - lastRowSpawnMs) >= brickRowSpawnIntervalMs()) {
-            lastRowSpawnMs = now;
-            spawnBrickRow((float)(HUD_H + 2));
+            // A skipped row (pool full / top band busy) is retried next frame.
+            if (spawnBrickRow((float)(HUD_H + 2))) lastRowSpawnMs = now;
         }
 
         // Breach handling: lose one life (each active player) and clear the lower band.
@@ -968,14 +958,14 @@ private:
 
         const float hp01 = (b.maxHp > 0) ? (float)b.hp / (float)b.maxHp : 1.0f;
         const uint8_t mul = (uint8_t)(120 + (int)(hp01 * 135.0f));
-        uint16_t base = dimColor(b.baseColor, mul);
+        uint16_t base = Pixel565::scale(b.baseColor, mul);
         if (b.exploding) {
             const bool flicker = ((now / 80) % 2) == 0;
             if (flicker) base = COLOR_WHITE;
         }
 
         const uint16_t hi = brightenColor(base, 36);
-        const uint16_t lo = dimColor(base, 160);
+        const uint16_t lo = Pixel565::scale(base, 160);
         display->fillRect(x, y, BRICK_WIDTH, BRICK_HEIGHT, base);
         display->fillRect(x, y, BRICK_WIDTH, 1, hi);
         display->fillRect(x, y + BRICK_HEIGHT - 1, BRICK_WIDTH, 1, lo);
@@ -1004,7 +994,7 @@ private:
         if (!floorShieldArmed) return;
         const int sy = PANEL_RES_Y - 1;
         const bool flicker = ((millis() / 240) % 2) == 0;
-        const uint16_t c = flicker ? COLOR_BLUE : dimColor(COLOR_BLUE, 160);
+        const uint16_t c = flicker ? COLOR_BLUE : Pixel565::scale(COLOR_BLUE, 160);
         display->drawFastHLine(0, sy, PANEL_RES_X, c);
     }
 
@@ -1130,7 +1120,7 @@ public:
         // HUD
         SmallFont::drawStringF(display, 2, 6, COLOR_YELLOW, "S:%d", score);
         SmallFont::drawStringF(display, 34, 6, COLOR_WHITE, "W:%d", level);
-        for (int x = 0; x < PANEL_RES_X; x += 2) display->drawPixel(x, HUD_H - 1, COLOR_BLUE);
+        Raster::dashedHLine(display, 0, HUD_H - 1, PANEL_RES_X, COLOR_BLUE);
 
         if (phase == PHASE_COUNTDOWN) {
             const uint32_t elapsed = (uint32_t)(now - phaseStartMs);
@@ -1168,5 +1158,42 @@ public:
     const char* leaderboardId() const override { return "breakout"; }
     const char* leaderboardName() const override { return "Breakout"; }
     uint32_t leaderboardScore() const override { return (score > 0) ? (uint32_t)score : 0u; }
+
+    // ------------------------------
+    // Self-check (DEBUG_INVARIANTS)
+    // ------------------------------
+    const char* checkInvariants() const override {
+        for (int i = 0; i < MAX_BALLS; i++) {
+            const Ball& b = balls[i];
+            if (!b.active) continue;
+            if (b.owner >= MAX_GAMEPADS) return "ball owner out of range";
+            if (b.x != b.x || b.y != b.y || b.vx != b.vx || b.vy != b.vy) return "ball position/velocity is NaN";
+        }
+        // Bricks sit on the column grid; within a column no two may share pixels
+        // (rows spawned or pushed down into each other). More bricks in a column
+        // than fit the playfield means an overlap too.
+        static constexpr int COLUMN_CAP = (PANEL_RES_Y - HUD_H) / BRICK_HEIGHT + 1;
+        float columnY[BRICK_COLS][COLUMN_CAP];
+        uint8_t columnCount[BRICK_COLS] = {};
+        for (int i = 0; i < MAX_BRICKS; i++) {
+            const Brick& br = bricks[i];
+            if (!br.active) continue;
+            if (br.hp == 0 && !br.exploding) return "active brick with 0 hp";
+            if (br.hp > br.maxHp) return "brick hp above max";
+            if (br.x < 0 || br.x >= PANEL_RES_X) return "brick x off panel";
+            if (br.y < (float)HUD_H || br.y >= (float)PANEL_RES_Y) return "brick y off playfield";
+            const int col = (br.x - bricksStartX()) / (BRICK_WIDTH + BRICK_SPACING);
+            if (col < 0 || col >= BRICK_COLS || brickXForCol(col) != br.x) return "brick off the column grid";
+            if (columnCount[col] >= COLUMN_CAP) return "overlapping bricks";
+            for (uint8_t k = 0; k < columnCount[col]; k++) {
+                if (fabsf(columnY[col][k] - br.y) < (float)BRICK_HEIGHT) return "overlapping bricks";
+            }
+            columnY[col][columnCount[col]++] = br.y;
+        }
+        for (int i = 0; i < MAX_POWERUPS; i++) {
+            if (powerups[i].active && powerups[i].type > PU_CYAN) return "powerup type out of range";
+        }
+        return nullptr;
+    }
 };
 
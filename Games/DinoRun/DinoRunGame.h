@@ -5,7 +5,9 @@
 #include "../../engine/GameBase.h"
 #include "../../engine/ControllerManager.h"
 #include "../../engine/config.h"
+#include "../../engine/Raster.h"
 #include "../../engine/UserProfiles.h"
+#include "../../engine/TileLayer.h"
 #include "../../component/SmallFont.h"
 #include "../../component/GameOverLeaderboardView.h"
 
@@ -46,14 +48,6 @@ private:
         }
     }
 
-    static inline bool aEdge(ControllerPtr ctl) {
-        static bool last = false;
-        const bool now = ctl && (bool)ctl->a();
-        const bool edge = now && !last;
-        last = now;
-        return edge;
-    }
-
     void spawnObstacle(float x) {
         for (auto &o : obs) {
             if (o.active) continue;
@@ -106,8 +100,8 @@ public:
         // Normalize to a ~60fps timestep so the game plays consistently regardless of loop rate.
         const float step = dt * 60.0f;
 
-        ControllerPtr ctl = input ? input->getController(0) : nullptr;
-        if (ctl && (aEdge(ctl) || (ctl->dpad() & 0x01))) {
+        const PadState& pad = input ? input->pad(0) : PadState();
+        if (pad.hit(PadState::BTN_A) || (pad.dpad & PadState::DPAD_UP)) {
             if (onGround) {
                 dinoVy = Cfg::JUMP_VY;
                 onGround = false;
@@ -174,24 +168,34 @@ public:
         // HUD
         SmallFont::drawString(d, 2, 6, "DINO", COLOR_CYAN);
         SmallFont::drawStringF(d, 40, 6, COLOR_YELLOW, "%lu", (unsigned long)score);
-        for (int x = 0; x < PANEL_RES_X; x += 2) d->drawPixel(x, Cfg::HUD_H - 1, COLOR_BLUE);
-
-        // Parallax background (simple pixel art bands)
-        for (int i = 0; i < Cfg::LAYER_COUNT; i++) {
-            const int y = Cfg::HUD_H + 6 + i * 10;
-            const uint16_t col = (i == 0) ? d->color565(30, 140, 80) : (i == 1) ? d->color565(30, 80, 150) : d->color565(140, 60, 160);
-            for (int x = 0; x < PANEL_RES_X; x += (6 - i)) {
-                const int xx = (int)(x - (int)layerOff[i]);
-                const int px = (xx % 64 + 64) % 64;
-                d->drawPixel(px, y, col);
-                if (i == 2) d->drawPixel(px, y + 1, col);
-            }
+        Raster::dashedHLine(d, 0, Cfg::HUD_H - 1, PANEL_RES_X, COLOR_BLUE);
+
+        // Parallax background (dot bands) + ground speckle: wrapping tile layers.
+        static const TileGfx::TileSet bandSet = {
+            DINO_BAND_TILES.rows, DinoBandTiles::W, DinoBandTiles::H, DinoBandTiles::BANDS * DinoBandTiles::TILES_PER_BAND
+        };
+        static constexpr uint16_t BAND_COLORS[DinoBandTiles::BANDS] = {
+            TileGfx::rgb565(30, 140, 80), TileGfx::rgb565(30, 80, 150), TileGfx::rgb565(140, 60, 160), TileGfx::rgb565(40, 150, 40)
+        };
+        for (int i = 0; i < DinoBandTiles::BANDS; i++) {
+            const uint16_t pal[4] = { 0, BAND_COLORS[i], BAND_COLORS[i], BAND_COLORS[i] };
+            const bool ground = (i >= Cfg::LAYER_COUNT);
+            TileGfx::TileLayer band;
+            band.set = &bandSet;
+            band.map = DINO_BAND_MAPS[i];
+            band.mapW = DinoBandTiles::TILES_PER_BAND;
+            band.mapH = 1;
+            band.wrapX = true;
+            band.scrollX = ground ? (int16_t)-(int)((score / 10) % 64) : (int16_t)(int)layerOff[i];
+            band.viewY = ground ? (int16_t)(Cfg::GROUND_Y + 1) : (int16_t)(Cfg::HUD_H + 6 + i * 10);
+            band.viewH = DinoBandTiles::H;
+            band.palette = pal;
+            band.draw(d);
         }
 
         // Ground
         const uint16_t gcol = d->color565(90, 220, 90);
         d->drawFastHLine(0, Cfg::GROUND_Y, PANEL_RES_X, gcol);
-        for (int x = 0; x < PANEL_RES_X; x += 4) d->drawPixel((x + (int)(score / 10)) % 64, Cfg::GROUND_Y + 1, d->color565(40, 150, 40));
 
         // Obstacles
         for (auto &o : obs) {
@@ -213,6 +217,22 @@ public:
     const char* leaderboardId() const override { return "dino"; }
     const char* leaderboardName() const override { return "Dino"; }
     uint32_t leaderboardScore() const override { return score; }
+
+    // ------------------------------
+    // Self-check (DEBUG_INVARIANTS)
+    // ------------------------------
+    const char* checkInvariants() const override {
+        const float groundY = (float)Cfg::GROUND_Y - (float)Cfg::DINO_H;
+        if (!(dinoY <= groundY)) return "dino below the ground";
+        if (onGround && dinoY != groundY) return "grounded dino in the air";
+        for (const auto& o : obs) {
+            if (!o.active) continue;
+            if (!(o.x >= -10.0f && o.x <= (float)PANEL_RES_X + 10.0f)) return "obstacle outside the spawn/despawn band";
+            // A touch ends the run in the same tick.
+            if (!gameOver && collideDinoObstacle(o)) return "dino overlaps an obstacle";
+        }
+        return nullptr;
+    }
 };
 
 
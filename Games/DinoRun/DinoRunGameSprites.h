@@ -42,4 +42,32 @@ inline constexpr uint8_t CACTUS_0[10][6] = {
   {0,1,1,1,1,0},
 };
 
+// Parallax dot bands as 64 px repeating strips, 4 tiles of 16x2 each (packed
+// for engine/TileLayer.h). Band b has a dot every (6 - b) px, band 2 dots are
+// 2 px tall; band 3 is the ground speckle (every 4 px).
+struct DinoBandTiles {
+    static constexpr int BANDS = 4;
+    static constexpr int TILES_PER_BAND = 4;
+    static constexpr int W = 16;
+    static constexpr int H = 2;
+    uint32_t rows[BANDS * TILES_PER_BAND * H] = {};
 
+    constexpr DinoBandTiles() {
+        for (int b = 0; b < BANDS; b++) {
+            const int spacing = (b == 3) ? 4 : 6 - b;
+            for (int x = 0; x < TILES_PER_BAND * W; x += spacing) {
+                const int t = b * TILES_PER_BAND + x / W;
+                const uint32_t bit = 1u << (2 * (x % W));
+                rows[t * H] |= bit;
+                if (b == 2) rows[t * H + 1] |= bit;
+            }
+        }
+    }
+};
+inline constexpr DinoBandTiles DINO_BAND_TILES{};
+inline constexpr uint8_t DINO_BAND_MAPS[DinoBandTiles::BANDS][DinoBandTiles::TILES_PER_BAND] = {
+    { 0, 1, 2, 3 },
+    { 4, 5, 6, 7 },
+    { 8, 9, 10, 11 },
+    { 12, 13, 14, 15 },
+};
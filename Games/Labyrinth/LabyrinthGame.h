@@ -4,6 +4,8 @@
 #include "../../engine/GameBase.h"
 #include "../../engine/ControllerManager.h"
 #include "../../engine/config.h"
+#include "../../engine/Raster.h"
+#include "../../engine/MemPolicy.h"
 #include "../../component/SmallFont.h"
 #include "../../engine/Settings.h"
 #include "../../engine/UserProfiles.h"
@@ -93,8 +95,15 @@ private:
     int exitX, exitY;
     // IMPORTANT (ESP32):
     // Do NOT allocate large temporary buffers as class members (heap) or locals (stack).
-    // We keep maze generation scratch buffers as static storage inside the generator functions
-    // (BSS), and we pack (x,y) into a single uint16_t cell index to keep memory low.
+    // Maze generation scratch buffers are Mem::ColdArray inside the generator functions:
+    // PSRAM while the generator runs on boards that have it, static storage (BSS) otherwise.
+    // If a PSRAM build cannot get them (no chip fitted, heap short), generateMaze()
+    // falls back to a scratch-free maze instead of aborting.
+    // (x,y) is packed into a single uint16_t cell index to keep memory low.
+    // The maze itself stays a member: collision reads it every tick.
+    struct CarveStackTag;
+    struct BfsQueueTag;
+    struct BfsDistTag;
 
     // Analog input smoothing / deadzone
     static constexpr int16_t AXIS_DIVISOR = LabyrinthGameConfig::AXIS_DIVISOR;   // Bluepad32 commonly ~[-512..512]
@@ -109,19 +118,6 @@ private:
      */
     static inline uint8_t tileSizeForLevel(int lvl) { return LabyrinthGameConfig::tileSizeForLevel(lvl); }
 
-    // Bluepad32 analog helper (SFINAE) so we don't hard-depend on a single API surface.
-    struct InputDetail {
-        template <typename T>
-        static auto axisX(T* c, int) -> decltype(c->axisX(), int16_t()) { return (int16_t)c->axisX(); }
-        template <typename T>
-        static int16_t axisX(T*, ...) { return 0; }
-
-        template <typename T>
-        static auto axisY(T* c, int) -> decltype(c->axisY(), int16_t()) { return (int16_t)c->axisY(); }
-        template <typename T>
-        static int16_t axisY(T*, ...) { return 0; }
-    };
-
     // Fixed-point helpers (8.8)
     static constexpr int FP_SHIFT = 8;
     static constexpr int32_t FP_ONE = (1 << FP_SHIFT);
@@ -334,9 +330,11 @@ private:
         }
     }
 
-    void carvePerfectMaze(int startX, int startY) {
-        // DFS stack (static storage to avoid stack overflow and heap allocation).
-        static uint16_t stack[MAX_CELLS];
+    // Returns false (maze untouched) when the scratch stack is unavailable.
+    bool carvePerfectMaze(int startX, int startY) {
+        // DFS stack (cold scratch, never on the task stack).
+        Mem::ColdArray<uint16_t, MAX_CELLS, CarveStackTag> stack;
+        if (!stack.ok()) return false;
         int top = 0;
         auto pack = [&](int x, int y) -> uint16_t { return (uint16_t)(y * mazeW + x); };
         auto unpackX = [&](uint16_t v) -> int { return (int)(v % (uint16_t)mazeW); };
@@ -381,12 +379,29 @@ private:
             top++;
             stack[top] = pack(nx, ny);
         }
+        return true;
+    }
+
+    // Scratch-free fallback: binary tree (every room opens north or west).
+    // Perfect and fully connected, just with a visible diagonal bias.
+    void carveBinaryTreeMaze() {
+        for (int y = 1; y < mazeH - 1; y += 2) {
+            for (int x = 1; x < mazeW - 1; x += 2) {
+                maze[y][x] = 1;
+                const bool canNorth = (y > 1);
+                const bool canWest = (x > 1);
+                if (canNorth && (!canWest || random(0, 2) == 0)) maze[y - 1][x] = 1;
+                else if (canWest) maze[y][x - 1] = 1;
+            }
+        }
     }
 
-    void pickFarthestExitFrom(int startX, int startY) {
+    // Returns false (exit unset) when the BFS scratch is unavailable.
+    bool pickFarthestExitFrom(int startX, int startY) {
         // BFS to guarantee the exit is reachable (fixes the "inaccessible exit" issue).
-        static uint16_t q[MAX_CELLS];
-        static int16_t dist[MAX_CELLS];
+        Mem::ColdArray<uint16_t, MAX_CELLS, BfsQueueTag> q;
+        Mem::ColdArray<int16_t, MAX_CELLS, BfsDistTag> dist;
+        if (!q.ok() || !dist.ok()) return false;
         const int total = mazeW * mazeH;
         for (int i = 0; i < total; i++) dist[i] = (int16_t)-1;
 
@@ -435,6 +450,7 @@ private:
 
         exitX = bestX;
         exitY = bestY;
+        return true;
     }
 
     void generateMaze() {
@@ -444,7 +460,7 @@ private:
         const int startX = 1;
         const int startY = 1;
 
-        carvePerfectMaze(startX, startY);
+        if (!carvePerfectMaze(startX, startY)) carveBinaryTreeMaze();
 
         // Difficulty shaping:
         // 1) Extend some dead ends to create longer false leads (more "getting lost").
@@ -457,7 +473,11 @@ private:
         extendDeadEnds(deadEndExtensions, (uint8_t)constrain(4 + level / 4, 4, 10));
         addLoops(loopOpenings);
 
-        pickFarthestExitFrom(startX, startY);
+        if (!pickFarthestExitFrom(startX, startY)) {
+            // Every room is connected; the opposite corner is far enough.
+            exitX = mazeW - 2;
+            exitY = mazeH - 2;
+        }
 
         // Mark start & exit
         maze[startY][startX] = 2;
@@ -655,16 +675,16 @@ public:
         }
         
         // Update player position (analog movement with collision against grid)
-        ControllerPtr p1 = input->getController(0);
-        if (p1 && p1->isConnected()) {
-            int16_t rawX = InputDetail::axisX(p1, 0);
-            int16_t rawY = InputDetail::axisY(p1, 0);
+        const PadState& p1 = input->pad(0);
+        if (p1.connected) {
+            int16_t rawX = p1.axisX;
+            int16_t rawY = p1.axisY;
             rawX = applyDeadzoneRaw(rawX, STICK_DEADZONE_RAW);
             rawY = applyDeadzoneRaw(rawY, STICK_DEADZONE_RAW);
 
             // Fallback to dpad when stick is idle (nice for older controllers).
             if (rawX == 0 && rawY == 0) {
-                const uint8_t d = p1->dpad();
+                const uint8_t d = p1.dpad;
                 if (d & 0x08) rawX = -(AXIS_DIVISOR);
                 else if (d & 0x04) rawX = (AXIS_DIVISOR);
                 if (d & 0x01) rawY = -(AXIS_DIVISOR);
@@ -753,7 +773,7 @@ public:
             const int approxCharW = 4;
             const int tx = PANEL_RES_X - 2 - ((int)strlen(tbuf) * approxCharW);
             SmallFont::drawString(display, tx, 6, tbuf, COLOR_CYAN);
-            for (int x = 0; x < PANEL_RES_X; x += 2) display->drawPixel(x, HUD_H-1, COLOR_BLUE);
+            Raster::dashedHLine(display, 0, HUD_H-1, PANEL_RES_X, COLOR_BLUE);
 
             // Labyrinth area (no HUD fade)
             display->fillRect(mazeOriginX, mazeOriginY, mazeW * cellSizePx, mazeH * cellSizePx, COLOR_BLACK);
@@ -775,7 +795,7 @@ public:
         SmallFont::drawString(display, tx, 6, tbuf, COLOR_CYAN);
 
         // Divider under HUD
-        for (int x = 0; x < PANEL_RES_X; x += 2) display->drawPixel(x, HUD_H-1, COLOR_BLUE);
+        Raster::dashedHLine(display, 0, HUD_H-1, PANEL_RES_X, COLOR_BLUE);
 
         // Softer colors for walls/exit (below HUD)
         uint16_t wallColor = display->color565(80, 120, 200);   // soft blue
@@ -836,5 +856,19 @@ public:
         // - +remaining seconds on the clock
         return score;
     }
+
+    // ------------------------------
+    // Self-check (DEBUG_INVARIANTS)
+    // ------------------------------
+    const char* checkInvariants() const override {
+        if (mazeW < 0 || mazeW > MAX_MAZE_W || mazeH < 0 || mazeH > MAX_MAZE_H) return "maze size out of range";
+        if (mazeW == 0 || mazeH == 0) return nullptr; // no maze yet
+        if (exitX < 0 || exitX >= mazeW || exitY < 0 || exitY >= mazeH) return "exit off the maze";
+        if (maze[exitY][exitX] != 3) return "exit cell not marked";
+        // Movement is swept against the solid mask, so the ball never rests in a wall.
+        if (player.sizePx == 0) return "player has no size";
+        if (collidesRectAtFp(player.x_fp, player.y_fp)) return "player inside a wall";
+        return nullptr;
+    }
 };
 
@@ -6,45 +6,40 @@
 #include "../../engine/config.h"
 
 /**
- * LavaLampApp - calming procedural color blobs using lightweight value noise.
+ * LavaLampApp - calming metaball "lava" at full 64x64 resolution.
+ *
+ * All per-pixel work is integer:
+ * - Blob centres are in 1/16 px (Q4) so motion is continuous, not cell-stepped.
+ * - Each blob adds a polynomial falloff (1 - d^2/r^2)^2 to a field buffer, only
+ *   inside its bounding box. d^2 is forward-differenced along each row, so the
+ *   inner loop is adds, one multiply for the ratio and one for the square.
+ * - The summed field (Q8, 256 = one blob centre) indexes a 256-entry RGB565
+ *   palette built once in start().
  */
 class LavaLampApp : public GameBase {
 private:
-    static inline uint32_t hash32(uint32_t x) {
-        x ^= x >> 16;
-        x *= 0x7feb352dU;
-        x ^= x >> 15;
-        x *= 0x846ca68bU;
-        x ^= x >> 16;
-        return x;
-    }
+    static constexpr int W = PANEL_RES_X;
+    static constexpr int H = PANEL_RES_Y;
+    static constexpr int NUM_BLOBS = 6;
+    static constexpr uint32_t TICK_MS = 20;
 
-    static inline float lerp(float a, float b, float t) { return a + (b - a) * t; }
-    static inline float smooth(float t) { return t * t * (3.0f - 2.0f * t); }
+    struct Blob {
+        int16_t x, y;     // centre, Q4 (1/16 px)
+        int8_t vx, vy;    // Q4 px per tick
+        uint8_t r;        // radius (px)
+        uint32_t r2;      // radius^2, Q8 (px^2 * 256)
+        uint32_t invR2;   // (256 << 16) / r2, turns (r2 - d2) into a Q8 fraction
+    };
 
-    static float noise2(int x, int y, int t) {
-        const uint32_t h = hash32((uint32_t)(x * 73856093) ^ (uint32_t)(y * 19349663) ^ (uint32_t)(t * 83492791));
-        return (float)(h & 0xFFFF) / 65535.0f;
-    }
+    Blob blobs[NUM_BLOBS];
+    uint16_t field[W * H];
+    uint16_t palette[256];
+    uint32_t lastMs = 0;
 
-    static float valueNoise(float fx, float fy, int t) {
-        const int x0 = (int)floorf(fx);
-        const int y0 = (int)floorf(fy);
-        const int x1 = x0 + 1;
-        const int y1 = y0 + 1;
-        const float tx = smooth(fx - (float)x0);
-        const float ty = smooth(fy - (float)y0);
-        const float v00 = noise2(x0, y0, t);
-        const float v10 = noise2(x1, y0, t);
-        const float v01 = noise2(x0, y1, t);
-        const float v11 = noise2(x1, y1, t);
-        const float a = lerp(v00, v10, tx);
-        const float b = lerp(v01, v11, tx);
-        return lerp(a, b, ty);
-    }
+    static inline float lerp(float a, float b, float t) { return a + (b - a) * t; }
 
-    static uint16_t palette(float v) {
-        // simple "lava lamp" palette: purple -> blue -> cyan -> pink
+    // simple "lava lamp" palette: purple -> blue -> cyan -> pink
+    static uint16_t paletteColor(float v) {
         v = constrain(v, 0.0f, 1.0f);
         const float r = (v < 0.5f) ? lerp(40, 20, v * 2.0f) : lerp(20, 240, (v - 0.5f) * 2.0f);
         const float g = (v < 0.5f) ? lerp(10, 160, v * 2.0f) : lerp(160, 30, (v - 0.5f) * 2.0f);
@@ -52,37 +47,97 @@ private:
         return (uint16_t)(((uint16_t)(r / 8) << 11) | ((uint16_t)(g / 4) << 5) | ((uint16_t)(b / 8)));
     }
 
+    void initBlob(Blob& b) {
+        b.r = (uint8_t)random(10, 19);
+        b.r2 = (uint32_t)b.r * b.r * 256u;
+        b.invR2 = (256u << 16) / b.r2;
+        b.x = (int16_t)(random(b.r, W - b.r) * 16);
+        b.y = (int16_t)(random(b.r, H - b.r) * 16);
+        do {
+            b.vx = (int8_t)random(-3, 4);
+            b.vy = (int8_t)random(-4, 5);
+        } while ((b.vx | b.vy) == 0);
+    }
+
+    void addBlob(const Blob& b) {
+        const int x0 = max(0, (b.x >> 4) - b.r);
+        const int x1 = min(W - 1, (b.x >> 4) + b.r);
+        const int y0 = max(0, (b.y >> 4) - b.r);
+        const int y1 = min(H - 1, (b.y >> 4) + b.r);
+        const int32_t dx0 = (int32_t)(x0 << 4) - b.x;
+        for (int y = y0; y <= y1; y++) {
+            const int32_t dy = (int32_t)(y << 4) - b.y;
+            // d2 and its x-step, both Q8: (dx + 16)^2 - dx^2 = 32 * dx + 256.
+            int32_t d2 = dx0 * dx0 + dy * dy;
+            int32_t step = 32 * dx0 + 256;
+            uint16_t* row = &field[y * W];
+            for (int x = x0; x <= x1; x++) {
+                if (d2 < (int32_t)b.r2) {
+                    const uint32_t q = ((b.r2 - (uint32_t)d2) * b.invR2) >> 16; // Q8, 0..256
+                    row[x] = (uint16_t)(row[x] + ((q * q) >> 8));
+                }
+                d2 += step;
+                step += 512;
+            }
+        }
+    }
+
 public:
-    void start() override {}
-    void reset() override {}
+    void start() override {
+        randomSeed((uint32_t)micros() ^ (uint32_t)millis());
+        for (int i = 0; i < NUM_BLOBS; i++) initBlob(blobs[i]);
+
+        // Soft threshold (as the old noise version): dark outside, blob colours
+        // ramp in around half a blob's strength.
+        for (int i = 0; i < 256; i++) {
+            const float v = (float)i / 255.0f;
+            palette[i] = paletteColor((v - 0.25f) / 0.6f);
+        }
+        lastMs = millis();
+    }
+    void reset() override { start(); }
     bool isGameOver() override { return false; }
-    void update(ControllerManager* /*input*/) override {}
+    bool isAmbient() const override { return true; }
 
-    void draw(MatrixPanel_I2S_DMA* d) override {
+    void update(ControllerManager* /*input*/) override {
         const uint32_t now = millis();
-        const int t0 = (int)(now / 350);
-        const float tf = (float)(now % 350) / 350.0f;
+        if ((uint32_t)(now - lastMs) < TICK_MS) return;
+        lastMs = now;
 
-        // Render at low-res 16x16 then upscale to 64x64 (4x4 blocks) for speed.
-        for (int gy = 0; gy < 16; gy++) {
-            for (int gx = 0; gx < 16; gx++) {
-                const float x = (float)gx / 5.0f;
-                const float y = (float)gy / 5.0f;
-                const float vA = valueNoise(x + 0.6f, y + 0.2f, t0);
-                const float vB = valueNoise(x + 0.6f, y + 0.2f, t0 + 1);
-                const float v = lerp(vA, vB, tf);
+        // Bounce inside the panel; a little jitter keeps the motion from looping.
+        for (int i = 0; i < NUM_BLOBS; i++) {
+            Blob& b = blobs[i];
+            b.x += b.vx;
+            b.y += b.vy;
+            if (b.x < 0 || b.x >= W * 16) { b.vx = (int8_t)-b.vx; b.x = (int16_t)constrain((int)b.x, 0, W * 16 - 1); }
+            if (b.y < 0 || b.y >= H * 16) { b.vy = (int8_t)-b.vy; b.y = (int16_t)constrain((int)b.y, 0, H * 16 - 1); }
+            if (random(0, 200) == 0) {
+                const int8_t vy = (int8_t)constrain(b.vy + (int)random(-1, 2), -4, 4);
+                if ((b.vx | vy) != 0) b.vy = vy; // never let a blob come to rest
+            }
+        }
+    }
 
-                // Soft threshold to form blobs
-                float blob = (v - 0.35f) / 0.65f;
-                blob = constrain(blob, 0.0f, 1.0f);
-                const uint16_t col = palette(blob);
+    void draw(MatrixPanel_I2S_DMA* d) override {
+        memset(field, 0, sizeof(field));
+        for (int i = 0; i < NUM_BLOBS; i++) addBlob(blobs[i]);
 
-                const int px = gx * 4;
-                const int py = gy * 4;
-                d->fillRect(px, py, 4, 4, col);
+        const uint16_t* f = field;
+        for (int y = 0; y < H; y++) {
+            for (int x = 0; x < W; x++) {
+                const uint16_t v = *f++;
+                d->drawPixel(x, y, palette[v > 255 ? 255 : v]);
             }
         }
     }
-};
-
 
+    // Self-check (DEBUG_INVARIANTS): blobs stay on the panel and never stop.
+    const char* checkInvariants() const override {
+        for (int i = 0; i < NUM_BLOBS; i++) {
+            const Blob& b = blobs[i];
+            if (b.x < 0 || b.x >= W * 16 || b.y < 0 || b.y >= H * 16) return "blob off the panel";
+            if ((b.vx | b.vy) == 0) return "blob at rest";
+        }
+        return nullptr;
+    }
+};
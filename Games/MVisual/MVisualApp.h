@@ -8,6 +8,15 @@
 //
 // Planned later:
 // - Replace the noise generator with microphone FFT magnitudes.
+//
+// Rendering:
+// - The spectrum is quantized to 0..255 once per simulation tick and aggregated
+//   into `bars` levels with integer math (only when it or the bar count changes).
+// - Colours come from small LUTs (per column, per gradient band, waterfall
+//   palette) rebuilt only when colour mode, shading, bar count or the hue tick
+//   change; bars are drawn as one vertical span per colour band.
+// - Waterfall keeps a ring buffer of palette-index rows: each tick writes one
+//   new row, drawing walks the ring as horizontal runs.
 // -----------------------------------------------------------------------------
 #pragma once
 
@@ -18,6 +27,8 @@
 #include "../../engine/GameBase.h"
 #include "../../engine/ControllerManager.h"
 #include "../../engine/config.h"
+#include "../../engine/Raster.h"
+#include "../../engine/Pixel565.h"
 #include "../../component/SmallFont.h"
 
 #include "MVisualAppConfig.h"
@@ -47,6 +58,12 @@ public:
             spectrum64[i] = rand01() * 0.25f;
         }
         smoothSpectrum64();
+        quantizeSpectrum();
+        aggregateBars();
+
+        memset(waterfall, 0, sizeof(waterfall));
+        waterfallHead = 0;
+        lutValid = false;
 
         // Reset input repeat/edge states.
         prevDpad = 0;
@@ -75,6 +92,9 @@ public:
         // Update the 64-bin "spectrum" regardless of current bar count.
         // This makes bar-count changes feel stable (we just resample/aggregate).
         updateNoiseSpectrum(now);
+        quantizeSpectrum();
+        aggregateBars();
+        pushWaterfallRow();
     }
 
     void draw(MatrixPanel_I2S_DMA* display) override {
@@ -91,33 +111,22 @@ public:
         const int barAreaH = (yBottom - yTop + 1);
         if (barAreaH <= 0) return;
 
-        // Build per-segment values by aggregating from the 64-bin spectrum.
-        // `bars` is 1..64 and acts as a resolution knob across all viz modes.
-        for (int i = 0; i < (int)bars; i++) {
-            const int a = (i * 64) / bars;
-            const int b = ((i + 1) * 64) / bars; // exclusive
-            float acc = 0.0f;
-            int cnt = 0;
-            for (int k = a; k < b; k++) {
-                acc += spectrum64[k];
-                cnt++;
-            }
-            barValue[i] = (cnt > 0) ? (acc / (float)cnt) : 0.0f;
-            if (barValue[i] < 0.0f) barValue[i] = 0.0f;
-            if (barValue[i] > 1.0f) barValue[i] = 1.0f;
-        }
-
         const uint8_t timeHue = (uint8_t)((millis() / 8) & 0xFF);
+        refreshColorLuts(timeHue);
+
         switch (vizMode) {
             default:
             case VIZ_BARS:
-                drawBars(display, yTop, yBottom, barAreaH, timeHue);
+                drawBars(display, yTop, yBottom, barAreaH);
                 break;
             case VIZ_LINES:
-                drawLines(display, yTop, yBottom, barAreaH, timeHue);
+                drawLines(display, yTop, yBottom, barAreaH);
                 break;
             case VIZ_DOTS:
-                drawDots(display, yTop, yBottom, barAreaH, timeHue);
+                drawDots(display, yTop, yBottom, barAreaH);
+                break;
+            case VIZ_WATERFALL:
+                drawWaterfall(display, yTop, barAreaH);
                 break;
         }
     }
@@ -156,7 +165,9 @@ private:
     enum VizMode : uint8_t {
         VIZ_BARS = 0,
         VIZ_LINES = 1,
-        VIZ_DOTS = 2
+        VIZ_DOTS = 2,
+        VIZ_WATERFALL = 3,
+        VIZ_MODE_COUNT = 4
     };
     VizMode vizMode = VIZ_BARS;
 
@@ -174,27 +185,33 @@ private:
     uint32_t rngState = 0x12345678u;
     float spectrum64[64] = {};
     float spectrumTmp64[64] = {};
-    float barValue[64] = {};
-
-    // -------------------------------------------------------------------------
-    // Bluepad32 button helpers (SFINAE + miscButtons fallback)
-    // -------------------------------------------------------------------------
-    struct InputDetail {
-        template <typename T>
-        static auto back(T* c, int) -> decltype(c->back(), bool()) { return (bool)c->back(); }
-        template <typename T>
-        static bool back(T*, ...) { return false; }
-
-        template <typename T>
-        static auto select(T* c, int) -> decltype(c->select(), bool()) { return (bool)c->select(); }
-        template <typename T>
-        static bool select(T*, ...) { return false; }
-
-        template <typename T>
-        static auto miscButtons(T* c, int) -> decltype(c->miscButtons(), uint16_t()) { return (uint16_t)c->miscButtons(); }
-        template <typename T>
-        static uint16_t miscButtons(T*, ...) { return 0; }
+    uint8_t spectrumQ[64] = {};  // spectrum64 as 0..255
+    uint8_t barLevel[64] = {};   // per bar, 0..255 (aggregated from spectrumQ)
+
+    // Colour LUTs, see refreshColorLuts().
+    enum VerticalKind : uint8_t {
+        VERT_FLAT = 0,     // one colour per column
+        VERT_SHADE = 1,    // column colour scaled per gradient band
+        VERT_GRADIENT = 2  // band colour scaled per column
     };
+    bool lutValid = false;
+    uint8_t lutColorMode = 0;
+    uint8_t lutMonoIndex = 0;
+    uint8_t lutEffect = 0;
+    uint8_t lutShading = 0;
+    uint8_t lutBars = 0;
+    uint8_t lutHue = 0;
+    VerticalKind vertKind = VERT_FLAT;
+    uint16_t colColor[PANEL_RES_X] = {};
+    uint8_t colMul[PANEL_RES_X] = {};
+    uint16_t bandColor[MVisualAppConfig::GRADIENT_STEPS] = {};
+    uint8_t bandMul[MVisualAppConfig::GRADIENT_STEPS] = {};
+    uint16_t waterfallColor[MVisualAppConfig::WATERFALL_LEVELS] = {};
+
+    // Waterfall ring: one row of per-column levels per simulation tick, newest at
+    // waterfallHead.
+    uint8_t waterfall[PANEL_RES_Y][PANEL_RES_X] = {};
+    uint8_t waterfallHead = 0;
 
     static inline float clamp01(float v) {
         return (v < 0.0f) ? 0.0f : (v > 1.0f) ? 1.0f : v;
@@ -215,24 +232,14 @@ private:
         return (float)((nextU32() >> 8) & 0x00FFFFFFu) / (float)0x01000000u;
     }
 
-    inline bool selectPressed(ControllerPtr ctl) const {
-        if (!ctl) return false;
-        // Prefer dedicated accessors when present.
-        if (InputDetail::back(ctl, 0)) return true;
-        if (InputDetail::select(ctl, 0)) return true;
-        // Fallback to miscButtons() bitmask.
-        const uint16_t misc = InputDetail::miscButtons(ctl, 0);
-        return (misc & MVisualAppConfig::MISC_SELECT_MASK) != 0;
-    }
-
     void handleInput(ControllerManager* input, uint32_t now) {
-        ControllerPtr p1 = input ? input->getController(0) : nullptr;
-        if (!p1) return;
+        const PadState& p1 = input ? input->pad(0) : PadState();
+        if (!p1.connected) return;
 
         // ----------------------
         // Up/Down => bar count (repeat)
         // ----------------------
-        const uint8_t d = p1->dpad();
+        const uint8_t d = p1.dpad;
         const bool up = (d & 0x01) != 0;
         const bool down = (d & 0x02) != 0;
         const bool prevUp = (prevDpad & 0x01) != 0;
@@ -259,13 +266,14 @@ private:
         if (deltaBars != 0) {
             const int nb = (int)bars + deltaBars;
             bars = (uint8_t)constrain(nb, (int)MVisualAppConfig::BAR_COUNT_MIN, (int)MVisualAppConfig::BAR_COUNT_MAX);
+            aggregateBars();
         }
         prevDpad = d;
 
         // ----------------------
         // A => mono+gradient mode + cycle base color (edge-triggered)
         // ----------------------
-        const bool aNow = (bool)p1->a();
+        const bool aNow = p1.held(PadState::BTN_A);
         if (aNow && !lastA) {
             colorMode = MODE_MONO_GRADIENT;
             monoColorIndex = (uint8_t)((monoColorIndex + 1) % MVisualAppConfig::MONO_COLOR_COUNT);
@@ -275,7 +283,7 @@ private:
         // ----------------------
         // B => cycle rainbow effects (edge-triggered)
         // ----------------------
-        const bool bNow = (bool)p1->b();
+        const bool bNow = p1.held(PadState::BTN_B);
         if (bNow && !lastB) {
             if (colorMode != MODE_RAINBOW) {
                 colorMode = MODE_RAINBOW;
@@ -288,18 +296,18 @@ private:
 
         // ----------------------
         // X => cycle visualization type (edge-triggered)
-        // Bars -> Lines -> Dots -> Bars
+        // Bars -> Lines -> Dots -> Waterfall -> Bars
         // ----------------------
-        const bool xNow = (bool)p1->x();
+        const bool xNow = p1.held(PadState::BTN_X);
         if (xNow && !lastX) {
-            vizMode = (VizMode)(((uint8_t)vizMode + 1) % 3);
+            vizMode = (VizMode)(((uint8_t)vizMode + 1) % VIZ_MODE_COUNT);
         }
         lastX = xNow;
 
         // ----------------------
         // Select/Back => toggle HUD (edge-triggered)
         // ----------------------
-        const bool selNow = selectPressed(p1);
+        const bool selNow = p1.held(PadState::BTN_SELECT);
         if (selNow && !lastSelect) {
             hudHidden = !hudHidden;
         }
@@ -309,7 +317,7 @@ private:
         // Y => cycle shading modes (edge-triggered)
         // Off -> Horizontal -> Vertical -> Off
         // ----------------------
-        const bool yNow = (bool)p1->y();
+        const bool yNow = p1.held(PadState::BTN_Y);
         if (yNow && !lastY) {
             shadingMode = (ShadingMode)(((uint8_t)shadingMode + 1) % 3);
         }
@@ -358,12 +366,41 @@ private:
         }
     }
 
+    void quantizeSpectrum() {
+        for (int i = 0; i < 64; i++) {
+            spectrumQ[i] = (uint8_t)(spectrum64[i] * 255.0f + 0.5f);
+        }
+    }
+
+    // Build per-segment levels by averaging the 64-bin spectrum.
+    // `bars` is 1..64 and acts as a resolution knob across all viz modes.
+    void aggregateBars() {
+        for (int i = 0; i < (int)bars; i++) {
+            const int a = (i * 64) / bars;
+            const int b = ((i + 1) * 64) / bars; // exclusive
+            uint16_t acc = 0;
+            for (int k = a; k < b; k++) acc += spectrumQ[k];
+            const int cnt = b - a;
+            barLevel[i] = (cnt > 0) ? (uint8_t)((acc + cnt / 2) / cnt) : 0;
+        }
+    }
+
+    // One new waterfall row from the current bar levels.
+    void pushWaterfallRow() {
+        waterfallHead = (uint8_t)((waterfallHead + 1) % PANEL_RES_Y);
+        uint8_t* row = waterfall[waterfallHead];
+        for (int x = 0; x < PANEL_RES_X; x++) {
+            const uint8_t v = barLevel[(x * (int)bars) / PANEL_RES_X];
+            row[x] = (uint8_t)((v * (MVisualAppConfig::WATERFALL_LEVELS - 1) + 127) / 255);
+        }
+    }
+
     // -------------------------------------------------------------------------
     // Rendering helpers
     // -------------------------------------------------------------------------
     void drawHud(MatrixPanel_I2S_DMA* d) {
         // Common HUD divider (dotted).
-        for (int x = 0; x < PANEL_RES_X; x += 2) d->drawPixel(x, MVisualAppConfig::HUD_H - 1, COLOR_BLUE);
+        Raster::dashedHLine(d, 0, MVisualAppConfig::HUD_H - 1, PANEL_RES_X, COLOR_BLUE);
 
         SmallFont::drawString(d, 2, 6, "MVIS", COLOR_CYAN);
         SmallFont::drawStringF(d, 32, 6, COLOR_YELLOW, "B%02d", (int)bars);
@@ -377,23 +414,11 @@ private:
         char sbuf[2] = { sc, '\0' };
         SmallFont::drawString(d, 58, 6, sbuf, COLOR_WHITE);
 
-        const char vc = (vizMode == VIZ_BARS) ? 'B' : (vizMode == VIZ_LINES) ? 'L' : 'D';
+        const char vc = (vizMode == VIZ_BARS) ? 'B' : (vizMode == VIZ_LINES) ? 'L' : (vizMode == VIZ_DOTS) ? 'D' : 'W';
         char vbuf[2] = { vc, '\0' };
         SmallFont::drawString(d, 26, 6, vbuf, COLOR_WHITE);
     }
 
-    static inline uint16_t scale565(uint16_t c, uint8_t mul /*0..255*/) {
-        const uint8_t r5 = (uint8_t)((c >> 11) & 0x1F);
-        const uint8_t g6 = (uint8_t)((c >> 5) & 0x3F);
-        const uint8_t b5 = (uint8_t)(c & 0x1F);
-
-        const uint8_t r = (uint8_t)((r5 * mul) / 255);
-        const uint8_t g = (uint8_t)((g6 * mul) / 255);
-        const uint8_t b = (uint8_t)((b5 * mul) / 255);
-
-        return (uint16_t)((r << 11) | (g << 5) | b);
-    }
-
     static inline uint16_t wheel565(uint8_t pos) {
         uint8_t r = 0, g = 0, b = 0;
         if (pos < 85) {
@@ -430,68 +455,136 @@ private:
         return (uint16_t)((r << 11) | (g << 5) | b);
     }
 
-    uint16_t colorForPixel(int x, int /*y*/, int /*yTop*/, int /*yBottom*/, uint8_t timeHue, uint8_t barIndex, int yyFromBottom, int barH) const {
-        if (colorMode == MODE_MONO_GRADIENT) {
-            const uint16_t base = MVisualAppConfig::MONO_BASE_COLORS[monoColorIndex % MVisualAppConfig::MONO_COLOR_COUNT];
-            uint16_t c = base;
-            c = applyShading(c, x, barIndex, yyFromBottom, barH);
-            return c;
-        }
+    static uint16_t heat565(uint8_t t) {
+        const uint8_t n = MVisualAppConfig::WATERFALL_HEAT_STOP_COUNT;
+        const int pos = (int)t * (n - 1);
+        const int i = pos / 255;
+        if (i >= n - 1) return MVisualAppConfig::WATERFALL_HEAT_STOPS[n - 1];
+        return lerp565(MVisualAppConfig::WATERFALL_HEAT_STOPS[i], MVisualAppConfig::WATERFALL_HEAT_STOPS[i + 1],
+                       (uint8_t)(pos - i * 255));
+    }
 
-        switch (rainbowEffectIndex % MVisualAppConfig::RAINBOW_EFFECT_COUNT) {
-            default:
-            case 0: {
-                const uint8_t hue = (uint8_t)(barIndex * (256 / max(1, (int)bars)));
-                return applyShading(wheel565(hue), x, barIndex, yyFromBottom, barH);
-            }
-            case 1: {
-                const uint8_t t = (barH <= 0) ? 0 : (uint8_t)((255 * yyFromBottom) / barH);
-                uint16_t c = lerp565(COLOR_BLUE, COLOR_RED, t);
-                return applyShading(c, x, barIndex, yyFromBottom, barH);
-            }
-            case 2: {
-                const uint8_t hue = (uint8_t)(timeHue + (uint8_t)(barIndex * (256 / max(1, (int)bars))));
-                return applyShading(wheel565(hue), x, barIndex, yyFromBottom, barH);
+    // Gradient band of pixel yy (0 = bottom) in a bar of height h.
+    static inline uint8_t bandFor(int yy, int h) {
+        return (h <= 0) ? 0 : (uint8_t)((yy * (MVisualAppConfig::GRADIENT_STEPS - 1)) / h);
+    }
+
+    inline int barHeight(int barIndex, int areaH) const {
+        return ((int)barLevel[barIndex] * (areaH - 1) + 127) / 255;
+    }
+
+    /**
+     * Rebuilds the colour LUTs when one of their inputs changed. The hue tick only
+     * counts for the moving rainbow, so other modes rebuild on button presses.
+     *
+     * A pixel colour is a per-column part (bar hue, horizontal shading) and a
+     * per-band part (vertical gradient or shading):
+     * - VERT_FLAT:     colColor[x]
+     * - VERT_SHADE:    colColor[x] scaled by bandMul[band]
+     * - VERT_GRADIENT: bandColor[band] scaled by colMul[x]
+     */
+    void refreshColorLuts(uint8_t timeHue) {
+        const uint8_t effect = (uint8_t)(rainbowEffectIndex % MVisualAppConfig::RAINBOW_EFFECT_COUNT);
+        const bool rainbow = (colorMode == MODE_RAINBOW);
+        const uint8_t hue = (rainbow && effect == 2) ? timeHue : 0;
+        if (lutValid && lutColorMode == (uint8_t)colorMode && lutMonoIndex == monoColorIndex && lutEffect == effect &&
+            lutShading == (uint8_t)shadingMode && lutBars == bars && lutHue == hue) {
+            return;
+        }
+        lutValid = true;
+        lutColorMode = (uint8_t)colorMode;
+        lutMonoIndex = monoColorIndex;
+        lutEffect = effect;
+        lutShading = (uint8_t)shadingMode;
+        lutBars = bars;
+        lutHue = hue;
+
+        const uint16_t mono = MVisualAppConfig::MONO_BASE_COLORS[monoColorIndex % MVisualAppConfig::MONO_COLOR_COUNT];
+        const int hueStep = 256 / max(1, (int)bars);
+        vertKind = (rainbow && effect == 1) ? VERT_GRADIENT
+                 : (shadingMode == SHADING_VERTICAL) ? VERT_SHADE
+                 : VERT_FLAT;
+
+        // Columns: bar hue, then horizontal shading (left 100% -> right 50% of each bar).
+        for (int x = 0; x < PANEL_RES_X; x++) {
+            const int bi = (x * (int)bars) / PANEL_RES_X;
+            uint8_t mul = 255;
+            if (shadingMode == SHADING_HORIZONTAL) {
+                const int startX = (bi * PANEL_RES_X) / (int)bars;
+                const int endX = ((bi + 1) * PANEL_RES_X) / (int)bars - 1;
+                const int w = max(1, endX - startX + 1);
+                mul = (w <= 1) ? 255 : (uint8_t)(255 - (127 * (x - startX)) / (w - 1));
             }
+            const uint16_t base = rainbow ? wheel565((uint8_t)(hue + bi * hueStep)) : mono;
+            colMul[x] = mul;
+            colColor[x] = (mul == 255) ? base : Pixel565::scale(base, mul);
         }
-    }
 
-    uint16_t applyShading(uint16_t c, int x, uint8_t barIndex, int yyFromBottom, int barH) const {
-        if (shadingMode == SHADING_OFF) return c;
+        // Bands: vertical shading (bottom 100% -> top 50%) and the Blue->Red ramp.
+        for (uint8_t s = 0; s < MVisualAppConfig::GRADIENT_STEPS; s++) {
+            const uint8_t t = (uint8_t)((255 * s) / (MVisualAppConfig::GRADIENT_STEPS - 1));
+            bandMul[s] = (shadingMode == SHADING_VERTICAL) ? (uint8_t)(255 - (127 * t) / 255) : 255;
+            const uint16_t c = lerp565(COLOR_BLUE, COLOR_RED, t);
+            bandColor[s] = (bandMul[s] == 255) ? c : Pixel565::scale(c, bandMul[s]);
+        }
 
-        if (shadingMode == SHADING_VERTICAL) {
-            const uint8_t mul = (barH <= 0) ? 255 : (uint8_t)(255 - (127 * yyFromBottom) / barH);
-            return scale565(c, mul);
+        // Waterfall palette: level 0 is off, louder is brighter.
+        waterfallColor[0] = COLOR_BLACK;
+        for (uint8_t l = 1; l < MVisualAppConfig::WATERFALL_LEVELS; l++) {
+            const uint8_t t = (uint8_t)((255 * l) / (MVisualAppConfig::WATERFALL_LEVELS - 1));
+            uint16_t c;
+            if (!rainbow) c = Pixel565::scale(mono, t);
+            else if (effect == 0) c = heat565(t);
+            else if (effect == 1) c = Pixel565::scale(lerp565(COLOR_BLUE, COLOR_RED, t), t);
+            else c = Pixel565::scale(wheel565((uint8_t)(hue + t)), t);
+            waterfallColor[l] = c;
         }
+    }
 
-        const int startX = ((int)barIndex * PANEL_RES_X) / (int)bars;
-        const int endX = (((int)barIndex + 1) * PANEL_RES_X) / (int)bars - 1;
-        const int w = max(1, endX - startX + 1);
-        const int lx = constrain(x - startX, 0, w - 1);
-        const uint8_t mul = (w <= 1) ? 255 : (uint8_t)(255 - (127 * lx) / (w - 1));
-        return scale565(c, mul);
+    inline uint16_t lutColor(int x, uint8_t band) const {
+        switch (vertKind) {
+            default:
+            case VERT_FLAT:
+                return colColor[x];
+            case VERT_SHADE:
+                return Pixel565::scale(colColor[x], bandMul[band]);
+            case VERT_GRADIENT:
+                return (colMul[x] == 255) ? bandColor[band] : Pixel565::scale(bandColor[band], colMul[x]);
+        }
     }
 
     // -------------------------------------------------------------------------
     // Visualization renderers
     // -------------------------------------------------------------------------
-    void drawBars(MatrixPanel_I2S_DMA* display, int yTop, int yBottom, int barAreaH, uint8_t timeHue) const {
+    void drawBars(MatrixPanel_I2S_DMA* display, int /*yTop*/, int yBottom, int barAreaH) const {
         for (int x = 0; x < PANEL_RES_X; x++) {
-            const int bi = (x * (int)bars) / PANEL_RES_X;
-            const float v = barValue[bi];
-            const int h = (int)lroundf(v * (float)(barAreaH - 1));
+            const int h = barHeight((x * (int)bars) / PANEL_RES_X, barAreaH);
             if (h <= 0) continue;
 
-            for (int yy = 0; yy <= h; yy++) {
-                const int y = yBottom - yy;
-                if (y < yTop) break;
-                const uint16_t c = colorForPixel(x, y, yTop, yBottom, timeHue, (uint8_t)bi, yy, h);
-                display->drawPixel(x, y, c);
+            if (vertKind == VERT_FLAT) {
+                Raster::vspan(display, x, yBottom - h, yBottom, colColor[x]);
+                continue;
+            }
+
+            // One span per run of equal colour, bottom up.
+            int runStart = 0;
+            uint8_t band = 0;
+            uint16_t c = lutColor(x, 0);
+            for (int yy = 1; yy <= h; yy++) {
+                const uint8_t b = bandFor(yy, h);
+                if (b == band) continue;
+                band = b;
+                const uint16_t nc = lutColor(x, b);
+                if (nc == c) continue;
+                Raster::vspan(display, x, yBottom - (yy - 1), yBottom - runStart, c);
+                runStart = yy;
+                c = nc;
             }
+            Raster::vspan(display, x, yBottom - h, yBottom - runStart, c);
         }
     }
 
-    void drawLines(MatrixPanel_I2S_DMA* display, int yTop, int yBottom, int barAreaH, uint8_t timeHue) const {
+    void drawLines(MatrixPanel_I2S_DMA* display, int yTop, int yBottom, int barAreaH) const {
         if (bars <= 0) return;
 
         int prevX = -1;
@@ -501,40 +594,54 @@ private:
             const int endX = (((i + 1) * PANEL_RES_X) / (int)bars) - 1;
             const int cx = (startX + endX) / 2;
 
-            const float v = barValue[i];
-            const int h = (int)lroundf(v * (float)(barAreaH - 1));
+            const int h = barHeight(i, barAreaH);
             const int y = yBottom - h;
             if (y < yTop) continue;
 
             if (prevX >= 0) {
-                const int midX = (prevX + cx) / 2;
+                // Segment takes bar i's colour (its left edge: unshaded) at the midpoint height.
                 const int midY = (prevY + y) / 2;
-                const int yyFromBottom = yBottom - midY;
-                const uint16_t c = colorForPixel(midX, midY, yTop, yBottom, timeHue, (uint8_t)i, yyFromBottom, max(1, barAreaH - 1));
-                display->drawLine(prevX, prevY, cx, y, c);
+                const uint16_t c = lutColor(startX, bandFor(yBottom - midY, max(1, barAreaH - 1)));
+                Raster::line(display, prevX, prevY, cx, y, c);
             }
             prevX = cx;
             prevY = y;
         }
     }
 
-    void drawDots(MatrixPanel_I2S_DMA* display, int yTop, int yBottom, int /*barAreaH*/, uint8_t timeHue) const {
+    void drawDots(MatrixPanel_I2S_DMA* display, int yTop, int yBottom, int /*barAreaH*/) const {
         if (bars <= 0) return;
         for (int i = 0; i < (int)bars; i++) {
             const int startX = (i * PANEL_RES_X) / (int)bars;
             const int endX = (((i + 1) * PANEL_RES_X) / (int)bars) - 1;
             const int cx = (startX + endX) / 2;
 
-            const float v = barValue[i];
-            const int h = (int)lroundf(v * (float)(PANEL_RES_Y - 1));
+            const int h = barHeight(i, PANEL_RES_Y);
             const int y = (PANEL_RES_Y - 1) - h;
             if (y < yTop) continue;
 
-            const int yyFromBottom = yBottom - y;
-            const uint16_t c = colorForPixel(cx, y, yTop, yBottom, timeHue, (uint8_t)i, yyFromBottom, max(1, PANEL_RES_Y - 1));
+            const uint16_t c = lutColor(cx, bandFor(yBottom - y, PANEL_RES_Y - 1));
             display->drawPixel(cx, y, c);
         }
     }
+
+    // Newest row at the top, history scrolling down; equal neighbours are one span.
+    void drawWaterfall(MatrixPanel_I2S_DMA* display, int yTop, int rows) const {
+        uint8_t r = waterfallHead;
+        for (int i = 0; i < rows && i < PANEL_RES_Y; i++) {
+            const uint8_t* row = waterfall[r];
+            const int y = yTop + i;
+            int x0 = 0;
+            while (x0 < PANEL_RES_X) {
+                const uint8_t v = row[x0];
+                int x1 = x0;
+                while (x1 + 1 < PANEL_RES_X && row[x1 + 1] == v) x1++;
+                if (v != 0) Raster::hspan(display, x0, x1, y, waterfallColor[v]);
+                x0 = x1 + 1;
+            }
+            r = (uint8_t)((r == 0) ? (PANEL_RES_Y - 1) : (r - 1));
+        }
+    }
 };
 
 
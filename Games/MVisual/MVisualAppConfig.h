@@ -35,6 +35,17 @@ static constexpr uint8_t BAR_COUNT_MIN = 1;
 static constexpr uint8_t BAR_COUNT_MAX = 64;
 static constexpr uint8_t DEFAULT_BAR_COUNT = 16;
 
+// Vertical gradients (Blue->Red effect, vertical shading) are quantized to this
+// many bands per bar, so a column is at most this many spans.
+static constexpr uint8_t GRADIENT_STEPS = 16;
+
+// -----------------------------------------------------------------------------
+// Waterfall (scrolling spectrogram)
+// -----------------------------------------------------------------------------
+// Intensity levels per cell (0 = off). Rows store the level, colours come from a
+// per-mode palette, so switching colours recolours the whole history.
+static constexpr uint8_t WATERFALL_LEVELS = 16;
+
 // -----------------------------------------------------------------------------
 // Noise generator shaping (placeholder until mic FFT is wired in)
 // -----------------------------------------------------------------------------
@@ -45,16 +56,6 @@ static constexpr float NOISE_SMOOTH = 0.35f;
 // Random impulse gain (0..1). Higher => more peaks.
 static constexpr float NOISE_IMPULSE_GAIN = 1.0f;
 
-// -----------------------------------------------------------------------------
-// Select/Back button mapping (Bluepad32 fallback)
-// -----------------------------------------------------------------------------
-// Bluepad32 exposes controller "miscButtons()" on many builds/controllers.
-// This repo already uses START as 0x04 (see `SnakeGameLedPanel.ino`).
-//
-// For SELECT/BACK, the exact bit can vary by controller mapping. 0x02 is a
-// common convention. If your controller differs, tweak this constant.
-static constexpr uint16_t MISC_SELECT_MASK = 0x02;
-
 // -----------------------------------------------------------------------------
 // Visual tables / palettes
 // -----------------------------------------------------------------------------
@@ -36,3 +36,18 @@ static constexpr uint8_t MONO_COLOR_COUNT =
 static constexpr uint8_t RAINBOW_EFFECT_COUNT = 3;
 
 
+
+// Waterfall palette for rainbow effect 0 ("heat"): quiet -> loud, interpolated
+// across WATERFALL_LEVELS. Effects 1/2 use the same ramps as the bars.
+static constexpr uint16_t WATERFALL_HEAT_STOPS[] = {
+    0x0008, // deep blue
+    COLOR_BLUE,
+    COLOR_MAGENTA,
+    COLOR_RED,
+    COLOR_ORANGE,
+    COLOR_YELLOW,
+    COLOR_WHITE
+};
+
+static constexpr uint8_t WATERFALL_HEAT_STOP_COUNT =
+    (uint8_t)(sizeof(WATERFALL_HEAT_STOPS) / sizeof(WATERFALL_HEAT_STOPS[0]));
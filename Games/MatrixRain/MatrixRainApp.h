@@ -5,89 +5,134 @@
 #include "../../engine/GameBase.h"
 #include "../../engine/ControllerManager.h"
 #include "../../engine/config.h"
-#include "../../component/SmallFont.h"
+#include "../../engine/QualityGovernor.h"
+#include "../../engine/Pixel565.h"
 
 /**
  * MatrixRainApp - classic "Matrix" green code rain.
  * Non-interactive background app (press B in engine game-over? START pauses globally).
+ *
+ * Rendering model:
+ * - One narrow (1px) stream per panel column. Each column has a persistent ring
+ *   of glyph slices (5px tall bit patterns) pinned to fixed rows; a few of them
+ *   mutate every tick, like the film's flickering characters.
+ * - A retained RGB565 trail buffer holds the fading glyphs. Every tick
+ *   Pixel565::scale() darkens it by FADE/255 (two pixels per word), then the
+ *   glyph under each stream head is added in with Pixel565::addSat(), so a
+ *   glyph stamped over a still-lit trail turns whiter instead of resetting it.
+ * - draw() clears the panel and plots lit pixels, skipping dark pixel pairs;
+ *   heads are overdrawn white.
+ * - Fewer columns rain at lower quality levels (globalQuality): an inactive
+ *   column finishes its current fall and then stays parked above the panel.
  */
 class MatrixRainApp : public GameBase {
 private:
-    static constexpr int COLS = 16;     // 64px / 4px column width
-    static constexpr int CELL_W = 4;
-    static constexpr int CELL_H = 6;    // fits TomThumb-ish vertically
+    static constexpr int COLS = PANEL_RES_X;    // one stream per pixel column
+    static constexpr int CELL_H = 6;            // 5px glyph slice + 1px gap
+    static constexpr int ROWS = (PANEL_RES_Y + CELL_H - 1) / CELL_H;
+    static constexpr uint32_t TICK_MS = 40;
+    static constexpr uint8_t FADE = 208;        // trail keeps ~4/5 per tick (channels round down to 0)
+    static constexpr uint8_t MUTATIONS_PER_TICK = 6;
+    static constexpr int PIXELS = PANEL_RES_X * PANEL_RES_Y;
+    // Pale green where a glyph is stamped; fades to dark green as the channels scale down.
+    static constexpr uint16_t GLYPH_COLOR = Pixel565::pack(6, 63, 6);
+
+    // Vertical 5px slices of 3x5 glyphs (bit 0 = top row).
+    static constexpr uint8_t GLYPH_SLICES[16] = {
+        0x15, 0x1B, 0x0E, 0x11, 0x1F, 0x16, 0x0D, 0x19,
+        0x13, 0x07, 0x1C, 0x0B, 0x1A, 0x17, 0x1D, 0x09
+    };
 
     struct Stream {
-        int16_t y = 0;
-        uint8_t speed = 1;
-        uint8_t len = 10;
-        uint8_t phase = 0;
+        int16_t y = 0;           // head position (px, may be negative while off-screen)
+        uint8_t speed = 1;       // px per tick
+        uint8_t ring[ROWS];      // glyph slice index per row
     };
 
     Stream s[COLS];
+    uint16_t trail[PIXELS] __attribute__((aligned(4))); // row-major, word-aligned for the Pixel565 kernels
     uint32_t lastMs = 0;
 
-    static inline char randGlyph() {
-        const uint8_t r = (uint8_t)random(0, 36);
-        if (r < 10) return (char)('0' + r);
-        return (char)('A' + (r - 10));
+    void respawn(Stream& st) {
+        st.y = (int16_t)random(-90, -4);
+        st.speed = (uint8_t)random(1, 4);
+    }
+
+    // Spreads `active` of the COLS columns evenly across the panel.
+    static inline bool columnActive(int x, int active) { return (x * active) % COLS < active; }
+
+    void stampHead(int x, const Stream& st) {
+        if (st.y < 0 || st.y >= PANEL_RES_Y) return;
+        const int row = st.y / CELL_H;
+        const uint8_t bits = GLYPH_SLICES[st.ring[row]];
+        for (int b = 0; b < 5; b++) {
+            const int yy = row * CELL_H + b;
+            if ((bits & (1u << b)) && yy < PANEL_RES_Y) {
+                uint16_t& px = trail[yy * PANEL_RES_X + x];
+                px = Pixel565::addSat(px, GLYPH_COLOR);
+            }
+        }
     }
 
 public:
     void start() override {
         randomSeed((uint32_t)micros() ^ (uint32_t)millis());
         for (int i = 0; i < COLS; i++) {
-            s[i].y = (int16_t)random(-64, 0);
-            s[i].speed = (uint8_t)random(1, 4);
-            s[i].len = (uint8_t)random(8, 18);
-            s[i].phase = (uint8_t)random(0, 255);
+            respawn(s[i]);
+            s[i].y = (int16_t)random(-64, PANEL_RES_Y);
+            for (int r = 0; r < ROWS; r++) s[i].ring[r] = (uint8_t)random(0, 16);
         }
+        Pixel565::fill(trail, PIXELS, 0);
         lastMs = millis();
     }
 
     void reset() override { start(); }
     bool isGameOver() override { return false; }
+    bool isAmbient() const override { return true; }
 
     void update(ControllerManager* /*input*/) override {
         const uint32_t now = millis();
-        if ((uint32_t)(now - lastMs) < 40) return;
+        if ((uint32_t)(now - lastMs) < TICK_MS) return;
         lastMs = now;
+
+        // 1) Fade trails.
+        Pixel565::scale(trail, PIXELS, FADE);
+
+        // 2) Occasional glyph mutations (visible when a head passes over them).
+        for (uint8_t m = 0; m < MUTATIONS_PER_TICK; m++) {
+            s[random(0, COLS)].ring[random(0, ROWS)] = (uint8_t)random(0, 16);
+        }
+
+        // 3) Advance heads and stamp the glyph under each one.
+        const int active = globalQuality.scale(COLS, COLS / 4);
         for (int i = 0; i < COLS; i++) {
+            if (s[i].y < 0 && !columnActive(i, active)) continue;
             s[i].y += s[i].speed;
-            if (s[i].y > 64 + (int)s[i].len * CELL_H) {
-                s[i].y = (int16_t)random(-90, -10);
-                s[i].speed = (uint8_t)random(1, 4);
-                s[i].len = (uint8_t)random(8, 18);
-            }
+            if (s[i].y >= PANEL_RES_Y) respawn(s[i]);
+            stampHead(i, s[i]);
         }
     }
 
     void draw(MatrixPanel_I2S_DMA* d) override {
-        // Fade effect: draw a translucent-ish black overlay by sparsely clearing pixels
-        // (cheap approximation for HUB75).
-        for (int y = 0; y < PANEL_RES_Y; y++) {
-            for (int x = 0; x < PANEL_RES_X; x++) {
-                if (((x + y + (int)(millis() / 20)) & 0x07) == 0) d->drawPixel(x, y, COLOR_BLACK);
+        d->fillScreen(COLOR_BLACK);
+
+        for (int i = 0; i < PIXELS; i += 2) {
+            if (Pixel565::swar::load(trail + i) == 0) continue;
+            for (int k = i; k < i + 2; k++) {
+                if (trail[k]) d->drawPixel(k % PANEL_RES_X, k / PANEL_RES_X, trail[k]);
             }
         }
 
-        for (int i = 0; i < COLS; i++) {
-            const int x = i * CELL_W;
-            // draw head + tail
-            for (int k = 0; k < (int)s[i].len; k++) {
-                const int yy = (int)s[i].y - k * CELL_H;
-                if (yy < -CELL_H || yy >= PANEL_RES_Y) continue;
-
-                const uint8_t fade = (uint8_t)constrain(255 - k * (220 / max(1, (int)s[i].len)), 20, 255);
-                const uint16_t col = d->color565(0, (uint8_t)min(255, 40 + fade), 0);
-                const char ch = randGlyph();
-                SmallFont::drawChar(d, x, yy, ch, col);
+        // Bright heads: only the current glyph of each stream.
+        for (int x = 0; x < COLS; x++) {
+            const Stream& st = s[x];
+            if (st.y < 0 || st.y >= PANEL_RES_Y) continue;
+            const int row = st.y / CELL_H;
+            const uint8_t bits = GLYPH_SLICES[st.ring[row]];
+            for (int b = 0; b < 5; b++) {
+                const int yy = row * CELL_H + b;
+                if ((bits & (1u << b)) && yy < PANEL_RES_Y) d->drawPixel(x, yy, COLOR_WHITE);
             }
-            // bright head
-            const int hy = (int)s[i].y;
-            if (hy >= 0 && hy < PANEL_RES_Y) SmallFont::drawChar(d, x, hy, randGlyph(), COLOR_WHITE);
         }
     }
 };
-
-
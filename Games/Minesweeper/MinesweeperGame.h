@@ -3,13 +3,16 @@
 #include <ESP32-HUB75-MatrixPanel-I2S-DMA.h>
 
 #include "../../engine/GameBase.h"
+#include "../../engine/Snapshot.h"
 #include "../../engine/ControllerManager.h"
 #include "../../engine/config.h"
+#include "../../engine/Raster.h"
 #include "../../engine/UserProfiles.h"
 #include "../../component/SmallFont.h"
 #include "../../component/GameOverLeaderboardView.h"
 
 #include "MinesweeperGameConfig.h"
+#include "MinesweeperGenerator.h"
 
 class MinesweeperGame : public GameBase {
 private:
@@ -30,6 +33,15 @@ private:
     uint32_t elapsedScore = 0;
     bool minesPlaced = false;
 
+    // No-guess generation runs across frames after the first click.
+    MinesweeperGenerator<Cfg::W, Cfg::H> gen;
+    bool generating = false;
+    uint8_t genX = 0, genY = 0;   // first-click cell, revealed once the board is ready
+    uint32_t genStartMs = 0;
+
+    // Scrolling viewport (top-left visible cell).
+    uint8_t camX = 0, camY = 0;
+
     bool lastA = false, lastB = false;
     uint8_t lastDpad = 0;
 
@@ -74,6 +86,43 @@ private:
         computeAdj();
     }
 
+    void applyGeneratedBoard() {
+        for (int y = 0; y < Cfg::H; y++) {
+            for (int x = 0; x < Cfg::W; x++) grid[y][x].mine = gen.mineAt(x, y) ? 1 : 0;
+        }
+        computeAdj();
+    }
+
+    // Keep the cursor at least SCROLL_MARGIN cells inside the visible window.
+    void followCursor() {
+        auto axis = [](int cur, int cam, int view, int size) -> int {
+            if (size <= view) return 0;
+            const int m = Cfg::SCROLL_MARGIN;
+            if (cur < cam + m) cam = cur - m;
+            if (cur > cam + view - 1 - m) cam = cur - (view - 1 - m);
+            return constrain(cam, 0, size - view);
+        };
+        camX = (uint8_t)axis(cursorX, camX, Cfg::VIEW_W, Cfg::W);
+        camY = (uint8_t)axis(cursorY, camY, Cfg::VIEW_H, Cfg::H);
+    }
+
+    void revealAt(int x, int y, uint32_t now) {
+        Cell& c = grid[y][x];
+        c.rev = 1;
+        if (c.mine) {
+            gameOver = true;
+            win = false;
+            elapsedScore = 0;
+        } else {
+            if (c.adj == 0) floodReveal(x, y);
+            if (checkWin()) {
+                gameOver = true;
+                win = true;
+                elapsedScore = (uint32_t)((now - startMs) / 1000UL);
+            }
+        }
+    }
+
     void floodReveal(int sx, int sy) {
         // BFS flood for zeros
         static uint8_t qx[Cfg::W * Cfg::H];
@@ -153,17 +202,32 @@ public:
         lastA = lastB = false;
         lastDpad = 0;
         minesPlaced = false; // mines placed on first reveal to guarantee safe start
+        generating = false;
+        camX = 0; camY = 0;
     }
 
     void reset() override { start(); }
 
     void update(ControllerManager* input) override {
         if (gameOver) return;
+
+        if (generating) {
+            if (!gen.step(Cfg::GEN_BUDGET_US)) return;
+            generating = false;
+            applyGeneratedBoard();
+            minesPlaced = true;
+            // Generation time doesn't count against the player.
+            const uint32_t t = millis();
+            startMs += t - genStartMs;
+            revealAt(genX, genY, t);
+            return;
+        }
+
         const uint32_t now = millis();
-        ControllerPtr ctl = input ? input->getController(0) : nullptr;
-        if (!ctl) return;
+        const PadState& pad = input ? input->pad(0) : PadState();
+        if (!pad.connected) return;
 
-        const uint8_t d = ctl->dpad();
+        const uint8_t d = pad.dpad;
         const bool upE = dUp(d) && !dUp(lastDpad);
         const bool downE = dDown(d) && !dDown(lastDpad);
         const bool leftE = dLeft(d) && !dLeft(lastDpad);
@@ -173,9 +237,10 @@ public:
         if (downE && cursorY < Cfg::H - 1) cursorY++;
         if (leftE && cursorX > 0) cursorX--;
         if (rightE && cursorX < Cfg::W - 1) cursorX++;
+        followCursor();
 
-        const bool aNow = (bool)ctl->a();
-        const bool bNow = (bool)ctl->b();
+        const bool aNow = pad.held(PadState::BTN_A);
+        const bool bNow = pad.held(PadState::BTN_B);
         const bool aE = aNow && !lastA;
         const bool bE = bNow && !lastB;
         lastA = aNow;
@@ -189,22 +254,18 @@ public:
         if (aE && !c.rev && !c.flag) {
             // First click: if no mines placed yet, place them now.
             if (!minesPlaced) {
+                if (Cfg::NO_GUESS) {
+                    gen.begin(Cfg::MINES, cursorX, cursorY, Cfg::GEN_MAX_ATTEMPTS);
+                    generating = true;
+                    genX = cursorX;
+                    genY = cursorY;
+                    genStartMs = now;
+                    return;
+                }
                 placeMines(cursorX, cursorY);
                 minesPlaced = true;
             }
-            c.rev = 1;
-            if (c.mine) {
-                gameOver = true;
-                win = false;
-                elapsedScore = 0;
-            } else {
-                if (c.adj == 0) floodReveal(cursorX, cursorY);
-                if (checkWin()) {
-                    gameOver = true;
-                    win = true;
-                    elapsedScore = (uint32_t)((now - startMs) / 1000UL);
-                }
-            }
+            revealAt(cursorX, cursorY, now);
         }
     }
 
@@ -217,20 +278,29 @@ public:
             return;
         }
 
-        // HUD
+        // HUD: label + mines left (mines - flags)
         SmallFont::drawString(d, 2, 6, "MINES", COLOR_CYAN);
-        for (int x = 0; x < PANEL_RES_X; x += 2) d->drawPixel(x, Cfg::HUD_H - 1, COLOR_BLUE);
+        {
+            int flags = 0;
+            for (int y = 0; y < Cfg::H; y++) {
+                for (int x = 0; x < Cfg::W; x++) flags += grid[y][x].flag;
+            }
+            SmallFont::drawStringF(d, 50, 6, COLOR_WHITE, "%d", (int)Cfg::MINES - flags);
+        }
+        Raster::dashedHLine(d, 0, Cfg::HUD_H - 1, PANEL_RES_X, COLOR_BLUE);
 
-        // Board: 16x16 * 4 = 64, we use full screen; HUD overlays top but OK.
-        for (int y = 0; y < Cfg::H; y++) {
-            for (int x = 0; x < Cfg::W; x++) {
-                const int px = x * Cfg::CELL;
-                const int py = y * Cfg::CELL;
-                const Cell& c = grid[y][x];
+        // Board: visible window below the HUD, scrolled by (camX, camY).
+        const int viewW = min(Cfg::VIEW_W, Cfg::W);
+        const int viewH = min(Cfg::VIEW_H, Cfg::H);
+        for (int vy = 0; vy < viewH; vy++) {
+            for (int vx = 0; vx < viewW; vx++) {
+                const int px = vx * Cfg::CELL;
+                const int py = Cfg::VIEW_Y + vy * Cfg::CELL;
+                const Cell& c = grid[camY + vy][camX + vx];
                 if (!c.rev) {
                     // closed
                     d->fillRect(px, py, 4, 4, d->color565(40,40,40));
-                    d->drawRect(px, py, 4, 4, d->color565(80,80,80));
+                    Raster::rect(d, px, py, 4, 4, d->color565(80,80,80));
                     if (c.flag) {
                         d->drawPixel(px + 1, py + 1, COLOR_RED);
                         d->drawPixel(px + 2, py + 1, COLOR_RED);
@@ -249,16 +319,26 @@ public:
         }
 
         // Cursor
-        const int cx = cursorX * Cfg::CELL;
-        const int cy = cursorY * Cfg::CELL;
-        d->drawRect(cx, cy, 4, 4, COLOR_YELLOW);
+        const int cx = (cursorX - camX) * Cfg::CELL;
+        const int cy = Cfg::VIEW_Y + (cursorY - camY) * Cfg::CELL;
+        Raster::rect(d, cx, cy, 4, 4, COLOR_YELLOW);
+
+        // Generation progress (attempt number + current attempt's solve progress).
+        if (generating) {
+            d->fillRect(6, 24, 52, 20, COLOR_BLACK);
+            Raster::rect(d, 6, 24, 52, 20, COLOR_WHITE);
+            SmallFont::drawStringF(d, 10, 32, COLOR_CYAN, "TRY %u", (unsigned)gen.attemptCount());
+            Raster::rect(d, 10, 36, 44, 4, d->color565(80,80,80));
+            const int fill = ((int)gen.solveProgress() * 42) / 255;
+            if (fill > 0) d->fillRect(11, 37, fill, 2, COLOR_GREEN);
+        }
     }
 
     bool isGameOver() override { return gameOver; }
 
     bool leaderboardEnabled() const override { return true; }
-    const char* leaderboardId() const override { return "mines"; }
-    const char* leaderboardName() const override { return "Mines"; }
+    const char* leaderboardId() const override { return Cfg::LEADERBOARD_ID; }
+    const char* leaderboardName() const override { return Cfg::LEADERBOARD_NAME; }
     uint32_t leaderboardScore() const override {
         // For now: win score = max(1, 999 - seconds). Loss = 0.
         if (!win) return 0;
@@ -266,6 +346,89 @@ public:
         const uint32_t v = (s >= 999) ? 1 : (999 - s);
         return v;
     }
+
+    // ------------------------------
+    // Self-check (DEBUG_INVARIANTS)
+    // ------------------------------
+    const char* checkInvariants() const override {
+        if (cursorX >= Cfg::W || cursorY >= Cfg::H) return "cursor off the board";
+        if (cursorX < camX || cursorX >= camX + Cfg::VIEW_W || cursorY < camY || cursorY >= camY + Cfg::VIEW_H) return "cursor outside the viewport";
+        if (minesPlaced && generating) return "board placed while still generating";
+        int mines = 0;
+        int revealedMines = 0;
+        for (int y = 0; y < Cfg::H; y++) {
+            for (int x = 0; x < Cfg::W; x++) {
+                const Cell& c = grid[y][x];
+                if (c.rev && c.flag) return "flagged cell revealed";
+                if (c.mine) { mines++; if (c.rev) revealedMines++; continue; }
+                int n = 0;
+                for (int dy = -1; dy <= 1; dy++) {
+                    for (int dx = -1; dx <= 1; dx++) {
+                        if ((dx || dy) && inBounds(x + dx, y + dy) && grid[y + dy][x + dx].mine) n++;
+                    }
+                }
+                if (c.adj != n) return "stale adjacency count";
+            }
+        }
+        if (mines != (minesPlaced ? Cfg::MINES : 0)) return "mine count does not match config";
+        // Only the losing click uncovers a mine.
+        if (revealedMines > ((gameOver && !win) ? 1 : 0)) return "mine revealed in play";
+        return nullptr;
+    }
+
+    // Snapshots (engine/Snapshot.h): 3 bits per cell, adjacency is recomputed.
+    // A board still being generated is saved as its first click and regenerated.
+    uint8_t snapshotVersion() const override { return 1; }
+
+    void saveSnapshot(SnapshotWriter& w) const override {
+        w.boolean(gameOver);
+        w.boolean(win);
+        w.boolean(minesPlaced);
+        w.boolean(generating);
+        w.u8(cursorX);
+        w.u8(cursorY);
+        w.u8(genX);
+        w.u8(genY);
+        w.time(startMs);
+        w.u32(elapsedScore);
+        for (int y = 0; y < Cfg::H; y++) {
+            for (int x = 0; x < Cfg::W; x++) {
+                const Cell& c = grid[y][x];
+                w.bits((uint32_t)c.mine | ((uint32_t)c.rev << 1) | ((uint32_t)c.flag << 2), 3);
+            }
+        }
+    }
+
+    bool loadSnapshot(SnapshotReader& r) override {
+        gameOver = r.boolean();
+        win = r.boolean();
+        minesPlaced = r.boolean();
+        generating = r.boolean();
+        cursorX = r.below(Cfg::W);
+        cursorY = r.below(Cfg::H);
+        genX = r.below(Cfg::W);
+        genY = r.below(Cfg::H);
+        startMs = r.time();
+        elapsedScore = r.u32();
+        for (int y = 0; y < Cfg::H; y++) {
+            for (int x = 0; x < Cfg::W; x++) {
+                const uint32_t v = r.bits(3);
+                Cell& c = grid[y][x];
+                c.mine = v & 1u;
+                c.rev = (v >> 1) & 1u;
+                c.flag = (v >> 2) & 1u;
+            }
+        }
+        computeAdj();
+        if (generating) {
+            gen.begin(Cfg::MINES, genX, genY, Cfg::GEN_MAX_ATTEMPTS);
+            genStartMs = millis();
+        }
+        lastA = lastB = false;
+        lastDpad = 0;
+        followCursor();
+        return r.ok();
+    }
 };
 
 
@@ -7,11 +7,32 @@ struct MinesweeperConfig {
 
 static constexpr int HUD_H = 8;
 static constexpr int CELL = 4;
-static constexpr int W = 16;
-static constexpr int H = 16; // uses full 64px height; top HUD overlays
 
-static constexpr uint8_t MINES = 40;
+// Board size (cells). Larger than the panel is fine: the view scrolls with the cursor.
+static constexpr int W = 24;
+static constexpr int H = 24;
 
-};
+static constexpr uint8_t MINES = 90;
+
+// Best times only compare on the same board, so the leaderboard table is keyed
+// by its size and mine count (the old 16x16/40 board used "mines").
+static constexpr const char* LEADERBOARD_ID = "mines24x24m90";
+static constexpr const char* LEADERBOARD_NAME = "Mines24"; // Leaderboard::NAME_LEN chars max
+
+// Visible window (below the HUD) and how close the cursor may get to its edge before scrolling.
+static constexpr int VIEW_Y = HUD_H;
+static constexpr int VIEW_W = PANEL_RES_X / CELL;
+static constexpr int VIEW_H = (PANEL_RES_Y - VIEW_Y) / CELL;
+static constexpr int SCROLL_MARGIN = 2;
 
+// No-guess generation (see MinesweeperGenerator.h): boards are re-rolled until
+// the solver clears them from the first click. Work is spread across frames.
+static constexpr bool NO_GUESS = true;
+static constexpr uint32_t GEN_BUDGET_US = 6000;    // per update() call
+static constexpr uint16_t GEN_MAX_ATTEMPTS = 500;  // then accept the last board as-is
 
+static_assert(W <= 255 && H <= 255, "Minesweeper: cursor/flood coords are 8-bit");
+static_assert((int)MINES <= W * H - 9, "Minesweeper: too many mines for the safe first click");
+static_assert(W == 24 && H == 24 && MINES == 90, "Minesweeper: board changed, give it a new LEADERBOARD_ID/NAME");
+
+};
@@ -0,0 +1,371 @@
+// MinesweeperGenerator.h
+// -----------------------------------------------------------------------------
+// "No-guess" board generator: place mines, then check with a constraint solver
+// that the board can be cleared from the first click by logic alone. Repeat
+// until it can (or the attempt cap is hit).
+//
+// Solver rules, cheapest first (each deduction loops back to the cheap rules):
+// 1) Trivial: a number whose remaining mines are 0 (all unknown neighbours safe)
+//    or equal to its unknown count (all mines).
+// 2) Subset: for two numbers A, B within 2 cells, if unknown(A) is a subset of
+//    unknown(B), then unknown(B) - unknown(A) holds rem(B) - rem(A) mines.
+// 3) Limited enumeration: all numbers within 2 cells of A, brute-forced over
+//    their unknown cells when there are at most ENUM_MAX_VARS of them. Cells
+//    that are safe (or mined) in every consistent assignment are resolved.
+// 4) Global mine count: remaining mines 0 / equal to remaining unknowns.
+//
+// Unknown neighbour sets are 64-bit masks over a 7x7 frame centred on A, so the
+// subset/enumeration rules are just a few ANDs and popcounts per pair.
+//
+// Time slicing: `step(budgetUs)` runs until the budget is spent and resumes
+// from the same phase/cursor next call, so generation can span frames while
+// the caller draws a progress indicator.
+// -----------------------------------------------------------------------------
+#pragma once
+
+#include <Arduino.h>
+
+template <int W, int H>
+class MinesweeperGenerator {
+public:
+    static constexpr uint16_t N = (uint16_t)(W * H);
+    static_assert(W > 0 && H > 0 && W * H <= 65535, "MinesweeperGenerator: board too large");
+
+    static constexpr uint8_t ENUM_MAX_VARS = 12;
+
+    /**
+     * Start generating a board with `mines` mines whose 3x3 block around
+     * (safeX, safeY) is mine-free. `maxAttempts` = 0 means "no cap".
+     */
+    void begin(uint16_t mines, uint8_t safeX, uint8_t safeY, uint16_t maxAttempts) {
+        mineCount = mines;
+        sx = safeX;
+        sy = safeY;
+        attemptCap = maxAttempts;
+        attempts = 0;
+        solved = false;
+        phase = PH_PLACE;
+    }
+
+    /**
+     * Work for about `budgetUs` microseconds. Returns true once a board is ready
+     * (`isNoGuess()` tells whether it passed the solver or hit the attempt cap).
+     */
+    bool step(uint32_t budgetUs) {
+        Budget budget(budgetUs);
+        while (phase != PH_DONE && !budget.out()) {
+            switch (phase) {
+                case PH_PLACE:   stepPlace(); break;
+                case PH_REVEAL:  stepReveal(budget); break;
+                case PH_TRIVIAL: stepTrivial(budget); break;
+                case PH_SUBSET:  stepSubset(budget); break;
+                case PH_ENUM:    stepEnum(budget); break;
+                case PH_GLOBAL:  stepGlobal(); break;
+                default: break;
+            }
+        }
+        return phase == PH_DONE;
+    }
+
+    bool isDone() const { return phase == PH_DONE; }
+    bool isNoGuess() const { return solved; }
+    uint16_t attemptCount() const { return attempts; }
+
+    // Progress of the current attempt's solve (0..255), for a progress bar.
+    uint8_t solveProgress() const {
+        const uint16_t safe = (uint16_t)(N - mineCount);
+        if (safe == 0) return 255;
+        return (uint8_t)(((uint32_t)revealedCount * 255u) / safe);
+    }
+
+    bool mineAt(int x, int y) const {
+        const uint16_t c = (uint16_t)(y * W + x);
+        return ((mineBits[c >> 3] >> (c & 7)) & 1u) != 0;
+    }
+
+private:
+    enum Phase : uint8_t { PH_PLACE, PH_REVEAL, PH_TRIVIAL, PH_SUBSET, PH_ENUM, PH_GLOBAL, PH_DONE };
+    enum CellState : uint8_t { ST_UNKNOWN = 0, ST_REVEALED, ST_MINE, ST_PENDING };
+
+    // Microsecond budget, polled every few work items to keep micros() overhead low.
+    struct Budget {
+        uint32_t startUs;
+        uint32_t limitUs;
+        uint16_t polls = 0;
+        bool expired = false;
+
+        Budget(uint32_t limit) : startUs(micros()), limitUs(limit) {}
+
+        bool out() {
+            if (expired) return true;
+            if ((++polls & 15u) == 0 && (uint32_t)(micros() - startUs) >= limitUs) expired = true;
+            return expired;
+        }
+    };
+
+    uint8_t mineBits[(N + 7) / 8];
+    uint8_t adj[N];
+    uint8_t st[N];
+    uint16_t queue[N];   // cells proven safe, waiting to be revealed (LIFO)
+    uint16_t queueLen = 0;
+
+    uint16_t mineCount = 0;
+    uint16_t knownMines = 0;
+    uint16_t revealedCount = 0;
+    uint8_t sx = 0, sy = 0;
+    uint16_t attempts = 0;
+    uint16_t attemptCap = 0;
+    bool solved = false;
+
+    Phase phase = PH_DONE;
+    uint16_t cursor = 0;
+    bool progress = false;
+
+    static inline bool inBounds(int x, int y) { return x >= 0 && y >= 0 && x < W && y < H; }
+
+    // ---------------------------------------------------------
+    // Attempt setup
+    // ---------------------------------------------------------
+    void stepPlace() {
+        attempts++;
+        memset(mineBits, 0, sizeof(mineBits));
+        memset(st, ST_UNKNOWN, sizeof(st));
+        queueLen = 0;
+        knownMines = 0;
+        revealedCount = 0;
+
+        uint16_t placed = 0;
+        while (placed < mineCount) {
+            const int x = random(0, W);
+            const int y = random(0, H);
+            if (abs(x - (int)sx) <= 1 && abs(y - (int)sy) <= 1) continue;
+            const uint16_t c = (uint16_t)(y * W + x);
+            if (mineBits[c >> 3] & (1u << (c & 7))) continue;
+            mineBits[c >> 3] |= (uint8_t)(1u << (c & 7));
+            placed++;
+        }
+        for (int y = 0; y < H; y++) {
+            for (int x = 0; x < W; x++) {
+                uint8_t n = 0;
+                for (int dy = -1; dy <= 1; dy++) {
+                    for (int dx = -1; dx <= 1; dx++) {
+                        if ((dx || dy) && inBounds(x + dx, y + dy) && mineAt(x + dx, y + dy)) n++;
+                    }
+                }
+                adj[y * W + x] = n;
+            }
+        }
+
+        markSafe(sx, sy);
+        phase = PH_REVEAL;
+    }
+
+    void finishAttempt(bool ok) {
+        if (ok) {
+            solved = true;
+            phase = PH_DONE;
+        } else if (attemptCap != 0 && attempts >= attemptCap) {
+            solved = false; // keep this board; it may need a guess
+            phase = PH_DONE;
+        } else {
+            phase = PH_PLACE;
+        }
+    }
+
+    // ---------------------------------------------------------
+    // Deductions
+    // ---------------------------------------------------------
+    void markSafe(int x, int y) {
+        const uint16_t c = (uint16_t)(y * W + x);
+        if (st[c] != ST_UNKNOWN) return;
+        st[c] = ST_PENDING;
+        queue[queueLen++] = c;
+        progress = true;
+    }
+
+    void markMine(int x, int y) {
+        const uint16_t c = (uint16_t)(y * W + x);
+        if (st[c] != ST_UNKNOWN) return;
+        st[c] = ST_MINE;
+        knownMines++;
+        progress = true;
+    }
+
+    // After a deduction, restart from the cheapest rule.
+    void afterDeduction() {
+        phase = (queueLen > 0) ? PH_REVEAL : PH_TRIVIAL;
+        cursor = 0;
+        progress = false;
+    }
+
+    void stepReveal(Budget& budget) {
+        while (queueLen > 0) {
+            if (budget.out()) return;
+            const uint16_t c = queue[--queueLen];
+            st[c] = ST_REVEALED;
+            revealedCount++;
+            if (adj[c] != 0) continue;
+            const int x = c % W;
+            const int y = c / W;
+            for (int dy = -1; dy <= 1; dy++) {
+                for (int dx = -1; dx <= 1; dx++) {
+                    if ((dx || dy) && inBounds(x + dx, y + dy)) markSafe(x + dx, y + dy);
+                }
+            }
+        }
+        if (revealedCount == (uint16_t)(N - mineCount)) {
+            finishAttempt(true);
+            return;
+        }
+        phase = PH_TRIVIAL;
+        cursor = 0;
+        progress = false;
+    }
+
+    // Unknown neighbours of (cx, cy) as bits in the 7x7 frame centred on (ax, ay),
+    // plus the number of mines still missing around it. Returns false if (cx, cy)
+    // is not a useful constraint (not revealed, or nothing unknown around it).
+    bool constraintAt(int cx, int cy, int ax, int ay, uint64_t& mask, int& rem) const {
+        const uint16_t c = (uint16_t)(cy * W + cx);
+        if (st[c] != ST_REVEALED || adj[c] == 0) return false;
+        mask = 0;
+        rem = adj[c];
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                if (!dx && !dy) continue;
+                const int nx = cx + dx;
+                const int ny = cy + dy;
+                if (!inBounds(nx, ny)) continue;
+                const uint8_t s = st[ny * W + nx];
+                if (s == ST_MINE) rem--;
+                else if (s == ST_UNKNOWN) mask |= 1ull << ((ny - ay + 3) * 7 + (nx - ax + 3));
+            }
+        }
+        return mask != 0;
+    }
+
+    void applyMask(uint64_t safe, uint64_t mines, int ax, int ay) {
+        while (safe) {
+            const int b = __builtin_ctzll(safe);
+            markSafe(ax + (b % 7) - 3, ay + (b / 7) - 3);
+            safe &= safe - 1;
+        }
+        while (mines) {
+            const int b = __builtin_ctzll(mines);
+            markMine(ax + (b % 7) - 3, ay + (b / 7) - 3);
+            mines &= mines - 1;
+        }
+    }
+
+    void stepTrivial(Budget& budget) {
+        while (cursor < N) {
+            if (budget.out()) return;
+            const int x = cursor % W;
+            const int y = cursor / W;
+            cursor++;
+            uint64_t m;
+            int rem;
+            if (!constraintAt(x, y, x, y, m, rem)) continue;
+            if (rem == 0) applyMask(m, 0, x, y);
+            else if (rem == __builtin_popcountll(m)) applyMask(0, m, x, y);
+        }
+        if (queueLen > 0) afterDeduction();
+        else if (progress) { cursor = 0; progress = false; } // new mines may unlock more
+        else { phase = PH_SUBSET; cursor = 0; }
+    }
+
+    void stepSubset(Budget& budget) {
+        while (cursor < N) {
+            if (budget.out()) return;
+            const int ax = cursor % W;
+            const int ay = cursor / W;
+            cursor++;
+            uint64_t ma;
+            int ra;
+            if (!constraintAt(ax, ay, ax, ay, ma, ra)) continue;
+            for (int dy = -2; dy <= 2; dy++) {
+                for (int dx = -2; dx <= 2; dx++) {
+                    if ((!dx && !dy) || !inBounds(ax + dx, ay + dy)) continue;
+                    uint64_t mb;
+                    int rb;
+                    if (!constraintAt(ax + dx, ay + dy, ax, ay, mb, rb)) continue;
+                    if ((ma & ~mb) != 0 || ma == mb) continue; // need A strictly inside B
+                    const uint64_t diff = mb & ~ma;
+                    const int d = rb - ra;
+                    if (d == 0) applyMask(diff, 0, ax, ay);
+                    else if (d == __builtin_popcountll(diff)) applyMask(0, diff, ax, ay);
+                }
+            }
+            if (progress) { afterDeduction(); return; }
+        }
+        phase = PH_ENUM;
+        cursor = 0;
+    }
+
+    void stepEnum(Budget& budget) {
+        static constexpr int MAX_C = 25;
+        uint64_t masks[MAX_C];
+        int rems[MAX_C];
+        while (cursor < N) {
+            if (budget.out()) return;
+            const int ax = cursor % W;
+            const int ay = cursor / W;
+            cursor++;
+            uint64_t m;
+            int r;
+            if (!constraintAt(ax, ay, ax, ay, m, r)) continue;
+
+            int cn = 0;
+            uint64_t vars = 0;
+            for (int dy = -2; dy <= 2; dy++) {
+                for (int dx = -2; dx <= 2; dx++) {
+                    if (!inBounds(ax + dx, ay + dy)) continue;
+                    if (!constraintAt(ax + dx, ay + dy, ax, ay, masks[cn], rems[cn])) continue;
+                    vars |= masks[cn];
+                    cn++;
+                }
+            }
+            if (cn < 2 || __builtin_popcountll(vars) > ENUM_MAX_VARS) continue;
+
+            uint64_t anyMine = 0;
+            uint64_t allMine = vars;
+            bool found = false;
+            uint64_t sub = 0;
+            do {
+                bool ok = true;
+                for (int i = 0; i < cn; i++) {
+                    if (__builtin_popcountll(sub & masks[i]) != rems[i]) { ok = false; break; }
+                }
+                if (ok) {
+                    found = true;
+                    anyMine |= sub;
+                    allMine &= sub;
+                }
+                sub = (sub - vars) & vars;
+            } while (sub != 0);
+            if (!found) continue;
+
+            applyMask(vars & ~anyMine, allMine, ax, ay);
+            if (progress) { afterDeduction(); return; }
+        }
+        phase = PH_GLOBAL;
+    }
+
+    void stepGlobal() {
+        uint16_t unknown = 0;
+        for (uint16_t c = 0; c < N; c++) {
+            if (st[c] == ST_UNKNOWN) unknown++;
+        }
+        const uint16_t left = (uint16_t)(mineCount - knownMines);
+        if (unknown > 0 && (left == 0 || left == unknown)) {
+            for (uint16_t c = 0; c < N; c++) {
+                if (st[c] != ST_UNKNOWN) continue;
+                if (left == 0) markSafe(c % W, c / W);
+                else markMine(c % W, c / W);
+            }
+            afterDeduction();
+            return;
+        }
+        finishAttempt(false);
+    }
+};
@@ -16,6 +16,7 @@
 #include "../../engine/ControllerManager.h"
 #include "../../engine/AudioManager.h"
 #include "../../engine/config.h"
+#include "../../engine/Raster.h"
 #include "../../engine/Settings.h"
 #include "../../component/SmallFont.h"
 #include "../../component/ScrollableList.h"
@@ -61,9 +62,9 @@ public:
         }
 
         // B stops playback (edge).
-        ControllerPtr ctl = input ? input->getController(0) : nullptr;
-        if (!ctl) return;
-        const bool bNow = (bool)ctl->b();
+        const PadState& pad = input ? input->pad(0) : PadState();
+        if (!pad.connected) return;
+        const bool bNow = pad.held(PadState::BTN_B);
         if (bNow && !lastB) {
             stopPlayback();
         }
@@ -76,7 +77,7 @@ public:
 
         // HUD
         SmallFont::drawString(display, 2, 6, "MUSIC", COLOR_CYAN);
-        for (int x = 0; x < PANEL_RES_X; x += 2) display->drawPixel(x, HUD_H - 1, COLOR_BLUE);
+        Raster::dashedHLine(display, 0, HUD_H - 1, PANEL_RES_X, COLOR_BLUE);
 
         // Right side HUD: volume + playing marker.
         SmallFont::drawStringF(display, 38, 6, COLOR_YELLOW, "V%02d", (int)globalSettings.getSoundVolumeLevel());
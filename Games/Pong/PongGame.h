@@ -9,26 +9,18 @@
 #include "../../component/SmallFont.h"
 #include "../../engine/Settings.h"
 #include "../../engine/UserProfiles.h"
+#include "../../engine/NetPlay.h"
 #include "../../component/GameOverLeaderboardView.h"
 #include "PongGameConfig.h"
 #include "PongGameAudio.h"
 
 /**
  * PongGame - Classic Pong game implementation
- * Supports 1-2 players with paddle controls
+ * Supports 1-2 players with paddle controls, or two linked cabinets
+ * (one player each) when NetPlay has a peer.
  */
-class PongGame : public GameBase {
+class PongGame : public GameBase, public NetGame {
 private:
-    // ---------------------------------------------------------
-    // Analog helpers (Bluepad32 API varies across versions/controllers)
-    // ---------------------------------------------------------
-    struct InputDetail {
-        template <typename T>
-        static auto axisY(T* c, int) -> decltype(c->axisY(), int16_t()) { return (int16_t)c->axisY(); }
-        template <typename T>
-        static int16_t axisY(T*, ...) { return 0; }
-    };
-
     static inline float clampf(float v, float lo, float hi) { return (v < lo) ? lo : (v > hi) ? hi : v; }
     static inline float deadzone01(float v, float dz) {
         const float a = fabsf(v);
@@ -101,7 +93,37 @@ private:
     static constexpr uint16_t WALL_SFX_COOLDOWN_MS = 30;
     static constexpr uint16_t PADDLE_SFX_COOLDOWN_MS = 18;
 
+    // ---------------------------------------------------------
+    // Linked play (see engine/NetPlay.h)
+    // ---------------------------------------------------------
+    // In net mode the match runs on a virtual clock (one tick per net frame) and
+    // all randomness comes from `rng`, so both cabinets simulate identically.
+    bool netMode = false;
+    bool netSeeded = false;
+    bool linkLost = false;
+    bool replaying = false;   // NetPlay is re-simulating after a rollback (mute SFX)
+    uint32_t simFrame = 0;    // net frames simulated
+    uint32_t endFrame = 0;    // net frame that ended the match
+    uint32_t netWaitStartMs = 0;
+    DetRandom rng;
+
+    // Everything netStep() reads or writes.
+    struct NetState {
+        float leftY, rightY;
+        int leftScore, rightScore;
+        Ball ball;
+        bool gameOver;
+        RoundPhase phase;
+        uint32_t phaseStartMs;
+        uint8_t lastPointWinner;
+        uint32_t simFrame;
+        uint32_t endFrame;
+        DetRandom rng;
+    };
+    NetState netSlots[NetPlay::STATE_SLOTS];
+
     inline void sfxPaddleHit(uint32_t now) {
+        if (replaying) return;
         if ((uint32_t)(now - lastPaddleSfxMs) < PADDLE_SFX_COOLDOWN_MS) return;
         lastPaddleSfxMs = now;
         globalAudio.playPattern(
@@ -111,6 +133,7 @@ private:
     }
 
     inline void sfxWallHit(uint32_t now) {
+        if (replaying) return;
         if ((uint32_t)(now - lastWallSfxMs) < WALL_SFX_COOLDOWN_MS) return;
         lastWallSfxMs = now;
         globalAudio.playPattern(
@@ -120,6 +143,7 @@ private:
     }
 
     inline void sfxScore() {
+        if (replaying) return;
         globalAudio.playPattern(
             PongGameAudio::SFX_SCORE,
             (uint8_t)(sizeof(PongGameAudio::SFX_SCORE) / sizeof(PongGameAudio::SFX_SCORE[0]))
@@ -127,6 +151,7 @@ private:
     }
 
     inline void sfxGameOver() {
+        if (replaying) return;
         globalAudio.playPattern(
             PongGameAudio::SFX_GAME_OVER,
             (uint8_t)(sizeof(PongGameAudio::SFX_GAME_OVER) / sizeof(PongGameAudio::SFX_GAME_OVER[0]))
@@ -140,7 +165,7 @@ private:
         ball.x = PANEL_RES_X / 2.0f;
         ball.y = PANEL_RES_Y / 2.0f;
         ball.vx = (serveDir >= 0) ? ballStartSpeed() : -ballStartSpeed();
-        ball.vy = (random(-100, 100) / 100.0f) * 0.55f;
+        ball.vy = (rng.range(-100, 100) / 100.0f) * 0.55f;
     }
     
     /**
@@ -185,54 +210,26 @@ private:
         }
     }
 
-public:
-    PongGame() 
-        : leftPaddle(2, PANEL_RES_Y / 2 - 6, 1, 12, COLOR_GREEN),
-          rightPaddle(PANEL_RES_X - 3, PANEL_RES_Y / 2 - 6, 1, 12, COLOR_CYAN),
-          gameOver(false),
-          twoPlayer(false),
-          lastUpdate(0) {
-        resetBall(1);
-    }
-
-    void start() override {
-        gameOver = false;
-        lastUpdate = millis();
-        lastWallSfxMs = 0;
-        lastPaddleSfxMs = 0;
-        lastAiThinkMs = 0;
-        aiAimY = PANEL_RES_Y / 2.0f;
-        phase = PHASE_COUNTDOWN;
-        phaseStartMs = lastUpdate;
-        lastPointWinner = 0;
-        
-        // Determine if two players based on connected controllers
-        twoPlayer = (globalControllerManager->getConnectedCount() >= 2);
+    // Analog stick (fallback to dpad) -> paddle movement.
+    void movePaddle(Paddle& p, const NetInput& in) {
+        const float raw = clampf((float)(in.axisY * 4) / (float)AXIS_DIVISOR, -1.0f, 1.0f);
+        float sy = deadzone01(raw, STICK_DEADZONE);
 
-        // Apply current global player color for Player 1 (left paddle).
-        leftPaddle.color = globalSettings.getPlayerColor();
-        
-        // Reset scores and positions
-        leftPaddle.score = 0;
-        rightPaddle.score = 0;
-        leftPaddle.y = (float)(PANEL_RES_Y / 2 - leftPaddle.height / 2);
-        rightPaddle.y = (float)(PANEL_RES_Y / 2 - rightPaddle.height / 2);
-        
-        // Countdown on start, then serve to the right.
-        resetBall(+1);
-    }
+        if (sy == 0.0f) {
+            if (in.dpad & 0x01) sy = -1.0f; // UP
+            else if (in.dpad & 0x02) sy = 1.0f; // DOWN
+        }
 
-    void reset() override {
-        start();
+        p.y += sy * PLAYER_SPEED;
+        p.y = clampf(p.y, 0.0f, (float)(PANEL_RES_Y - p.height));
     }
 
-    void update(ControllerManager* input) override {
+    /**
+     * One logic tick. Shared by local play (real clock, pads read directly) and
+     * linked play (virtual clock, inputs from NetPlay).
+     */
+    void simulate(uint32_t now, const NetInput& in1, const NetInput& in2) {
         if (gameOver) return;
-        
-        // Throttle updates for smooth gameplay
-        const unsigned long now = millis();
-        if (now - lastUpdate < UPDATE_INTERVAL_MS) return;
-        lastUpdate = now;
 
         // -----------------------------------------------------
         // Round phases (flash -> countdown -> play)
@@ -255,41 +252,9 @@ public:
             // Still allow paddle movement during countdown.
         }
         
-        // Update left paddle (Player 1) - analog stick (fallback to dpad)
-        ControllerPtr p1 = input->getController(0);
-        if (p1 && p1->isConnected()) {
-            const float raw = clampf((float)InputDetail::axisY(p1, 0) / (float)AXIS_DIVISOR, -1.0f, 1.0f);
-            float sy = deadzone01(raw, STICK_DEADZONE);
-
-            if (sy == 0.0f) {
-                const uint8_t dpad = p1->dpad();
-                if (dpad & 0x01) sy = -1.0f; // UP
-                else if (dpad & 0x02) sy = 1.0f; // DOWN
-            }
-
-            leftPaddle.y += sy * PLAYER_SPEED;
-            leftPaddle.y = clampf(leftPaddle.y, 0.0f, (float)(PANEL_RES_Y - leftPaddle.height));
-        }
-        
-        // Update right paddle (Player 2 or AI) - analog stick for player 2
-        if (twoPlayer) {
-            ControllerPtr p2 = input->getController(1);
-            if (p2 && p2->isConnected()) {
-                const float raw = clampf((float)InputDetail::axisY(p2, 0) / (float)AXIS_DIVISOR, -1.0f, 1.0f);
-                float sy = deadzone01(raw, STICK_DEADZONE);
-
-                if (sy == 0.0f) {
-                    const uint8_t dpad = p2->dpad();
-                    if (dpad & 0x01) sy = -1.0f; // UP
-                    else if (dpad & 0x02) sy = 1.0f; // DOWN
-                }
-
-                rightPaddle.y += sy * PLAYER_SPEED;
-                rightPaddle.y = clampf(rightPaddle.y, 0.0f, (float)(PANEL_RES_Y - rightPaddle.height));
-            }
-        } else {
-            updateAI((uint32_t)now);
-        }
+        movePaddle(leftPaddle, in1);
+        if (twoPlayer) movePaddle(rightPaddle, in2);
+        else updateAI(now);
 
         // During countdown we don't move the ball.
         if (phase != PHASE_PLAYING) return;
@@ -360,13 +325,204 @@ public:
         }
     }
 
+    void updateNet(ControllerManager* input) {
+        if (isGameOver()) return;
+        if (globalNetPlay.sessionLost()) {
+            linkLost = true;
+            gameOver = true;
+            return;
+        }
+        if (!globalNetPlay.sessionRunning()) {
+            // "WAIT PEER": the other cabinet may never start Pong. Play here
+            // instead once it's gone quiet, the wait times out, or on B.
+            if (!globalNetPlay.linked() || input->pad(0).held(PadState::BTN_B) ||
+                (uint32_t)(millis() - netWaitStartMs) >= PongGameConfig::NET_PEER_WAIT_MS) {
+                globalNetPlay.endSession();
+                begin(/*tryLink=*/false);
+            }
+            return;
+        }
+
+        if (!netSeeded) {
+            // Same starting state on both cabinets.
+            netSeeded = true;
+            rng.seed(globalNetPlay.sessionSeed());
+            resetBall(+1);
+        }
+        // This cabinet's pad 0 drives our side; the peer's arrives over the link.
+        globalNetPlay.tick(*this, NetInput::sample(input->pad(0)));
+    }
+
+    // Linked match when `tryLink` and a peer cabinet is around, else local play.
+    void begin(bool tryLink) {
+        gameOver = false;
+        lastUpdate = millis();
+        lastWallSfxMs = 0;
+        lastPaddleSfxMs = 0;
+        lastAiThinkMs = 0;
+        aiAimY = PANEL_RES_Y / 2.0f;
+        phase = PHASE_COUNTDOWN;
+        phaseStartMs = lastUpdate;
+        lastPointWinner = 0;
+        
+        // Linked cabinet available -> one player per cabinet; otherwise
+        // determine if two players based on connected controllers.
+        netMode = tryLink && globalNetPlay.linked();
+        netWaitStartMs = lastUpdate;
+        netSeeded = false;
+        linkLost = false;
+        simFrame = 0;
+        endFrame = 0;
+        if (netMode) {
+            twoPlayer = true;
+            phaseStartMs = 0;
+            globalNetPlay.startSession(PongGameConfig::NET_GAME_ID);
+            // Our colour goes on our side; the peer's paddle keeps its default.
+            const bool left = (globalNetPlay.localSide() == 0);
+            leftPaddle.color = left ? globalSettings.getPlayerColor() : COLOR_GREEN;
+            rightPaddle.color = left ? COLOR_CYAN : globalSettings.getPlayerColor();
+        } else {
+            twoPlayer = (globalControllerManager->getConnectedCount() >= 2);
+            rng.seed((uint32_t)random(1, 0x7FFFFFFF));
+
+            // Apply current global player color for Player 1 (left paddle).
+            leftPaddle.color = globalSettings.getPlayerColor();
+            rightPaddle.color = COLOR_CYAN;
+        }
+        
+        // Reset scores and positions
+        leftPaddle.score = 0;
+        rightPaddle.score = 0;
+        leftPaddle.y = (float)(PANEL_RES_Y / 2 - leftPaddle.height / 2);
+        rightPaddle.y = (float)(PANEL_RES_Y / 2 - rightPaddle.height / 2);
+        
+        // Countdown on start, then serve to the right.
+        resetBall(+1);
+    }
+
+public:
+    PongGame() 
+        : leftPaddle(2, PANEL_RES_Y / 2 - 6, 1, 12, COLOR_GREEN),
+          rightPaddle(PANEL_RES_X - 3, PANEL_RES_Y / 2 - 6, 1, 12, COLOR_CYAN),
+          gameOver(false),
+          twoPlayer(false),
+          lastUpdate(0) {
+        resetBall(1);
+    }
+
+    ~PongGame() override {
+        if (netMode) globalNetPlay.endSession();
+    }
+
+    void start() override {
+        begin(/*tryLink=*/true);
+    }
+
+    void reset() override {
+        start();
+    }
+
+    void update(ControllerManager* input) override {
+        if (gameOver && !netMode) return;
+        
+        // Throttle updates for smooth gameplay
+        const unsigned long now = millis();
+        if (now - lastUpdate < UPDATE_INTERVAL_MS) return;
+        lastUpdate = now;
+
+        if (netMode) {
+            updateNet(input);
+            return;
+        }
+
+        const NetInput p1 = NetInput::sample(input->pad(0));
+        const NetInput p2 = twoPlayer ? NetInput::sample(input->pad(1)) : NetInput();
+        simulate((uint32_t)now, p1, p2);
+    }
+
+    // ------------------------------
+    // NetGame (linked play)
+    // ------------------------------
+    void netSaveState(uint8_t slot) override {
+        NetState& n = netSlots[slot];
+        n.leftY = leftPaddle.y;
+        n.rightY = rightPaddle.y;
+        n.leftScore = leftPaddle.score;
+        n.rightScore = rightPaddle.score;
+        n.ball = ball;
+        n.gameOver = gameOver;
+        n.phase = phase;
+        n.phaseStartMs = phaseStartMs;
+        n.lastPointWinner = lastPointWinner;
+        n.simFrame = simFrame;
+        n.endFrame = endFrame;
+        n.rng = rng;
+    }
+
+    void netLoadState(uint8_t slot) override {
+        const NetState& n = netSlots[slot];
+        leftPaddle.y = n.leftY;
+        rightPaddle.y = n.rightY;
+        leftPaddle.score = n.leftScore;
+        rightPaddle.score = n.rightScore;
+        ball = n.ball;
+        gameOver = n.gameOver;
+        phase = n.phase;
+        phaseStartMs = n.phaseStartMs;
+        lastPointWinner = n.lastPointWinner;
+        simFrame = n.simFrame;
+        endFrame = n.endFrame;
+        rng = n.rng;
+    }
+
+    void netStep(const NetInput in[2], bool isReplay) override {
+        replaying = isReplay;
+        const bool wasOver = gameOver;
+        simFrame++;
+        simulate(simFrame * UPDATE_INTERVAL_MS, in[0], in[1]);
+        if (gameOver && !wasOver) endFrame = simFrame - 1;
+        replaying = false;
+    }
+
+    uint32_t netChecksum() const override {
+        NetHash h;
+        h.f32(leftPaddle.y);
+        h.f32(rightPaddle.y);
+        h.u32((uint32_t)leftPaddle.score);
+        h.u32((uint32_t)rightPaddle.score);
+        h.f32(ball.x);
+        h.f32(ball.y);
+        h.f32(ball.vx);
+        h.f32(ball.vy);
+        h.u32(gameOver);
+        h.u32(phase);
+        h.u32(phaseStartMs);
+        h.u32(lastPointWinner);
+        h.u32(endFrame);
+        h.u32(rng.state);
+        return h.value;
+    }
+
     void draw(MatrixPanel_I2S_DMA* display) override {
         display->fillScreen(COLOR_BLACK);
+
+        if (netMode && !linkLost && !globalNetPlay.sessionRunning()) {
+            SmallFont::drawString(display, 14, 30, "WAIT PEER", COLOR_YELLOW);
+            const uint32_t waited = (uint32_t)(millis() - netWaitStartMs);
+            const uint32_t secsLeft = (waited < PongGameConfig::NET_PEER_WAIT_MS) ? (PongGameConfig::NET_PEER_WAIT_MS - waited + 999) / 1000 : 0;
+            SmallFont::drawStringF(display, 14, 40, COLOR_CYAN, "B SOLO %lu", (unsigned long)secsLeft);
+            return;
+        }
         
-        if (gameOver) {
+        if (isGameOver()) {
             // Standard leaderboard game-over view.
             char title[12];
-            if (leftPaddle.score >= 5) snprintf(title, sizeof(title), twoPlayer ? "P1 WINS" : "YOU WIN");
+            if (linkLost) snprintf(title, sizeof(title), "LINK LOST");
+            else if (netMode) {
+                const uint8_t winner = (leftPaddle.score >= 5) ? 0 : 1;
+                snprintf(title, sizeof(title), (winner == globalNetPlay.localSide()) ? "YOU WIN" : "YOU LOSE");
+            }
+            else if (leftPaddle.score >= 5) snprintf(title, sizeof(title), twoPlayer ? "P1 WINS" : "YOU WIN");
             else snprintf(title, sizeof(title), twoPlayer ? "P2 WINS" : "CPU WINS");
 
             char tag[4];
@@ -420,7 +576,7 @@ public:
         }
 
         if (phase == PHASE_COUNTDOWN) {
-            const uint32_t now = millis();
+            const uint32_t now = netMode ? simFrame * UPDATE_INTERVAL_MS : millis();
             const uint32_t elapsed = (uint32_t)(now - phaseStartMs);
             int secsLeft = 3 - (int)(elapsed / 1000UL);
             if (secsLeft < 1) secsLeft = 1;
@@ -437,13 +593,15 @@ public:
     }
 
     bool isGameOver() override {
-        return gameOver;
+        // Linked: a predicted game over only counts once no rollback can undo it.
+        if (!netMode || linkLost) return gameOver;
+        return gameOver && (int32_t)endFrame <= globalNetPlay.confirmedFrame();
     }
 
     // ------------------------------
     // Leaderboard integration
     // ------------------------------
-    bool leaderboardEnabled() const override { return true; }
+    bool leaderboardEnabled() const override { return !linkLost; }
     const char* leaderboardId() const override { return "pong"; }
     const char* leaderboardName() const override { return "Pong"; }
     uint32_t leaderboardScore() const override {
@@ -451,5 +609,18 @@ public:
         const int best = (leftPaddle.score > rightPaddle.score) ? leftPaddle.score : rightPaddle.score;
         return (best > 0) ? (uint32_t)best : 0u;
     }
+
+    // ------------------------------
+    // Self-check (DEBUG_INVARIANTS)
+    // ------------------------------
+    const char* checkInvariants() const override {
+        if (leftPaddle.score < 0 || leftPaddle.score > 5 || rightPaddle.score < 0 || rightPaddle.score > 5) return "score out of range";
+        if (!(leftPaddle.y >= 0.0f && leftPaddle.y <= (float)(PANEL_RES_Y - leftPaddle.height))) return "left paddle off the court";
+        if (!(rightPaddle.y >= 0.0f && rightPaddle.y <= (float)(PANEL_RES_Y - rightPaddle.height))) return "right paddle off the court";
+        if (!isfinite(ball.x) || !isfinite(ball.vx) || !isfinite(ball.vy)) return "ball state not finite";
+        // Wall bounces clamp the ball back inside every tick.
+        if (!(ball.y >= BALL_HALF && ball.y <= PANEL_RES_Y - BALL_HALF)) return "ball through a wall";
+        return nullptr;
+    }
 };
 
@@ -35,6 +35,12 @@ static constexpr int AI_ERROR_PX = 7;       // aim error range (+/-)
 static constexpr uint16_t POINT_FLASH_MS = 450;
 static constexpr uint16_t COUNTDOWN_MS = 3000;
 
+// Linked play (engine/NetPlay.h): both cabinets must agree on this id.
+static constexpr uint8_t NET_GAME_ID = 1;
+// "WAIT PEER": if the other cabinet doesn't start Pong within this time (or B
+// is pressed), play locally instead.
+static constexpr uint32_t NET_PEER_WAIT_MS = 10000;
+
 // Visual tables (currently empty placeholder)
 #include "PongGameSprites.h"
 
@@ -4,55 +4,28 @@
 #include "../../engine/GameBase.h"
 #include "../../engine/ControllerManager.h"
 #include "../../engine/config.h"
+#include "../../engine/Raster.h"
+#include "../../engine/Pixel565.h"
 #include "../../engine/AudioManager.h"
 #include "../../component/SmallFont.h"
 #include "../../engine/Settings.h"
 #include "../../engine/UserProfiles.h"
+#include "../../engine/Trace.h"
+#include "../../engine/QualityGovernor.h"
 #include "../../component/GameOverLeaderboardView.h"
 #include "ShooterGameConfig.h"
 #include "ShooterGameAudio.h"
+#include "ShooterGameScripts.h"
 
 /**
  * ShooterGame - Space shooter game
  * Player controls a ship at the bottom, shoots enemies from above
+ *
+ * Enemy waves and boss attack cadence are bytecode scripts
+ * (ShooterGameScripts.h), run by ShooterScript::Vm lanes each tick.
  */
-class ShooterGame : public GameBase {
+class ShooterGame : public GameBase, public ShooterScript::Host {
 private:
-    // ---------------------------------------------------------
-    // Analog / Trigger helpers (Bluepad32 API varies across versions/controllers)
-    // ---------------------------------------------------------
-    struct InputDetail {
-        template <typename T>
-        static auto axisX(T* c, int) -> decltype(c->axisX(), int16_t()) { return (int16_t)c->axisX(); }
-        template <typename T>
-        static int16_t axisX(T*, ...) { return 0; }
-
-        template <typename T>
-        static auto axisY(T* c, int) -> decltype(c->axisY(), int16_t()) { return (int16_t)c->axisY(); }
-        template <typename T>
-        static int16_t axisY(T*, ...) { return 0; }
-
-        template <typename T>
-        static auto throttle(T* c, int) -> decltype(c->throttle(), uint16_t()) { return (uint16_t)c->throttle(); }
-        template <typename T>
-        static uint16_t throttle(T*, ...) { return 0; }
-
-        template <typename T>
-        static auto r2(T* c, int) -> decltype(c->r2(), bool()) { return (bool)c->r2(); }
-        template <typename T>
-        static bool r2(T*, ...) { return false; }
-
-        template <typename T>
-        static auto btnX(T* c, int) -> decltype(c->x(), bool()) { return (bool)c->x(); }
-        template <typename T>
-        static bool btnX(T*, ...) { return false; }
-
-        template <typename T>
-        static auto btnY(T* c, int) -> decltype(c->y(), bool()) { return (bool)c->y(); }
-        template <typename T>
-        static bool btnY(T*, ...) { return false; }
-    };
-
     static inline float clampf(float v, float lo, float hi) { return (v < lo) ? lo : (v > hi) ? hi : v; }
     static inline float deadzone01(float v, float dz) {
         const float a = fabsf(v);
@@ -150,6 +123,7 @@ private:
         float vy;      // px per tick
         bool active;
         uint16_t color; // base color for head
+        uint16_t tail[3]; // pre-shaded tail (160/90/40 of color), set at spawn
         uint8_t dmg;    // damage dealt on hit
     };
 
@@ -195,11 +169,8 @@ private:
         uint8_t maxHp = 0;
         uint8_t shieldTier = 0;   // 0..10 (absorbs hits before HP)
         uint32_t shieldFlashUntilMs = 0;
-        uint32_t nextStarBurstMs = 0;
-        uint32_t nextRocketMs = 0;
     };
     Boss boss = {};
-    bool bossPending = false;         // threshold reached: stop spawning, wait for clear, then spawn boss
     uint8_t bossesDefeated = 0;       // difficulty scaling
 
     // Boss spawn pacing (requested):
@@ -267,6 +238,7 @@ private:
     Cloud cloudsNear[CLOUD_LAYER1_COUNT] = {};
     
     Ship player;
+    TileGfx::Palette shipPalette; // player.color pre-shaded in start()
 
     // Avoid heap churn: keep fixed-size pools for bullets and powerups.
     static constexpr int MAX_PLAYER_BULLETS = ShooterGameConfig::MAX_PLAYER_BULLETS;
@@ -292,9 +264,9 @@ private:
     static const int UPDATE_INTERVAL_MS = ShooterGameConfig::UPDATE_INTERVAL_MS;  // ~60 FPS
     static const int SHOT_COOLDOWN_MS = ShooterGameConfig::PLAYER_SHOT_COOLDOWN_MS;
 
-    // Continuous spawning
-    uint32_t lastSpawnMs = 0;
-    static constexpr uint32_t SPAWN_INTERVAL_MS = ShooterGameConfig::ENEMY_SPAWN_INTERVAL_MS;
+    // Scripted spawning / boss attacks (ShooterGameScripts.h)
+    ShooterScript::Vm waveScript;
+    ShooterScript::Vm bossLanes[2]; // star bursts, rockets
     uint32_t spawnPauseUntilMs = 0; // post-boss grace time to pick up loot
 
     // SFX throttling state
@@ -401,10 +373,12 @@ private:
 
     void spawnParticles(float x, float y, uint16_t color, uint8_t count, uint32_t now) {
         // Keep it modest: looks good on 64×64 without being too heavy.
-        const uint8_t tuned = max<uint8_t>(1, (uint8_t)(count / 2));
+        // Bursts and the live pool shrink with the quality level.
+        const uint8_t tuned = (uint8_t)globalQuality.scale(max<uint8_t>(1, (uint8_t)(count / 2)));
+        const int poolSize = globalQuality.scale(MAX_PARTICLES, MAX_PARTICLES / 4);
         for (uint8_t n = 0; n < tuned; n++) {
             int slot = -1;
-            for (int i = 0; i < MAX_PARTICLES; i++) {
+            for (int i = 0; i < poolSize; i++) {
                 if (!particles[i].active) { slot = i; break; }
             }
             if (slot < 0) return;
@@ -552,16 +526,8 @@ private:
         return (centerX + 1) + (idx - half);
     }
 
-    static inline uint16_t dimColor(MatrixPanel_I2S_DMA* d, uint16_t c, uint8_t mul /*0..255*/) {
-        // Approximate RGB565 dimming by scaling 5/6/5 channels.
-        uint8_t r = (uint8_t)((c >> 11) & 0x1F);
-        uint8_t g = (uint8_t)((c >> 5) & 0x3F);
-        uint8_t b = (uint8_t)(c & 0x1F);
-        r = (uint8_t)((r * mul) / 255);
-        g = (uint8_t)((g * mul) / 255);
-        b = (uint8_t)((b * mul) / 255);
-        return (uint16_t)((r << 11) | (g << 5) | b);
-    }
+    // Empty HP pip (enemies, boss).
+    static constexpr uint16_t HP_PIP_EMPTY = Pixel565::scale(COLOR_GREEN, 60);
 
     void clearBullets() {
         for (int i = 0; i < MAX_PLAYER_BULLETS; i++) playerBullets[i].active = false;
@@ -599,7 +565,7 @@ private:
         // (2s explosion + 1s pickup time)
         const uint32_t pauseUntil = now + (uint32_t)ShooterGameConfig::BOSS_DEATH_EXPLOSION_MS + (uint32_t)ShooterGameConfig::BOSS_LOOT_GRACE_MS;
         if ((int32_t)(pauseUntil - spawnPauseUntilMs) > 0) spawnPauseUntilMs = pauseUntil;
-        lastSpawnMs = now; // avoid "instant spawn" the frame the pause ends
+        for (auto& lane : bossLanes) lane.halt();
     }
 
     void drawBossDeathExplosion(MatrixPanel_I2S_DMA* display, uint32_t now) {
@@ -619,9 +585,9 @@ private:
 
         const bool flicker = ((now / 80) % 2) == 0;
         const uint16_t core = flicker ? COLOR_WHITE : COLOR_YELLOW;
-        display->drawCircle(cx, cy, r1, COLOR_ORANGE);
-        display->drawCircle(cx, cy, r2, COLOR_RED);
-        display->drawCircle(cx, cy, r3, COLOR_YELLOW);
+        Raster::circle(display, cx, cy, r1, COLOR_ORANGE);
+        Raster::circle(display, cx, cy, r2, COLOR_RED);
+        Raster::circle(display, cx, cy, r3, COLOR_YELLOW);
         display->drawPixel(cx, cy, core);
         display->drawPixel(cx + 1, cy, core);
         display->drawPixel(cx - 1, cy, core);
@@ -775,9 +741,9 @@ private:
 
         const bool flicker = ((now / 70) % 2) == 0;
         const uint16_t core = flicker ? COLOR_WHITE : COLOR_YELLOW;
-        display->drawCircle(cx, cy, r1, COLOR_ORANGE);
-        display->drawCircle(cx, cy, r2, COLOR_RED);
-        display->drawCircle(cx, cy, r3, COLOR_YELLOW);
+        Raster::circle(display, cx, cy, r1, COLOR_ORANGE);
+        Raster::circle(display, cx, cy, r2, COLOR_RED);
+        Raster::circle(display, cx, cy, r3, COLOR_YELLOW);
         display->drawPixel(cx, cy, core);
         display->drawPixel(cx + 1, cy, core);
         display->drawPixel(cx - 1, cy, core);
@@ -825,7 +791,9 @@ private:
         return c;
     }
     
-    void spawnEnemy(uint32_t now) {
+    // type: 0..3 or ShooterScript::ANY (random); xPos: pixel or ANY (random);
+    // hpOverride: 1..4, 0 = level-based roll.
+    void spawnEnemy(uint32_t now, uint8_t typeSel = ShooterScript::ANY, uint8_t xPos = ShooterScript::ANY, uint8_t hpOverride = 0) {
         // Find a free slot.
         int slot = -1;
         for (int i = 0; i < MAX_ENEMIES; i++) {
@@ -836,10 +804,12 @@ private:
         // Spawn behavior (requested):
         // Enemies should not "pop" into existence in the playfield. They enter from the top
         // (like bosses), drifting down into view.
-        const float x = (float)random(2, PANEL_RES_X - (int)ENEMY_W - 2);
+        const float x = (xPos == ShooterScript::ANY)
+            ? (float)random(2, PANEL_RES_X - (int)ENEMY_W - 2)
+            : (float)min((int)xPos, PANEL_RES_X - (int)ENEMY_W);
         const float y = -(float)ENEMY_H - (float)random(0, 12);
 
-        const int type = random(0, 4);
+        const int type = (typeSel == ShooterScript::ANY) ? (int)random(0, 4) : (int)typeSel;
         // Movement tuning:
         // - Mostly linear downward movement
         // - Slight side-to-side drift (2x vs previous)
@@ -859,6 +829,7 @@ private:
         if (lvl >= 3 && r < 25) hp = 2;
         if (lvl >= 6 && r < 18) hp = 3;
         if (lvl >= 10 && r < 12) hp = 4;
+        if (hpOverride > 0) hp = hpOverride;
         enemies[slot].hp = hp;
         enemies[slot].maxHp = hp;
 
@@ -888,28 +859,42 @@ private:
         boss.shieldTier = (uint8_t)constrain(baseShield, 1, 10);
         boss.shieldFlashUntilMs = 0;
 
-        // Attack cadence (gets faster over time).
-        const uint32_t starBase = ShooterGameConfig::BOSS_STAR_BASE_MS;
-        const uint32_t rocketBase = ShooterGameConfig::BOSS_ROCKET_BASE_MS;
-        const uint32_t dec = (uint32_t)min((int)ShooterGameConfig::BOSS_ATTACK_DEC_MAX, (int)bossesDefeated * (int)ShooterGameConfig::BOSS_ATTACK_DEC_PER_BOSS);
-        boss.nextStarBurstMs = now + (starBase - dec) + (uint32_t)random(0, 500);
-        boss.nextRocketMs = now + (rocketBase - dec) + (uint32_t)random(0, 800);
+        // Attack cadence (gets faster over time) is scripted per lane.
+        bossLanes[0].load(ShooterGameScripts::BOSS_STARS, sizeof(ShooterGameScripts::BOSS_STARS));
+        bossLanes[1].load(ShooterGameScripts::BOSS_ROCKETS, sizeof(ShooterGameScripts::BOSS_ROCKETS));
+        (void)now;
     }
 
-    void updateBossFlow(uint32_t now) {
-        // hits_until_boss model:
-        // - once we've accumulated enough total damage hits against normal enemies,
-        //   stop spawning and wait for the screen to clear, then spawn a boss.
-        if (!bossPending && !boss.active && !bossDeathActive && hitsThisLevel >= hitsUntilBoss) {
-            bossPending = true;
-        }
-        if (bossPending && !boss.active && !bossDeathActive) {
-            if (aliveEnemyCount() == 0) {
-                spawnBoss(now);
-            }
+    // ---------------------------------------------------------
+    // ShooterScript::Host (queries/actions for the wave + boss scripts)
+    // ---------------------------------------------------------
+    int targetEnemyCount() const {
+        return min(MAX_ENEMIES, 1 + (max(1, level) - 1) / 2); // 1,1,2,2,3,3...
+    }
+
+    bool scriptCond(uint8_t cond, uint8_t arg, uint32_t now) override {
+        switch (cond) {
+            case ShooterScript::C_HITS_REACHED: return hitsThisLevel >= hitsUntilBoss;
+            case ShooterScript::C_ALIVE_LT: return aliveEnemyCount() < ((arg == ShooterScript::ANY) ? targetEnemyCount() : (int)arg);
+            case ShooterScript::C_BOSS_DONE: return !boss.active && !bossDeathActive;
+            case ShooterScript::C_SPAWN_OK: return (int32_t)(spawnPauseUntilMs - now) <= 0;
+            case ShooterScript::C_LEVEL_GE: return level >= (int)arg;
+            case ShooterScript::C_BOSSES_GE: return bossesDefeated >= arg;
+            default: return false;
         }
     }
 
+    void scriptSpawn(uint8_t type, uint8_t x, uint8_t hp, uint32_t now) override { spawnEnemy(now, type, x, hp); }
+    void scriptBoss(uint32_t now) override { spawnBoss(now); }
+
+    void scriptFire(uint8_t pattern, uint32_t now) override {
+        if (!boss.active) return;
+        if (pattern == ShooterScript::P_STAR_BURST) bossFireStarBurst(now);
+        else if (pattern == ShooterScript::P_ROCKET) bossFireRocket(now);
+    }
+
+    uint8_t scriptDifficulty() override { return bossesDefeated; }
+
     void balanceBossDifficulty() {
         // Quick readability/fairness clamps for 64×64:
         // - Keep boss vertical band limited
@@ -961,6 +946,13 @@ private:
     static constexpr float POWERUP_BOUNCE = ShooterGameConfig::POWERUP_BOUNCE;
     static constexpr int POWERUP_SIZE_PX = ShooterGameConfig::POWERUP_SIZE_PX; // drawn as 2x2 box
 
+    static void setBulletColor(Bullet& b, uint16_t color) {
+        b.color = color;
+        b.tail[0] = Pixel565::scale(color, 160);
+        b.tail[1] = Pixel565::scale(color, 90);
+        b.tail[2] = Pixel565::scale(color, 40);
+    }
+
     void spawnPlayerBullet(int x, int y, uint16_t color, uint8_t dmg) {
         for (int i = 0; i < MAX_PLAYER_BULLETS; i++) {
             if (playerBullets[i].active) continue;
@@ -970,7 +962,7 @@ private:
             playerBullets[i].vx = 0.0f;
             playerBullets[i].vy = -ShooterGameConfig::PLAYER_BULLET_SPEED;
             // Color/damage are decided by the firing logic so we can support mixed-color spreads.
-            playerBullets[i].color = color;
+            setBulletColor(playerBullets[i], color);
             playerBullets[i].dmg = max<uint8_t>(1, dmg);
             return;
         }
@@ -992,7 +984,7 @@ private:
             const float s = ShooterGameConfig::ENEMY_BULLET_SPEED; // requested: 2x slower
             enemyBullets[i].vx = dx * inv * s;
             enemyBullets[i].vy = dy * inv * s;
-            enemyBullets[i].color = ShooterGameConfig::ENEMY_COLORS[type % 4];
+            setBulletColor(enemyBullets[i], ShooterGameConfig::ENEMY_COLORS[type % 4]);
             enemyBullets[i].dmg = 1;
             return;
         }
@@ -1078,20 +1070,8 @@ private:
         if (boss.x < 1) { boss.x = 1; boss.vx = fabsf(boss.vx); }
         if (boss.x > (float)(PANEL_RES_X - BOSS_W - 1)) { boss.x = (float)(PANEL_RES_X - BOSS_W - 1); boss.vx = -fabsf(boss.vx); }
 
-        // Attacks
-        if (now >= boss.nextStarBurstMs) {
-            bossFireStarBurst(now);
-            const uint32_t base = 2500;
-            const uint32_t dec = (uint32_t)min(1500, (int)bossesDefeated * 120);
-            boss.nextStarBurstMs = now + (base - dec) + (uint32_t)random(0, 650);
-        }
-        if (now >= boss.nextRocketMs) {
-            // First 5 bosses (bossesDefeated 0..4) do NOT fire rockets.
-        if (bossesDefeated >= ShooterGameConfig::BOSSES_WITHOUT_ROCKETS) bossFireRocket(now);
-            const uint32_t base = 3600;
-            const uint32_t dec = (uint32_t)min(2200, (int)bossesDefeated * 160);
-            boss.nextRocketMs = now + (base - dec) + (uint32_t)random(0, 900);
-        }
+        // Attacks (ShooterGameScripts::BOSS_STARS / BOSS_ROCKETS)
+        for (auto& lane : bossLanes) lane.run(*this, now, ShooterGameConfig::SCRIPT_OPS_PER_TICK);
     }
 
     void updateBossProjectiles(uint32_t now) {
@@ -1471,6 +1451,7 @@ private:
     }
 
     void handleCollisions(uint32_t now) {
+        TRACE_SCOPE("Shooter.handleCollisions");
         // ---------------------------------------------------------
         // Player guided rockets vs enemies/boss
         // ---------------------------------------------------------
@@ -1504,7 +1485,6 @@ private:
                     hitsThisLevel = 0;       // reset hits for the new level
                     hitsUntilBoss = (uint16_t)(9 + max(1, level)); // level1=10, level2=11, ...
                     boss.active = false;
-                    bossPending = false;
                     startBossDeath(now);
                 }
                 continue;
@@ -1579,7 +1559,6 @@ private:
                         hitsThisLevel = 0;       // reset hits for the new level
                         hitsUntilBoss = (uint16_t)(9 + max(1, level)); // level1=10, level2=11, ...
                         boss.active = false;
-                        bossPending = false;
                         startBossDeath(now);
                     }
                     break;
@@ -1804,24 +1783,19 @@ private:
         const int sy = exhaustDown ? 1 : -1;
 
         const int len = (int)ShooterGameConfig::THRUSTER_LEN_PX;
-        const float denom = (float)max(1, len - 1);
         for (int i = 1; i <= len; i++) {
             const int y = cy + sy * i;
 
-            // Fade from bright cyan to transparent (by skipping very dim pixels).
-            // d: 0 at first exhaust pixel, 1 at last exhaust pixel
-            const float d = (float)(i - 1) / denom;
-            float f = 1.0f - d;      // 1..0
-            f = f * f;               // faster fade than linear, but smoother than cubic
-            const uint8_t mul = (uint8_t)constrain((int)(255.0f * f), 0, 255);
-            if (mul < ShooterGameConfig::THRUSTER_MIN_MUL) continue; // transparent
+            // Fade from bright cyan to transparent (pre-shaded ramp, 0 = skipped).
+            const uint16_t c = ShooterGameConfig::THRUSTER_RAMP.c[i];
+            if (c == 0) continue;
 
             // 1px wide (requested)
             const int x = cx;
             if (x < 0 || x >= PANEL_RES_X || y < 0 || y >= PANEL_RES_Y) continue;
             if (x >= shipX && x < shipX + shipW && y >= shipY && y < shipY + shipH) continue;
 
-            display->drawPixel(x, y, dimColor(display, COLOR_CYAN, mul));
+            display->drawPixel(x, y, c);
         }
     }
 
@@ -1895,47 +1869,26 @@ private:
         );
     }
 
-    void drawCloudLayer(MatrixPanel_I2S_DMA* display, const Cloud* arr, int count, uint8_t mul) {
+    void drawCloudLayer(MatrixPanel_I2S_DMA* display, const Cloud* arr, int count, const TileGfx::Palette& palette) {
+        TRACE_SCOPE("Shooter.drawCloudLayer");
+        static constexpr TileGfx::SpriteSet cloudSet(ShooterGameConfig::CLOUD_RUNS);
         for (int i = 0; i < count; i++) {
             const Cloud& c = arr[i];
             if (!c.active) continue;
-            const int sx = (int)c.sprite;
-            const int w = (int)ShooterGameConfig::CLOUD_W[sx];
-            const int h = (int)ShooterGameConfig::CLOUD_H[sx];
-            const int x0 = (int)c.x;
-            const int y0 = (int)c.y;
-            for (int y = 0; y < h; y++) {
-                const int py = y0 + y;
-                if (py < 0 || py >= PANEL_RES_Y) continue;
-                for (int x = 0; x < w; x++) {
-                    const uint8_t v = ShooterGameConfig::CLOUD_SPRITES[sx][y][x] & 3;
-                    if (v == 0) continue;
-                    const int px = x0 + x;
-                    if (px < 0 || px >= PANEL_RES_X) continue;
-                    // Layer mul is the brightness for "3". Scale 1..3 accordingly.
-                    const uint8_t pmul = (uint8_t)((uint16_t)mul * (uint16_t)v / 3u);
-                    display->drawPixel(px, py, dimColor(display, COLOR_WHITE, pmul));
-                }
-            }
+            TileGfx::drawSprite(display, cloudSet, c.sprite, (int)c.x, (int)c.y, palette);
         }
     }
 
     void drawClouds(MatrixPanel_I2S_DMA* display) {
-        // Two-layer parallax: draw far first, then near.
-        drawCloudLayer(display, cloudsFar, CLOUD_LAYER0_COUNT, ShooterGameConfig::CLOUD_LAYER0_MUL);
-        drawCloudLayer(display, cloudsNear, CLOUD_LAYER1_COUNT, ShooterGameConfig::CLOUD_LAYER1_MUL);
+        // Two-layer parallax: draw far first, then near. The far layer thins out
+        // (down to none) at lower quality levels; its clouds keep moving regardless.
+        drawCloudLayer(display, cloudsFar, globalQuality.scale(CLOUD_LAYER0_COUNT, 0), ShooterGameConfig::CLOUD_PALETTES[0]);
+        drawCloudLayer(display, cloudsNear, CLOUD_LAYER1_COUNT, ShooterGameConfig::CLOUD_PALETTES[1]);
     }
 
-    void drawShip(MatrixPanel_I2S_DMA* display, int x, int y, uint16_t color, bool shield) {
-        static constexpr uint8_t MUL_LUT[4] = { 0, 80, 160, 255 };
-        for (int yy = 0; yy < SHIP_H; yy++) {
-            for (int xx = 0; xx < SHIP_W; xx++) {
-                const uint8_t v = ShooterGameConfig::SHIP_SPRITE[yy][xx] & 3;
-                if (v == 0) continue;
-                const uint16_t c = (v == 3) ? color : dimColor(display, color, MUL_LUT[v]);
-                display->drawPixel(x + xx, y + yy, c);
-            }
-        }
+    void drawShip(MatrixPanel_I2S_DMA* display, int x, int y, bool shield) {
+        static constexpr TileGfx::SpriteSet shipSet(ShooterGameConfig::SHIP_RUNS);
+        TileGfx::drawSprite(display, shipSet, 0, x, y, shipPalette);
 
         // Center pixel "magnetism" indicator (requested):
         // User removed the ship center pixel from the sprite; we use it as a white
@@ -1948,7 +1901,7 @@ private:
                 const uint8_t baseMul = (uint8_t)map((int)tier, 1, (int)ShooterGameConfig::CYAN_TIER_MAX, 70, 255);
                 const bool pulse = ((now / 180) % 2) == 0;
                 const uint8_t mul = pulse ? baseMul : (uint8_t)max(40, (int)baseMul - 55);
-                display->drawPixel(x + 2, y + 2, dimColor(display, COLOR_WHITE, mul));
+                display->drawPixel(x + 2, y + 2, Pixel565::scale(COLOR_WHITE, mul));
             }
         }
 
@@ -1997,26 +1950,18 @@ private:
             // Slower flicker
             const bool flicker = ((now / 320) % 2) == 0;
             uint16_t c = COLOR_CYAN;
-            if (!flash && flicker) c = dimColor(display, COLOR_CYAN, 200);
+            if (!flash && flicker) c = Pixel565::scale(COLOR_CYAN, 200);
             if (flash) c = COLOR_RED;
 
             const int cx = x + 2;
             const int cy = y + 2;
-            display->drawCircle(cx, cy, r, c);
+            Raster::circle(display, cx, cy, r, c);
         }
     }
 
     void drawEnemy(MatrixPanel_I2S_DMA* display, int x, int y, int type) {
-        static constexpr uint8_t MUL_LUT[4] = { 0, 80, 160, 255 };
-        const uint16_t c = ShooterGameConfig::ENEMY_COLORS[type & 3];
-        for (int yy = 0; yy < ENEMY_H; yy++) {
-            for (int xx = 0; xx < ENEMY_W; xx++) {
-                const uint8_t v = ShooterGameConfig::ENEMY_SPRITES[type & 3][yy][xx] & 3;
-                if (v == 0) continue;
-                const uint16_t col = (v == 3) ? c : dimColor(display, c, MUL_LUT[v]);
-                display->drawPixel(x + xx, y + yy, col);
-            }
-        }
+        static constexpr TileGfx::SpriteSet enemySet(ShooterGameConfig::ENEMY_RUNS);
+        TileGfx::drawSprite(display, enemySet, (uint8_t)(type & 3), x, y, ShooterGameConfig::ENEMY_PALETTES[type & 3]);
 
         // Enemy HP pips: 4 pixels at the top of the enemy (above sprite if possible).
         // Stronger enemies (2..4 hp) show more pips.
@@ -2043,7 +1988,7 @@ private:
             for (uint8_t i = 0; i < maxHp; i++) {
                 const int px = centeredPipXWithGap(cx, (int)maxHp, (int)i);
                 if (px < 0 || px >= PANEL_RES_X) continue;
-                const uint16_t col = (i < hp) ? COLOR_GREEN : dimColor(display, COLOR_GREEN, 60);
+                const uint16_t col = (i < hp) ? COLOR_GREEN : HP_PIP_EMPTY;
                 display->drawPixel(px, dotY, col);
             }
         }
@@ -2051,25 +1996,17 @@ private:
 
     void drawBoss(MatrixPanel_I2S_DMA* display, uint32_t now) {
         if (!boss.active) return;
-        static constexpr uint8_t MUL_LUT[4] = { 0, 80, 160, 255 };
+        static constexpr TileGfx::SpriteSet bossSet(ShooterGameConfig::BOSS_RUNS);
         const int x0 = (int)boss.x;
         const int y0 = (int)boss.y;
         // Boss faces DOWN, so exhaust goes UP. Always on while boss is active.
         drawThrusterBack(display, x0, y0, BOSS_W, BOSS_H, false, true, now);
-        const uint16_t baseCol = ShooterGameConfig::BOSS_COLORS[boss.type % 5];
 
         // Shield flash when hit.
         const bool flash = ((int32_t)(boss.shieldFlashUntilMs - now) > 0);
-        const uint16_t col = flash ? COLOR_WHITE : baseCol;
-
-        for (int y = 0; y < BOSS_H; y++) {
-            for (int x = 0; x < BOSS_W; x++) {
-                const uint8_t v = ShooterGameConfig::BOSS_SPRITES[boss.type % 5][y][x] & 3;
-                if (v == 0) continue;
-                const uint16_t col2 = (v == 3) ? col : dimColor(display, col, MUL_LUT[v]);
-                display->drawPixel(x0 + x, y0 + y, col2);
-            }
-        }
+        const TileGfx::Palette& pal =
+            flash ? ShooterGameConfig::BOSS_FLASH_PALETTE : ShooterGameConfig::BOSS_PALETTES[boss.type % 5];
+        TileGfx::drawSprite(display, bossSet, (uint8_t)(boss.type % 5), x0, y0, pal);
 
         // Boss shield ring (10 tiers max).
         if (boss.shieldTier > 0) {
@@ -2078,9 +2015,9 @@ private:
             const int r = 6 + (int)min<uint8_t>(4, (uint8_t)(boss.shieldTier / 2)); // 6..10
             const bool flicker = ((now / 220) % 2) == 0;
             uint16_t sc = COLOR_CYAN;
-            if (!flash && flicker) sc = dimColor(display, COLOR_CYAN, 180);
+            if (!flash && flicker) sc = Pixel565::scale(COLOR_CYAN, 180);
             if (flash) sc = COLOR_RED;
-            display->drawCircle(cx, cy, r, sc);
+            Raster::circle(display, cx, cy, r, sc);
         }
 
         // Lives behind the boss (same style concept as the player):
@@ -2091,7 +2028,7 @@ private:
             const int maxHp = (int)boss.maxHp;
             const int startX = cxp - (maxHp - 1) / 2;
             for (int i = 0; i < maxHp; i++) {
-                const uint16_t c = (i < (int)boss.hp) ? COLOR_GREEN : dimColor(display, COLOR_GREEN, 60);
+                const uint16_t c = (i < (int)boss.hp) ? COLOR_GREEN : HP_PIP_EMPTY;
                 display->drawPixel(startX + i, py, c);
             }
         }
@@ -2164,9 +2101,6 @@ private:
     void drawBullet(MatrixPanel_I2S_DMA* display, const Bullet& b, bool playerUp) {
         // Fading tail along velocity (straight trajectory; enemy shots can be angled now).
         const uint16_t head = b.color;
-        const uint16_t mid = dimColor(display, b.color, 160);
-        const uint16_t tail = dimColor(display, b.color, 90);
-        const uint16_t tail2 = dimColor(display, b.color, 40);
 
         const int hx = (int)b.x;
         const int hy = (int)b.y;
@@ -2190,34 +2124,16 @@ private:
             const int tx = (int)roundf((float)hx - ux * (float)i);
             const int ty = (int)roundf((float)hy - uy * (float)i);
             if (tx < 0 || tx >= PANEL_RES_X || ty < 0 || ty >= PANEL_RES_Y) continue;
-            const uint16_t c = (i == 1) ? mid : (i == 2) ? tail : tail2;
+            const uint16_t c = b.tail[(i < 3) ? i - 1 : 2];
             display->drawPixel(tx, ty, c);
         }
     }
 
     void drawPowerup(MatrixPanel_I2S_DMA* display, int x, int y, uint8_t type) {
-        const uint16_t c =
-            (type == ShooterGameConfig::POWERUP_SHIELD_BLUE) ? COLOR_BLUE :
-            (type == ShooterGameConfig::POWERUP_WEAPON_RED) ? COLOR_RED :
-            (type == ShooterGameConfig::POWERUP_LIFE_GREEN) ? COLOR_GREEN :
-            (type == ShooterGameConfig::POWERUP_ROCKET_PURPLE) ? COLOR_PURPLE :
-            (type == ShooterGameConfig::POWERUP_POINTS_YELLOW) ? COLOR_YELLOW :
-            (type == ShooterGameConfig::POWERUP_FUN_CYAN) ? COLOR_CYAN :
-            COLOR_WHITE;
         // Render from sprite table so visuals are tweakable in `ShooterGameSprites.h`.
+        static constexpr TileGfx::SpriteSet powerupSet(ShooterGameConfig::POWERUP_RUNS);
         const uint8_t t = (uint8_t)min<int>((int)ShooterGameConfig::POWERUP_TYPE_COUNT - 1, (int)type);
-        static constexpr uint8_t MUL_LUT[4] = { 0, 90, 170, 255 };
-        for (int yy = 0; yy < POWERUP_SIZE_PX; yy++) {
-            const int py = y + yy;
-            if (py < 0 || py >= PANEL_RES_Y) continue;
-            for (int xx = 0; xx < POWERUP_SIZE_PX; xx++) {
-                const int px = x + xx;
-                if (px < 0 || px >= PANEL_RES_X) continue;
-                const uint8_t v = ShooterGameConfig::POWERUP_SPRITES[t][yy][xx] & 3u;
-                if (v == 0) continue;
-                display->drawPixel(px, py, dimColor(display, c, MUL_LUT[v]));
-            }
-        }
+        TileGfx::drawSprite(display, powerupSet, t, x, y, ShooterGameConfig::POWERUP_PALETTES[t]);
     }
 
     void drawHudStatus(MatrixPanel_I2S_DMA* display) {
@@ -2252,8 +2168,6 @@ public:
         weaponTier = 0;
         cyanUntilMs = 0;
         cyanTier = 0;
-        // Prevent immediate spawn bursts based on uptime.
-        lastSpawnMs = (uint32_t)lastUpdate;
         invulnUntilMs = 0;
         shieldHitFlashUntilMs = 0;
         clearBullets();
@@ -2262,7 +2176,8 @@ public:
         clearBossProjectiles();
         boss.active = false;
         bossesDefeated = 0;
-        bossPending = false;
+        waveScript.load(ShooterGameScripts::WAVE, sizeof(ShooterGameScripts::WAVE));
+        for (auto& lane : bossLanes) lane.halt();
         level = 1;
         hitsThisLevel = 0;
         hitsUntilBoss = ShooterGameConfig::BOSS_HITS_BASE;
@@ -2275,6 +2190,7 @@ public:
         
         // Apply current global player color (chosen in the main menu).
         player.color = globalSettings.getPlayerColor();
+        shipPalette = TileGfx::Palette(player.color, ShooterGameConfig::SPRITE_MUL1, ShooterGameConfig::SPRITE_MUL2, 255);
 
         // Start game intro sting (RTTTL). AudioManager will no-op if Sound is OFF.
         // Not looping: this is only a short "first few notes" cue.
@@ -2342,13 +2258,13 @@ public:
         }
         
         // Update player position
-        ControllerPtr p1 = input->getController(0);
-        if (p1 && p1->isConnected()) {
+        const PadState& p1 = input->pad(0);
+        if (p1.connected) {
             // -----------------------------------------------------
             // Dev cheat input: YYYXXX (edge-based), disables leaderboard.
             // -----------------------------------------------------
-            const bool xNow = InputDetail::btnX(p1, 0);
-            const bool yNow = InputDetail::btnY(p1, 0);
+            const bool xNow = p1.held(PadState::BTN_X);
+            const bool yNow = p1.held(PadState::BTN_Y);
             const bool xEdge = xNow && !lastXBtn;
             const bool yEdge = yNow && !lastYBtn;
             lastXBtn = xNow;
@@ -2400,17 +2316,17 @@ public:
             if (yEdge) feedCheat('Y');
             if (xEdge) feedCheat('X');
 
-            const float rawX = clampf((float)InputDetail::axisX(p1, 0) / (float)AXIS_DIVISOR, -1.0f, 1.0f);
-            const float rawY = clampf((float)InputDetail::axisY(p1, 0) / (float)AXIS_DIVISOR, -1.0f, 1.0f);
+            const float rawX = clampf((float)p1.axisX / (float)AXIS_DIVISOR, -1.0f, 1.0f);
+            const float rawY = clampf((float)p1.axisY / (float)AXIS_DIVISOR, -1.0f, 1.0f);
             float sx = deadzone01(rawX, STICK_DEADZONE);
             float sy = deadzone01(rawY, STICK_DEADZONE);
             if (sx == 0.0f) {
-                const uint8_t dpad = p1->dpad();
+                const uint8_t dpad = p1.dpad;
                 if (dpad & 0x08) sx = -1.0f;
                 else if (dpad & 0x04) sx = 1.0f;
             }
             if (sy == 0.0f) {
-                const uint8_t dpad = p1->dpad();
+                const uint8_t dpad = p1.dpad;
                 // D-pad up/down fallback for vertical motion
                 if (dpad & 0x01) sy = -1.0f;
                 else if (dpad & 0x02) sy = 1.0f;
@@ -2446,8 +2362,7 @@ public:
             if (player.y > maxY) { player.y = maxY; player.vy = 0.0f; }
             
             // Shoot with right trigger (fallback to A)
-            const uint16_t rt = InputDetail::throttle(p1, 0);
-            const bool shoot = (rt >= TRIGGER_THRESHOLD) || InputDetail::r2(p1, 0) || p1->a();
+            const bool shoot = (p1.throttle >= TRIGGER_THRESHOLD) || p1.held(PadState::BTN_R2 | PadState::BTN_A);
             uint32_t shotCooldown = (uint32_t)SHOT_COOLDOWN_MS;
             if (ShooterGameConfig::CYAN_POWERUP_KIND == 2 && (int32_t)(cyanUntilMs - (uint32_t)now) > 0) {
                 shotCooldown = max<uint32_t>(60u, shotCooldown / 2u);
@@ -2498,7 +2413,7 @@ public:
             }
 
             // Fire guided missile (B) if we have rocket ammo (purple powerup).
-            if (p1->b() && rocketAmmo > 0 && phase == PHASE_PLAYING && (uint32_t)(now - lastRocketFireMs) > ROCKET_COOLDOWN_MS) {
+            if (p1.held(PadState::BTN_B) && rocketAmmo > 0 && phase == PHASE_PLAYING && (uint32_t)(now - lastRocketFireMs) > ROCKET_COOLDOWN_MS) {
                 const float rx = player.x + 2.0f;         // center-ish
                 const float ry = (float)((int)player.y) - 1.0f;  // launch just above ship
                 spawnPlayerRocket(rx, ry, (uint32_t)now);
@@ -2517,24 +2432,16 @@ public:
 
         if (phase != PHASE_PLAYING) return;
 
-        // Boss flow: hits_until_boss -> stop spawning, wait for clear, then spawn boss.
+        // Waves + boss flow (hits_until_boss -> stop spawning, wait for clear,
+        // then spawn boss) are scripted: ShooterGameScripts::WAVE.
         balanceBossDifficulty();
-        updateBossFlow((uint32_t)now);
+        waveScript.run(*this, (uint32_t)now, ShooterGameConfig::SCRIPT_OPS_PER_TICK);
         updateBoss((uint32_t)now);
         updateBossProjectiles((uint32_t)now);
         updatePlayerRockets((uint32_t)now);
         maybeApplyBossDeathExplosionDamage((uint32_t)now);
         updateBossDeath((uint32_t)now);
 
-        // Continuous spawning (requested): start with 1 enemy, increase slowly with level.
-        const bool spawningPaused = bossPending || boss.active || bossDeathActive || ((int32_t)(spawnPauseUntilMs - (uint32_t)now) > 0);
-        const int target = min(MAX_ENEMIES, 1 + (max(1, level) - 1) / 2); // 1,1,2,2,3,3...
-        if (!spawningPaused &&
-            (uint32_t)(now - lastSpawnMs) >= SPAWN_INTERVAL_MS && aliveEnemyCount() < target) {
-            lastSpawnMs = (uint32_t)now;
-            spawnEnemy((uint32_t)now);
-        }
-
         updateBulletsAndPowerups((uint32_t)now);
         updateEnemiesAndEnemyFire((uint32_t)now);
         handleCollisions((uint32_t)now);
@@ -2555,7 +2462,7 @@ public:
             SmallFont::drawStringF(display, 2, 6, COLOR_YELLOW, "S:%d", score);
             SmallFont::drawStringF(display, 38, 6, COLOR_WHITE, "W:%d", level);
             drawHudStatus(display);
-            for (int x = 0; x < PANEL_RES_X; x += 2) display->drawPixel(x, HUD_H - 1, COLOR_BLUE);
+            Raster::dashedHLine(display, 0, HUD_H - 1, PANEL_RES_X, COLOR_BLUE);
 
             // Render frozen entities
             for (int i = 0; i < MAX_ENEMIES; i++) if (enemies[i].alive) drawEnemy(display, enemies[i]);
@@ -2565,7 +2472,7 @@ public:
             // Player faces UP, so exhaust goes DOWN. Only on while "thrusters" are engaged.
             const bool thrOn = (fabsf(player.vx) > ShooterGameConfig::PLAYER_DRIFT_STOP_EPS) || (fabsf(player.vy) > ShooterGameConfig::PLAYER_DRIFT_STOP_EPS);
             drawThrusterBack(display, (int)player.x, (int)player.y, SHIP_W, SHIP_H, true, thrOn, now);
-            drawShip(display, (int)player.x, (int)player.y, player.color, ((int32_t)(shieldUntilMs - now) > 0));
+            drawShip(display, (int)player.x, (int)player.y, ((int32_t)(shieldUntilMs - now) > 0));
             drawExplosions(display, now);
             drawParticles(display, now);
             drawPlayerDeathExplosion(display, now);
@@ -2587,7 +2494,7 @@ public:
         SmallFont::drawStringF(display, 2, 6, COLOR_YELLOW, "S:%d", score);
         SmallFont::drawStringF(display, 38, 6, COLOR_WHITE, "W:%d", level);
         drawHudStatus(display);
-        for (int x = 0; x < PANEL_RES_X; x += 2) display->drawPixel(x, HUD_H - 1, COLOR_BLUE);
+        Raster::dashedHLine(display, 0, HUD_H - 1, PANEL_RES_X, COLOR_BLUE);
 
         if (phase == PHASE_COUNTDOWN) {
             const uint32_t now = millis();
@@ -2600,7 +2507,7 @@ public:
             // Player faces UP, so exhaust goes DOWN. Only on while "thrusters" are engaged.
             const bool thrOn = (fabsf(player.vx) > ShooterGameConfig::PLAYER_DRIFT_STOP_EPS) || (fabsf(player.vy) > ShooterGameConfig::PLAYER_DRIFT_STOP_EPS);
             drawThrusterBack(display, (int)player.x, (int)player.y, SHIP_W, SHIP_H, true, thrOn, now);
-            drawShip(display, (int)player.x, (int)player.y, player.color, ((int32_t)(shieldUntilMs - now) > 0));
+            drawShip(display, (int)player.x, (int)player.y, ((int32_t)(shieldUntilMs - now) > 0));
             return;
         }
 
@@ -2630,7 +2537,7 @@ public:
         // Player faces UP, so exhaust goes DOWN. Only on while "thrusters" are engaged.
         const bool thrOn = (fabsf(player.vx) > ShooterGameConfig::PLAYER_DRIFT_STOP_EPS) || (fabsf(player.vy) > ShooterGameConfig::PLAYER_DRIFT_STOP_EPS);
         drawThrusterBack(display, (int)player.x, (int)player.y, SHIP_W, SHIP_H, true, thrOn, now);
-        drawShip(display, (int)player.x, (int)player.y, player.color, ((int32_t)(shieldUntilMs - (uint32_t)millis()) > 0));
+        drawShip(display, (int)player.x, (int)player.y, ((int32_t)(shieldUntilMs - (uint32_t)millis()) > 0));
 
         // Explosions overlay
         drawExplosions(display, now);
@@ -2652,5 +2559,25 @@ public:
         if (devCheatUsed) return 0u;
         return (score > 0) ? (uint32_t)score : 0u;
     }
+
+    // ------------------------------
+    // Self-check (DEBUG_INVARIANTS)
+    // ------------------------------
+    const char* checkInvariants() const override {
+        if (lives < 0 || lives > (int)ShooterGameConfig::PLAYER_MAX_LIVES) return "lives out of range";
+        if (rocketAmmo > ShooterGameConfig::PLAYER_MAX_ROCKET_AMMO) return "rocket ammo above max";
+        if (shieldTier > 10 || weaponTier > 5 || cyanTier > ShooterGameConfig::CYAN_TIER_MAX) return "power-up tier out of range";
+        // Movement clamps the ship into the playfield below the HUD band.
+        if (!(player.x >= 0.0f && player.x <= (float)(PANEL_RES_X - SHIP_W))) return "ship off the playfield";
+        if (!(player.y >= (float)(HUD_H + 1) && player.y <= (float)(PANEL_RES_Y - SHIP_H))) return "ship off the playfield";
+        for (int i = 0; i < MAX_ENEMIES; i++) {
+            const Enemy& e = enemies[i];
+            if (!e.alive) continue;
+            if (e.type < 0 || e.type > 3) return "enemy type out of range";
+            if (e.hp == 0 || e.hp > e.maxHp) return "live enemy hp out of range";
+        }
+        if (boss.active && (boss.type > 4 || boss.hp > boss.maxHp || boss.shieldTier > 10)) return "boss state out of range";
+        return nullptr;
+    }
 };
 
@@ -17,6 +17,7 @@
 
 #include <Arduino.h>
 #include "../../engine/config.h"
+#include "../../engine/TileLayer.h"
 
 namespace ShooterGameConfig {
 
@@ -124,6 +125,10 @@ static constexpr uint16_t BOSS_HITS_BASE = 10;  // level 1 => 10
 // Lower = faster spawns.
 static constexpr uint16_t ENEMY_SPAWN_INTERVAL_MS = 450;
 
+// Wave/boss scripts (ShooterGameScripts.h): max bytecode instructions each
+// script lane may execute per update tick.
+static constexpr uint8_t SCRIPT_OPS_PER_TICK = 16;
+
 // -----------------------------------------------------------------------------
 // Audio (buzzer) - SFX throttling
 // -----------------------------------------------------------------------------
@@ -223,11 +228,28 @@ static constexpr uint8_t DROP_W_WHITE  = WHITE_DROP_WEIGHT;
 // Boss stops in the top half at HUD_H + BOSS_STOP_Y_OFFSET.
 static constexpr uint8_t BOSS_STOP_Y_OFFSET = 14;
 
-// Boss attacks
+// Boss attacks (ShooterGameScripts.h). The first volley of a lane waits
+// *_BASE_MS minus BOSS_ATTACK_DEC_PER_BOSS per boss defeated (at most
+// BOSS_ATTACK_DEC_MAX) plus up to *_FIRST_JITTER_MS; after that the lane
+// repeats every *_REPEAT_MS, shortened the same way by its own DEC/DEC_MAX.
 static constexpr uint16_t BOSS_STAR_BASE_MS = 2600;
 static constexpr uint16_t BOSS_ROCKET_BASE_MS = 3800;
 static constexpr uint16_t BOSS_ATTACK_DEC_PER_BOSS = 140;
 static constexpr uint16_t BOSS_ATTACK_DEC_MAX = 1600;
+static constexpr uint16_t BOSS_STAR_FIRST_JITTER_MS = 500;
+static constexpr uint16_t BOSS_ROCKET_FIRST_JITTER_MS = 800;
+
+// Star bursts: 2.5 s apart, down to 1.0 s.
+static constexpr uint16_t BOSS_STAR_REPEAT_MS = 2500;
+static constexpr uint8_t BOSS_STAR_REPEAT_DEC_PER_BOSS = 120;
+static constexpr uint16_t BOSS_STAR_REPEAT_DEC_MAX = 1500;
+static constexpr uint16_t BOSS_STAR_REPEAT_JITTER_MS = 650;
+
+// Rockets: 3.6 s apart, down to 1.4 s.
+static constexpr uint16_t BOSS_ROCKET_REPEAT_MS = 3600;
+static constexpr uint8_t BOSS_ROCKET_REPEAT_DEC_PER_BOSS = 160;
+static constexpr uint16_t BOSS_ROCKET_REPEAT_DEC_MAX = 2200;
+static constexpr uint16_t BOSS_ROCKET_REPEAT_JITTER_MS = 900;
 
 // Disable boss rockets for the first N bosses.
 static constexpr uint8_t BOSSES_WITHOUT_ROCKETS = 5;
@@ -0,0 +1,75 @@
+// ShooterGameScripts.h
+// -----------------------------------------------------------------------------
+// Wave and boss attack scripts for ShooterGame (see ShooterScript.h for the
+// instruction set). Tuning lives here as data; new stages are new tables, not
+// new C++.
+//
+// Label ids are local to each script.
+// -----------------------------------------------------------------------------
+#pragma once
+
+#include "ShooterScript.h"
+#include "ShooterGameConfig.h"
+
+namespace ShooterGameScripts {
+
+using namespace ShooterScript;
+namespace Cfg = ShooterGameConfig;
+
+// -----------------------------------------------------------------------------
+// Main wave loop (hits_until_boss model)
+// -----------------------------------------------------------------------------
+// Keep the level's target number of enemies on screen, one spawn per
+// ENEMY_SPAWN_INTERVAL_MS. Once enough hits have landed: stop spawning, wait for
+// the screen to clear, send in the boss and wait for its death sequence.
+enum : uint8_t { WAVE_TOP, WAVE_IDLE, WAVE_BOSS };
+static constexpr uint8_t WAVE[] = {
+    SS_LABEL(WAVE_TOP),
+    SS_BRANCH(C_HITS_REACHED, 0, WAVE_BOSS),
+    SS_BRANCH(NOT | C_SPAWN_OK, 0, WAVE_IDLE),
+    SS_BRANCH(NOT | C_ALIVE_LT, SS_ANY, WAVE_IDLE),
+    SS_SPAWN(SS_ANY, SS_ANY, 0),
+    SS_WAIT(Cfg::ENEMY_SPAWN_INTERVAL_MS),
+    SS_JUMP(WAVE_TOP),
+
+    SS_LABEL(WAVE_IDLE),
+    SS_WAIT(0),
+    SS_JUMP(WAVE_TOP),
+
+    SS_LABEL(WAVE_BOSS),
+    SS_WAIT_UNTIL(C_ALIVE_LT, 1),
+    SS_BOSS(),
+    SS_WAIT_UNTIL(C_BOSS_DONE, 0),
+    SS_JUMP(WAVE_TOP),
+};
+static_assert(validate(WAVE, sizeof(WAVE)), "ShooterGameScripts::WAVE is malformed");
+
+// -----------------------------------------------------------------------------
+// Boss attack lanes (one VM each, started by spawnBoss)
+// -----------------------------------------------------------------------------
+// Cadence shrinks with bosses defeated (WAIT_SCALED difficulty).
+enum : uint8_t { LANE_LOOP, LANE_SKIP };
+
+// Slow 12-way star bursts.
+static constexpr uint8_t BOSS_STARS[] = {
+    SS_WAIT_SCALED(Cfg::BOSS_STAR_BASE_MS, Cfg::BOSS_ATTACK_DEC_PER_BOSS, Cfg::BOSS_ATTACK_DEC_MAX, Cfg::BOSS_STAR_FIRST_JITTER_MS),
+    SS_LABEL(LANE_LOOP),
+    SS_FIRE(P_STAR_BURST),
+    SS_WAIT_SCALED(Cfg::BOSS_STAR_REPEAT_MS, Cfg::BOSS_STAR_REPEAT_DEC_PER_BOSS, Cfg::BOSS_STAR_REPEAT_DEC_MAX, Cfg::BOSS_STAR_REPEAT_JITTER_MS),
+    SS_JUMP(LANE_LOOP),
+};
+static_assert(validate(BOSS_STARS, sizeof(BOSS_STARS)), "ShooterGameScripts::BOSS_STARS is malformed");
+
+// Homing rockets, only once the first few bosses are down.
+static constexpr uint8_t BOSS_ROCKETS[] = {
+    SS_WAIT_SCALED(Cfg::BOSS_ROCKET_BASE_MS, Cfg::BOSS_ATTACK_DEC_PER_BOSS, Cfg::BOSS_ATTACK_DEC_MAX, Cfg::BOSS_ROCKET_FIRST_JITTER_MS),
+    SS_LABEL(LANE_LOOP),
+    SS_BRANCH(NOT | C_BOSSES_GE, Cfg::BOSSES_WITHOUT_ROCKETS, LANE_SKIP),
+    SS_FIRE(P_ROCKET),
+    SS_LABEL(LANE_SKIP),
+    SS_WAIT_SCALED(Cfg::BOSS_ROCKET_REPEAT_MS, Cfg::BOSS_ROCKET_REPEAT_DEC_PER_BOSS, Cfg::BOSS_ROCKET_REPEAT_DEC_MAX, Cfg::BOSS_ROCKET_REPEAT_JITTER_MS),
+    SS_JUMP(LANE_LOOP),
+};
+static_assert(validate(BOSS_ROCKETS, sizeof(BOSS_ROCKETS)), "ShooterGameScripts::BOSS_ROCKETS is malformed");
+
+} // namespace ShooterGameScripts
@@ -11,6 +11,7 @@
 #pragma once
 
 #include "../../engine/config.h" // COLOR_* constants
+#include "../../engine/TileLayer.h"
 #include <Arduino.h>
 
 // -----------------------------------------------------------------------------
@@ -107,6 +108,17 @@ static inline constexpr uint8_t CLOUD_SPRITES[CLOUD_SPRITE_COUNT][CLOUD_SPRITE_M
     },
 };
 
+// Same bitmaps as runs for TileGfx::drawSprite (brightness = palette index).
+static inline constexpr int CLOUD_RUN_COUNT = TileGfx::countRuns(CLOUD_SPRITES);
+static inline constexpr TileGfx::SpriteRuns<CLOUD_SPRITE_COUNT, CLOUD_SPRITE_MAX_H, CLOUD_SPRITE_MAX_W, CLOUD_RUN_COUNT>
+    CLOUD_RUNS(CLOUD_SPRITES);
+
+// Pre-shaded white per layer: the layer mul is the brightness of "3", 1..2 scale down from it.
+static inline constexpr TileGfx::Palette CLOUD_PALETTES[2] = {
+    TileGfx::Palette(COLOR_WHITE, CLOUD_LAYER0_MUL / 3, CLOUD_LAYER0_MUL * 2 / 3, CLOUD_LAYER0_MUL),
+    TileGfx::Palette(COLOR_WHITE, CLOUD_LAYER1_MUL / 3, CLOUD_LAYER1_MUL * 2 / 3, CLOUD_LAYER1_MUL),
+};
+
 // -----------------------------------------------------------------------------
 // Powerup "lootbox" sprites (0..3 brightness maps)
 // -----------------------------------------------------------------------------
@@ -149,6 +161,21 @@ static inline constexpr uint8_t POWERUP_SPRITES[POWERUP_TYPE_COUNT][POWERUP_SIZE
       {3, 3} },
 };
 
+static inline constexpr int POWERUP_RUN_COUNT = TileGfx::countRuns(POWERUP_SPRITES);
+static inline constexpr TileGfx::SpriteRuns<POWERUP_TYPE_COUNT, POWERUP_SIZE_PX, POWERUP_SIZE_PX, POWERUP_RUN_COUNT>
+    POWERUP_RUNS(POWERUP_SPRITES);
+
+// Indexed by powerup type (same order as POWERUP_* in ShooterGameConfig.h).
+static inline constexpr TileGfx::Palette POWERUP_PALETTES[POWERUP_TYPE_COUNT] = {
+    TileGfx::Palette(COLOR_BLUE, 90, 170, 255),
+    TileGfx::Palette(COLOR_RED, 90, 170, 255),
+    TileGfx::Palette(COLOR_GREEN, 90, 170, 255),
+    TileGfx::Palette(COLOR_PURPLE, 90, 170, 255),
+    TileGfx::Palette(COLOR_YELLOW, 90, 170, 255),
+    TileGfx::Palette(COLOR_CYAN, 90, 170, 255),
+    TileGfx::Palette(COLOR_WHITE, 90, 170, 255),
+};
+
 // -----------------------------------------------------------------------------
 // Ship / enemy / boss sprites (0..3 brightness maps) + palettes
 // -----------------------------------------------------------------------------
@@ -190,6 +217,23 @@ static inline constexpr uint16_t ENEMY_COLORS[4] = {
     COLOR_YELLOW
 };
 
+// Brightness of sprite values 1..3 for ships, enemies and bosses.
+static inline constexpr uint8_t SPRITE_MUL1 = 80;
+static inline constexpr uint8_t SPRITE_MUL2 = 160;
+
+static inline constexpr int SHIP_RUN_COUNT = TileGfx::countRuns(SHIP_SPRITE);
+static inline constexpr TileGfx::SpriteRuns<1, SHIP_H, SHIP_W, SHIP_RUN_COUNT> SHIP_RUNS(SHIP_SPRITE);
+
+static inline constexpr int ENEMY_RUN_COUNT = TileGfx::countRuns(ENEMY_SPRITES);
+static inline constexpr TileGfx::SpriteRuns<4, ENEMY_H, ENEMY_W, ENEMY_RUN_COUNT> ENEMY_RUNS(ENEMY_SPRITES);
+
+static inline constexpr TileGfx::Palette ENEMY_PALETTES[4] = {
+    TileGfx::Palette(ENEMY_COLORS[0], SPRITE_MUL1, SPRITE_MUL2, 255),
+    TileGfx::Palette(ENEMY_COLORS[1], SPRITE_MUL1, SPRITE_MUL2, 255),
+    TileGfx::Palette(ENEMY_COLORS[2], SPRITE_MUL1, SPRITE_MUL2, 255),
+    TileGfx::Palette(ENEMY_COLORS[3], SPRITE_MUL1, SPRITE_MUL2, 255),
+};
+
 static inline constexpr uint8_t BOSS_SPRITES[5][BOSS_H][BOSS_W] = {
     // Boss 0: "Mothership"
     {{0,0,3,3,3,3,3,3,0,0},
@@ -256,4 +300,34 @@ static inline constexpr uint16_t BOSS_COLORS[5] = {
     COLOR_MAGENTA
 };
 
+static inline constexpr int BOSS_RUN_COUNT = TileGfx::countRuns(BOSS_SPRITES);
+static inline constexpr TileGfx::SpriteRuns<5, BOSS_H, BOSS_W, BOSS_RUN_COUNT> BOSS_RUNS(BOSS_SPRITES);
+
+static inline constexpr TileGfx::Palette BOSS_PALETTES[5] = {
+    TileGfx::Palette(BOSS_COLORS[0], SPRITE_MUL1, SPRITE_MUL2, 255),
+    TileGfx::Palette(BOSS_COLORS[1], SPRITE_MUL1, SPRITE_MUL2, 255),
+    TileGfx::Palette(BOSS_COLORS[2], SPRITE_MUL1, SPRITE_MUL2, 255),
+    TileGfx::Palette(BOSS_COLORS[3], SPRITE_MUL1, SPRITE_MUL2, 255),
+    TileGfx::Palette(BOSS_COLORS[4], SPRITE_MUL1, SPRITE_MUL2, 255),
+};
+// Shield hit flash.
+static inline constexpr TileGfx::Palette BOSS_FLASH_PALETTE(COLOR_WHITE, SPRITE_MUL1, SPRITE_MUL2, 255);
+
+// -----------------------------------------------------------------------------
+// Thruster ramp
+// -----------------------------------------------------------------------------
+// Colour of exhaust pixel i (1..THRUSTER_LEN_PX): cyan fading with (1 - d)^2, where d
+// runs 0..1 along the tail. 0 = below THRUSTER_MIN_MUL (not drawn).
+struct ThrusterRamp {
+    uint16_t c[THRUSTER_LEN_PX + 1] = {};
 
+    constexpr ThrusterRamp() {
+        const float denom = (float)((THRUSTER_LEN_PX > 1) ? THRUSTER_LEN_PX - 1 : 1);
+        for (int i = 1; i <= THRUSTER_LEN_PX; i++) {
+            const float f = 1.0f - (float)(i - 1) / denom;
+            const int mul = (int)(255.0f * f * f);
+            c[i] = (mul < THRUSTER_MIN_MUL) ? 0 : Pixel565::scale(COLOR_CYAN, (uint8_t)(mul > 255 ? 255 : mul));
+        }
+    }
+};
+static inline constexpr ThrusterRamp THRUSTER_RAMP{};
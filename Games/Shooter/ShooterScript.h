@@ -0,0 +1,310 @@
+// ShooterScript.h
+// -----------------------------------------------------------------------------
+// Tiny bytecode VM for ShooterGame waves and boss attack patterns.
+//
+// Scripts are `static constexpr uint8_t[]` tables (flash, no RAM), written with
+// the SS_* assembler macros below and checked at compile time:
+//
+//   static constexpr uint8_t WAVE[] = { SS_LABEL(0), SS_SPAWN(SS_ANY, SS_ANY, 0), ... };
+//   static_assert(ShooterScript::validate(WAVE, sizeof(WAVE)), "bad script");
+//
+// Instruction set (opcode + fixed operand bytes, u16 operands little-endian):
+//   END                          stop this script
+//   LABEL id                     jump target (0..MAX_LABELS-1), no-op at runtime
+//   JUMP id                      unconditional jump
+//   BRANCH cond arg id           jump if cond(arg) holds (cond | NOT inverts it)
+//   WAIT ms16                    yield for ms (0 = until the next tick)
+//   WAIT_SCALED base16 dec8 max16 jitter16
+//                                yield for base - min(max, difficulty*dec) + random(0, jitter)
+//   WAIT_UNTIL cond arg          yield every tick until cond(arg) holds
+//   LOOP n / NEXT                repeat the body n times (nesting <= MAX_LOOP_DEPTH;
+//                                do not jump out of a loop body)
+//   SPAWN type x hp              enemy; SS_ANY = random type / random x, hp 0 = level-based
+//   BOSS                         spawn the boss (starts its attack lanes)
+//   FIRE pattern                 boss attack pattern (P_*)
+//
+// Cost: each Vm::run() executes at most `budget` instructions and then yields,
+// so a runaway script costs a bounded, known amount per tick (see peakOps).
+// -----------------------------------------------------------------------------
+#pragma once
+
+#include <Arduino.h>
+#include "../../engine/config.h"
+
+namespace ShooterScript {
+
+enum Op : uint8_t {
+    OP_END = 0,
+    OP_LABEL,
+    OP_JUMP,
+    OP_BRANCH,
+    OP_WAIT,
+    OP_WAIT_SCALED,
+    OP_WAIT_UNTIL,
+    OP_LOOP,
+    OP_NEXT,
+    OP_SPAWN,
+    OP_BOSS,
+    OP_FIRE,
+    OP_COUNT
+};
+
+// Operand bytes per opcode (index = Op).
+static constexpr uint8_t OPERANDS[OP_COUNT] = { 0, 1, 1, 3, 2, 7, 2, 1, 0, 3, 0, 1 };
+
+// Conditions for BRANCH / WAIT_UNTIL. C_ALWAYS and C_CHANCE are evaluated by the
+// VM, the rest by the Host.
+enum Cond : uint8_t {
+    C_ALWAYS = 0,
+    C_CHANCE,        // random(0, 100) < arg
+    C_HITS_REACHED,  // enough enemy hits this level to call the boss
+    C_ALIVE_LT,      // alive enemies < arg (SS_ANY = the level's target count)
+    C_BOSS_DONE,     // no boss on screen and no boss death sequence running
+    C_SPAWN_OK,      // post-boss loot grace is over
+    C_LEVEL_GE,      // level >= arg
+    C_BOSSES_GE,     // bosses defeated >= arg
+    C_COUNT
+};
+static constexpr uint8_t NOT = 0x80;
+
+enum Pattern : uint8_t { P_STAR_BURST = 0, P_ROCKET, P_COUNT };
+
+static constexpr uint8_t ANY = 0xFF;
+static constexpr uint8_t MAX_LABELS = 16;
+static constexpr uint8_t MAX_LOOP_DEPTH = 2;
+static constexpr uint8_t ENEMY_TYPES = 4;
+static constexpr uint8_t MAX_HP = 4;
+
+// -----------------------------
+// Assembler macros
+// -----------------------------
+#define SS_U16(v) (uint8_t)((v) & 0xFF), (uint8_t)(((v) >> 8) & 0xFF)
+#define SS_ANY ShooterScript::ANY
+#define SS_END() ShooterScript::OP_END
+#define SS_LABEL(id) ShooterScript::OP_LABEL, (uint8_t)(id)
+#define SS_JUMP(id) ShooterScript::OP_JUMP, (uint8_t)(id)
+#define SS_BRANCH(cond, arg, id) ShooterScript::OP_BRANCH, (uint8_t)(cond), (uint8_t)(arg), (uint8_t)(id)
+#define SS_WAIT(ms) ShooterScript::OP_WAIT, SS_U16(ms)
+#define SS_WAIT_SCALED(base, dec, max, jitter) ShooterScript::OP_WAIT_SCALED, SS_U16(base), (uint8_t)(dec), SS_U16(max), SS_U16(jitter)
+#define SS_WAIT_UNTIL(cond, arg) ShooterScript::OP_WAIT_UNTIL, (uint8_t)(cond), (uint8_t)(arg)
+#define SS_LOOP(n) ShooterScript::OP_LOOP, (uint8_t)(n)
+#define SS_NEXT() ShooterScript::OP_NEXT
+#define SS_SPAWN(type, x, hp) ShooterScript::OP_SPAWN, (uint8_t)(type), (uint8_t)(x), (uint8_t)(hp)
+#define SS_BOSS() ShooterScript::OP_BOSS
+#define SS_FIRE(pattern) ShooterScript::OP_FIRE, (uint8_t)(pattern)
+
+/**
+ * Structural check: known opcodes, complete operands, operand ranges, unique
+ * labels, defined jump targets, balanced LOOP/NEXT, and no falling off the end.
+ * constexpr so scripts in flash are checked by static_assert; also run by
+ * Vm::load() for scripts that come from elsewhere.
+ */
+constexpr bool validate(const uint8_t* code, size_t len) {
+    if (len == 0 || len > 0xFFFF) return false;
+    bool defined[MAX_LABELS] = {};
+    int depth = 0;
+    uint8_t last = OP_END;
+    size_t pc = 0;
+    while (pc < len) {
+        const uint8_t op = code[pc];
+        if (op >= OP_COUNT || pc + 1 + OPERANDS[op] > len) return false;
+        const uint8_t* a = &code[pc + 1];
+        switch (op) {
+            case OP_LABEL:
+                if (a[0] >= MAX_LABELS || defined[a[0]]) return false;
+                defined[a[0]] = true;
+                break;
+            case OP_BRANCH:
+            case OP_WAIT_UNTIL:
+                if ((a[0] & ~NOT) >= C_COUNT) return false;
+                break;
+            case OP_LOOP:
+                if (a[0] == 0 || ++depth > MAX_LOOP_DEPTH) return false;
+                break;
+            case OP_NEXT:
+                if (--depth < 0) return false;
+                break;
+            case OP_SPAWN:
+                if (a[0] != ANY && a[0] >= ENEMY_TYPES) return false;
+                if (a[1] != ANY && a[1] >= PANEL_RES_X) return false;
+                if (a[2] > MAX_HP) return false;
+                break;
+            case OP_FIRE:
+                if (a[0] >= P_COUNT) return false;
+                break;
+            default:
+                break;
+        }
+        last = op;
+        pc += 1 + OPERANDS[op];
+    }
+    if (depth != 0 || (last != OP_END && last != OP_JUMP)) return false;
+
+    // Second pass: every jump lands on a defined label.
+    pc = 0;
+    while (pc < len) {
+        const uint8_t op = code[pc];
+        if (op == OP_JUMP && (code[pc + 1] >= MAX_LABELS || !defined[code[pc + 1]])) return false;
+        if (op == OP_BRANCH && (code[pc + 3] >= MAX_LABELS || !defined[code[pc + 3]])) return false;
+        pc += 1 + OPERANDS[op];
+    }
+    return true;
+}
+
+/**
+ * Implemented by the game: state queries and actions the scripts can use.
+ */
+class Host {
+public:
+    virtual bool scriptCond(uint8_t cond, uint8_t arg, uint32_t now) = 0;
+    virtual void scriptSpawn(uint8_t type, uint8_t x, uint8_t hp, uint32_t now) = 0;
+    virtual void scriptBoss(uint32_t now) = 0;
+    virtual void scriptFire(uint8_t pattern, uint32_t now) = 0;
+    // Scales WAIT_SCALED (ShooterGame: bosses defeated).
+    virtual uint8_t scriptDifficulty() = 0;
+    virtual ~Host() {}
+};
+
+/**
+ * One running script ("lane"). A game can run several side by side (e.g. the
+ * wave script plus one lane per boss attack pattern).
+ */
+class Vm {
+public:
+    // Per-tick cost, in instructions (peakOps never exceeds the run() budget).
+    uint8_t lastOps = 0;
+    uint8_t peakOps = 0;
+
+    bool load(const uint8_t* script, size_t len) {
+        halt();
+        if (!validate(script, len)) return false;
+        code = script;
+        size = (uint16_t)len;
+        for (uint8_t i = 0; i < MAX_LABELS; i++) labels[i] = 0;
+        for (uint16_t p = 0; p < size; p += (uint16_t)(1 + OPERANDS[code[p]])) {
+            if (code[p] == OP_LABEL) labels[code[p + 1]] = p;
+        }
+        pc = 0;
+        running = true;
+        return true;
+    }
+
+    void halt() {
+        running = false;
+        waiting = false;
+        depth = 0;
+    }
+
+    bool isRunning() const { return running; }
+
+    // Execute until the script yields, ends, or `budget` instructions have run.
+    void run(Host& host, uint32_t now, uint8_t budget) {
+        lastOps = 0;
+        if (!running) return;
+        if (waiting) {
+            if ((int32_t)(now - waitUntilMs) < 0) return;
+            waiting = false;
+        }
+        while (running && lastOps < budget) {
+            lastOps++;
+            const uint8_t op = code[pc];
+            const uint8_t* a = &code[pc + 1];
+            const uint16_t next = (uint16_t)(pc + 1 + OPERANDS[op]);
+            switch (op) {
+                case OP_END:
+                    halt();
+                    break;
+                case OP_LABEL:
+                    pc = next;
+                    break;
+                case OP_JUMP:
+                    pc = labels[a[0]];
+                    break;
+                case OP_BRANCH:
+                    pc = cond(host, a[0], a[1], now) ? labels[a[2]] : next;
+                    break;
+                case OP_WAIT:
+                    pc = next;
+                    yieldFor(now, u16(a));
+                    break;
+                case OP_WAIT_SCALED: {
+                    const uint32_t base = u16(a);
+                    const uint32_t dec = min<uint32_t>(u16(a + 3), (uint32_t)host.scriptDifficulty() * a[2]);
+                    const uint32_t jitter = u16(a + 5);
+                    pc = next;
+                    yieldFor(now, (base > dec ? base - dec : 0) + (jitter ? (uint32_t)random(0, (long)jitter) : 0));
+                    break;
+                }
+                case OP_WAIT_UNTIL:
+                    if (cond(host, a[0], a[1], now)) pc = next;
+                    else yieldFor(now, 0);
+                    break;
+                case OP_LOOP:
+                    if (depth >= MAX_LOOP_DEPTH) { halt(); break; }
+                    loops[depth].start = next;
+                    loops[depth].left = a[0];
+                    depth++;
+                    pc = next;
+                    break;
+                case OP_NEXT:
+                    if (depth == 0) { halt(); break; }
+                    if (--loops[depth - 1].left > 0) pc = loops[depth - 1].start;
+                    else { depth--; pc = next; }
+                    break;
+                case OP_SPAWN:
+                    host.scriptSpawn(a[0], a[1], a[2], now);
+                    pc = next;
+                    break;
+                case OP_BOSS:
+                    host.scriptBoss(now);
+                    pc = next;
+                    break;
+                case OP_FIRE:
+                    host.scriptFire(a[0], now);
+                    pc = next;
+                    break;
+                default:
+                    halt();
+                    break;
+            }
+            if (waiting) break;
+        }
+        if (lastOps > peakOps) peakOps = lastOps;
+    }
+
+private:
+    struct Loop {
+        uint16_t start;
+        uint8_t left;
+    };
+
+    const uint8_t* code = nullptr;
+    uint16_t size = 0;
+    uint16_t pc = 0;
+    uint16_t labels[MAX_LABELS] = {};
+    Loop loops[MAX_LOOP_DEPTH] = {};
+    uint8_t depth = 0;
+    bool running = false;
+    bool waiting = false;
+    uint32_t waitUntilMs = 0;
+
+    static uint16_t u16(const uint8_t* p) { return (uint16_t)(p[0] | ((uint16_t)p[1] << 8)); }
+
+    void yieldFor(uint32_t now, uint32_t ms) {
+        waiting = true;
+        // WAIT 0 still yields: resume on the next tick.
+        waitUntilMs = now + (ms ? ms : 1);
+    }
+
+    static bool cond(Host& host, uint8_t c, uint8_t arg, uint32_t now) {
+        bool v;
+        switch (c & ~NOT) {
+            case C_ALWAYS: v = true; break;
+            case C_CHANCE: v = random(0, 100) < (long)arg; break;
+            default: v = host.scriptCond((uint8_t)(c & ~NOT), arg, now); break;
+        }
+        return (c & NOT) ? !v : v;
+    }
+};
+
+} // namespace ShooterScript
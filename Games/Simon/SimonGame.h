@@ -5,6 +5,8 @@
 #include "../../engine/GameBase.h"
 #include "../../engine/ControllerManager.h"
 #include "../../engine/config.h"
+#include "../../engine/Raster.h"
+#include "../../engine/Pixel565.h"
 #include "../../engine/Settings.h"
 #include "../../engine/UserProfiles.h"
 #include "../../engine/AudioManager.h"
@@ -54,32 +56,6 @@ private:
         PHASE_GAME_OVER
     };
 
-    // -----------------------------------------------------
-    // Input helpers (Bluepad32 API can vary across versions/controllers)
-    // -----------------------------------------------------
-    struct InputDetail {
-        template <typename T>
-        static auto l1(T* c, int) -> decltype(c->l1(), bool()) { return (bool)c->l1(); }
-        template <typename T>
-        static bool l1(T*, ...) { return false; }
-
-        template <typename T>
-        static auto r1(T* c, int) -> decltype(c->r1(), bool()) { return (bool)c->r1(); }
-        template <typename T>
-        static bool r1(T*, ...) { return false; }
-
-        // Some Bluepad32 versions/controllers expose LB/RB as lb()/rb()
-        template <typename T>
-        static auto lb(T* c, int) -> decltype(c->lb(), bool()) { return (bool)c->lb(); }
-        template <typename T>
-        static bool lb(T*, ...) { return false; }
-
-        template <typename T>
-        static auto rb(T* c, int) -> decltype(c->rb(), bool()) { return (bool)c->rb(); }
-        template <typename T>
-        static bool rb(T*, ...) { return false; }
-    };
-
     // -----------------------------------------------------
     // State
     // -----------------------------------------------------
@@ -133,18 +109,6 @@ private:
     // -----------------------------------------------------
     // Helpers
     // -----------------------------------------------------
-    static inline uint16_t dim565(uint16_t c, uint8_t amount /*0..255*/) {
-        // Linear dimming in RGB565 space (cheap + good enough for LED panel UI).
-        // amount=255 -> unchanged; amount=0 -> black.
-        const uint16_t r = (uint16_t)((c >> 11) & 0x1F);
-        const uint16_t g = (uint16_t)((c >> 5) & 0x3F);
-        const uint16_t b = (uint16_t)(c & 0x1F);
-        const uint16_t rr = (uint16_t)((r * amount) / 255);
-        const uint16_t gg = (uint16_t)((g * amount) / 255);
-        const uint16_t bb = (uint16_t)((b * amount) / 255);
-        return (uint16_t)((rr << 11) | (gg << 5) | bb);
-    }
-
     static inline uint32_t speedScaleMs(uint32_t ms) {
         // globalSettings.getGameSpeed() is 1..5; higher should be faster.
         const uint8_t sp = globalSettings.getGameSpeed();
@@ -276,13 +240,13 @@ private:
         }
     }
 
-    Symbol readEdgeSymbol(ControllerPtr ctl) {
-        if (!ctl) return SYM_NONE;
+    Symbol readEdgeSymbol(const PadState& pad) {
+        if (!pad.connected) return SYM_NONE;
 
-        const bool aNow = (bool)ctl->a();
-        const bool bNow = (bool)ctl->b();
-        const bool xNow = (bool)ctl->x();
-        const bool yNow = (bool)ctl->y();
+        const bool aNow = pad.held(PadState::BTN_A);
+        const bool bNow = pad.held(PadState::BTN_B);
+        const bool xNow = pad.held(PadState::BTN_X);
+        const bool yNow = pad.held(PadState::BTN_Y);
 
         const bool aEdge = aNow && !lastA;
         const bool bEdge = bNow && !lastB;
@@ -297,8 +261,8 @@ private:
         if (yEdge) return SYM_Y;
 
         if (difficulty >= DIFF_MEDIUM) {
-            const bool lbNow = InputDetail::l1(ctl, 0) || InputDetail::lb(ctl, 0);
-            const bool rbNow = InputDetail::r1(ctl, 0) || InputDetail::rb(ctl, 0);
+            const bool lbNow = pad.held(PadState::BTN_L1);
+            const bool rbNow = pad.held(PadState::BTN_R1);
             const bool lbEdge = lbNow && !lastLB;
             const bool rbEdge = rbNow && !lastRB;
             lastLB = lbNow; lastRB = rbNow;
@@ -307,7 +271,7 @@ private:
         }
 
         if (difficulty >= DIFF_HARD) {
-            const uint8_t d = ctl->dpad();
+            const uint8_t d = pad.dpad;
             const bool upEdge = dpadUp(d) && !dpadUp(lastDpad);
             const bool downEdge = dpadDown(d) && !dpadDown(lastDpad);
             const bool leftEdge = dpadLeft(d) && !dpadLeft(lastDpad);
@@ -375,7 +339,7 @@ private:
         const int halfT = thick / 2;  // 2
 
         // Base cross is always visible (dim).
-        const uint16_t base = dim565(SimonGameConfig::COL_DPAD, 80);
+        const uint16_t base = Pixel565::scale(SimonGameConfig::COL_DPAD, 80);
         d->fillRect(cx - halfT, y0, thick, size, base);     // vertical
         d->fillRect(x0, cy - halfT, size, thick, base);     // horizontal
 
@@ -387,7 +351,7 @@ private:
         if (activeSym == SYM_UP || activeSym == SYM_DOWN || activeSym == SYM_LEFT || activeSym == SYM_RIGHT) s = activeSym;
         // Stronger highlight (boost intensity).
         const uint8_t hiAmt = (uint8_t)constrain((int)intensity + 80, 0, 255);
-        const uint16_t hi = dim565(SimonGameConfig::COL_DPAD, hiAmt);
+        const uint16_t hi = Pixel565::scale(SimonGameConfig::COL_DPAD, hiAmt);
 
         // Highlight arm segment only (keep center hollow).
         if (s == SYM_UP) {
@@ -409,10 +373,10 @@ private:
 
     static void drawButton(MatrixPanel_I2S_DMA* d, const Rect& r, uint16_t baseColor, const char* label, bool active) {
         if (!d || r.w <= 0 || r.h <= 0) return;
-        const uint16_t fill = active ? baseColor : dim565(baseColor, 90);
-        const uint16_t border = active ? COLOR_WHITE : dim565(baseColor, 180);
+        const uint16_t fill = active ? baseColor : Pixel565::scale(baseColor, 90);
+        const uint16_t border = active ? COLOR_WHITE : Pixel565::scale(baseColor, 180);
         d->fillRect(r.x, r.y, r.w, r.h, fill);
-        d->drawRect(r.x, r.y, r.w, r.h, border);
+        Raster::rect(d, r.x, r.y, r.w, r.h, border);
         if (label && label[0]) {
             // Center label approximately (TomThumb is tiny; ~4px advance per char in this project).
             int len = 0;
@@ -434,8 +398,8 @@ private:
         if (!d || r.w <= 0 || r.h <= 0) return;
         const uint16_t col = errorTint ? COLOR_RED : baseColor;
         const uint8_t amt = active ? intensity : 90;
-        const uint16_t fill = dim565(col, amt);
-        const uint16_t border = active ? COLOR_WHITE : dim565(col, 180);
+        const uint16_t fill = Pixel565::scale(col, amt);
+        const uint16_t border = active ? COLOR_WHITE : Pixel565::scale(col, 180);
         const int rad = max(1, r.h / 2);
         d->fillRoundRect(r.x, r.y, r.w, r.h, rad, fill);
         d->drawRoundRect(r.x, r.y, r.w, r.h, rad, border);
@@ -449,23 +413,20 @@ private:
         }
     }
 
-    static void drawFaceCircle(MatrixPanel_I2S_DMA* d, Symbol s, uint16_t baseColor, const char* label, bool active, uint8_t intensity /*0..255*/, bool errorTint) {
+    // Face button from its pre-rendered sprite. A lit face takes its fill from
+    // the intensity table (red when it is the wrong press being flashed).
+    static void drawFace(MatrixPanel_I2S_DMA* d, Symbol s, bool active, uint8_t intensity /*0..255*/, bool errorTint) {
         if (!d) return;
         using namespace SimonGameConfig;
         int cx, cy;
         faceCenter(s, cx, cy);
-        const uint16_t col = errorTint ? COLOR_RED : baseColor;
-        const uint8_t dimAmt = active ? intensity : 90;
-        const uint16_t fill = dim565(col, dimAmt);
-        const uint16_t border = active ? COLOR_WHITE : dim565(col, 180);
-        d->fillCircle(cx, cy, FACE_R, fill);
-        d->drawCircle(cx, cy, FACE_R, border);
-        if (label && label[0]) {
-            const int lx = cx - 2;
-            const int ly = cy + 2;
-            const uint16_t lc = (col == COLOR_YELLOW) ? COLOR_BLACK : COLOR_WHITE;
-            SmallFont::drawString(d, lx, ly, label, lc);
+        TileGfx::Palette pal = FACE_IDLE[s];
+        if (active) {
+            const uint8_t shade = errorTint ? FACE_ERROR : (uint8_t)s;
+            pal = facePalette(FACE_SHADES.c[shade][faceLevel(intensity)], COLOR_WHITE,
+                              faceLabelColor(errorTint ? COLOR_RED : FACE_COLORS[s]));
         }
+        TileGfx::drawSprite(d, faceSprites(), (uint8_t)s, cx - FACE_R, cy - FACE_R, pal);
     }
 
     static void drawHeart(MatrixPanel_I2S_DMA* d, int x, int y, bool filled) {
@@ -478,7 +439,7 @@ private:
             {0,1,1,1,0},
             {0,0,1,0,0}
         };
-        const uint16_t col = filled ? COLOR_RED : dim565(COLOR_RED, 90);
+        const uint16_t col = filled ? COLOR_RED : Pixel565::scale(COLOR_RED, 90);
         for (int yy = 0; yy < 5; yy++) {
             for (int xx = 0; xx < 5; xx++) {
                 if (!H[yy][xx]) continue;
@@ -521,14 +482,14 @@ private:
         const int step = (int)(age / max(1u, stepMs));
         if (step < 0 || step > 3) return;
         const uint8_t a = (uint8_t)max(0, 220 - step * 55);
-        const uint16_t col = dim565(colorFor(pulse.sym), a);
+        const uint16_t col = Pixel565::scale(colorFor(pulse.sym), a);
 
         // Face buttons: expanding circle outline.
         if (pulse.sym == SYM_X || pulse.sym == SYM_Y || pulse.sym == SYM_A || pulse.sym == SYM_B) {
             int cx, cy;
             faceCenter(pulse.sym, cx, cy);
             const int r = SimonGameConfig::FACE_R + 2 + step * 2;
-            d->drawCircle(cx, cy, r, col);
+            Raster::circle(d, cx, cy, r, col);
             return;
         }
 
@@ -536,7 +497,7 @@ private:
         if (pulse.sym == SYM_LB || pulse.sym == SYM_RB) {
             Rect r = this->shoulderRect(pulse.sym);
             const int pad = 1 + step;
-            d->drawRect(r.x - pad, r.y - pad, r.w + pad * 2, r.h + pad * 2, col);
+            Raster::rect(d, r.x - pad, r.y - pad, r.w + pad * 2, r.h + pad * 2, col);
             return;
         }
     }
@@ -547,7 +508,7 @@ private:
         char buf[16];
         snprintf(buf, sizeof(buf), "L:%u", (unsigned)bestScore);
         SmallFont::drawString(display, PANEL_RES_X - 20, 6, buf, COLOR_YELLOW);
-        for (int x = 0; x < PANEL_RES_X; x += 2) display->drawPixel(x, 7, COLOR_BLUE);
+        Raster::dashedHLine(display, 0, 7, PANEL_RES_X, COLOR_BLUE);
     }
 
 public:
@@ -557,6 +518,7 @@ public:
         maxLives = globalSettings.getSimonLives();
         lives = maxLives;
         simonSpeed = globalSettings.getSimonSpeed();
+        SimonGameConfig::faceSprites(); // rasterize the faces now, not in the first frame
         randomSeed((uint32_t)micros() ^ (uint32_t)millis());
         startNewRun((uint32_t)millis());
     }
@@ -565,8 +527,8 @@ public:
         const uint32_t now = (uint32_t)millis();
         if (gameOver) return;
 
-        ControllerPtr ctl = (input != nullptr) ? input->getController(0) : nullptr;
-        if (!(ctl && ctl->isConnected())) return;
+        const PadState& pad = (input != nullptr) ? input->pad(0) : PadState();
+        if (!pad.connected) return;
 
         // Expire highlight
         if (activeSym != SYM_NONE && (int32_t)(now - activeUntilMs) >= 0) {
@@ -631,7 +593,7 @@ public:
             }
 
             case PHASE_INPUT: {
-                const Symbol pressed = readEdgeSymbol(ctl);
+                const Symbol pressed = readEdgeSymbol(pad);
                 if (pressed == SYM_NONE) break;
 
                 const Symbol expected = (inputIndex < seqLen) ? (Symbol)seq[inputIndex] : SYM_NONE;
@@ -725,22 +687,10 @@ public:
             }
         }
         // If we're in error phase, the wrong symbol becomes the "active" one with red tint + animated intensity.
-        drawFaceCircle(display, SYM_Y, SimonGameConfig::COL_Y, "Y",
-                       (activeSym == SYM_Y) || (err == SYM_Y),
-                       (err == SYM_Y) ? errI : inten,
-                       err == SYM_Y);
-        drawFaceCircle(display, SYM_X, SimonGameConfig::COL_X, "X",
-                       (activeSym == SYM_X) || (err == SYM_X),
-                       (err == SYM_X) ? errI : inten,
-                       err == SYM_X);
-        drawFaceCircle(display, SYM_B, SimonGameConfig::COL_B, "B",
-                       (activeSym == SYM_B) || (err == SYM_B),
-                       (err == SYM_B) ? errI : inten,
-                       err == SYM_B);
-        drawFaceCircle(display, SYM_A, SimonGameConfig::COL_A, "A",
-                       (activeSym == SYM_A) || (err == SYM_A),
-                       (err == SYM_A) ? errI : inten,
-                       err == SYM_A);
+        const Symbol faces[SimonGameConfig::FACE_COUNT] = { SYM_Y, SYM_X, SYM_B, SYM_A };
+        for (const Symbol f : faces) {
+            drawFace(display, f, (activeSym == f) || (err == f), (err == f) ? errI : inten, err == f);
+        }
 
         // Medium+: shoulders
         if (difficulty >= DIFF_MEDIUM) {
@@ -766,7 +716,7 @@ public:
             // Vertical gradient under HUD (y>=8)
             for (int y = 8; y < PANEL_RES_Y; y++) {
                 const uint8_t g = (uint8_t)map(y, 8, PANEL_RES_Y - 1, 40, 0);
-                const uint16_t c = dim565(display->color565(255, g, g), a);
+                const uint16_t c = Pixel565::scale(display->color565(255, g, g), a);
                 display->drawFastHLine(0, y, PANEL_RES_X, c);
             }
         }
@@ -808,6 +758,21 @@ public:
     const char* leaderboardId() const override { return "simon"; }
     const char* leaderboardName() const override { return "Simon"; }
     uint32_t leaderboardScore() const override { return (bestScore > 0) ? (uint32_t)bestScore : 0u; }
+
+    // ------------------------------
+    // Self-check (DEBUG_INVARIANTS)
+    // ------------------------------
+    const char* checkInvariants() const override {
+        if (lives > maxLives) return "lives above max";
+        if (gameOver != (phase == PHASE_GAME_OVER)) return "game over flag out of sync with phase";
+        if (seqLen > SimonGameConfig::MAX_SEQUENCE) return "sequence past MAX_SEQUENCE";
+        if (inputIndex > seqLen || showIndex > seqLen) return "progress past the sequence";
+        if (bestScore > seqLen) return "best score past the sequence";
+        for (uint16_t i = 0; i < seqLen; i++) {
+            if (seq[i] > SYM_RIGHT) return "sequence symbol out of range";
+        }
+        return nullptr;
+    }
 };
 
 
@@ -1,11 +1,16 @@
 #pragma once
 #include <Arduino.h>
 #include "../../engine/config.h"
+#include "../../engine/Pixel565.h"
+#include "../../engine/Raster.h"
+#include "../../engine/TileLayer.h"
+#include "../../component/SmallFont.h"
 
 /**
  * SimonGameConfig
  * ---------------
  * Tweakable timing and UI constants for the Simon Says style game.
+ * Face button sprites live in `SimonGameSprites.h`, included inside the namespace.
  */
 namespace SimonGameConfig {
 
@@ -59,6 +64,12 @@ static constexpr uint16_t COL_LB = COLOR_PURPLE;
 static constexpr uint16_t COL_RB = COLOR_ORANGE;
 static constexpr uint16_t COL_DPAD = COLOR_WHITE;
 
+// Brightness steps of a lit face (show flash, error flash); fills come from a
+// table with one colour per step.
+static constexpr uint8_t FACE_INTENSITY_LEVELS = 16;
+
+#include "SimonGameSprites.h"
+
 } // namespace SimonGameConfig
 
 
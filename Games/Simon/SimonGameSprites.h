@@ -0,0 +1,120 @@
+// SimonGameSprites.h
+// -----------------------------------------------------------------------------
+// Pre-rendered face buttons (X, Y, A, B) for Simon.
+//
+// NOTE:
+// - This header is intended to be included from inside `namespace SimonGameConfig`
+//   (see SimonGameConfig.h). Do NOT declare `namespace SimonGameConfig {}` again.
+// -----------------------------------------------------------------------------
+#pragma once
+
+// A face is the filled circle of FACE_R, its outline and its letter, the same
+// pixels Raster::fillCircle(), Raster::circle() and SmallFont::drawString()
+// produce. They are rasterized once into a 0..3 bitmap and cut into runs, so a
+// face costs one span per run: no circle walk, no text rendering, no overdraw.
+// Palette entries: 1 = fill, 2 = outline, 3 = letter.
+static constexpr int FACE_SIZE = 2 * FACE_R + 1;
+static constexpr uint8_t FACE_COUNT = 4; // sprite index = SimonGame::Symbol (X, Y, A, B)
+static constexpr uint8_t FACE_ERROR = FACE_COUNT; // FACE_SHADES row of the red error tint
+
+static inline constexpr const char* FACE_LABELS[FACE_COUNT] = { "X", "Y", "A", "B" };
+static inline constexpr uint16_t FACE_COLORS[FACE_COUNT] = { COL_X, COL_Y, COL_A, COL_B };
+
+// Worst case per row: outline | fill | letter | fill | letter | fill | outline.
+static constexpr int FACE_MAX_RUNS = FACE_COUNT * FACE_SIZE * 7;
+using FaceRuns = TileGfx::SpriteRuns<FACE_COUNT, FACE_SIZE, FACE_SIZE, FACE_MAX_RUNS>;
+
+struct FaceBitmaps {
+    uint8_t px[FACE_COUNT][FACE_SIZE][FACE_SIZE] = {};
+};
+
+inline FaceBitmaps rasterizeFaces() {
+    FaceBitmaps out;
+    constexpr int c = FACE_R; // centre in sprite coordinates
+    for (uint8_t t = 0; t < FACE_COUNT; t++) {
+        uint8_t(&px)[FACE_SIZE][FACE_SIZE] = out.px[t];
+        auto hrun = [&](int x0, int x1, int y, uint8_t v) {
+            for (int x = x0; x <= x1; x++) px[y][x] = v;
+        };
+        auto vrun = [&](int x, int y0, int y1, uint8_t v) {
+            for (int y = y0; y <= y1; y++) px[y][x] = v;
+        };
+
+        // Fill, as Raster::fillCircle().
+        int lastSideRow = -1;
+        Raster::Detail::circleRuns(FACE_R, [&](int v, int a, int b) {
+            for (int x = a; x <= b; x++) {
+                hrun(c - v, c + v, c - x, 1);
+                hrun(c - v, c + v, c + x, 1);
+                lastSideRow = x;
+            }
+        });
+        Raster::Detail::circleRuns(FACE_R, [&](int v, int, int b) {
+            if (v <= lastSideRow) return;
+            hrun(c - b, c + b, c - v, 1);
+            hrun(c - b, c + b, c + v, 1);
+        });
+
+        // Outline on top, as Raster::circle().
+        Raster::Detail::circleRuns(FACE_R, [&](int v, int a, int b) {
+            hrun(c - b, c - a, c - v, 2);
+            hrun(c + a, c + b, c - v, 2);
+            hrun(c - b, c - a, c + v, 2);
+            hrun(c + a, c + b, c + v, 2);
+            vrun(c - v, c - b, c - a, 2);
+            vrun(c - v, c + a, c + b, 2);
+            vrun(c + v, c - b, c - a, 2);
+            vrun(c + v, c + a, c + b, 2);
+        });
+
+        // Letter last, at the spot SimonGame used to print it (cx - 2, cy + 2).
+        SmallFont::forEachPixel(c - 2, c + 2, FACE_LABELS[t], [&](int x, int y) {
+            if ((unsigned)x < (unsigned)FACE_SIZE && (unsigned)y < (unsigned)FACE_SIZE) px[y][x] = 3;
+        });
+    }
+    return out;
+}
+
+// Built on first use (SimonGame::start()); the letters come from the font at runtime.
+inline TileGfx::SpriteSet faceSprites() {
+    static const FaceRuns runs(rasterizeFaces().px);
+    return runs;
+}
+
+// Lit face fills: FACE_SHADES.c[face or FACE_ERROR][level], level 0 = black,
+// last level = full colour.
+struct FaceShades {
+    uint16_t c[FACE_COUNT + 1][FACE_INTENSITY_LEVELS] = {};
+
+    constexpr FaceShades() {
+        for (uint8_t f = 0; f <= FACE_COUNT; f++) {
+            const uint16_t base = (f < FACE_COUNT) ? FACE_COLORS[f] : COLOR_RED;
+            for (uint8_t i = 0; i < FACE_INTENSITY_LEVELS; i++)
+                c[f][i] = Pixel565::scale(base, (uint8_t)(i * 255 / (FACE_INTENSITY_LEVELS - 1)));
+        }
+    }
+};
+static inline constexpr FaceShades FACE_SHADES{};
+
+// Intensity 0..255 to the nearest level.
+constexpr uint8_t faceLevel(uint8_t intensity) {
+    return (uint8_t)((intensity * (FACE_INTENSITY_LEVELS - 1) + 127) / 255);
+}
+
+constexpr uint16_t faceLabelColor(uint16_t fillBase) { return (fillBase == COLOR_YELLOW) ? COLOR_BLACK : COLOR_WHITE; }
+
+constexpr TileGfx::Palette facePalette(uint16_t fill, uint16_t outline, uint16_t label) {
+    TileGfx::Palette p;
+    p.c[1] = fill;
+    p.c[2] = outline;
+    p.c[3] = label;
+    return p;
+}
+
+// Unlit faces: fill at 90/255, outline at 180/255.
+static inline constexpr TileGfx::Palette FACE_IDLE[FACE_COUNT] = {
+    facePalette(Pixel565::scale(COL_X, 90), Pixel565::scale(COL_X, 180), faceLabelColor(COL_X)),
+    facePalette(Pixel565::scale(COL_Y, 90), Pixel565::scale(COL_Y, 180), faceLabelColor(COL_Y)),
+    facePalette(Pixel565::scale(COL_A, 90), Pixel565::scale(COL_A, 180), faceLabelColor(COL_A)),
+    facePalette(Pixel565::scale(COL_B, 90), Pixel565::scale(COL_B, 180), faceLabelColor(COL_B)),
+};
@@ -3,14 +3,18 @@
 #include <math.h>
 #include <ESP32-HUB75-MatrixPanel-I2S-DMA.h>
 #include "../../engine/GameBase.h"
+#include "../../engine/Snapshot.h"
 #include "../../engine/ControllerManager.h"
 #include "../../engine/config.h"
+#include "../../engine/Raster.h"
 #include "../../engine/AudioManager.h"
+#include "../../engine/NetPlay.h"
 #include "../../component/SmallFont.h"
 #include "../../engine/Settings.h"
 #include "../../engine/UserProfiles.h"
 #include "../../component/GameOverLeaderboardView.h"
 #include "SnakeGameConfig.h"
+#include "SnakeGameAi.h"
 
 // Local aliases for readability (these are all tweakable in SnakeGameConfig.h)
 static constexpr int HUD_HEIGHT = SnakeGameConfig::HUD_HEIGHT;
@@ -117,6 +121,7 @@ public:
     Direction nextDir;
     uint16_t color;
     bool enabled;
+    bool isAi;     // CPU-controlled (fills an empty controller slot)
     bool alive;
     bool dying;
     uint32_t deathStartMs;
@@ -132,6 +137,7 @@ public:
         nextDir(NONE),
         color(COLOR_GREEN),
         enabled(false),
+        isAi(false),
         alive(false),
         dying(false),
         deathStartMs(0),
@@ -141,15 +147,17 @@ public:
         body.clear();
     }
 
-    void init(int idx, int x, int y, uint16_t c) {
+    void init(int idx, int x, int y, uint16_t c, bool ai = false) {
         playerIndex = idx;
         color = c;
         enabled = true;
+        isAi = ai;
         reset(x, y);
     }
 
     void disable() {
         enabled = false;
+        isAi = false;
         alive = false;
         dying = false;
         deathStartMs = 0;
@@ -176,19 +184,6 @@ public:
         bulgeIndex = -1;
     }
 
-    // Bluepad32 analog helper (SFINAE) so we don't hard-depend on a single API surface.
-    struct InputDetail {
-        template <typename T>
-        static auto axisX(T* c, int) -> decltype(c->axisX(), int16_t()) { return (int16_t)c->axisX(); }
-        template <typename T>
-        static int16_t axisX(T*, ...) { return 0; }
-
-        template <typename T>
-        static auto axisY(T* c, int) -> decltype(c->axisY(), int16_t()) { return (int16_t)c->axisY(); }
-        template <typename T>
-        static int16_t axisY(T*, ...) { return 0; }
-    };
-
     static inline float clampf(float v, float lo, float hi) { return (v < lo) ? lo : (v > hi) ? hi : v; }
     static inline float deadzone01(float v, float dz) {
         const float a = fabsf(v);
@@ -202,15 +197,23 @@ public:
                (a == LEFT && b == RIGHT) || (a == RIGHT && b == LEFT);
     }
 
-    void handleInput(ControllerPtr ctl) {
-        if (!ctl || !ctl->isConnected()) return;
+    void handleInput(const PadState& pad) {
+        if (!pad.connected) return;
+        steer(pad.dpad, pad.axisX, pad.axisY);
+    }
 
+    // Linked play: NetInput carries the stick at 1/4 resolution.
+    void handleInput(const NetInput& in) {
+        steer(in.dpad, (int16_t)(in.axisX * 4), (int16_t)(in.axisY * 4));
+    }
+
+    void steer(uint8_t dpad, int16_t axisX, int16_t axisY) {
         // Prefer analog stick (dominant axis), fallback to D-pad.
         static constexpr float STICK_DEADZONE = 0.22f;
         static constexpr int16_t AXIS_DIVISOR = 512;
 
-        const float ax = clampf((float)InputDetail::axisX(ctl, 0) / (float)AXIS_DIVISOR, -1.0f, 1.0f);
-        const float ay = clampf((float)InputDetail::axisY(ctl, 0) / (float)AXIS_DIVISOR, -1.0f, 1.0f);
+        const float ax = clampf((float)axisX / (float)AXIS_DIVISOR, -1.0f, 1.0f);
+        const float ay = clampf((float)axisY / (float)AXIS_DIVISOR, -1.0f, 1.0f);
         const float sx = deadzone01(ax, STICK_DEADZONE);
         const float sy = deadzone01(ay, STICK_DEADZONE);
 
@@ -220,7 +223,7 @@ public:
             if (fabsf(sx) >= fabsf(sy)) desired = (sx < 0) ? LEFT : RIGHT;
             else desired = (sy < 0) ? UP : DOWN;
         } else {
-            const uint8_t d = ctl->dpad();
+            const uint8_t d = dpad;
             if (d & 0x01) desired = UP;
             else if (d & 0x02) desired = DOWN;
             else if (d & 0x04) desired = RIGHT;
@@ -254,7 +257,14 @@ public:
     }
 };
 
-class SnakeGame : public GameBase {
+/**
+ * SnakeGame - multiplayer Snake with CPU snakes in empty controller slots.
+ *
+ * Linked play (engine/NetPlay.h): with a peer cabinet around, start() runs a
+ * lockstep match instead: one snake per cabinet (slot 0 and 1 = NetPlay sides),
+ * CPU snakes in the other slots, food from the session DetRandom.
+ */
+class SnakeGame : public GameBase, public NetGame {
 private:
     Snake snakes[SnakeGameConfig::MAX_SNAKES];
     FoodItem foods[SnakeGameConfig::MAX_FOODS];
@@ -275,6 +285,69 @@ private:
         COLOR_GREEN, COLOR_CYAN, COLOR_ORANGE, COLOR_PURPLE
     };
 
+    // Autopilot board view, rebuilt at most once per move tick (shared by all bots).
+    SnakeGameAi::CellSet aiBlocked;
+
+    // ---------------------------------------------------------
+    // Linked play (see engine/NetPlay.h)
+    // ---------------------------------------------------------
+    // In net mode the match runs on a virtual clock (NET_FRAME_MS per net frame)
+    // and all randomness comes from `rng`, so both cabinets simulate identically.
+    // Local matches use `rng` too (seeded from random()).
+    static constexpr uint32_t NET_FRAME_MS = SnakeGameConfig::NET_FRAME_MS;
+    bool netMode = false;
+    bool netSeeded = false;
+    bool linkLost = false;
+    bool replaying = false;   // NetPlay is re-simulating after a rollback (mute SFX)
+    uint32_t simFrame = 0;    // net frames simulated
+    uint32_t endFrame = 0;    // net frame that ended the match
+    uint32_t netWaitStartMs = 0;
+    uint32_t lastNetFrameMs = 0;
+    DetRandom rng;
+
+    // Bodies are rings that only gain a head or lose a tail per tick, and
+    // clearing one only resets its indices, so a state slot keeps the ring
+    // position and length and the cells stay where they were. Linked snakes stop
+    // growing this far below the ring size, so a rollback's worth of new heads
+    // never overwrites a saved body.
+    static constexpr uint16_t NET_MAX_LEN = Snake::BodyRing::MAX_LEN - NetPlay::STATE_SLOTS;
+    struct NetSnake {
+        uint16_t headIdx;
+        uint16_t len;
+        Direction dir;
+        Direction nextDir;
+        bool alive;
+        bool dying;
+        uint32_t deathStartMs;
+        int score;
+        int bulgeIndex;
+    };
+    // Everything netStep() reads or writes.
+    struct NetState {
+        NetSnake snakes[SnakeGameConfig::MAX_SNAKES];
+        FoodItem foods[SnakeGameConfig::MAX_FOODS];
+        uint8_t foodCount;
+        Phase phase;
+        uint32_t phaseStartMs;
+        uint32_t lastMove;
+        bool gameOver;
+        uint32_t simFrame;
+        uint32_t endFrame;
+        DetRandom rng;
+    };
+    NetState netSlots[NetPlay::STATE_SLOTS];
+
+    // The snake this cabinet's pad 0 steers.
+    uint8_t localSlot() const { return netMode ? globalNetPlay.localSide() : 0; }
+
+    // Timestamps are on the net frame clock in linked play.
+    uint32_t clockMs() const { return netMode ? simFrame * NET_FRAME_MS : (uint32_t)millis(); }
+
+    // Player 1's snake (this cabinet's, when linked) takes the global player color.
+    uint16_t snakeColor(int i) const {
+        return (i == (int)localSlot()) ? globalSettings.getPlayerColor() : playerColors[i];
+    }
+
     static inline int pointsForFood(FoodKind k) {
         switch (k) {
             case FOOD_APPLE: return 10;
@@ -293,9 +366,9 @@ private:
         return SnakeGameConfig::CREATURE_TTL_MS;
     }
 
-    static inline FoodKind chooseNextFoodKind() {
+    FoodKind chooseNextFoodKind() {
         // Weighted: mostly apples, occasional creatures.
-        const int r = random(0, 100);
+        const int r = rng.range(0, 100);
         const int t0 = SnakeGameConfig::FOOD_WEIGHT_APPLE;
         const int t1 = t0 + SnakeGameConfig::FOOD_WEIGHT_MOUSE;
         const int t2 = t1 + SnakeGameConfig::FOOD_WEIGHT_FROG;
@@ -348,16 +421,17 @@ private:
      * - Moving UP or LEFT must NOT produce a sound.
      *
      * Implementation:
-     * - We only play for Player 1 (pad index 0) to keep multiplayer from
-     *   becoming a wall of beeps.
+     * - We only play for Player 1 (this cabinet's snake when linked) to keep
+     *   multiplayer from becoming a wall of beeps.
      * - We emit a tiny non-blocking tone once per movement tick when the
      *   direction is RIGHT or DOWN.
      *
      * Notes:
      * - `globalAudio` internally respects Settings.soundEnabled + volume.
      */
-    static inline void playMoveSfxIfAllowed(const Snake& s) {
-        if (s.playerIndex != 0) return;                // minimal: only Player 1
+    inline void playMoveSfxIfAllowed(const Snake& s) const {
+        if (s.isAi || replaying) return;               // bots (and rollback replays) stay silent
+        if (s.playerIndex != (int)localSlot()) return; // minimal: only Player 1
         if (s.dir == UP || s.dir == LEFT) return;      // explicit: no sound for UP/LEFT
         if (s.dir != RIGHT && s.dir != DOWN) return;   // ignore NONE/unknown
 
@@ -365,7 +439,7 @@ private:
         globalAudio.playTone(1320 /*Hz*/, 8 /*ms*/);
     }
 
-    void spawnFood(FoodKind kind = FOOD_APPLE) {
+    void spawnFood(FoodKind kind, uint32_t now) {
         bool ok;
         FoodItem f;
         do {
@@ -376,11 +450,11 @@ private:
             f.hCells = h;
 
             // Keep within bounds for a multi-cell hitbox.
-            f.p.x = (int16_t)random(0, max(1, LOGICAL_WIDTH - (int)w));
-            f.p.y = (int16_t)random(0, max(1, LOGICAL_HEIGHT - (int)h));
+            f.p.x = (int16_t)rng.range(0, max(1, LOGICAL_WIDTH - (int)w));
+            f.p.y = (int16_t)rng.range(0, max(1, LOGICAL_HEIGHT - (int)h));
             f.kind = kind;
             const uint32_t ttl = ttlForFoodMs(kind);
-            f.expireMs = (ttl == 0) ? 0 : (millis() + ttl);
+            f.expireMs = (ttl == 0) ? 0 : (now + ttl);
 
             for (uint8_t si = 0; si < SnakeGameConfig::MAX_SNAKES; si++) {
                 Snake& s = snakes[si];
@@ -410,73 +484,72 @@ private:
             foods[foodCount++] = f;
         } else {
             // Shouldn't happen because we keep foodCount capped, but guard anyway.
-            foods[random(0, (int)SnakeGameConfig::MAX_FOODS)] = f;
+            foods[rng.range(0, (int)SnakeGameConfig::MAX_FOODS)] = f;
         }
     }
 
-public:
-    SnakeGame() {
-        lastMove = 0;
-        gameOver = false;
-        phase = PHASE_COUNTDOWN;
-        phaseStartMs = 0;
-        foodCount = 0;
-        playerCountAtStart = 0;
-        for (uint8_t i = 0; i < SnakeGameConfig::MAX_SNAKES; i++) snakes[i].disable();
+    static inline uint16_t aiCell(const Point& p) {
+        return SnakeGameAi::cellOf(p.x, p.y);
     }
 
-    /**
-     * Snake updates at a fixed tick rate (`SnakeGameConfig::MOVE_TICK_MS`).
-     * Rendering faster than that doesn't improve gameplay, but it *does*
-     * increase display bandwidth and can surface HUB75 ghosting artifacts on
-     * some panels (especially with lots of black background).
-     */
-    uint16_t preferredRenderFps() const override {
-        if (SnakeGameConfig::MOVE_TICK_MS == 0) return GAME_RENDER_FPS;
-        uint16_t fps = (uint16_t)(1000UL / (uint32_t)SnakeGameConfig::MOVE_TICK_MS);
-        if (fps < 10) fps = 10; // keep UI responsive / flashing visible
-        if (fps > GAME_RENDER_FPS) fps = GAME_RENDER_FPS;
-        return fps;
+    // Cells that stay occupied after this tick: every live body minus its tail
+    // (tails vacate unless the snake eats, which the flood-fill margin covers).
+    void buildAiBoard() {
+        aiBlocked.clear();
+        for (uint8_t si = 0; si < SnakeGameConfig::MAX_SNAKES; si++) {
+            const Snake& s = snakes[si];
+            if (!s.enabled || !s.alive) continue;
+            const uint16_t len = s.body.size();
+            const uint16_t keep = (len > 1) ? (uint16_t)(len - 1) : len;
+            for (uint16_t k = 0; k < keep; k++) aiBlocked.set(aiCell(s.body.at(k)));
+        }
     }
 
-    void start() override {
-        gameOver = false;
-        phase = PHASE_COUNTDOWN;
-        phaseStartMs = millis();
-        lastMove = phaseStartMs;
-        foodCount = 0;
-        playerCountAtStart = 0;
-
-        for (uint8_t i = 0; i < SnakeGameConfig::MAX_SNAKES; i++) snakes[i].disable();
-
-        // Apply current global player color for Player 1 (pad index 0).
-        // This allows changing the color in the main menu and having it reflect here.
-        playerColors[0] = globalSettings.getPlayerColor();
+    void steerAi(Snake& s) {
+        // Head-on risk: cells any other live head can step into this tick.
+        SnakeGameAi::CellSet contested;
+        contested.clear();
+        for (uint8_t si = 0; si < SnakeGameConfig::MAX_SNAKES; si++) {
+            const Snake& o = snakes[si];
+            if (&o == &s || !o.enabled || !o.alive || o.body.empty()) continue;
+            const uint16_t oh = aiCell(o.body.head());
+            for (uint8_t d = 0; d < 4; d++) contested.set(SnakeGameAi::stepCell(oh, d));
+        }
 
-        // Create snakes first so food never spawns on top of a snake on round start.
-        for (int i = 0; i < MAX_GAMEPADS; i++) {
-            if (globalControllerManager->getController(i)) {
-                snakes[i].init(
-                    i,
-                    (int)(LOGICAL_WIDTH / 2 + i * 2),
-                    (int)(LOGICAL_HEIGHT / 2),
-                    playerColors[i]
-                );
-                playerCountAtStart++;
+        // Every cell covered by a food hitbox is a goal.
+        uint16_t foodCells[SnakeGameConfig::MAX_FOODS * 4];
+        uint8_t foodCellCount = 0;
+        for (uint8_t fi = 0; fi < foodCount; fi++) {
+            const FoodItem& f = foods[fi];
+            for (int yy = 0; yy < (int)f.hCells; yy++) {
+                for (int xx = 0; xx < (int)f.wCells; xx++) {
+                    if (foodCellCount >= (uint8_t)(sizeof(foodCells) / sizeof(foodCells[0]))) break;
+                    foodCells[foodCellCount++] = SnakeGameAi::cellOf(f.p.x + xx, f.p.y + yy);
+                }
             }
         }
 
-        // Spawn multiple foods after snakes exist (so spawnFood() can avoid them).
-        for (uint8_t i = 0; i < SnakeGameConfig::MAX_FOODS; i++) spawnFood(chooseNextFoodKind());
-    }
-
-    void reset() override {
-        start();
+#if DEBUG_GAME_STATS
+        const uint32_t t0 = micros();
+#endif
+        const uint8_t d = SnakeGameAi::decide(aiBlocked, contested,
+                                              aiCell(s.body.head()), aiCell(s.body.tail()), s.body.size(),
+                                              (uint8_t)s.dir, foodCells, foodCellCount,
+                                              SnakeGameConfig::AI_DECISION_BUDGET_US,
+                                              netMode ? SnakeGameConfig::AI_NET_WORK_LIMIT : 0);
+#if DEBUG_GAME_STATS
+        SnakeGameAi::gStats.decision((uint32_t)(micros() - t0), SnakeGameConfig::AI_DECISION_BUDGET_US);
+#endif
+        if (d < SnakeGameAi::DIR_NONE && !Snake::isOpposite(s.dir, (Direction)d)) s.nextDir = (Direction)d;
     }
 
-    void update(ControllerManager* input) override {
+    /**
+     * One logic step. Shared by local play (real clock, pads read from `input`)
+     * and linked play (net frame clock, side inputs in `net`, `input` unused).
+     */
+    void simulate(uint32_t now, ControllerManager* input, const NetInput* net) {
         if (gameOver) return;
-        const uint32_t now = millis();
+
 
         // Remove expired creature foods (keeps the playfield feeling alive)
         for (uint8_t i = 0; i < foodCount;) {
@@ -484,7 +557,7 @@ public:
                 // Remove by shifting down.
                 for (uint8_t j = i + 1; j < foodCount; j++) foods[j - 1] = foods[j];
                 if (foodCount > 0) foodCount--;
-                spawnFood(chooseNextFoodKind());
+                spawnFood(chooseNextFoodKind(), now);
             } else {
                 i++;
             }
@@ -510,7 +583,7 @@ public:
             bool anyDying = false;
             for (uint8_t si = 0; si < SnakeGameConfig::MAX_SNAKES; si++) {
                 Snake& s = snakes[si];
-                if (!s.enabled) continue;
+                if (!s.enabled || s.isAi) continue; // bots don't keep the round going
                 if (s.alive) anyAlive = true;
                 if (s.dying) anyDying = true;
             }
@@ -525,9 +598,9 @@ public:
         if (phase == PHASE_COUNTDOWN) {
             for (uint8_t si = 0; si < SnakeGameConfig::MAX_SNAKES; si++) {
                 Snake& s = snakes[si];
-                if (!s.enabled || !s.alive) continue;
-                ControllerPtr ctl = input->getController(s.playerIndex);
-                if (ctl) s.handleInput(ctl);
+                if (!s.enabled || !s.alive || s.isAi) continue;
+                if (net) s.handleInput(net[s.playerIndex]);
+                else s.handleInput(input->pad(s.playerIndex));
             }
             if ((uint32_t)(now - phaseStartMs) >= COUNTDOWN_MS) {
                 phase = PHASE_PLAYING;
@@ -564,19 +637,31 @@ public:
         for (uint8_t i = 0; i < n; i++) foodHitIndex[i] = -1;
 
         // 1) Inputs + next heads
+        bool aiBoardReady = false;
         for (uint8_t i = 0; i < n; i++) {
             Snake& s = snakes[activeIdx[i]];
             if (!s.alive) continue;
 
-            ControllerPtr ctl = input->getController(s.playerIndex);
-            if (!ctl) {
-                s.alive = false;
-                s.dying = true;
-                s.deathStartMs = now;
-                continue;
+            if (s.isAi) {
+                // No snake has moved yet this tick, so one board serves every bot.
+                if (!aiBoardReady) {
+                    buildAiBoard();
+                    aiBoardReady = true;
+                }
+                steerAi(s);
+            } else if (net) {
+                // Slot 0/1 = NetPlay side 0/1.
+                s.handleInput(net[s.playerIndex]);
+            } else {
+                const PadState& pad = input->pad(s.playerIndex);
+                if (!pad.connected) {
+                    s.alive = false;
+                    s.dying = true;
+                    s.deathStartMs = now;
+                    continue;
+                }
+                s.handleInput(pad);
             }
-
-            s.handleInput(ctl);
             s.dir = s.nextDir;
 
             // Minimal movement SFX (RIGHT/DOWN only; no UP/LEFT).
@@ -598,8 +683,10 @@ public:
             nextHead[i] = nh;
             willMove[i] = true;
 
-            // Determine if this move would eat food (resolved later)
-            for (uint8_t fi = 0; fi < foodCount; fi++) {
+            // Determine if this move would eat food (resolved later).
+            // Linked snakes at NET_MAX_LEN pass over food instead.
+            const bool canGrow = !netMode || s.body.size() < NET_MAX_LEN;
+            for (uint8_t fi = 0; canGrow && fi < foodCount; fi++) {
                 if (pointInFood(foods[fi], nh)) {
                     willGrow[i] = true;
                     foodHitIndex[i] = (int8_t)fi;
@@ -689,6 +776,9 @@ public:
                 s.alive = false;
                 s.dying = true;
                 s.deathStartMs = now;
+#if DEBUG_GAME_STATS
+                if (s.isAi) SnakeGameAi::gStats.deaths++;
+#endif
                 continue;
             }
 
@@ -703,7 +793,7 @@ public:
                     if (foodCount > 0) foodCount--;
                     // Start a new bulge right behind the head.
                     s.bulgeIndex = 1;
-                    spawnFood(chooseNextFoodKind());
+                    spawnFood(chooseNextFoodKind(), now);
                 }
             }
         }
@@ -712,7 +802,7 @@ public:
         bool anyDying = false;
         for (uint8_t si = 0; si < SnakeGameConfig::MAX_SNAKES; si++) {
             Snake& s = snakes[si];
-            if (!s.enabled) continue;
+            if (!s.enabled || s.isAi) continue;
             if (s.alive) anyAlive = true;
             if (s.dying) anyDying = true;
         }
@@ -722,6 +812,150 @@ public:
         }
     }
 
+    void updateNet(ControllerManager* input) {
+        if (isGameOver()) return;
+        if (globalNetPlay.sessionLost()) {
+            linkLost = true;
+            gameOver = true;
+            return;
+        }
+        if (!globalNetPlay.sessionRunning()) {
+            // "WAIT PEER": the other cabinet may never start Snake. Play here
+            // instead once it's gone quiet, the wait times out, or on B.
+            if (!globalNetPlay.linked() || input->pad(0).held(PadState::BTN_B) ||
+                (uint32_t)(millis() - netWaitStartMs) >= SnakeGameConfig::NET_PEER_WAIT_MS) {
+                globalNetPlay.endSession();
+                begin(/*tryLink=*/false);
+            }
+            return;
+        }
+
+        if (!netSeeded) {
+            // Same starting state on both cabinets.
+            netSeeded = true;
+            rng.seed(globalNetPlay.sessionSeed());
+            beginMatch(0);
+        }
+        // This cabinet's pad 0 drives our snake; the peer's arrives over the link.
+        globalNetPlay.tick(*this, NetInput::sample(input->pad(0)));
+    }
+
+    // Linked match when `tryLink` and a peer cabinet is around, else local play.
+    void begin(bool tryLink) {
+        gameOver = false;
+        phase = PHASE_COUNTDOWN;
+        foodCount = 0;
+        playerCountAtStart = 0;
+        for (uint8_t i = 0; i < SnakeGameConfig::MAX_SNAKES; i++) snakes[i].disable();
+
+        netMode = tryLink && globalNetPlay.linked();
+        netSeeded = false;
+        linkLost = false;
+        simFrame = 0;
+        endFrame = 0;
+        netWaitStartMs = millis();
+        lastNetFrameMs = netWaitStartMs;
+        if (netMode) {
+            // The match starts once the peer has joined (updateNet()).
+            globalNetPlay.startSession(SnakeGameConfig::NET_GAME_ID);
+            return;
+        }
+        rng.seed((uint32_t)random(1, 0x7FFFFFFF));
+        beginMatch(millis());
+    }
+
+    void beginMatch(uint32_t now) {
+        phase = PHASE_COUNTDOWN;
+        phaseStartMs = now;
+        lastMove = now;
+
+        // Create snakes first so food never spawns on top of a snake on round start.
+        // Humans: connected pads, or one snake per cabinet when linked.
+        for (int i = 0; i < MAX_GAMEPADS; i++) {
+            const bool human = netMode ? (i < 2) : globalControllerManager->pad(i).connected;
+            if (human) {
+                snakes[i].init(
+                    i,
+                    (int)(LOGICAL_WIDTH / 2 + i * 2),
+                    (int)(LOGICAL_HEIGHT / 2),
+                    snakeColor(i)
+                );
+                playerCountAtStart++;
+            }
+        }
+
+        // Fill empty slots with CPU snakes.
+        if (SnakeGameConfig::AI_FILL_EMPTY_SLOTS) {
+            uint8_t bots = 0;
+            for (int i = 0; i < MAX_GAMEPADS && bots < SnakeGameConfig::MAX_AI_SNAKES; i++) {
+                if (snakes[i].enabled) continue;
+                snakes[i].init(
+                    i,
+                    (int)(LOGICAL_WIDTH / 2 + i * 2),
+                    (int)(LOGICAL_HEIGHT / 2),
+                    snakeColor(i),
+                    true
+                );
+                bots++;
+#if DEBUG_GAME_STATS
+                SnakeGameAi::gStats.spawned++;
+#endif
+            }
+        }
+
+        // Spawn multiple foods after snakes exist (so spawnFood() can avoid them).
+        for (uint8_t i = 0; i < SnakeGameConfig::MAX_FOODS; i++) spawnFood(chooseNextFoodKind(), now);
+    }
+
+public:
+    SnakeGame() {
+        lastMove = 0;
+        gameOver = false;
+        phase = PHASE_COUNTDOWN;
+        phaseStartMs = 0;
+        foodCount = 0;
+        playerCountAtStart = 0;
+        for (uint8_t i = 0; i < SnakeGameConfig::MAX_SNAKES; i++) snakes[i].disable();
+    }
+
+    ~SnakeGame() override {
+        if (netMode) globalNetPlay.endSession();
+    }
+
+    /**
+     * Snake updates at a fixed tick rate (`SnakeGameConfig::MOVE_TICK_MS`).
+     * Rendering faster than that doesn't improve gameplay, but it *does*
+     * increase display bandwidth and can surface HUB75 ghosting artifacts on
+     * some panels (especially with lots of black background).
+     */
+    uint16_t preferredRenderFps() const override {
+        if (SnakeGameConfig::MOVE_TICK_MS == 0) return GAME_RENDER_FPS;
+        uint16_t fps = (uint16_t)(1000UL / (uint32_t)SnakeGameConfig::MOVE_TICK_MS);
+        if (fps < 10) fps = 10; // keep UI responsive / flashing visible
+        if (fps > GAME_RENDER_FPS) fps = GAME_RENDER_FPS;
+        return fps;
+    }
+
+    void start() override {
+        begin(/*tryLink=*/true);
+    }
+
+    void reset() override {
+        start();
+    }
+
+    void update(ControllerManager* input) override {
+        if (netMode) {
+            const uint32_t now = millis();
+            if ((uint32_t)(now - lastNetFrameMs) < NET_FRAME_MS) return;
+            lastNetFrameMs = now;
+            updateNet(input);
+            return;
+        }
+        if (gameOver) return;
+        simulate(millis(), input, nullptr);
+    }
+
     void draw(MatrixPanel_I2S_DMA* display) override {
         // Keep our project palette as requested:
         // - black background
@@ -731,14 +965,30 @@ public:
         // - standard HUD
         display->fillScreen(COLOR_BLACK);
 
-        if (gameOver) {
+        if (netMode && !netSeeded && !linkLost) {
+            SmallFont::drawString(display, 14, 30, "WAIT PEER", COLOR_YELLOW);
+            const uint32_t waited = (uint32_t)(millis() - netWaitStartMs);
+            const uint32_t secsLeft = (waited < SnakeGameConfig::NET_PEER_WAIT_MS) ? (SnakeGameConfig::NET_PEER_WAIT_MS - waited + 999) / 1000 : 0;
+            SmallFont::drawStringF(display, 14, 40, COLOR_CYAN, "B SOLO %lu", (unsigned long)secsLeft);
+            return;
+        }
+
+        if (isGameOver()) {
             // -----------------------------------------------------
             // GAME OVER + per-game leaderboard view
             // -----------------------------------------------------
+            const char* title = "GAME OVER";
+            if (linkLost) title = "LINK LOST";
+            else if (netMode) {
+                // Linked: the higher score of the two cabinets' snakes wins.
+                const int mine = snakes[localSlot()].score;
+                const int theirs = snakes[localSlot() ^ 1].score;
+                title = (mine > theirs) ? "YOU WIN" : (mine < theirs) ? "YOU LOSE" : "DRAW";
+            }
             const uint32_t score = leaderboardScore();
             char tag[4];
             UserProfiles::getPadTag(0, tag);
-            GameOverLeaderboardView::draw(display, "GAME OVER", leaderboardId(), score, tag);
+            GameOverLeaderboardView::draw(display, title, leaderboardId(), score, tag);
             return;
         }
 
@@ -753,22 +1003,28 @@ public:
             activeIdx[n++] = si;
         }
 
+        uint8_t humans = 0;
         for (uint8_t i = 0; i < n; i++) {
             char buf[10];
             Snake& s = snakes[activeIdx[i]];
-            snprintf(buf, sizeof(buf), "P%u:%d", (unsigned)i + 1u, s.score);
+            // "P" = human player, "C" = CPU snake.
+            snprintf(buf, sizeof(buf), "%c%u:%d", s.isAi ? 'C' : 'P', (unsigned)i + 1u, s.score);
             SmallFont::drawString(display, hudX, hudY, buf, s.color);
             hudX += 16;
+            if (!s.isAi) humans++;
+        }
+        // Player count only fits while the HUD has a free column.
+        if (n < SnakeGameConfig::MAX_SNAKES) {
+            char pbuf[8];
+            snprintf(pbuf, sizeof(pbuf), "%dP", (int)humans);
+            SmallFont::drawString(display, PANEL_RES_X - 14, hudY, pbuf, COLOR_YELLOW);
         }
-        char pbuf[8];
-        snprintf(pbuf, sizeof(pbuf), "%dP", (int)n);
-        SmallFont::drawString(display, PANEL_RES_X - 14, hudY, pbuf, COLOR_YELLOW);
 
         // HUD divider
-        for (int x = 0; x < PANEL_RES_X; x += 2) display->drawPixel(x, HUD_HEIGHT - 1, COLOR_BLUE);
+        Raster::dashedHLine(display, 0, HUD_HEIGHT - 1, PANEL_RES_X, COLOR_BLUE);
 
         // Playfield border (inset to avoid using edge pixels)
-        display->drawRect(PLAYFIELD_BORDER_X, PLAYFIELD_BORDER_Y, PLAYFIELD_BORDER_W, PLAYFIELD_BORDER_H, COLOR_WHITE);
+        Raster::rect(display, PLAYFIELD_BORDER_X, PLAYFIELD_BORDER_Y, PLAYFIELD_BORDER_W, PLAYFIELD_BORDER_H, COLOR_WHITE);
 
         // Helper to draw a small rect but avoid spilling into the last row/col.
         // This preserves game logic while keeping everything aligned to edges.
@@ -827,7 +1083,7 @@ public:
             // Alive snakes draw always. Dead snakes blink for a short time, then disappear.
             bool drawSnake = s.alive;
             if (!drawSnake && s.dying) {
-                const uint32_t now = millis();
+                const uint32_t now = clockMs();
                 if ((uint32_t)(now - s.deathStartMs) < DEATH_BLINK_TOTAL_MS) {
                     drawSnake = (((now / DEATH_BLINK_PERIOD_MS) % 2) == 0);
                 }
@@ -835,7 +1091,7 @@ public:
             if (!drawSnake) continue;
 
             // Determine if mouth should be open: if the next move will eat a food hitbox and it's "soon".
-            const uint32_t nowMs = millis();
+            const uint32_t nowMs = clockMs();
             const uint32_t dt = (uint32_t)(nowMs - lastMove);
             const uint32_t tickMs = (uint32_t)SnakeGameConfig::MOVE_TICK_MS;
             const uint32_t msToMove = (dt >= tickMs) ? 0u : (tickMs - dt);
@@ -951,7 +1207,7 @@ public:
 
         // Countdown overlay (during round start)
         if (phase == PHASE_COUNTDOWN) {
-            const uint32_t now = millis();
+            const uint32_t now = clockMs();
             const uint32_t elapsed = (uint32_t)(now - phaseStartMs);
             int secsLeft = 3 - (int)(elapsed / 1000UL);
             if (secsLeft < 1) secsLeft = 1;
@@ -961,7 +1217,9 @@ public:
     }
 
     bool isGameOver() override {
-        return gameOver;
+        // Linked: a predicted game over only counts once no rollback can undo it.
+        if (!netMode || linkLost) return gameOver;
+        return gameOver && (int32_t)endFrame <= globalNetPlay.confirmedFrame();
     }
 
     // ------------------------------
@@ -971,11 +1229,260 @@ public:
     const char* leaderboardId() const override { return "snake"; }
     const char* leaderboardName() const override { return "Snake"; }
     uint32_t leaderboardScore() const override {
-        // Multiplayer: submit the best individual score of the round.
+        // Linked: this cabinet's snake. Multiplayer: the best individual (human) score of the round.
+        if (netMode) return (uint32_t)max(0, snakes[localSlot()].score);
         uint32_t best = 0;
         for (const auto& s : snakes) {
+            if (s.isAi) continue;
             if ((uint32_t)s.score > best) best = (uint32_t)s.score;
         }
         return best;
     }
+
+    // ------------------------------
+    // Self-check (DEBUG_INVARIANTS)
+    // ------------------------------
+    const char* checkInvariants() const override {
+        if (foodCount > SnakeGameConfig::MAX_FOODS) return "food count above MAX_FOODS";
+        for (uint8_t fi = 0; fi < foodCount; fi++) {
+            const FoodItem& f = foods[fi];
+            if (f.p.x < 0 || f.p.y < 0 || f.p.x + f.wCells > LOGICAL_WIDTH || f.p.y + f.hCells > LOGICAL_HEIGHT) {
+                return "food hitbox off grid";
+            }
+        }
+        // Live snakes are unbroken chains of grid neighbours (wrapping) and never
+        // share a cell: any collision kills the snake in the same tick.
+        SnakeGameAi::CellSet occupied;
+        occupied.clear();
+        for (uint8_t si = 0; si < SnakeGameConfig::MAX_SNAKES; si++) {
+            const Snake& sn = snakes[si];
+            if (!sn.enabled) {
+                if (sn.alive || sn.dying) return "disabled snake alive or dying";
+                continue;
+            }
+            if (!sn.alive) continue;
+            if (sn.body.empty() || sn.body.size() > Snake::BodyRing::MAX_LEN) return "live snake length out of range";
+            if (sn.dir == NONE) return "live snake without a direction";
+            if (sn.bulgeIndex >= (int)sn.body.size()) return "bulge past the tail";
+            for (uint16_t k = 0; k < sn.body.size(); k++) {
+                const Point& p = sn.body.at(k);
+                if (p.x < 0 || p.x >= LOGICAL_WIDTH || p.y < 0 || p.y >= LOGICAL_HEIGHT) return "snake segment off grid";
+                if (k > 0 && SnakeGameAi::torusDist(aiCell(p), aiCell(sn.body.at((uint16_t)(k - 1)))) != 1) {
+                    return "snake body not contiguous";
+                }
+                const uint16_t c = aiCell(p);
+                if (occupied.test(c)) return "live snakes overlap";
+                occupied.set(c);
+            }
+        }
+        return nullptr;
+    }
+
+    // ------------------------------
+    // Snapshots (engine/Snapshot.h)
+    // ------------------------------
+    // A linked match can't be resumed without the peer.
+    uint8_t snapshotVersion() const override { return netMode ? 0 : 1; }
+
+    void saveSnapshot(SnapshotWriter& w) const override {
+        w.boolean(gameOver);
+        w.u8((uint8_t)phase);
+        w.time(phaseStartMs);
+        w.time((uint32_t)lastMove);
+        w.u8(playerCountAtStart);
+
+        for (const Snake& sn : snakes) {
+            w.bits(sn.enabled, 1);
+            w.bits(sn.isAi, 1);
+            w.bits(sn.alive, 1);
+            w.bits(sn.dying, 1);
+            w.u8((uint8_t)sn.dir);
+            w.u8((uint8_t)sn.nextDir);
+            w.u16(sn.color);
+            w.time(sn.deathStartMs);
+            w.i32(sn.score);
+            w.u8((uint8_t)(sn.playerIndex + 1));
+            w.i16((int16_t)sn.bulgeIndex);
+
+            // Body: head cell, then one 2-bit step per segment (segments are always
+            // grid neighbours, modulo wrap-around). Raw cells as a fallback.
+            const uint16_t len = sn.body.size();
+            w.u16(len);
+            if (len == 0) continue;
+            bool packed = true;
+            for (uint16_t i = 1; i < len && packed; i++) packed = (bodyStep(sn.body.at(i - 1), sn.body.at(i)) >= 0);
+            w.boolean(packed);
+            w.u8((uint8_t)sn.body.head().x);
+            w.u8((uint8_t)sn.body.head().y);
+            for (uint16_t i = 1; i < len; i++) {
+                if (packed) w.bits((uint32_t)bodyStep(sn.body.at(i - 1), sn.body.at(i)), 2);
+                else { w.u8((uint8_t)sn.body.at(i).x); w.u8((uint8_t)sn.body.at(i).y); }
+            }
+        }
+
+        w.u8(foodCount);
+        for (uint8_t i = 0; i < foodCount; i++) {
+            const FoodItem& f = foods[i];
+            w.u8((uint8_t)f.p.x);
+            w.u8((uint8_t)f.p.y);
+            w.u8((uint8_t)f.kind);
+            w.u8(f.wCells);
+            w.u8(f.hCells);
+            w.time(f.expireMs);
+        }
+    }
+
+    bool loadSnapshot(SnapshotReader& r) override {
+        gameOver = r.boolean();
+        phase = (Phase)r.below(PHASE_GAME_OVER + 1);
+        phaseStartMs = r.time();
+        lastMove = r.time();
+        playerCountAtStart = r.u8();
+
+        for (Snake& sn : snakes) {
+            sn.enabled = r.bits(1);
+            sn.isAi = r.bits(1);
+            sn.alive = r.bits(1);
+            sn.dying = r.bits(1);
+            sn.dir = (Direction)r.below(NONE + 1);
+            sn.nextDir = (Direction)r.below(NONE + 1);
+            sn.color = r.u16();
+            sn.deathStartMs = r.time();
+            sn.score = r.i32();
+            sn.playerIndex = (int)r.below(SnakeGameConfig::MAX_SNAKES + 1) - 1;
+            sn.bulgeIndex = r.i16();
+
+            const uint16_t len = r.u16();
+            sn.body.clear();
+            if (len == 0) continue;
+            if (len > Snake::BodyRing::MAX_LEN) return false;
+            const bool packed = r.boolean();
+            Point p = { (int16_t)r.below(LOGICAL_WIDTH), (int16_t)r.below(LOGICAL_HEIGHT) };
+            sn.body.seg[0] = p;
+            sn.body.headIdx = 0;
+            sn.body.len = 1;
+            for (uint16_t i = 1; i < len; i++) {
+                if (packed) p = stepFrom(p, (uint8_t)r.bits(2));
+                else p = { (int16_t)r.below(LOGICAL_WIDTH), (int16_t)r.below(LOGICAL_HEIGHT) };
+                sn.body.appendTail(p);
+            }
+        }
+
+        foodCount = r.below(SnakeGameConfig::MAX_FOODS + 1);
+        for (uint8_t i = 0; i < foodCount; i++) {
+            FoodItem& f = foods[i];
+            f.p.x = (int16_t)r.u8();
+            f.p.y = (int16_t)r.u8();
+            f.kind = (FoodKind)r.below(FOOD_BUG + 1);
+            f.wCells = r.u8();
+            f.hCells = r.u8();
+            f.expireMs = r.time();
+        }
+        return r.ok();
+    }
+
+    // ------------------------------
+    // NetGame (linked play)
+    // ------------------------------
+    void netSaveState(uint8_t slot) override {
+        NetState& n = netSlots[slot];
+        for (uint8_t i = 0; i < SnakeGameConfig::MAX_SNAKES; i++) {
+            const Snake& sn = snakes[i];
+            n.snakes[i] = { sn.body.headIdx, sn.body.len, sn.dir, sn.nextDir, sn.alive, sn.dying,
+                            sn.deathStartMs, sn.score, sn.bulgeIndex };
+        }
+        for (uint8_t i = 0; i < SnakeGameConfig::MAX_FOODS; i++) n.foods[i] = foods[i];
+        n.foodCount = foodCount;
+        n.phase = phase;
+        n.phaseStartMs = phaseStartMs;
+        n.lastMove = (uint32_t)lastMove;
+        n.gameOver = gameOver;
+        n.simFrame = simFrame;
+        n.endFrame = endFrame;
+        n.rng = rng;
+    }
+
+    void netLoadState(uint8_t slot) override {
+        const NetState& n = netSlots[slot];
+        for (uint8_t i = 0; i < SnakeGameConfig::MAX_SNAKES; i++) {
+            Snake& sn = snakes[i];
+            const NetSnake& ns = n.snakes[i];
+            sn.body.headIdx = ns.headIdx;
+            sn.body.len = ns.len;
+            sn.dir = ns.dir;
+            sn.nextDir = ns.nextDir;
+            sn.alive = ns.alive;
+            sn.dying = ns.dying;
+            sn.deathStartMs = ns.deathStartMs;
+            sn.score = ns.score;
+            sn.bulgeIndex = ns.bulgeIndex;
+        }
+        for (uint8_t i = 0; i < SnakeGameConfig::MAX_FOODS; i++) foods[i] = n.foods[i];
+        foodCount = n.foodCount;
+        phase = n.phase;
+        phaseStartMs = n.phaseStartMs;
+        lastMove = n.lastMove;
+        gameOver = n.gameOver;
+        simFrame = n.simFrame;
+        endFrame = n.endFrame;
+        rng = n.rng;
+    }
+
+    void netStep(const NetInput in[2], bool isReplay) override {
+        replaying = isReplay;
+        const bool wasOver = gameOver;
+        simFrame++;
+        simulate(simFrame * NET_FRAME_MS, nullptr, in);
+        if (gameOver && !wasOver) endFrame = simFrame - 1;
+        replaying = false;
+    }
+
+    uint32_t netChecksum() const override {
+        NetHash h;
+        for (const Snake& sn : snakes) {
+            h.u32((uint32_t)sn.alive | ((uint32_t)sn.dying << 1) | ((uint32_t)sn.dir << 8) | ((uint32_t)sn.nextDir << 16));
+            h.u32(sn.deathStartMs);
+            h.u32((uint32_t)sn.score);
+            h.u32((uint32_t)sn.bulgeIndex);
+            h.u32(sn.body.size());
+            for (uint16_t k = 0; k < sn.body.size(); k++) {
+                const Point& p = sn.body.at(k);
+                h.u32((uint32_t)(uint16_t)p.x | ((uint32_t)(uint16_t)p.y << 16));
+            }
+        }
+        for (uint8_t i = 0; i < foodCount; i++) {
+            const FoodItem& f = foods[i];
+            h.u32((uint32_t)(uint16_t)f.p.x | ((uint32_t)(uint16_t)f.p.y << 16));
+            h.u32(f.kind);
+            h.u32(f.expireMs);
+        }
+        h.u32(foodCount);
+        h.u32(phase);
+        h.u32(phaseStartMs);
+        h.u32((uint32_t)lastMove);
+        h.u32(gameOver);
+        h.u32(endFrame);
+        h.u32(rng.state);
+        return h.value;
+    }
+
+private:
+    // 0 up, 1 down, 2 left, 3 right (wrapping), -1 if `b` is not a neighbour of `a`.
+    static int bodyStep(const Point& a, const Point& b) {
+        const int dx = (b.x - a.x + LOGICAL_WIDTH) % LOGICAL_WIDTH;
+        const int dy = (b.y - a.y + LOGICAL_HEIGHT) % LOGICAL_HEIGHT;
+        if (dx == 0 && dy == LOGICAL_HEIGHT - 1) return 0;
+        if (dx == 0 && dy == 1) return 1;
+        if (dy == 0 && dx == LOGICAL_WIDTH - 1) return 2;
+        if (dy == 0 && dx == 1) return 3;
+        return -1;
+    }
+
+    static Point stepFrom(Point p, uint8_t step) {
+        if (step == 0) p.y = (int16_t)((p.y + LOGICAL_HEIGHT - 1) % LOGICAL_HEIGHT);
+        else if (step == 1) p.y = (int16_t)((p.y + 1) % LOGICAL_HEIGHT);
+        else if (step == 2) p.x = (int16_t)((p.x + LOGICAL_WIDTH - 1) % LOGICAL_WIDTH);
+        else p.x = (int16_t)((p.x + 1) % LOGICAL_WIDTH);
+        return p;
+    }
 };
@@ -0,0 +1,339 @@
+// SnakeGameAi.h
+// -----------------------------------------------------------------------------
+// Autopilot for CPU-controlled snakes (used to fill empty controller slots).
+//
+// One decision per bot per move tick:
+// 1) A* from the head to the nearest food cell (wrap-around grid).
+// 2) Flood-fill "don't trap yourself" check on the cell that path steps into.
+// 3) If that fails (or food is unreachable): chase our own tail, which is a
+//    safe loop as long as we are not growing.
+// 4) Last resort: the free neighbour with the most reachable space.
+//
+// Every phase polls a microsecond budget (`AI_DECISION_BUDGET_US`). When it
+// runs out we stop searching and fall back to the cheapest safe answer, so the
+// worst case per tick is bounded no matter how crowded the board is. Linked
+// play counts work items instead (`AI_NET_WORK_LIMIT`), so the answer does not
+// depend on how fast each cabinet happens to be.
+//
+// Memory: all scratch is static (shared by all bots since decisions run one at
+// a time) and bit-packed where possible: 1 bit per cell for sets, 2 bits per
+// cell for "first step" directions.
+//
+// DEBUG_GAME_STATS: decision cost histogram and bot survival, see `Stats`.
+// -----------------------------------------------------------------------------
+#pragma once
+
+#include <Arduino.h>
+#include "SnakeGameConfig.h"
+
+namespace SnakeGameAi {
+
+static constexpr int W = SnakeGameConfig::LOGICAL_WIDTH;
+static constexpr int H = SnakeGameConfig::LOGICAL_HEIGHT;
+static constexpr uint16_t CELLS = (uint16_t)(W * H);
+
+// Heap keys pack (f, g, cell) into 32 bits: 12 | 10 | 10.
+static_assert(CELLS <= 1024, "SnakeGameAi: heap key packing assumes <= 1024 cells");
+
+// Same order as the `Direction` enum in SnakeGame.h (UP, DOWN, LEFT, RIGHT, NONE).
+static constexpr uint8_t DIR_UP = 0;
+static constexpr uint8_t DIR_DOWN = 1;
+static constexpr uint8_t DIR_LEFT = 2;
+static constexpr uint8_t DIR_RIGHT = 3;
+static constexpr uint8_t DIR_NONE = 4;
+
+static inline uint8_t opposite(uint8_t d) { return (uint8_t)(d ^ 1u); } // UP<->DOWN, LEFT<->RIGHT
+
+// 1 bit per cell.
+struct CellSet {
+    uint32_t bits[(CELLS + 31) / 32];
+
+    void clear() { memset(bits, 0, sizeof(bits)); }
+    bool test(uint16_t c) const { return ((bits[c >> 5] >> (c & 31)) & 1u) != 0; }
+    void set(uint16_t c) { bits[c >> 5] |= (1u << (c & 31)); }
+};
+
+static inline uint16_t cellOf(int x, int y) { return (uint16_t)(y * W + x); }
+
+static inline uint16_t stepCell(uint16_t c, uint8_t dir) {
+    int x = c % W;
+    int y = c / W;
+    if (dir == DIR_UP) y = (y == 0) ? H - 1 : y - 1;
+    else if (dir == DIR_DOWN) y = (y == H - 1) ? 0 : y + 1;
+    else if (dir == DIR_LEFT) x = (x == 0) ? W - 1 : x - 1;
+    else if (dir == DIR_RIGHT) x = (x == W - 1) ? 0 : x + 1;
+    return cellOf(x, y);
+}
+
+// Manhattan distance on the torus (the playfield wraps on both axes).
+static inline uint16_t torusDist(uint16_t a, uint16_t b) {
+    int dx = abs((int)(a % W) - (int)(b % W));
+    int dy = abs((int)(a / W) - (int)(b / W));
+    if (dx > W - dx) dx = W - dx;
+    if (dy > H - dy) dy = H - dy;
+    return (uint16_t)(dx + dy);
+}
+
+// ---------------------------------------------------------
+// Scratch memory (static, shared across bots)
+// ---------------------------------------------------------
+static CellSet gSeen;                        // A*: discovered cells; flood fill: visited
+static CellSet gGoals;                       // A*: target cells
+static uint8_t gFirstDir[(CELLS + 3) / 4];   // 2 bits/cell: first move from the head on the way here
+static uint32_t gWork[CELLS];                // A*: binary min-heap of packed keys; flood fill: FIFO of cells
+
+static inline void setFirstDir(uint16_t c, uint8_t d) {
+    const uint8_t shift = (uint8_t)((c & 3) * 2);
+    gFirstDir[c >> 2] = (uint8_t)((gFirstDir[c >> 2] & ~(3u << shift)) | ((d & 3u) << shift));
+}
+
+static inline uint8_t firstDir(uint16_t c) {
+    return (uint8_t)((gFirstDir[c >> 2] >> ((c & 3) * 2)) & 3u);
+}
+
+// Microsecond budget, polled every few work items to keep micros() overhead low.
+// With a `workLimit` it expires after that many work items instead (deterministic).
+struct Budget {
+    uint32_t startUs;
+    uint32_t limitUs;
+    uint16_t workLimit;
+    uint16_t polls = 0;
+    bool expired = false;
+
+    Budget(uint32_t limit, uint16_t work = 0) : startUs(micros()), limitUs(limit), workLimit(work) {}
+
+    bool out() {
+        if (expired) return true;
+        if (workLimit != 0) {
+            if (++polls >= workLimit) expired = true;
+        } else if ((++polls & 15u) == 0 && (uint32_t)(micros() - startUs) >= limitUs) {
+            expired = true;
+        }
+        return expired;
+    }
+};
+
+// ---------------------------------------------------------
+// A* (unit costs, torus Manhattan heuristic)
+// ---------------------------------------------------------
+static uint16_t gHeapSize = 0;
+
+static inline void heapPush(uint32_t key) {
+    uint16_t i = gHeapSize++;
+    while (i > 0) {
+        const uint16_t parent = (uint16_t)((i - 1) >> 1);
+        if (gWork[parent] <= key) break;
+        gWork[i] = gWork[parent];
+        i = parent;
+    }
+    gWork[i] = key;
+}
+
+static inline uint32_t heapPop() {
+    const uint32_t top = gWork[0];
+    const uint32_t last = gWork[--gHeapSize];
+    uint16_t i = 0;
+    for (;;) {
+        uint16_t child = (uint16_t)(i * 2 + 1);
+        if (child >= gHeapSize) break;
+        if (child + 1 < gHeapSize && gWork[child + 1] < gWork[child]) child++;
+        if (gWork[child] >= last) break;
+        gWork[i] = gWork[child];
+        i = child;
+    }
+    if (gHeapSize > 0) gWork[i] = last;
+    return top;
+}
+
+// Lower key = better: f first, then larger g (deeper nodes) to break ties toward the goal.
+static inline uint32_t packKey(uint16_t f, uint16_t g, uint16_t cell) {
+    return ((uint32_t)f << 20) | ((uint32_t)(1023u - g) << 10) | (uint32_t)cell;
+}
+
+static inline uint16_t heuristic(uint16_t c, const uint16_t* goals, uint8_t goalCount) {
+    uint16_t best = 0xFFFF;
+    for (uint8_t i = 0; i < goalCount; i++) {
+        const uint16_t d = torusDist(c, goals[i]);
+        if (d < best) best = d;
+    }
+    return best;
+}
+
+/**
+ * First move from `head` toward the closest cell in `gGoals`, or DIR_NONE when
+ * unreachable or out of budget. Cells in `avoidFirst` are never used as the
+ * first step (e.g. cells another head can enter this tick).
+ *
+ * Goals are accepted when discovered (not when popped); with unit costs this
+ * can cost a step of optimality in rare ties, which is fine for a bot.
+ */
+static uint8_t aStarFirstStep(const CellSet& blocked, const CellSet& avoidFirst, uint16_t head, uint8_t curDir,
+                              const uint16_t* goals, uint8_t goalCount, Budget& budget) {
+    gSeen.clear();
+    gHeapSize = 0;
+    gSeen.set(head);
+
+    for (uint8_t d = 0; d < 4; d++) {
+        if (d == opposite(curDir)) continue;
+        const uint16_t n = stepCell(head, d);
+        if (blocked.test(n) || avoidFirst.test(n) || gSeen.test(n)) continue;
+        if (gGoals.test(n)) return d;
+        gSeen.set(n);
+        setFirstDir(n, d);
+        heapPush(packKey((uint16_t)(1 + heuristic(n, goals, goalCount)), 1, n));
+    }
+
+    while (gHeapSize > 0) {
+        if (budget.out()) return DIR_NONE;
+        const uint32_t key = heapPop();
+        const uint16_t c = (uint16_t)(key & 1023u);
+        const uint16_t g = (uint16_t)(1023u - ((key >> 10) & 1023u));
+        const uint8_t fd = firstDir(c);
+        for (uint8_t d = 0; d < 4; d++) {
+            const uint16_t n = stepCell(c, d);
+            if (blocked.test(n) || gSeen.test(n)) continue;
+            if (gGoals.test(n)) return fd;
+            gSeen.set(n);
+            setFirstDir(n, fd);
+            heapPush(packKey((uint16_t)(g + 1 + heuristic(n, goals, goalCount)), (uint16_t)(g + 1), n));
+        }
+    }
+    return DIR_NONE;
+}
+
+// ---------------------------------------------------------
+// Flood fill
+// ---------------------------------------------------------
+// Number of free cells reachable from `start` (inclusive), stopping early at `cap`.
+static uint16_t floodCount(const CellSet& blocked, uint16_t start, uint16_t cap, Budget& budget) {
+    if (blocked.test(start)) return 0;
+    gSeen.clear();
+    uint16_t qHead = 0;
+    uint16_t qTail = 0;
+    gWork[qTail++] = start;
+    gSeen.set(start);
+    while (qHead < qTail) {
+        if (qTail >= cap || budget.out()) break;
+        const uint16_t c = (uint16_t)gWork[qHead++];
+        for (uint8_t d = 0; d < 4; d++) {
+            const uint16_t n = stepCell(c, d);
+            if (blocked.test(n) || gSeen.test(n)) continue;
+            gSeen.set(n);
+            gWork[qTail++] = n;
+        }
+    }
+    return qTail;
+}
+
+// ---------------------------------------------------------
+// Decision
+// ---------------------------------------------------------
+/**
+ * Pick the next direction for a CPU snake.
+ *
+ * - `blocked`: cells that will still be occupied after this tick (bodies minus tails).
+ * - `contested`: cells another snake's head can move into this tick (head-on risk).
+ * - `foodCells`: every cell covered by a food hitbox.
+ * - `workLimit`: 0 = stop after `budgetUs`, else after that many work items.
+ *
+ * Always returns a direction that is not a reversal of `curDir`.
+ */
+static uint8_t decide(const CellSet& blocked, const CellSet& contested,
+                      uint16_t head, uint16_t tail, uint16_t bodyLen, uint8_t curDir,
+                      const uint16_t* foodCells, uint8_t foodCellCount, uint32_t budgetUs,
+                      uint16_t workLimit = 0) {
+    Budget budget(budgetUs, workLimit);
+
+    // 1) Shortest path to food, 2) accepted only if we keep room to live afterwards.
+    if (foodCellCount > 0) {
+        gGoals.clear();
+        for (uint8_t i = 0; i < foodCellCount; i++) gGoals.set(foodCells[i]);
+        const uint8_t d = aStarFirstStep(blocked, contested, head, curDir, foodCells, foodCellCount, budget);
+        if (d != DIR_NONE) {
+            const uint16_t need = (uint16_t)(bodyLen + 1);
+            if (floodCount(blocked, stepCell(head, d), need, budget) >= need) return d;
+        }
+    }
+
+    // 3) Tail chase: following our own tail keeps a loop open while we wait for a safer path.
+    if (!budget.expired && bodyLen > 1) {
+        gGoals.clear();
+        gGoals.set(tail);
+        const uint8_t d = aStarFirstStep(blocked, contested, head, curDir, &tail, 1, budget);
+        if (d != DIR_NONE) return d;
+    }
+
+    // 4) Most open neighbour (straight first so ties keep the current heading).
+    //    Once the budget is gone we only check that the neighbour is free.
+    uint8_t best = DIR_NONE;
+    int bestScore = -1;
+    const uint8_t startDir = (curDir < DIR_NONE) ? curDir : DIR_UP;
+    for (uint8_t k = 0; k < 4; k++) {
+        const uint8_t d = (uint8_t)((startDir + k) & 3u);
+        if (d == opposite(curDir)) continue;
+        const uint16_t n = stepCell(head, d);
+        if (blocked.test(n)) continue;
+        int score = budget.expired ? 1 : (int)floodCount(blocked, n, CELLS, budget);
+        if (contested.test(n)) score /= 4; // head-on is a coin flip at best
+        if (score > bestScore) {
+            bestScore = score;
+            best = d;
+        }
+    }
+    return (best != DIR_NONE) ? best : startDir;
+}
+
+#if DEBUG_GAME_STATS
+// ---------------------------------------------------------
+// Measurement (DEBUG_GAME_STATS)
+// ---------------------------------------------------------
+// Decision cost in power-of-two microsecond buckets (<64, <128, ... >=4096)
+// plus how long bots live, printed every STATS_REPORT_DECISIONS decisions.
+struct Stats {
+    static constexpr uint8_t BUCKETS = 8;
+    static constexpr uint32_t STATS_REPORT_DECISIONS = 2000;
+
+    uint32_t hist[BUCKETS] = {};
+    uint32_t decisions = 0;
+    uint32_t overBudget = 0;
+    uint32_t maxUs = 0;
+    uint64_t totalUs = 0;
+    uint32_t spawned = 0; // bot lives started
+    uint32_t deaths = 0;
+
+    void decision(uint32_t us, uint32_t budgetUs) {
+        uint8_t b = 0;
+        while (b < BUCKETS - 1 && us >= (64u << b)) b++;
+        hist[b]++;
+        decisions++;
+        totalUs += us;
+        if (us > maxUs) maxUs = us;
+        if (us >= budgetUs) overBudget++;
+        if (decisions % STATS_REPORT_DECISIONS == 0) report();
+    }
+
+    // Smallest bucket bound that covers `pct` percent of decisions.
+    uint32_t percentileBound(uint8_t pct) const {
+        uint32_t acc = 0;
+        for (uint8_t b = 0; b < BUCKETS; b++) {
+            acc += hist[b];
+            if (acc * 100u >= decisions * (uint32_t)pct) return 64u << b;
+        }
+        return 64u << (BUCKETS - 1);
+    }
+
+    void report() const {
+        Serial.printf("[SnakeAI] %lu decisions: mean %lu us, p50 <%lu, p95 <%lu, p99 <%lu, max %lu, over budget %lu\n",
+                      (unsigned long)decisions, (unsigned long)(totalUs / (decisions ? decisions : 1)),
+                      (unsigned long)percentileBound(50), (unsigned long)percentileBound(95),
+                      (unsigned long)percentileBound(99), (unsigned long)maxUs, (unsigned long)overBudget);
+        Serial.printf("[SnakeAI] bots %lu, deaths %lu (survival %lu%%), %lu moves per death\n",
+                      (unsigned long)spawned, (unsigned long)deaths,
+                      (unsigned long)(spawned ? 100u * (spawned - deaths) / spawned : 0u),
+                      (unsigned long)(deaths ? decisions / deaths : decisions));
+    }
+};
+static Stats gStats;
+#endif
+
+} // namespace SnakeGameAi
@@ -88,6 +88,35 @@ static constexpr uint8_t FOOD_WEIGHT_BUG   = 3;
 
 static constexpr uint32_t CREATURE_TTL_MS = 9000UL;
 
+// -----------------------------------------------------------------------------
+// CPU snakes (autopilot, see SnakeGameAi.h)
+// -----------------------------------------------------------------------------
+// Empty controller slots at round start are filled with CPU snakes so solo play
+// has opponents. The round still ends when all human snakes are gone.
+static constexpr bool AI_FILL_EMPTY_SLOTS = true;
+static constexpr uint8_t MAX_AI_SNAKES = 3;
+
+// Hard CPU budget per bot decision (microseconds). All bots together must stay
+// a small fraction of one move tick so rendering/input never starve.
+static constexpr uint32_t AI_DECISION_BUDGET_US = 1500;
+static_assert((uint32_t)MAX_AI_SNAKES * AI_DECISION_BUDGET_US * 4UL <= (uint32_t)MOVE_TICK_MS * 1000UL,
+              "Snake AI budget must fit in a quarter of the move tick");
+// Linked play: both cabinets must stop a search at the same point, so bots
+// count work items (cells visited) instead of microseconds.
+static constexpr uint16_t AI_NET_WORK_LIMIT = 6000;
+
+// -----------------------------------------------------------------------------
+// Linked play (engine/NetPlay.h)
+// -----------------------------------------------------------------------------
+// One snake per cabinet (slot = NetPlay side), CPU snakes in the other slots as
+// above. Both cabinets must agree on this id.
+static constexpr uint8_t NET_GAME_ID = 2;
+// One net frame; snakes still move every MOVE_TICK_MS on the frame clock.
+static constexpr uint32_t NET_FRAME_MS = 20;
+// "WAIT PEER": if the other cabinet doesn't start Snake within this time (or B
+// is pressed), play locally instead.
+static constexpr uint32_t NET_PEER_WAIT_MS = 10000;
+
 // -----------------------------------------------------------------------------
 // Sprites / tables
 // -----------------------------------------------------------------------------
@@ -2,14 +2,20 @@
 #include <Arduino.h>
 #include <ESP32-HUB75-MatrixPanel-I2S-DMA.h>
 #include "../../engine/GameBase.h"
+#include "../../engine/Snapshot.h"
 #include "../../engine/ControllerManager.h"
 #include "../../engine/config.h"
+#include "../../engine/Raster.h"
+#include "../../engine/Pixel565.h"
 #include "../../engine/AudioManager.h"
 #include "../../component/SmallFont.h"
 #include "../../engine/UserProfiles.h"
+#include "../../engine/Trace.h"
+#include "../../engine/QualityGovernor.h"
 #include "../../component/GameOverLeaderboardView.h"
 #include "TetrisGameConfig.h"
 #include "TetrisGameAudio.h"
+#include "TetrisGameAi.h"
 
 /**
  * TetrisGame - Classic Tetris game
@@ -62,24 +68,42 @@ private:
     uint8_t flashingRowCount;
     uint8_t pendingCleared; // number of lines being cleared (for scoring/level)
     static constexpr unsigned long FLASH_TOGGLE_MS = TetrisGameConfig::FLASH_TOGGLE_MS;
+
+    // Autoplay (attract/demo mode): the bot replaces pad 0.
+    bool autoplay = false;
+    TetrisBot bot;
+    uint32_t pieceSerial = 0;      // bumped whenever currentPiece is replaced
+    uint32_t botPieceSerial = 0;   // piece the bot last started a search for
+    bool botPlanReady = false;
+    TetrisBot::Plan botPlan;
+    unsigned long autoplayGameOverMs = 0;
+
+#if DEBUG_GAME_STATS
+    // Bot search throughput: time spent inside bot.step() per finished plan,
+    // printed every BOT_STATS_REPORT_PLANS plans.
+    static constexpr uint32_t BOT_STATS_REPORT_PLANS = 100;
+    uint64_t botStepUs = 0;
+    uint32_t botStatsEvals = 0;
+    uint32_t botStatsPlans = 0;
+    uint32_t botStepMaxUs = 0;
+
+    void recordBotStep(uint32_t us, uint32_t evals, bool planDone) {
+        botStepUs += us;
+        botStatsEvals += evals;
+        if (us > botStepMaxUs) botStepMaxUs = us;
+        if (!planDone || ++botStatsPlans % BOT_STATS_REPORT_PLANS != 0) return;
+        Serial.printf("[TetrisAI] %lu plans: %lu placements/s, %lu placements/plan, %lu us/plan, worst step %lu us, lines %d\n",
+                      (unsigned long)botStatsPlans,
+                      (unsigned long)(botStepUs ? (uint64_t)botStatsEvals * 1000000ULL / botStepUs : 0),
+                      (unsigned long)(botStatsEvals / botStatsPlans), (unsigned long)(botStepUs / botStatsPlans),
+                      (unsigned long)botStepMaxUs, linesCleared);
+    }
+#endif
     
     // Tetris pieces (Tetrominoes) - 7 types (from TetrisGameConfig).
     static inline constexpr auto& PIECES = TetrisGameConfig::PIECES;             // [type][rotation][y][x]
     static inline constexpr auto& PIECE_COLORS = TetrisGameConfig::PIECE_COLORS; // RGB565 palette
 
-    // ---------------------------------------------------------
-    // Small color helper (RGB565 dimming) - used for ghost piece
-    // ---------------------------------------------------------
-    static inline uint16_t dimColor(uint16_t c, uint8_t mul /*0..255*/) {
-        uint8_t r = (uint8_t)((c >> 11) & 0x1F);
-        uint8_t g = (uint8_t)((c >> 5) & 0x3F);
-        uint8_t b = (uint8_t)(c & 0x1F);
-        r = (uint8_t)((r * mul) / 255);
-        g = (uint8_t)((g * mul) / 255);
-        b = (uint8_t)((b * mul) / 255);
-        return (uint16_t)((r << 11) | (g << 5) | b);
-    }
-    
     // ---------------------------------------------------------
     // Tetris-only "Tetris!" explosion particles (spawned ONLY when clearing 4 lines)
     // ---------------------------------------------------------
@@ -270,6 +294,7 @@ private:
     void spawnNewPiece() {
         // Shift next queue and spawn a new 3rd preview.
         currentPiece = nextPieces[0];
+        pieceSerial++;
         nextPieces[0] = nextPieces[1];
         nextPieces[1] = nextPieces[2];
         initPiece(nextPieces[2], random(0, 7));
@@ -289,6 +314,7 @@ private:
             const int temp = holdType;
             holdType = currentPiece.type;
             initPiece(currentPiece, temp); // reset position/rotation
+            pieceSerial++;
             if (!canPlacePiece(currentPiece, 0, 0, currentPiece.rotation)) {
                 gameOver = true;
             }
@@ -309,6 +335,66 @@ private:
         return y;
     }
 
+    void hardDrop() {
+        while (canPlacePiece(currentPiece, 0, 1, currentPiece.rotation)) {
+            currentPiece.y++;
+            score += 2;
+        }
+    }
+
+    /**
+     * Autoplay input: plan incrementally (AI_EVALS_PER_TICK placements per call),
+     * then walk the piece to the planned rotation/column one input at a time and
+     * hard drop. Locking is left to the normal auto-fall, same as a human drop.
+     */
+    void updateAutoplay(unsigned long now) {
+        TRACE_SCOPE("Tetris.updateAutoplay");
+        if (botPieceSerial != pieceSerial) {
+            botPieceSerial = pieceSerial;
+            botPlanReady = false;
+            int types[TetrisBot::MAX_DEPTH] = { currentPiece.type, nextPieces[0].type, nextPieces[1].type, nextPieces[2].type };
+            // Fewer previews searched when the frame budget is tight.
+            bot.begin(board, types, (uint8_t)globalQuality.scale(TetrisGameConfig::AI_LOOKAHEAD));
+        }
+        if (!botPlanReady) {
+#if DEBUG_GAME_STATS
+            const uint32_t evals0 = bot.placementsEvaluated();
+            const uint32_t c0 = ESP.getCycleCount();
+            const bool planDone = bot.step(TetrisGameConfig::AI_EVALS_PER_TICK);
+            recordBotStep((ESP.getCycleCount() - c0) / (uint32_t)getCpuFrequencyMhz(),
+                          bot.placementsEvaluated() - evals0, planDone);
+            if (!planDone) return;
+#else
+            if (!bot.step(TetrisGameConfig::AI_EVALS_PER_TICK)) return;
+#endif
+            botPlan = bot.plan();
+            botPlanReady = true;
+            lastMove = now;
+        }
+        if (now - lastMove < TetrisGameConfig::AI_MOVE_INTERVAL_MS) return;
+        if (now - lastDrop <= 200) return; // already dropped; waiting for the lock
+        lastMove = now;
+
+        if (botPlan.valid && currentPiece.rotation != (int)botPlan.rotation) {
+            const int newRot = (currentPiece.rotation + 1) % 4;
+            if (canPlacePiece(currentPiece, 0, 0, newRot)) {
+                currentPiece.rotation = newRot;
+                return;
+            }
+            botPlan.valid = false; // blocked: drop where we are
+        }
+        if (botPlan.valid && currentPiece.x != (int)botPlan.x) {
+            const int dx = (currentPiece.x < (int)botPlan.x) ? 1 : -1;
+            if (canPlacePiece(currentPiece, dx, 0, currentPiece.rotation)) {
+                currentPiece.x += dx;
+                return;
+            }
+            botPlan.valid = false;
+        }
+        hardDrop();
+        lastDrop = now;
+    }
+
 public:
     TetrisGame() 
         : gameOver(false), score(0), linesCleared(0), level(1), 
@@ -343,6 +429,7 @@ public:
         flashTogglesRemaining = 0;
         flashingRowCount = 0;
         pendingCleared = 0;
+        autoplayGameOverMs = 0;
         const unsigned long now = millis();
         lastFall = now;
         lastMove = now;
@@ -364,6 +451,7 @@ public:
         initPiece(nextPieces[0], random(0, 7));
         initPiece(nextPieces[1], random(0, 7));
         initPiece(nextPieces[2], random(0, 7));
+        pieceSerial++;
 
         // Clear particles
         for (int i = 0; i < MAX_PARTICLES; i++) particles[i].active = false;
@@ -373,19 +461,41 @@ public:
         // -----------------------------------------------------
         // This is intentionally minimal: we play on start/reset and stop any
         // leftover ringtone from other applets (e.g. MusicApp).
+        // The attract-mode demo restarts on its own, so it stays silent.
         globalAudio.stopRtttl();
-        globalAudio.playRtttl(TetrisGameAudio::MUSIC_START_RTTTL, /*loop=*/false);
+        if (!autoplay) globalAudio.playRtttl(TetrisGameAudio::MUSIC_START_RTTTL, /*loop=*/false);
     }
 
     void reset() override {
         start();
     }
 
+    // ------------------------------
+    // Autoplay / attract mode
+    // ------------------------------
+    // When enabled, the bot plays instead of pad 0, no controller is required,
+    // scores are not submitted and game over restarts after AUTOPLAY_RESTART_MS.
+    void setAutoplay(bool on) {
+        autoplay = on;
+        botPieceSerial = pieceSerial - 1; // force a fresh search
+    }
+    bool isAutoplay() const { return autoplay; }
+
+    // Total placements the bot has evaluated (throughput / stress reporting).
+    uint32_t botPlacementsEvaluated() const { return bot.placementsEvaluated(); }
+
     void update(ControllerManager* input) override {
-        if (gameOver) return;
+        if (gameOver) {
+            if (autoplay) {
+                const unsigned long t = millis();
+                if (autoplayGameOverMs == 0) autoplayGameOverMs = t;
+                else if (t - autoplayGameOverMs >= TetrisGameConfig::AUTOPLAY_RESTART_MS) start();
+            }
+            return;
+        }
         
-        ControllerPtr p1 = input->getController(0);
-        if (!p1 || !p1->isConnected()) return;
+        const PadState* p1 = autoplay ? nullptr : &input->pad(0);
+        if (!autoplay && !p1->connected) return;
         
         unsigned long now = millis();
         // Particle simulation runs regardless of line flashing.
@@ -418,63 +528,65 @@ public:
             return;
         }
 
-        uint8_t dpad = p1->dpad();
-        const bool acceptInput = (now >= inputIgnoreUntil);
-        
-        // Handle input with debouncing
-        if (acceptInput && (now - lastMove > 100)) {
-            if (dpad & 0x08) {  // LEFT
-                if (canPlacePiece(currentPiece, -1, 0, currentPiece.rotation)) {
-                    currentPiece.x--;
-                    lastMove = now;
+        if (autoplay) {
+            updateAutoplay(now);
+        } else {
+            uint8_t dpad = p1->dpad;
+            const bool acceptInput = (now >= inputIgnoreUntil);
+
+            // Handle input with debouncing
+            if (acceptInput && (now - lastMove > 100)) {
+                if (dpad & 0x08) {  // LEFT
+                    if (canPlacePiece(currentPiece, -1, 0, currentPiece.rotation)) {
+                        currentPiece.x--;
+                        lastMove = now;
+                    }
                 }
-            }
-            if (dpad & 0x04) {  // RIGHT
-                if (canPlacePiece(currentPiece, 1, 0, currentPiece.rotation)) {
-                    currentPiece.x++;
-                    lastMove = now;
+                if (dpad & 0x04) {  // RIGHT
+                    if (canPlacePiece(currentPiece, 1, 0, currentPiece.rotation)) {
+                        currentPiece.x++;
+                        lastMove = now;
+                    }
                 }
-            }
-            if (dpad & 0x02) {  // DOWN - soft drop
-                if (canPlacePiece(currentPiece, 0, 1, currentPiece.rotation)) {
-                    currentPiece.y++;
-                    score += 1;  // Bonus for soft drop
-                    lastMove = now;
+                if (dpad & 0x02) {  // DOWN - soft drop
+                    if (canPlacePiece(currentPiece, 0, 1, currentPiece.rotation)) {
+                        currentPiece.y++;
+                        score += 1;  // Bonus for soft drop
+                        lastMove = now;
+                    }
                 }
             }
-        }
-        
-        // Controls: UP and A are intentionally flipped per your request:
-        // - UP = hard drop
-        // - A  = rotate
-        if (acceptInput) {
-            // Hold / swap (X)
-            if (p1->x() && !holdUsedThisTurn && (now - lastHold > 200)) {
-                doHoldSwap(now);
-            }
 
-            // Hard drop (UP)
-            if ((dpad & 0x01) && (now - lastDrop > 200)) {
-                while (canPlacePiece(currentPiece, 0, 1, currentPiece.rotation)) {
-                    currentPiece.y++;
-                    score += 2;
+            // Controls: UP and A are intentionally flipped per your request:
+            // - UP = hard drop
+            // - A  = rotate
+            if (acceptInput) {
+                // Hold / swap (X)
+                if (p1->held(PadState::BTN_X) && !holdUsedThisTurn && (now - lastHold > 200)) {
+                    doHoldSwap(now);
+                }
+
+                // Hard drop (UP)
+                if ((dpad & 0x01) && (now - lastDrop > 200)) {
+                    hardDrop();
+                    lastDrop = now;
                 }
-                lastDrop = now;
-            }
 
-            // Rotate piece (A)
-            if (p1->a() && (now - lastRotate > 150)) {
-                int newRot = (currentPiece.rotation + 1) % 4;
-                if (canPlacePiece(currentPiece, 0, 0, newRot)) {
-                    currentPiece.rotation = newRot;
-                    lastRotate = now;
+                // Rotate piece (A)
+                if (p1->held(PadState::BTN_A) && (now - lastRotate > 150)) {
+                    int newRot = (currentPiece.rotation + 1) % 4;
+                    if (canPlacePiece(currentPiece, 0, 0, newRot)) {
+                        currentPiece.rotation = newRot;
+                        lastRotate = now;
+                    }
                 }
             }
         }
         
         // Auto fall
-        unsigned long fallDelay = INITIAL_FALL_DELAY - (level * 50);
-        if (fallDelay < 100) fallDelay = 100;
+        // Signed: past level 10 the subtraction goes negative (and would wrap).
+        const long fallDelayRaw = (long)INITIAL_FALL_DELAY - (long)level * 50;
+        const unsigned long fallDelay = (fallDelayRaw < 100) ? 100UL : (unsigned long)fallDelayRaw;
         
         if (now - lastFall > fallDelay) {
             if (canPlacePiece(currentPiece, 0, 1, currentPiece.rotation)) {
@@ -506,7 +618,7 @@ public:
     void draw(MatrixPanel_I2S_DMA* display) override {
         display->fillScreen(COLOR_BLACK);
         
-        if (gameOver) {
+        if (gameOver && !autoplay) {
             char tag[4];
             UserProfiles::getPadTag(0, tag);
             GameOverLeaderboardView::draw(display, "GAME OVER", leaderboardId(), leaderboardScore(), tag);
@@ -566,7 +678,7 @@ public:
             // TomThumb is tiny; approximate centering with a 4px advance per char.
             const int textW = 6 * 4;
             const int sx = hudBlockX + max(0, (boxesW - textW) / 2);
-            const uint16_t dim = dimColor(COLOR_YELLOW, 120);
+            const uint16_t dim = Pixel565::scale(COLOR_YELLOW, 120);
 
             // Find first non-zero digit (keep at least the last digit bright).
             int firstNZ = 5;
@@ -585,7 +697,7 @@ public:
             snprintf(lbuf, sizeof(lbuf), "%03d", max(0, level));
             const int textW = 3 * 4;
             const int lx = hudBlockX + max(0, (boxesW - textW) / 2);
-            const uint16_t dim = dimColor(COLOR_GREEN, 120);
+            const uint16_t dim = Pixel565::scale(COLOR_GREEN, 120);
 
             int firstNZ = 2;
             for (int i = 0; i < 3; i++) {
@@ -599,11 +711,11 @@ public:
             }
         }
 
-        display->drawRect(nextOuterX, boxesY, boxOuter, nextOuterH, COLOR_WHITE);
-        display->drawRect(holdOuterX, boxesY, boxOuter, boxOuter, COLOR_WHITE);
+        Raster::rect(display, nextOuterX, boxesY, boxOuter, nextOuterH, COLOR_WHITE);
+        Raster::rect(display, holdOuterX, boxesY, boxOuter, boxOuter, COLOR_WHITE);
 
         // Board border
-        display->drawRect(boardOuterX, outerY, boardOuterW, boardOuterH, COLOR_WHITE);
+        Raster::rect(display, boardOuterX, outerY, boardOuterW, boardOuterH, COLOR_WHITE);
         
         // Draw placed blocks
         auto isFlashingRow = [&](int y) -> bool {
@@ -636,7 +748,7 @@ public:
         // This shows where UP would land the piece.
         if (!lineFlashing) {
             const int ghostY = computeGhostY();
-            const uint16_t ghostCol = dimColor(currentPiece.color, 85); // ~33% intensity
+            const uint16_t ghostCol = Pixel565::scale(currentPiece.color, 85); // ~33% intensity
             for (int y = 0; y < 4; y++) {
                 for (int x = 0; x < 4; x++) {
                     if (!PIECES[currentPiece.type][currentPiece.rotation][y][x]) continue;
@@ -646,7 +758,7 @@ public:
                     const int screenX = boardStartX + boardX * CELL_SIZE;
                     const int screenY = boardStartY + boardY * CELL_SIZE;
                     // Outline looks better than fill for a "ghost" on 3×3 cells.
-                    display->drawRect(screenX, screenY, CELL_SIZE, CELL_SIZE, ghostCol);
+                    Raster::rect(display, screenX, screenY, CELL_SIZE, CELL_SIZE, ghostCol);
                 }
             }
         }
@@ -723,10 +835,114 @@ public:
     // ------------------------------
     // Leaderboard integration
     // ------------------------------
-    bool leaderboardEnabled() const override { return true; }
+    bool leaderboardEnabled() const override { return !autoplay; }
     const char* leaderboardId() const override { return "tetris"; }
     const char* leaderboardName() const override { return "Tetris"; }
     uint32_t leaderboardScore() const override { return (score > 0) ? (uint32_t)score : 0u; }
+
+    // ------------------------------
+    // Self-check (DEBUG_INVARIANTS)
+    // ------------------------------
+    const char* checkInvariants() const override {
+        if (currentPiece.type < 0 || currentPiece.type >= 7) return "piece type out of range";
+        if (currentPiece.rotation < 0 || currentPiece.rotation >= 4) return "piece rotation out of range";
+        for (int i = 0; i < 3; i++) if (nextPieces[i].type < 0 || nextPieces[i].type >= 7) return "next queue type out of range";
+        if (flashingRowCount > 4) return "too many flashing rows";
+        for (int y = 0; y < BOARD_HEIGHT; y++) {
+            for (int x = 0; x < BOARD_WIDTH; x++) if (board[y][x] > 7) return "board cell value out of range";
+        }
+        // The live piece never overlaps settled blocks or leaves the well
+        // (the spawn that ends the game is the one allowed exception).
+        if (!gameOver && !lineFlashing) {
+            for (int y = 0; y < 4; y++) {
+                for (int x = 0; x < 4; x++) {
+                    if (!PIECES[currentPiece.type][currentPiece.rotation][y][x]) continue;
+                    const int bx = currentPiece.x + x;
+                    const int by = currentPiece.y + y;
+                    if (bx < 0 || bx >= BOARD_WIDTH || by >= BOARD_HEIGHT) return "piece outside the well";
+                    if (by >= 0 && board[by][bx] != 0) return "piece overlaps the stack";
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    // ------------------------------
+    // Snapshots (engine/Snapshot.h)
+    // ------------------------------
+    // Particles are cosmetic and not saved; the bot replans after a load.
+    uint8_t snapshotVersion() const override { return 1; }
+
+    void saveSnapshot(SnapshotWriter& w) const override {
+        w.rle(&board[0][0], sizeof(board));
+        w.u8((uint8_t)currentPiece.type);
+        w.u8((uint8_t)currentPiece.rotation);
+        w.i16((int16_t)currentPiece.x);
+        w.i16((int16_t)currentPiece.y);
+        for (int i = 0; i < 3; i++) w.u8((uint8_t)nextPieces[i].type);
+        w.boolean(hasHold);
+        w.boolean(holdUsedThisTurn);
+        w.boolean(gameOver);
+        w.boolean(lineFlashing);
+        w.boolean(flashOn);
+        w.u8((uint8_t)holdType);
+        w.i32(score);
+        w.i32(linesCleared);
+        w.i32(level);
+        w.time((uint32_t)lastFall);
+        w.time((uint32_t)lastMove);
+        w.time((uint32_t)lastRotate);
+        w.time((uint32_t)lastDrop);
+        w.time((uint32_t)lastHold);
+        w.time((uint32_t)inputIgnoreUntil);
+        w.u8(flashTogglesRemaining);
+        w.time((uint32_t)lastFlashToggleMs);
+        w.u8(flashingRowCount);
+        w.bytes(flashingRows, sizeof(flashingRows));
+        w.u8(pendingCleared);
+    }
+
+    bool loadSnapshot(SnapshotReader& r) override {
+        r.rle(&board[0][0], sizeof(board));
+        for (int y = 0; y < BOARD_HEIGHT; y++) {
+            for (int x = 0; x < BOARD_WIDTH; x++) {
+                if (board[y][x] > 7) return false;
+            }
+        }
+        initPiece(currentPiece, r.below(7));
+        currentPiece.rotation = r.below(4);
+        currentPiece.x = r.i16();
+        currentPiece.y = r.i16();
+        for (int i = 0; i < 3; i++) initPiece(nextPieces[i], r.below(7));
+        hasHold = r.boolean();
+        holdUsedThisTurn = r.boolean();
+        gameOver = r.boolean();
+        lineFlashing = r.boolean();
+        flashOn = r.boolean();
+        holdType = r.below(7);
+        score = r.i32();
+        linesCleared = r.i32();
+        level = r.i32();
+        lastFall = r.time();
+        lastMove = r.time();
+        lastRotate = r.time();
+        lastDrop = r.time();
+        lastHold = r.time();
+        inputIgnoreUntil = r.time();
+        flashTogglesRemaining = r.u8();
+        lastFlashToggleMs = r.time();
+        flashingRowCount = r.below(5);
+        r.bytes(flashingRows, sizeof(flashingRows));
+        for (uint8_t i = 0; i < flashingRowCount; i++) {
+            if (flashingRows[i] >= BOARD_HEIGHT) return false;
+        }
+        pendingCleared = r.u8();
+
+        for (int i = 0; i < MAX_PARTICLES; i++) particles[i].active = false;
+        pieceSerial++;
+        botPlanReady = false;
+        return r.ok();
+    }
 };
 
 // NOTE: Tetromino shapes + colors moved to `Games/Tetris/TetrisGameSprites.h`
@@ -0,0 +1,299 @@
+// TetrisGameAi.h
+// -----------------------------------------------------------------------------
+// Placement bot for Tetris (autoplay / attract mode / headless stress runs).
+//
+// Search:
+// - Every rotation (duplicates skipped) x every column is a "placement": the
+//   piece is hard-dropped, locked and full lines are cleared on a bitboard copy.
+// - Each resulting board is scored with the classic 4-feature heuristic
+//   (aggregate height, holes, bumpiness, lines cleared).
+// - Beam search: the best `AI_BEAM_WIDTH` boards after the current piece are
+//   expanded with the next preview piece, and so on for `AI_LOOKAHEAD` pieces.
+//   The chosen move is the root placement of the best leaf.
+//
+// Incremental: `step(maxEvals)` evaluates at most `maxEvals` placements and
+// returns, so a search is spread across update() calls and never stalls a frame.
+//
+// The bot has no dependency on TetrisGame itself (only the board array and the
+// piece table), so it can also be driven headless.
+// -----------------------------------------------------------------------------
+#pragma once
+
+#include <Arduino.h>
+#include "TetrisGameConfig.h"
+
+class TetrisBot {
+public:
+    static constexpr int W = TetrisGameConfig::BOARD_WIDTH;
+    static constexpr int H = TetrisGameConfig::BOARD_HEIGHT;
+    static constexpr uint8_t BEAM = TetrisGameConfig::AI_BEAM_WIDTH;
+    static constexpr uint8_t MAX_DEPTH = 4; // current piece + 3 previews
+    static_assert(W <= 16, "TetrisBot: rows are stored as 16-bit masks");
+    static_assert(TetrisGameConfig::AI_LOOKAHEAD >= 1 && TetrisGameConfig::AI_LOOKAHEAD <= MAX_DEPTH,
+                  "TetrisBot: AI_LOOKAHEAD must be 1..4 (current piece + up to 3 previews)");
+
+    struct Plan {
+        bool valid = false;
+        int8_t x = 0;       // piece origin column (same meaning as TetrisGame::Piece::x)
+        uint8_t rotation = 0;
+    };
+
+    TetrisBot() { buildPieceMasks(); }
+
+    /**
+     * Start a new search.
+     * `types[0]` is the falling piece, the rest are previews (up to MAX_DEPTH total).
+     */
+    void begin(const uint8_t board[H][W], const int* types, uint8_t typeCount) {
+        if (typeCount > MAX_DEPTH) typeCount = MAX_DEPTH;
+        if (typeCount < 1) typeCount = 1;
+        depthCount = typeCount;
+        for (uint8_t i = 0; i < typeCount; i++) pieceTypes[i] = (uint8_t)types[i];
+
+        Node& root = layers[0][0];
+        for (int y = 0; y < H; y++) {
+            uint16_t m = 0;
+            for (int x = 0; x < W; x++) {
+                if (board[y][x] != 0) m |= (uint16_t)(1u << x);
+            }
+            root.rows[y] = m;
+        }
+        root.score = 0;
+        root.lines = 0;
+        root.rootX = 0;
+        root.rootRot = 0;
+        layerCount[0] = 1;
+        layerCount[1] = 0;
+        cur = 0;
+        depth = 0;
+        cursorNode = 0;
+        cursorRot = 0;
+        cursorX = MIN_X;
+        done = false;
+        result = Plan();
+    }
+
+    /**
+     * Evaluate up to `maxEvals` placements. Returns true when the plan is ready.
+     */
+    bool step(uint16_t maxEvals) {
+        uint16_t evals = 0;
+        while (!done && evals < maxEvals) {
+            if (cursorNode >= layerCount[cur]) {
+                finishLayer();
+                continue;
+            }
+            const uint8_t type = pieceTypes[depth];
+            if (cursorRot >= 4) {
+                cursorRot = 0;
+                cursorX = MIN_X;
+                cursorNode++;
+                continue;
+            }
+            if (rotDuplicate[type][cursorRot] || cursorX > MAX_X) {
+                cursorRot++;
+                cursorX = MIN_X;
+                continue;
+            }
+            const int8_t x = cursorX++;
+            const PieceMask& pm = masks[type][cursorRot];
+            if (x + pm.minX < 0 || x + pm.maxX >= W) continue; // off-board, not an evaluation
+            expand(layers[cur][cursorNode], pm, x, cursorRot);
+            evals++;
+        }
+        return done;
+    }
+
+    bool isDone() const { return done; }
+    Plan plan() const { return result; }
+
+    // Running total of evaluated placements (for stress/throughput reporting).
+    uint32_t placementsEvaluated() const { return totalEvals; }
+
+private:
+    static constexpr int8_t MIN_X = -3;
+    static constexpr int8_t MAX_X = (int8_t)(W - 1);
+    static constexpr uint16_t FULL_ROW = (uint16_t)((1u << W) - 1u);
+
+    struct PieceMask {
+        uint8_t rows[4]; // bit x set = cell at (x, row) within the 4x4 piece box
+        int8_t minX;
+        int8_t maxX;
+    };
+
+    struct Node {
+        uint16_t rows[H];
+        int32_t score;
+        uint8_t lines;   // total lines cleared along this branch
+        int8_t rootX;    // first placement of the branch (what we actually play)
+        uint8_t rootRot;
+    };
+
+    PieceMask masks[7][4];
+    bool rotDuplicate[7][4];
+
+    Node layers[2][BEAM];
+    uint8_t layerCount[2] = { 0, 0 };
+    uint8_t cur = 0;
+    uint8_t depth = 0;
+    uint8_t depthCount = 1;
+    uint8_t pieceTypes[MAX_DEPTH] = { 0, 0, 0, 0 };
+
+    uint8_t cursorNode = 0;
+    uint8_t cursorRot = 0;
+    int8_t cursorX = MIN_X;
+
+    bool done = false;
+    Plan result;
+    uint32_t totalEvals = 0;
+
+    void buildPieceMasks() {
+        for (int t = 0; t < 7; t++) {
+            for (int r = 0; r < 4; r++) {
+                PieceMask& pm = masks[t][r];
+                pm.minX = 4;
+                pm.maxX = -1;
+                for (int y = 0; y < 4; y++) {
+                    uint8_t m = 0;
+                    for (int x = 0; x < 4; x++) {
+                        if (!TetrisGameConfig::PIECES[t][r][y][x]) continue;
+                        m |= (uint8_t)(1u << x);
+                        if (x < pm.minX) pm.minX = (int8_t)x;
+                        if (x > pm.maxX) pm.maxX = (int8_t)x;
+                    }
+                    pm.rows[y] = m;
+                }
+                // Rotations with an identical shape give identical placements.
+                rotDuplicate[t][r] = false;
+                for (int prev = 0; prev < r; prev++) {
+                    if (memcmp(masks[t][prev].rows, pm.rows, sizeof(pm.rows)) == 0) {
+                        rotDuplicate[t][r] = true;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    static inline uint16_t shiftRow(uint8_t m, int8_t x) {
+        return (x >= 0) ? (uint16_t)((uint16_t)m << x) : (uint16_t)(m >> (-x));
+    }
+
+    static inline bool fits(const uint16_t rows[H], const PieceMask& pm, int8_t x, int y) {
+        for (int i = 0; i < 4; i++) {
+            if (!pm.rows[i]) continue;
+            const int by = y + i;
+            if (by >= H) return false;
+            if (by >= 0 && (rows[by] & shiftRow(pm.rows[i], x))) return false;
+        }
+        return true;
+    }
+
+    // Heuristic (higher is better). Weights are the well-known tuned set, scaled x1000.
+    static int32_t evaluate(const uint16_t rows[H], uint8_t lines) {
+        uint16_t seen = 0;
+        int heights[W];
+        int holes = 0;
+        for (int x = 0; x < W; x++) heights[x] = 0;
+        for (int y = 0; y < H; y++) {
+            const uint16_t row = rows[y];
+            holes += __builtin_popcount((unsigned)(seen & (uint16_t)~row & FULL_ROW));
+            uint16_t fresh = (uint16_t)(row & (uint16_t)~seen);
+            while (fresh) {
+                const int x = __builtin_ctz((unsigned)fresh);
+                heights[x] = H - y;
+                fresh &= (uint16_t)(fresh - 1u);
+            }
+            seen |= row;
+        }
+        int aggregate = 0;
+        int bumpiness = 0;
+        for (int x = 0; x < W; x++) {
+            aggregate += heights[x];
+            if (x > 0) bumpiness += abs(heights[x] - heights[x - 1]);
+        }
+        return (int32_t)TetrisGameConfig::AI_W_LINES * lines
+             - (int32_t)TetrisGameConfig::AI_W_HEIGHT * aggregate
+             - (int32_t)TetrisGameConfig::AI_W_HOLES * holes
+             - (int32_t)TetrisGameConfig::AI_W_BUMPINESS * bumpiness;
+    }
+
+    void expand(const Node& parent, const PieceMask& pm, int8_t x, uint8_t rot) {
+        totalEvals++;
+        // Spawn row is y=0 (same as TetrisGame::initPiece); blocked spawn = no placement.
+        if (!fits(parent.rows, pm, x, 0)) return;
+        int y = 0;
+        while (fits(parent.rows, pm, x, y + 1)) y++;
+
+        Node child;
+        memcpy(child.rows, parent.rows, sizeof(child.rows));
+        for (int i = 0; i < 4; i++) {
+            if (pm.rows[i]) child.rows[y + i] |= shiftRow(pm.rows[i], x);
+        }
+
+        // Clear full lines (single compress pass, bottom-up).
+        uint8_t cleared = 0;
+        int dst = H - 1;
+        for (int src = H - 1; src >= 0; src--) {
+            if (child.rows[src] == FULL_ROW) {
+                cleared++;
+                continue;
+            }
+            child.rows[dst--] = child.rows[src];
+        }
+        while (dst >= 0) child.rows[dst--] = 0;
+
+        child.lines = (uint8_t)(parent.lines + cleared);
+        child.score = evaluate(child.rows, child.lines);
+        if (depth == 0) {
+            child.rootX = x;
+            child.rootRot = rot;
+        } else {
+            child.rootX = parent.rootX;
+            child.rootRot = parent.rootRot;
+        }
+        insertTop(child);
+    }
+
+    // Keep the next layer sorted by score (descending), capped at BEAM entries.
+    void insertTop(const Node& n) {
+        const uint8_t nxt = (uint8_t)(cur ^ 1u);
+        Node* L = layers[nxt];
+        uint8_t count = layerCount[nxt];
+        if (count == BEAM && n.score <= L[BEAM - 1].score) return;
+        int i = (count < BEAM) ? count : (BEAM - 1);
+        while (i > 0 && L[i - 1].score < n.score) {
+            L[i] = L[i - 1];
+            i--;
+        }
+        L[i] = n;
+        if (count < BEAM) layerCount[nxt] = (uint8_t)(count + 1);
+    }
+
+    void finishLayer() {
+        const uint8_t nxt = (uint8_t)(cur ^ 1u);
+        if (layerCount[nxt] == 0) {
+            // Nothing fits any more: play the best branch found so far (or give up at the root).
+            if (depth > 0 && layerCount[cur] > 0) setResult(layers[cur][0]);
+            done = true;
+            return;
+        }
+        if ((uint8_t)(depth + 1) >= depthCount) {
+            setResult(layers[nxt][0]);
+            done = true;
+            return;
+        }
+        cur = nxt;
+        layerCount[cur ^ 1u] = 0;
+        depth++;
+        cursorNode = 0;
+        cursorRot = 0;
+        cursorX = MIN_X;
+    }
+
+    void setResult(const Node& n) {
+        result.valid = true;
+        result.x = n.rootX;
+        result.rotation = n.rootRot;
+    }
+};
@@ -27,6 +27,23 @@ static constexpr int CELL_SIZE = 3;
 static constexpr unsigned long INITIAL_FALL_DELAY_MS = 500;
 static constexpr unsigned long FLASH_TOGGLE_MS = 90; // 6 toggles => 3 visible flashes
 
+// -----------------------------------------------------------------------------
+// Bot / autoplay (see TetrisGameAi.h)
+// -----------------------------------------------------------------------------
+// Beam search over the falling piece + previews. Width x lookahead bounds RAM
+// (2 * AI_BEAM_WIDTH nodes of ~48 bytes) and the work per search.
+static constexpr uint8_t AI_BEAM_WIDTH = 6;
+static constexpr uint8_t AI_LOOKAHEAD = 2;           // pieces searched: current + (AI_LOOKAHEAD - 1) previews (max 4)
+static constexpr uint16_t AI_EVALS_PER_TICK = 40;    // placements evaluated per update() call
+static constexpr unsigned long AI_MOVE_INTERVAL_MS = 60;   // pace of bot rotate/shift inputs
+static constexpr unsigned long AUTOPLAY_RESTART_MS = 4000; // game over -> new demo game
+
+// Heuristic weights (x1000): lines cleared, aggregate height, holes, bumpiness.
+static constexpr int16_t AI_W_LINES = 761;
+static constexpr int16_t AI_W_HEIGHT = 510;
+static constexpr int16_t AI_W_HOLES = 357;
+static constexpr int16_t AI_W_BUMPINESS = 184;
+
 // -----------------------------------------------------------------------------
 // Sprites / palettes
 // -----------------------------------------------------------------------------
@@ -2,15 +2,19 @@
 #include <Arduino.h>
 #include <ESP32-HUB75-MatrixPanel-I2S-DMA.h>
 #include "../../engine/GameBase.h"
+#include "../../engine/Snapshot.h"
 #include "../../engine/ControllerManager.h"
 #include "../../engine/config.h"
+#include "../../engine/Raster.h"
 #include "../../engine/AudioManager.h"
+#include "../../engine/NetPlay.h"
 #include "../../component/SmallFont.h"
 #include "../../engine/Settings.h"
 #include "../../engine/UserProfiles.h"
 #include "../../component/GameOverLeaderboardView.h"
 #include "TronGameConfig.h"
 #include "TronGameAudio.h"
+#include "TronTrailGrid.h"
 
 /**
  * TronGame - Classic Tron / Light-Cycles
@@ -21,6 +25,17 @@
  * - Colliding with the wall or ANY trail (including another player's head cell) eliminates you.
  * - When <= 1 player remains, the surviving player (if any) earns 1 point and a new round starts.
  * - First to WIN_SCORE wins the match.
+ * - Up to MAX_PLAYERS riders: one per connected pad, plus AI riders up to the chosen count.
+ *
+ * Match setup (before the first round, kept for rematches):
+ * - Player 1 picks the rider count (MIN_RIDERS..MAX_PLAYERS) and the arena
+ *   (TronGameConfig::ARENAS). UP/DOWN select, LEFT/RIGHT change, A starts.
+ * - Arenas larger than the content area scroll with player 1's rider.
+ *
+ * Linked play (engine/NetPlay.h): with a peer cabinet around, start() skips the
+ * setup screen and runs a lockstep match instead: one rider per cabinet (slot 0
+ * and 1 = NetPlay sides), CPU riders up to NET_RIDERS, arena NET_ARENA. The CPU
+ * riders draw from the session DetRandom, so both cabinets steer them alike.
  *
  * HUD:
  * - Same style / reserved top area approach as Snake: scores across the top.
@@ -29,7 +44,7 @@
  * - All constants/types are kept inside the class to avoid header name collisions
  *   with other games (e.g., Snake defines Point/Direction/HUD_HEIGHT globally).
  */
-class TronGame : public GameBase {
+class TronGame : public GameBase, public NetGame {
 private:
     // ---------------------------------------------------------
     // Layout (match Snake's "inset border + HUD" concept)
@@ -52,10 +67,17 @@ private:
     static constexpr int CONTENT_W = TronGameConfig::CONTENT_W;
     static constexpr int CONTENT_H = TronGameConfig::CONTENT_H;
 
-    // Logical grid (cells)
+    // Logical grid (cells) of the content area; arenas may be smaller or larger.
     static constexpr int GRID_W = TronGameConfig::GRID_W;
     static constexpr int GRID_H = TronGameConfig::GRID_H;
 
+    static constexpr int MAX_PLAYERS = TronGameConfig::MAX_PLAYERS;
+    static_assert(MAX_PLAYERS >= MAX_GAMEPADS, "Tron needs a slot per pad");
+    static_assert(MAX_PLAYERS <= TronTrailGrid::MAX_OWNERS, "trail cells store owner + 1 in 4 bits");
+    static constexpr int MIN_RIDERS = TronGameConfig::MIN_RIDERS;
+    static constexpr int ARENA_COUNT = TronGameConfig::ARENA_COUNT;
+    static_assert(MIN_RIDERS >= 2 && MIN_RIDERS <= MAX_PLAYERS, "a round needs two riders");
+
     // ---------------------------------------------------------
     // Game rules / pacing
     // ---------------------------------------------------------
@@ -68,7 +90,7 @@ private:
         bool active = false;     // participating in this match (connected at start)
         bool alive = false;      // alive in the current round
         bool isAi = false;       // true when this player is controlled by the built-in AI
-        uint8_t padIndex = 0;    // 0..3 (controller slot)
+        uint8_t padIndex = 0;    // player slot (0..MAX_PLAYERS-1); pad index for humans
         uint8_t score = 0;       // round wins
         uint16_t color = COLOR_WHITE;
         Dir dir = Dir::Right;
@@ -77,11 +99,21 @@ private:
         int y = 0;               // logical cell
     };
 
-    // 0 = empty, else (padIndex+1) owner
-    uint8_t trail[GRID_W * GRID_H];
-    Player players[MAX_GAMEPADS];
+    // 0 = empty, else (slot+1) owner; sized per round in startRound().
+    TronTrailGrid trail;
+    Player players[MAX_PLAYERS];
     bool gameOver = false;
-    int winnerPad = -1; // 0..3
+
+    // Match setup: chosen on the setup screen, kept across reset().
+    bool inSetup = true;
+    uint8_t setupRow = 0; // 0 = riders, 1 = arena
+    uint8_t riderTarget = TronGameConfig::DEFAULT_RIDERS;
+    uint8_t arenaIndex = TronGameConfig::DEFAULT_ARENA;
+
+    // Arena cell shown at the content area's top-left (negative = arena centered).
+    int viewX = 0;
+    int viewY = 0;
+    int winnerPad = -1; // player slot
     uint8_t roundNo = 1;
 
     uint32_t lastTickMs = 0;
@@ -98,9 +130,55 @@ private:
     static constexpr uint16_t CRASH_SFX_COOLDOWN_MS = 250;
     static constexpr uint16_t ROUND_WIN_SFX_COOLDOWN_MS = 350;
 
-    uint16_t playerColors[4] = { COLOR_GREEN, COLOR_CYAN, COLOR_ORANGE, COLOR_PURPLE };
+    // ---------------------------------------------------------
+    // Linked play (see engine/NetPlay.h)
+    // ---------------------------------------------------------
+    // In net mode the match runs on a virtual clock (NET_FRAME_MS per net frame)
+    // and all randomness comes from `rng`, so both cabinets simulate identically.
+    // Local matches use `rng` too (seeded from random()).
+    static constexpr uint32_t NET_FRAME_MS = TronGameConfig::NET_FRAME_MS;
+    bool netMode = false;
+    bool netSeeded = false;
+    bool linkLost = false;
+    bool replaying = false;   // NetPlay is re-simulating after a rollback (mute SFX)
+    uint32_t simFrame = 0;    // net frames simulated
+    uint32_t endFrame = 0;    // net frame that ended the match
+    uint32_t netWaitStartMs = 0;
+    uint32_t lastNetFrameMs = 0;
+    DetRandom rng;
+
+    // Trail cells are only ever added during a round, so a state slot keeps the
+    // number marked so far and a rollback clears the newer ones, listed here,
+    // instead of storing a copy of the grid per slot.
+    struct Mark {
+        uint8_t x;
+        uint8_t y;
+    };
+    static constexpr uint16_t MARK_RING = 128;
+    static_assert(MARK_RING >= (NetPlay::STATE_SLOTS + 1) * MAX_PLAYERS, "mark ring shorter than the rollback window");
+    // A rollback never reaches back past a round start into the previous round's play.
+    static_assert(ROUND_RESET_DELAY_MS > NetPlay::STATE_SLOTS * NET_FRAME_MS, "round pause shorter than the rollback window");
+    Mark markRing[MARK_RING];
+    uint16_t marks = 0; // cells marked this round
+
+    // Everything netStep() reads or writes (plus `trail`, see Mark).
+    struct NetState {
+        Player players[MAX_PLAYERS];
+        bool gameOver;
+        bool roundActive;
+        int8_t winnerPad;
+        uint8_t roundNo;
+        uint32_t lastTickMs;
+        uint32_t roundEndMs;
+        uint16_t marks;
+        uint32_t simFrame;
+        uint32_t endFrame;
+        DetRandom rng;
+    };
+    NetState netSlots[NetPlay::STATE_SLOTS];
 
-    static inline int idx(int x, int y) { return y * GRID_W + x; }
+    // The rider this cabinet's pad 0 steers.
+    uint8_t localSlot() const { return netMode ? globalNetPlay.localSide() : 0; }
 
     static inline bool isOpposite(Dir a, Dir b) {
         return (a == Dir::Up && b == Dir::Down) ||
@@ -129,127 +207,131 @@ private:
         return Dir::Up;
     }
 
-    void clearTrail() {
-        memset(trail, 0, sizeof(trail));
-    }
-
     void markCell(int x, int y, uint8_t ownerPadIndex) {
-        if (x < 0 || x >= GRID_W || y < 0 || y >= GRID_H) return;
-        trail[idx(x, y)] = (uint8_t)(ownerPadIndex + 1);
+        trail.set(x, y, (uint8_t)(ownerPadIndex + 1));
+        if (netMode) {
+            markRing[marks % MARK_RING] = { (uint8_t)x, (uint8_t)y };
+            marks++;
+        }
     }
 
+    // 0 = free; out of bounds reads as TronTrailGrid::WALL.
     uint8_t getCell(int x, int y) const {
-        if (x < 0 || x >= GRID_W || y < 0 || y >= GRID_H) return 0xFF; // treat OOB as wall
-        return trail[idx(x, y)];
+        return trail.get(x, y);
     }
 
     void setupPlayersFromConnectedControllers() {
-        // Apply current global player color for Player 1 (pad index 0).
-        playerColors[0] = globalSettings.getPlayerColor();
-
         // Initialize all players as inactive; only controllers present at match start participate.
-        for (int i = 0; i < MAX_GAMEPADS; i++) {
+        for (int i = 0; i < MAX_PLAYERS; i++) {
             players[i].active = false;
             players[i].alive = false;
             players[i].isAi = false;
             players[i].padIndex = (uint8_t)i;
             players[i].score = 0;
-            players[i].color = playerColors[i];
+            players[i].color = TronGameConfig::PLAYER_COLORS[i];
             players[i].dir = Dir::Right;
             players[i].nextDir = Dir::Right;
             players[i].x = 0;
             players[i].y = 0;
         }
-
-        for (int i = 0; i < MAX_GAMEPADS; i++) {
-            if (globalControllerManager->getController(i)) {
-                players[i].active = true;
-            }
-        }
-
-        // Single-player support: if only one controller is connected at match start,
-        // spawn one basic AI opponent in the first free slot.
-        if (globalControllerManager->getConnectedCount() == 1) {
-            int humanPad = -1;
-            for (int i = 0; i < MAX_GAMEPADS; i++) {
-                if (players[i].active) { humanPad = i; break; }
-            }
-
-            int aiPad = -1;
+        // Apply current global player color for this cabinet's rider.
+        players[localSlot()].color = globalSettings.getPlayerColor();
+
+        if (netMode) {
+            // One rider per cabinet.
+            players[0].active = true;
+            players[1].active = true;
+        } else {
             for (int i = 0; i < MAX_GAMEPADS; i++) {
-                if (i == humanPad) continue;
-                if (!players[i].active) { aiPad = i; break; }
+                if (globalControllerManager->pad(i).connected) {
+                    players[i].active = true;
+                }
             }
+        }
 
-            if (aiPad >= 0) {
-                players[aiPad].active = true;
-                players[aiPad].isAi = true;
-            }
+        // AI riders fill the first free slots up to the chosen rider count.
+        const int riders = netMode ? TronGameConfig::NET_RIDERS : riderTarget;
+        int count = activeCount();
+        for (int i = 0; i < MAX_PLAYERS && count < riders; i++) {
+            if (players[i].active) continue;
+            players[i].active = true;
+            players[i].isAi = true;
+            count++;
         }
     }
 
     int activeCount() const {
         int c = 0;
-        for (int i = 0; i < MAX_GAMEPADS; i++) if (players[i].active) c++;
+        for (int i = 0; i < MAX_PLAYERS; i++) if (players[i].active) c++;
         return c;
     }
 
     int aliveCount() const {
         int c = 0;
-        for (int i = 0; i < MAX_GAMEPADS; i++) if (players[i].active && players[i].alive) c++;
+        for (int i = 0; i < MAX_PLAYERS; i++) if (players[i].active && players[i].alive) c++;
         return c;
     }
 
     int lastAlivePad() const {
-        for (int i = 0; i < MAX_GAMEPADS; i++) {
+        for (int i = 0; i < MAX_PLAYERS; i++) {
             if (players[i].active && players[i].alive) return i;
         }
         return -1;
     }
 
+    // Linked matches always use NET_ARENA; the local choice is kept for later.
+    uint8_t matchArena() const { return netMode ? (uint8_t)TronGameConfig::NET_ARENA : arenaIndex; }
+    int arenaW() const { return TronGameConfig::ARENAS[matchArena()].w; }
+    int arenaH() const { return TronGameConfig::ARENAS[matchArena()].h; }
+
     void startRound(uint32_t nowMs) {
-        clearTrail();
+        trail.resize(arenaW(), arenaH());
+        marks = 0;
         roundActive = true;
         roundEndMs = 0;
         lastTickMs = nowMs;
 
-        // Default spawn points (works for 1..4 players)
-        // P1: left-mid -> right
-        // P2: right-mid -> left
-        // P3: mid-top -> down
-        // P4: mid-bottom -> up
+        // Default spawn points (works for 1..8 players)
+        // P1: left-mid -> right        P5: left, upper quarter -> right
+        // P2: right-mid -> left        P6: right, lower quarter -> left
+        // P3: mid-top -> down          P7: top, right quarter -> down
+        // P4: mid-bottom -> up         P8: bottom, left quarter -> up
+        const int w = trail.width();
+        const int h = trail.height();
         const int leftX = 2;
-        const int rightX = GRID_W - 3;
-        const int midX = GRID_W / 2;
+        const int rightX = w - 3;
         const int topY = 2;
-        const int bottomY = GRID_H - 3;
-        const int midY = GRID_H / 2;
-
-        for (int i = 0; i < MAX_GAMEPADS; i++) {
+        const int bottomY = h - 3;
+        struct Spawn { int x; int y; Dir dir; };
+        const Spawn spawns[8] = {
+            { leftX, h / 2, Dir::Right },       { rightX, h / 2, Dir::Left },
+            { w / 2, topY, Dir::Down },         { w / 2, bottomY, Dir::Up },
+            { leftX, h / 4, Dir::Right },       { rightX, (3 * h) / 4, Dir::Left },
+            { (3 * w) / 4, topY, Dir::Down },   { w / 4, bottomY, Dir::Up },
+        };
+        static_assert(MAX_PLAYERS <= 8, "add spawn points for more players");
+
+        for (int i = 0; i < MAX_PLAYERS; i++) {
             if (!players[i].active) continue;
             players[i].alive = true;
-            players[i].nextDir = players[i].dir; // will be set below
+            players[i].x = spawns[i].x;
+            players[i].y = spawns[i].y;
+            players[i].dir = spawns[i].dir;
+            players[i].nextDir = spawns[i].dir;
         }
 
-        if (players[0].active) { players[0].x = leftX;  players[0].y = midY;   players[0].dir = Dir::Right; players[0].nextDir = Dir::Right; }
-        if (players[1].active) { players[1].x = rightX; players[1].y = midY;   players[1].dir = Dir::Left;  players[1].nextDir = Dir::Left;  }
-        if (players[2].active) { players[2].x = midX;   players[2].y = topY;   players[2].dir = Dir::Down;  players[2].nextDir = Dir::Down;  }
-        if (players[3].active) { players[3].x = midX;   players[3].y = bottomY;players[3].dir = Dir::Up;    players[3].nextDir = Dir::Up;    }
-
         // Mark initial head cells as occupied (heads are solid in Tron)
-        for (int i = 0; i < MAX_GAMEPADS; i++) {
+        for (int i = 0; i < MAX_PLAYERS; i++) {
             if (players[i].active && players[i].alive) {
                 markCell(players[i].x, players[i].y, (uint8_t)i);
             }
         }
     }
 
-    void handlePlayerInput(Player& p, ControllerPtr ctl) {
-        if (!ctl || !ctl->isConnected()) return;
-
+    void handlePlayerInput(Player& p, uint8_t dpad, uint32_t now) {
         // D-pad mapping in this codebase:
         // 0x01 UP, 0x02 DOWN, 0x04 RIGHT, 0x08 LEFT
-        const uint8_t d = ctl->dpad();
+        const uint8_t d = dpad;
         Dir desired = p.nextDir;
 
         if (d & 0x01) desired = Dir::Up;
@@ -261,9 +343,8 @@ private:
         if (!isOpposite(p.dir, desired)) {
             // Turn SFX (minimal):
             // - Only when the direction actually changes (edge)
-            // - Only for the human player on pad 0 to keep multiplayer/AI from being noisy
-            if (!p.isAi && p.padIndex == 0 && desired != p.nextDir) {
-                const uint32_t now = millis();
+            // - Only for this cabinet's rider to keep multiplayer/AI from being noisy
+            if (!p.isAi && p.padIndex == localSlot() && !replaying && desired != p.nextDir) {
                 if ((uint32_t)(now - lastTurnSfxMs[p.padIndex]) >= TURN_SFX_COOLDOWN_MS) {
                     lastTurnSfxMs[p.padIndex] = now;
                     globalAudio.playPattern(
@@ -315,39 +396,24 @@ private:
         Dir bestDir = straight;
 
         if (sLeft > best) { best = sLeft; bestDir = left; }
-        else if (sLeft == best && random(0, 2) == 0) { bestDir = left; }
+        else if (sLeft == best && rng.range(0, 2) == 0) { bestDir = left; }
 
         if (sRight > best) { best = sRight; bestDir = right; }
-        else if (sRight == best && random(0, 2) == 0) { bestDir = right; }
+        else if (sRight == best && rng.range(0, 2) == 0) { bestDir = right; }
 
         // If all are zero, we still must choose something; pick a turn randomly.
         if (best == 0) {
-            bestDir = (random(0, 2) == 0) ? left : right;
+            bestDir = (rng.range(0, 2) == 0) ? left : right;
         }
 
         p.nextDir = bestDir;
     }
 
-public:
-    TronGame() {
-        memset(trail, 0, sizeof(trail));
-    }
-
-    /**
-     * Tron is a fixed-tick game; rendering much faster than the tick doesn't help.
-     */
-    uint16_t preferredRenderFps() const override {
-        if (TRON_SPEED_MS == 0) return GAME_RENDER_FPS;
-        uint16_t fps = (uint16_t)(1000UL / (uint32_t)TRON_SPEED_MS);
-        if (fps < 10) fps = 10;
-        if (fps > GAME_RENDER_FPS) fps = GAME_RENDER_FPS;
-        return fps;
-    }
-
-    void start() override {
+    void beginMatch(uint32_t nowMs) {
         gameOver = false;
         winnerPad = -1;
         roundNo = 1;
+        inSetup = false;
 
         // Reset audio cooldowns for a clean match start.
         for (int i = 0; i < MAX_GAMEPADS; i++) {
@@ -357,15 +423,90 @@ public:
         lastRoundWinSfxMs = 0;
 
         setupPlayersFromConnectedControllers();
-        startRound(millis());
+        startRound(nowMs);
     }
 
-    void reset() override {
-        start();
+    void updateSetup(const PadState& pad, uint32_t nowMs) {
+        if (pad.dpadPressed & (PadState::DPAD_UP | PadState::DPAD_DOWN)) {
+            setupRow ^= 1;
+            if (pad.dpadPressed & PadState::DPAD_UP) globalAudio.uiUp();
+            else globalAudio.uiDown();
+        }
+        int step = 0;
+        if (pad.dpadPressed & PadState::DPAD_LEFT) step = -1;
+        if (pad.dpadPressed & PadState::DPAD_RIGHT) step = 1;
+        if (step != 0) {
+            if (setupRow == 0) {
+                const int span = MAX_PLAYERS - MIN_RIDERS + 1;
+                riderTarget = (uint8_t)(MIN_RIDERS + (riderTarget - MIN_RIDERS + step + span) % span);
+            } else {
+                arenaIndex = (uint8_t)((arenaIndex + step + ARENA_COUNT) % ARENA_COUNT);
+            }
+            if (step < 0) globalAudio.uiLeft();
+            else globalAudio.uiRight();
+        }
+        if (pad.hit(PadState::BTN_A)) {
+            globalAudio.uiConfirmShoot();
+            beginMatch(nowMs);
+        }
     }
 
-    void update(ControllerManager* input) override {
-        const uint32_t now = millis();
+    // Per axis: an arena that fits is centered, a larger one scrolls to keep the
+    // followed rider (player 1, else the first one alive) in the middle.
+    static int viewAxis(int arena, int visible, int follow, int current) {
+        if (arena <= visible) return -(visible - arena) / 2;
+        int v = (follow >= 0) ? follow - visible / 2 : current;
+        if (v < 0) v = 0;
+        if (v > arena - visible) v = arena - visible;
+        return v;
+    }
+
+    void updateView() {
+        const int me = localSlot();
+        int follow = (players[me].active && players[me].alive) ? me : lastAlivePad();
+        const int fx = (follow >= 0) ? players[follow].x : -1;
+        const int fy = (follow >= 0) ? players[follow].y : -1;
+        viewX = viewAxis(trail.width(), GRID_W, fx, viewX);
+        viewY = viewAxis(trail.height(), GRID_H, fy, viewY);
+    }
+
+    // Arena walls, clipped to the border rectangle. When the arena scrolls, the
+    // border shows dim where it is only the edge of the view.
+    void drawWalls(MatrixPanel_I2S_DMA* display) const {
+        const int fx0 = BORDER_X, fx1 = BORDER_X + BORDER_W - 1;
+        const int fy0 = BORDER_Y, fy1 = BORDER_Y + BORDER_H - 1;
+        if (trail.width() > GRID_W || trail.height() > GRID_H) {
+            Raster::rect(display, BORDER_X, BORDER_Y, BORDER_W, BORDER_H, TronGameConfig::VIEW_EDGE_COLOR);
+        }
+        const int left = CONTENT_X + (-1 - viewX) * CELL_PX;
+        const int right = CONTENT_X + (trail.width() - viewX) * CELL_PX;
+        const int top = CONTENT_Y + (-1 - viewY) * CELL_PX;
+        const int bottom = CONTENT_Y + (trail.height() - viewY) * CELL_PX;
+        const int x0 = max(left, fx0), x1 = min(right, fx1);
+        const int y0 = max(top, fy0), y1 = min(bottom, fy1);
+        if (x0 > x1 || y0 > y1) return;
+        if (top >= fy0) Raster::hspan(display, x0, x1, top, COLOR_WHITE);
+        if (bottom <= fy1) Raster::hspan(display, x0, x1, bottom, COLOR_WHITE);
+        if (left >= fx0) Raster::vspan(display, left, y0, y1, COLOR_WHITE);
+        if (right <= fx1) Raster::vspan(display, right, y0, y1, COLOR_WHITE);
+    }
+
+    void drawSetup(MatrixPanel_I2S_DMA* display) const {
+        const TronGameConfig::Arena& a = TronGameConfig::ARENAS[arenaIndex];
+        SmallFont::drawString(display, 22, 8, "TRON", COLOR_CYAN);
+        const uint16_t riderColor = (setupRow == 0) ? COLOR_YELLOW : COLOR_WHITE;
+        const uint16_t arenaColor = (setupRow == 1) ? COLOR_YELLOW : COLOR_WHITE;
+        SmallFont::drawStringF(display, 4, 22, riderColor, "RIDERS <%d>", riderTarget);
+        SmallFont::drawStringF(display, 4, 32, arenaColor, "ARENA <%s>", a.name);
+        SmallFont::drawStringF(display, 4, 42, COLOR_BLUE, "%dX%d", a.w, a.h);
+        SmallFont::drawString(display, 4, 56, "A: START", COLOR_GREEN);
+    }
+
+    /**
+     * One logic step. Shared by local play (real clock, pads read from `input`)
+     * and linked play (net frame clock, side inputs in `net`, `input` unused).
+     */
+    void simulate(uint32_t now, ControllerManager* input, const NetInput* net) {
         if (gameOver) return;
 
         // Inter-round pause: after delay, start next round
@@ -382,26 +523,29 @@ public:
         lastTickMs = now;
 
         // 1) Input
-        for (int i = 0; i < MAX_GAMEPADS; i++) {
+        for (int i = 0; i < MAX_PLAYERS; i++) {
             Player& p = players[i];
             if (!p.active || !p.alive) continue;
             if (p.isAi) {
                 handleAiInput(p);
+            } else if (net) {
+                // Slot 0/1 = NetPlay side 0/1.
+                handlePlayerInput(p, net[i].dpad, now);
             } else {
-                ControllerPtr ctl = input->getController(p.padIndex);
-                if (!ctl) {
+                const PadState& pad = input->pad(p.padIndex);
+                if (!pad.connected) {
                     // Controller disappeared -> eliminated
                     p.alive = false;
                     continue;
                 }
-                handlePlayerInput(p, ctl);
+                handlePlayerInput(p, pad.dpad, now);
             }
         }
 
         // 2) Compute next heads (simultaneous)
         struct NextPos { int x; int y; bool willMove; bool crash; };
-        NextPos next[MAX_GAMEPADS];
-        for (int i = 0; i < MAX_GAMEPADS; i++) {
+        NextPos next[MAX_PLAYERS];
+        for (int i = 0; i < MAX_PLAYERS; i++) {
             next[i] = {0, 0, false, false};
             Player& p = players[i];
             if (!p.active || !p.alive) continue;
@@ -419,7 +563,7 @@ public:
 
         // 3) Collisions (walls + trails + head-on)
         // Wall/trail collision
-        for (int i = 0; i < MAX_GAMEPADS; i++) {
+        for (int i = 0; i < MAX_PLAYERS; i++) {
             if (!next[i].willMove) continue;
             const uint8_t cell = getCell(next[i].x, next[i].y);
             if (cell != 0) {
@@ -428,9 +572,9 @@ public:
         }
 
         // Head-on: same destination cell => crash all involved
-        for (int i = 0; i < MAX_GAMEPADS; i++) {
+        for (int i = 0; i < MAX_PLAYERS; i++) {
             if (!next[i].willMove) continue;
-            for (int j = i + 1; j < MAX_GAMEPADS; j++) {
+            for (int j = i + 1; j < MAX_PLAYERS; j++) {
                 if (!next[j].willMove) continue;
                 if (next[i].x == next[j].x && next[i].y == next[j].y) {
                     next[i].crash = true;
@@ -440,7 +584,7 @@ public:
         }
 
         // 4) Apply moves + mark trails
-        for (int i = 0; i < MAX_GAMEPADS; i++) {
+        for (int i = 0; i < MAX_PLAYERS; i++) {
             Player& p = players[i];
             if (!p.active || !p.alive) continue;
 
@@ -454,8 +598,8 @@ public:
                 p.alive = false;
 
                 // Crash SFX (minimal):
-                // - Only for pad 0 so multiplayer doesn't become chaotic
-                if (wasAlive && p.padIndex == 0) {
+                // - Only for this cabinet's rider so multiplayer doesn't become chaotic
+                if (wasAlive && p.padIndex == localSlot() && !replaying) {
                     if ((uint32_t)(now - lastCrashSfxMs[p.padIndex]) >= CRASH_SFX_COOLDOWN_MS) {
                         lastCrashSfxMs[p.padIndex] = now;
                         globalAudio.playPattern(
@@ -484,13 +628,15 @@ public:
                     winnerPad = last;
 
                     // Match over SFX (minimal): only once at match end.
-                    globalAudio.playPattern(
-                        TronGameAudio::SFX_GAME_OVER,
-                        (uint8_t)(sizeof(TronGameAudio::SFX_GAME_OVER) / sizeof(TronGameAudio::SFX_GAME_OVER[0]))
-                    );
+                    if (!replaying) {
+                        globalAudio.playPattern(
+                            TronGameAudio::SFX_GAME_OVER,
+                            (uint8_t)(sizeof(TronGameAudio::SFX_GAME_OVER) / sizeof(TronGameAudio::SFX_GAME_OVER[0]))
+                        );
+                    }
                 } else {
                     // Round win SFX: rate-limited so we don't double-play on edge cases.
-                    if ((uint32_t)(now - lastRoundWinSfxMs) >= ROUND_WIN_SFX_COOLDOWN_MS) {
+                    if (!replaying && (uint32_t)(now - lastRoundWinSfxMs) >= ROUND_WIN_SFX_COOLDOWN_MS) {
                         lastRoundWinSfxMs = now;
                         globalAudio.playPattern(
                             TronGameAudio::SFX_ROUND_WIN,
@@ -502,13 +648,130 @@ public:
         }
     }
 
+    void updateNet(ControllerManager* input) {
+        if (isGameOver()) return;
+        if (globalNetPlay.sessionLost()) {
+            linkLost = true;
+            gameOver = true;
+            return;
+        }
+        if (!globalNetPlay.sessionRunning()) {
+            // "WAIT PEER": the other cabinet may never start Tron. Set up a
+            // local match instead once it's gone quiet, the wait times out, or on B.
+            if (!globalNetPlay.linked() || input->pad(0).held(PadState::BTN_B) ||
+                (uint32_t)(millis() - netWaitStartMs) >= TronGameConfig::NET_PEER_WAIT_MS) {
+                globalNetPlay.endSession();
+                begin(/*tryLink=*/false);
+            }
+            return;
+        }
+
+        if (!netSeeded) {
+            // Same starting state on both cabinets.
+            netSeeded = true;
+            rng.seed(globalNetPlay.sessionSeed());
+            beginMatch(0);
+        }
+        // This cabinet's pad 0 drives our rider; the peer's arrives over the link.
+        globalNetPlay.tick(*this, NetInput::sample(input->pad(0)));
+    }
+
+    // Linked match when `tryLink` and a peer cabinet is around, else the setup screen.
+    void begin(bool tryLink) {
+        gameOver = false;
+        winnerPad = -1;
+        roundNo = 1;
+        roundActive = false;
+        roundEndMs = 0;
+        setupRow = 0;
+        for (int i = 0; i < MAX_PLAYERS; i++) {
+            players[i].active = false;
+            players[i].alive = false;
+        }
+
+        netMode = tryLink && globalNetPlay.linked();
+        netSeeded = false;
+        linkLost = false;
+        simFrame = 0;
+        endFrame = 0;
+        netWaitStartMs = millis();
+        lastNetFrameMs = netWaitStartMs;
+        inSetup = !netMode;
+        if (netMode) {
+            globalNetPlay.startSession(TronGameConfig::NET_GAME_ID);
+        } else {
+            rng.seed((uint32_t)random(1, 0x7FFFFFFF));
+        }
+    }
+
+public:
+    TronGame() = default;
+
+    ~TronGame() override {
+        if (netMode) globalNetPlay.endSession();
+    }
+
+    /**
+     * Tron is a fixed-tick game; rendering much faster than the tick doesn't help.
+     */
+    uint16_t preferredRenderFps() const override {
+        if (TRON_SPEED_MS == 0) return GAME_RENDER_FPS;
+        uint16_t fps = (uint16_t)(1000UL / (uint32_t)TRON_SPEED_MS);
+        if (fps < 10) fps = 10;
+        if (fps > GAME_RENDER_FPS) fps = GAME_RENDER_FPS;
+        return fps;
+    }
+
+    // Linked match with a peer cabinet around; otherwise opens the match setup
+    // screen and the first round starts when player 1 confirms.
+    void start() override {
+        begin(/*tryLink=*/true);
+    }
+
+    // Rematch with the same riders and arena (a linked match looks for the peer again).
+    void reset() override {
+        if (netMode) begin(/*tryLink=*/true);
+        else beginMatch(millis());
+    }
+
+    void update(ControllerManager* input) override {
+        const uint32_t now = millis();
+        if (inSetup) {
+            updateSetup(input->pad(0), now);
+            return;
+        }
+        if (netMode) {
+            if ((uint32_t)(now - lastNetFrameMs) < NET_FRAME_MS) return;
+            lastNetFrameMs = now;
+            updateNet(input);
+            return;
+        }
+        simulate(now, input, nullptr);
+    }
+
     void draw(MatrixPanel_I2S_DMA* display) override {
         display->fillScreen(COLOR_BLACK);
 
+        if (inSetup) {
+            drawSetup(display);
+            return;
+        }
+
+        if (netMode && !netSeeded && !linkLost) {
+            SmallFont::drawString(display, 14, 30, "WAIT PEER", COLOR_YELLOW);
+            const uint32_t waited = (uint32_t)(millis() - netWaitStartMs);
+            const uint32_t secsLeft = (waited < TronGameConfig::NET_PEER_WAIT_MS) ? (TronGameConfig::NET_PEER_WAIT_MS - waited + 999) / 1000 : 0;
+            SmallFont::drawStringF(display, 14, 40, COLOR_CYAN, "B SOLO %lu", (unsigned long)secsLeft);
+            return;
+        }
+
         // GAME OVER screen
-        if (gameOver) {
+        if (isGameOver()) {
             char title[12];
-            if (winnerPad >= 0) snprintf(title, sizeof(title), "P%d WINS", winnerPad + 1);
+            if (linkLost) snprintf(title, sizeof(title), "LINK LOST");
+            else if (netMode && winnerPad == localSlot()) snprintf(title, sizeof(title), "YOU WIN");
+            else if (netMode) snprintf(title, sizeof(title), "YOU LOSE");
+            else if (winnerPad >= 0) snprintf(title, sizeof(title), "P%d WINS", winnerPad + 1);
             else snprintf(title, sizeof(title), "GAME OVER");
 
             char tag[4];
@@ -520,37 +783,50 @@ public:
         // HUD (same spirit as Snake)
         const int hudY = 6; // 1px margin + avoid top overflow
         int hudX = 2;
-        for (int i = 0; i < MAX_GAMEPADS; i++) {
+        const bool compactHud = activeCount() > 3; // "P1:3" fits three times next to the alive count
+        for (int i = 0; i < MAX_PLAYERS; i++) {
             if (!players[i].active) continue;
-            SmallFont::drawStringF(display, hudX, hudY, players[i].color, "P%d:%d", i + 1, players[i].score);
-            hudX += 16;
+            if (compactHud) {
+                // Score only, in the rider's color.
+                SmallFont::drawStringF(display, hudX, hudY, players[i].color, "%d", players[i].score);
+                hudX += 6;
+            } else {
+                SmallFont::drawStringF(display, hudX, hudY, players[i].color, "P%d:%d", i + 1, players[i].score);
+                hudX += 16;
+            }
         }
 
         // Alive count indicator on the right
         SmallFont::drawStringF(display, PANEL_RES_X - 12, hudY, COLOR_YELLOW, "A%d", aliveCount());
 
-        // Border
-        display->drawRect(BORDER_X, BORDER_Y, BORDER_W, BORDER_H, COLOR_WHITE);
-
-        // Trails (grid)
-        for (int y = 0; y < GRID_H; y++) {
-            for (int x = 0; x < GRID_W; x++) {
-                const uint8_t v = trail[idx(x, y)];
-                if (v == 0) continue;
-                const uint8_t owner = (uint8_t)(v - 1);
-                const uint16_t c = (owner < 4) ? playerColors[owner] : COLOR_WHITE;
-                const int px = CONTENT_X + x * CELL_PX;
-                const int py = CONTENT_Y + y * CELL_PX;
-                // 1px-wide trails (CELL_PX == 1), but keep math generic.
-                display->drawPixel(px, py, c);
-            }
-        }
+        // Border / arena walls
+        updateView();
+        drawWalls(display);
+
+        // Trails: one span per run of same-owner cells; empty 8-cell words are skipped.
+        // Runs are clipped to the visible window of the arena.
+        const int visX0 = max(0, viewX), visX1 = min(trail.width(), viewX + GRID_W) - 1;
+        const int visY0 = max(0, viewY), visY1 = min(trail.height(), viewY + GRID_H) - 1;
+        trail.forEachRun([&](int x0, int x1, int y, uint8_t v) {
+            if (y < visY0 || y > visY1) return;
+            x0 = max(x0, visX0);
+            x1 = min(x1, visX1);
+            if (x0 > x1) return;
+            const uint8_t owner = (uint8_t)(v - 1);
+            const uint16_t c = (owner < MAX_PLAYERS) ? players[owner].color : COLOR_WHITE;
+            const int px = CONTENT_X + (x0 - viewX) * CELL_PX;
+            const int py = CONTENT_Y + (y - viewY) * CELL_PX;
+            // 1px-wide trails (CELL_PX == 1), but keep math generic.
+            if (CELL_PX == 1) Raster::hspan(display, px, CONTENT_X + (x1 - viewX), py, c);
+            else display->fillRect(px, py, (x1 - x0 + 1) * CELL_PX, CELL_PX, c);
+        });
 
         // Heads: small highlight so you can see direction more easily
-        for (int i = 0; i < MAX_GAMEPADS; i++) {
+        for (int i = 0; i < MAX_PLAYERS; i++) {
             if (!players[i].active || !players[i].alive) continue;
-            const int px = CONTENT_X + players[i].x * CELL_PX;
-            const int py = CONTENT_Y + players[i].y * CELL_PX;
+            if (players[i].x < visX0 || players[i].x > visX1 || players[i].y < visY0 || players[i].y > visY1) continue;
+            const int px = CONTENT_X + (players[i].x - viewX) * CELL_PX;
+            const int py = CONTENT_Y + (players[i].y - viewY) * CELL_PX;
             // White highlight on the head (still 1px)
             display->drawPixel(px, py, COLOR_WHITE);
         }
@@ -567,7 +843,9 @@ public:
     }
 
     bool isGameOver() override {
-        return gameOver;
+        // Linked: a predicted game over only counts once no rollback can undo it.
+        if (!netMode || linkLost) return gameOver;
+        return gameOver && (int32_t)endFrame <= globalNetPlay.confirmedFrame();
     }
 
     // ------------------------------
@@ -579,12 +857,188 @@ public:
     uint32_t leaderboardScore() const override {
         // Submit the highest match score achieved by any player.
         uint32_t best = 0;
-        for (int i = 0; i < MAX_GAMEPADS; i++) {
+        for (int i = 0; i < MAX_PLAYERS; i++) {
             if (!players[i].active) continue;
             if ((uint32_t)players[i].score > best) best = (uint32_t)players[i].score;
         }
         return best;
     }
+
+    // ------------------------------
+    // Self-check (DEBUG_INVARIANTS)
+    // ------------------------------
+    const char* checkInvariants() const override {
+        if (winnerPad < -1 || winnerPad >= MAX_PLAYERS) return "winner slot out of range";
+        if (arenaIndex >= ARENA_COUNT) return "arena choice out of range";
+        if (riderTarget < MIN_RIDERS || riderTarget > MAX_PLAYERS) return "rider count out of range";
+        if (roundActive && (trail.width() != arenaW() || trail.height() != arenaH())) return "trail grid not sized for the arena";
+        if (!trail.valid(MAX_PLAYERS)) return "trail cell owner out of range";
+        // Heads are solid: every live rider sits on a cell it owns.
+        for (int i = 0; i < MAX_PLAYERS; i++) {
+            const Player& p = players[i];
+            if (!p.alive) continue;
+            if (!p.active) return "inactive rider alive";
+            if (p.x < 0 || p.x >= trail.width() || p.y < 0 || p.y >= trail.height()) return "rider off the grid";
+            if (trail.get(p.x, p.y) != (uint8_t)(i + 1)) return "rider head not on its own trail";
+        }
+        return nullptr;
+    }
+
+    // ------------------------------
+    // Snapshots (engine/Snapshot.h)
+    // ------------------------------
+    // A linked match can't be resumed without the peer.
+    uint8_t snapshotVersion() const override { return netMode ? 0 : 4; }
+
+    void saveSnapshot(SnapshotWriter& w) const override {
+        w.boolean(inSetup);
+        w.u8(setupRow);
+        w.u8(riderTarget);
+        w.u8(arenaIndex);
+        if (inSetup) return; // no match yet
+        w.boolean(gameOver);
+        w.boolean(roundActive);
+        w.u8((uint8_t)(winnerPad + 1));
+        w.u8(roundNo);
+        w.time(lastTickMs);
+        w.time(roundEndMs);
+        w.u8((uint8_t)trail.width());
+        w.u8((uint8_t)trail.height());
+        for (const Player& p : players) {
+            w.bits(p.active, 1);
+            w.bits(p.alive, 1);
+            w.bits(p.isAi, 1);
+            w.bits((uint8_t)p.dir, 2);
+            w.bits((uint8_t)p.nextDir, 2);
+            w.u8(p.padIndex);
+            w.u8(p.score);
+            w.u16(p.color);
+            // A rider that hit the wall has its head one cell outside the grid.
+            w.u8((uint8_t)(p.x + 1));
+            w.u8((uint8_t)(p.y + 1));
+        }
+        // Mostly empty arena: runs compress it to a few hundred bytes at most.
+        w.rle(trail.data(), trail.bytes());
+    }
+
+    bool loadSnapshot(SnapshotReader& r) override {
+        inSetup = r.boolean();
+        setupRow = r.below(2);
+        riderTarget = r.below(MAX_PLAYERS + 1);
+        arenaIndex = r.below(ARENA_COUNT);
+        if (riderTarget < MIN_RIDERS) return false;
+        if (inSetup) {
+            const uint8_t row = setupRow;
+            start();
+            setupRow = row;
+            return r.ok();
+        }
+        gameOver = r.boolean();
+        roundActive = r.boolean();
+        winnerPad = (int)r.below(MAX_PLAYERS + 1) - 1;
+        roundNo = r.u8();
+        lastTickMs = r.time();
+        roundEndMs = r.time();
+        const uint8_t w = r.u8();
+        const uint8_t h = r.u8();
+        // The grid always matches the chosen arena.
+        if (w != arenaW() || h != arenaH()) return false;
+        trail.resize(w, h);
+        for (Player& p : players) {
+            p.active = r.bits(1);
+            p.alive = r.bits(1);
+            p.isAi = r.bits(1);
+            p.dir = (Dir)r.bits(2);
+            p.nextDir = (Dir)r.bits(2);
+            p.padIndex = r.below(MAX_PLAYERS);
+            p.score = r.u8();
+            p.color = r.u16();
+            p.x = (int)r.u8() - 1;
+            p.y = (int)r.u8() - 1;
+            if (p.x > w || p.y > h) return false;
+        }
+        r.rle(trail.data(), trail.bytes());
+        if (!trail.valid(MAX_PLAYERS)) return false;
+        return r.ok();
+    }
+
+    // ------------------------------
+    // NetGame (linked play)
+    // ------------------------------
+    void netSaveState(uint8_t slot) override {
+        NetState& n = netSlots[slot];
+        for (int i = 0; i < MAX_PLAYERS; i++) n.players[i] = players[i];
+        n.gameOver = gameOver;
+        n.roundActive = roundActive;
+        n.winnerPad = (int8_t)winnerPad;
+        n.roundNo = roundNo;
+        n.lastTickMs = lastTickMs;
+        n.roundEndMs = roundEndMs;
+        n.marks = marks;
+        n.simFrame = simFrame;
+        n.endFrame = endFrame;
+        n.rng = rng;
+    }
+
+    void netLoadState(uint8_t slot) override {
+        const NetState& n = netSlots[slot];
+        // Same round: unmark what was added since. A slot from the previous round
+        // lies in its end pause, which never reads the grid, and re-simulating
+        // from there runs startRound() again.
+        if (n.roundNo == roundNo) {
+            for (uint16_t i = n.marks; i < marks; i++) {
+                const Mark& m = markRing[i % MARK_RING];
+                trail.set(m.x, m.y, TronTrailGrid::EMPTY);
+            }
+        }
+        for (int i = 0; i < MAX_PLAYERS; i++) players[i] = n.players[i];
+        gameOver = n.gameOver;
+        roundActive = n.roundActive;
+        winnerPad = n.winnerPad;
+        roundNo = n.roundNo;
+        lastTickMs = n.lastTickMs;
+        roundEndMs = n.roundEndMs;
+        marks = n.marks;
+        simFrame = n.simFrame;
+        endFrame = n.endFrame;
+        rng = n.rng;
+    }
+
+    void netStep(const NetInput in[2], bool isReplay) override {
+        replaying = isReplay;
+        const bool wasOver = gameOver;
+        simFrame++;
+        simulate(simFrame * NET_FRAME_MS, nullptr, in);
+        if (gameOver && !wasOver) endFrame = simFrame - 1;
+        replaying = false;
+    }
+
+    uint32_t netChecksum() const override {
+        NetHash h;
+        for (const Player& p : players) {
+            h.u32((uint32_t)p.active | ((uint32_t)p.alive << 1) | ((uint32_t)p.isAi << 2));
+            h.u32(p.score);
+            h.u32((uint32_t)p.dir | ((uint32_t)p.nextDir << 8));
+            h.u32((uint32_t)p.x);
+            h.u32((uint32_t)p.y);
+        }
+        h.u32(gameOver);
+        h.u32(roundActive);
+        h.u32((uint32_t)winnerPad);
+        h.u32(roundNo);
+        h.u32(lastTickMs);
+        h.u32(roundEndMs);
+        h.u32(marks);
+        h.u32(endFrame);
+        h.u32(rng.state);
+        const uint8_t* cells = trail.data();
+        for (size_t i = 0; cells && i < trail.bytes(); i += 4) {
+            uint32_t word;
+            memcpy(&word, cells + i, 4);
+            h.u32(word);
+        }
+        return h.value;
+    }
 };
 
 
@@ -34,16 +34,60 @@ static constexpr int CONTENT_Y = BORDER_Y + 1;
 static constexpr int CONTENT_W = BORDER_W - 2;
 static constexpr int CONTENT_H = BORDER_H - 2;
 
-// Logical grid (cells)
+// Logical grid (cells) that fills the content area exactly.
 static constexpr int GRID_W = (CONTENT_W / CELL_PX);
 static constexpr int GRID_H = (CONTENT_H / CELL_PX);
 
+// -----------------------------------------------------------------------------
+// Match setup (chosen on the pre-match screen, kept for rematches)
+// -----------------------------------------------------------------------------
+// Arena sizes in cells. Arenas larger than the content area scroll: the view
+// follows player 1's rider (or the first one still alive).
+struct Arena {
+    const char* name;
+    uint8_t w;
+    uint8_t h;
+};
+static constexpr Arena ARENAS[] = {
+    { "SMALL", 40, 34 },
+    { "PANEL", (uint8_t)GRID_W, (uint8_t)GRID_H },
+    { "LARGE", 128, 128 },
+};
+static constexpr int ARENA_COUNT = (int)(sizeof(ARENAS) / sizeof(ARENAS[0]));
+static constexpr int DEFAULT_ARENA = 1;
+// Border color where a scrolling arena continues past the edge of the view.
+static constexpr uint16_t VIEW_EDGE_COLOR = 0x4208;
+
+// -----------------------------------------------------------------------------
+// Players
+// -----------------------------------------------------------------------------
+// Player slots per match: pads 0..MAX_GAMEPADS-1 are humans, the rest AI-only.
+static constexpr int MAX_PLAYERS = 8;
+// Riders per match: AI riders fill the free slots up to the chosen count
+// (never fewer than one per connected pad). 2 = one AI opponent for a lone human.
+static constexpr int MIN_RIDERS = 2;
+static constexpr int DEFAULT_RIDERS = 2;
+
 // -----------------------------------------------------------------------------
 // Game rules / pacing
 // -----------------------------------------------------------------------------
 static constexpr uint8_t WIN_SCORE = 5;
 static constexpr uint32_t ROUND_RESET_DELAY_MS = 1200;
 
+// -----------------------------------------------------------------------------
+// Linked play (engine/NetPlay.h)
+// -----------------------------------------------------------------------------
+// Both cabinets must agree on the id and on the match below: one rider per
+// cabinet (slot = NetPlay side), CPU riders up to NET_RIDERS, fixed arena.
+static constexpr uint8_t NET_GAME_ID = 3;
+static constexpr int NET_RIDERS = 4;
+static constexpr int NET_ARENA = 1; // PANEL: fits the view, nothing scrolls off-screen
+// One net frame; riders still move every TRON_SPEED_MS on the frame clock.
+static constexpr uint32_t NET_FRAME_MS = 20;
+// "WAIT PEER": if the other cabinet doesn't start Tron within this time (or B
+// is pressed), open the local setup screen instead.
+static constexpr uint32_t NET_PEER_WAIT_MS = 10000;
+
 // -----------------------------------------------------------------------------
 // Visual tables / sprites
 // -----------------------------------------------------------------------------
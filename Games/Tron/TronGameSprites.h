@@ -9,7 +9,11 @@
 #pragma once
 
 // No bitmap sprites currently needed; trails are 1px.
-// This file exists to follow the repo convention and to keep room for future
-// additions (e.g., 2x2 bike heads, glow masks, etc.).
+
+// Trail colors per player slot (P1 is replaced by the player's color setting).
+static constexpr uint16_t PLAYER_COLORS[MAX_PLAYERS] = {
+    COLOR_GREEN, COLOR_CYAN, COLOR_ORANGE, COLOR_PURPLE,
+    COLOR_RED, COLOR_BLUE, COLOR_YELLOW, COLOR_MAGENTA
+};
 
 
@@ -0,0 +1,126 @@
+// TronTrailGrid.h
+// -----------------------------------------------------------------------------
+// Packed light-cycle trail grid for Tron: 4 bits per cell (0 = empty,
+// 1..15 = owner + 1), sized at runtime.
+//
+// - Rows are padded to whole 32-bit words (8 cells), so a word of 0 means 8 empty
+//   cells and the renderer skips it in one compare.
+// - get()/set() are O(1); out-of-range reads return WALL, so collision checks
+//   need no separate bounds test.
+// - The buffer is heap memory (MemPolicy INTERNAL_FAST: collision reads it every
+//   tick), allocated by resize() and kept for later rounds of the same size.
+// -----------------------------------------------------------------------------
+#pragma once
+
+#include <Arduino.h>
+#include "../../engine/MemPolicy.h"
+
+class TronTrailGrid {
+public:
+    static constexpr uint8_t EMPTY = 0;
+    static constexpr uint8_t WALL = 0x0F;
+    static constexpr uint8_t MAX_OWNERS = 14; // owner + 1 must stay below WALL
+    static constexpr int MAX_SIDE = 254;      // snapshots store coordinate + 1 (up to the wall cell) as a byte
+
+    TronTrailGrid() = default;
+    ~TronTrailGrid() { Mem::release(cells); }
+
+    TronTrailGrid(const TronTrailGrid&) = delete;
+    TronTrailGrid& operator=(const TronTrailGrid&) = delete;
+
+    // Resize and clear. Keeps the allocation when it is already big enough.
+    void resize(int w, int h) {
+        if (w < 1) w = 1;
+        if (h < 1) h = 1;
+        if (w > MAX_SIDE) w = MAX_SIDE;
+        if (h > MAX_SIDE) h = MAX_SIDE;
+        const uint16_t words = (uint16_t)((w + 7) >> 3);
+        const size_t need = (size_t)words * 4u * (size_t)h;
+        if (need > capacity) {
+            Mem::release(cells);
+            cells = (uint8_t*)Mem::alloc(need, Mem::INTERNAL_FAST);
+            capacity = need;
+        }
+        gw = w;
+        gh = h;
+        rowWords = words;
+        clear();
+    }
+
+    void clear() {
+        if (cells) memset(cells, 0, bytes());
+    }
+
+    int width() const { return gw; }
+    int height() const { return gh; }
+
+    // Packed storage, row-major, rowWords * 4 bytes per row (snapshots).
+    uint8_t* data() { return cells; }
+    const uint8_t* data() const { return cells; }
+    size_t bytes() const { return (size_t)rowWords * 4u * (size_t)gh; }
+
+    uint8_t get(int x, int y) const {
+        if ((unsigned)x >= (unsigned)gw || (unsigned)y >= (unsigned)gh) return WALL;
+        const uint8_t b = cells[byteIndex(x, y)];
+        return (x & 1) ? (uint8_t)(b >> 4) : (uint8_t)(b & 0x0F);
+    }
+
+    void set(int x, int y, uint8_t v) {
+        if ((unsigned)x >= (unsigned)gw || (unsigned)y >= (unsigned)gh) return;
+        uint8_t& b = cells[byteIndex(x, y)];
+        b = (x & 1) ? (uint8_t)((b & 0x0F) | (v << 4)) : (uint8_t)((b & 0xF0) | (v & 0x0F));
+    }
+
+    // All stored values in range (1..maxValue) and padding cells empty.
+    bool valid(uint8_t maxValue) const {
+        for (int y = 0; y < gh; y++) {
+            for (int x = 0; x < rowWords * 8; x++) {
+                const uint8_t b = cells[(size_t)y * rowWords * 4u + (size_t)(x >> 1)];
+                const uint8_t v = (x & 1) ? (uint8_t)(b >> 4) : (uint8_t)(b & 0x0F);
+                if (v > ((x < gw) ? maxValue : 0)) return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Calls fn(x0, x1, y, value) for each horizontal run of equal non-empty
+     * cells (inclusive ends), row by row. Empty 8-cell words cost one compare.
+     */
+    template <typename Fn>
+    void forEachRun(Fn&& fn) const {
+        if (!cells) return;
+        const uint32_t* word = (const uint32_t*)cells;
+        for (int y = 0; y < gh; y++) {
+            uint8_t runValue = EMPTY;
+            int runStart = 0;
+            for (uint16_t wi = 0; wi < rowWords; wi++) {
+                uint32_t v = word[wi];
+                if (v == 0) {
+                    if (runValue != EMPTY) fn(runStart, (int)(wi << 3) - 1, y, runValue);
+                    runValue = EMPTY;
+                    continue;
+                }
+                const int base = (int)(wi << 3);
+                for (int k = 0; k < 8; k++, v >>= 4) {
+                    const uint8_t c = (uint8_t)(v & 0x0F);
+                    if (c == runValue) continue;
+                    if (runValue != EMPTY) fn(runStart, base + k - 1, y, runValue);
+                    runValue = c;
+                    runStart = base + k;
+                }
+            }
+            if (runValue != EMPTY) fn(runStart, (int)(rowWords << 3) - 1, y, runValue);
+            word += rowWords;
+        }
+    }
+
+private:
+    uint8_t* cells = nullptr;
+    size_t capacity = 0;
+    int gw = 0;
+    int gh = 0;
+    uint16_t rowWords = 0;
+
+    size_t byteIndex(int x, int y) const { return (size_t)y * rowWords * 4u + (size_t)(x >> 1); }
+};
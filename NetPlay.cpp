@@ -0,0 +1,3 @@
+#include "engine/NetPlay.cpp"
+
+
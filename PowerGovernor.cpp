@@ -0,0 +1,3 @@
+#include "engine/PowerGovernor.cpp"
+
+
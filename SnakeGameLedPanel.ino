@@ -36,6 +36,12 @@
 #include "applet/LeaderboardMenu.h"
 #include "engine/Leaderboard.h"
 #include "engine/UserProfiles.h"
+#include "engine/ResumeStore.h"
+#include "engine/BootProfile.h"
+#include "engine/Trace.h"
+#include "engine/QualityGovernor.h"
+#include "engine/PowerGovernor.h"
+#include "engine/MemPolicy.h"
 #include "applet/UserSelectMenu.h"
 #include "applet/PauseMenu.h"
 #include "component/SmallFont.h"
@@ -54,6 +60,13 @@ GameBase* currentGame = nullptr;
 // Monotonic game-run token to avoid relying on pointer addresses (which can be reused).
 // Incremented each time we start a NEW game instance from the menu.
 uint32_t currentGameRunId = 0;
+// Menu entry the current game was created from (-1 = none); used to recreate it
+// on boot from a resume snapshot.
+int currentGameSlot = -1;
+// Attract-mode demo shown while no controller is connected. Kept separate from
+// currentGame so a paused/in-progress game still resumes on reconnect.
+TetrisGame* attractGame = nullptr;
+uint32_t attractIdleSinceMs = 0; // 0 = idle timer not running
 
 // ---------------------------------------------------------
 // Frame pacing / presentation helpers
@@ -67,7 +80,10 @@ static inline uint32_t fpsToIntervalMs(uint32_t fps) {
   return (uint32_t)(1000UL / fps);
 }
 
+// A frame whose present has not reached the scanout boundary yet still owns
+// the buffer we would draw into: wait (a forced render stays pending).
 static inline bool shouldRenderNow(uint32_t nowMs, uint32_t& lastRenderMs, uint32_t intervalMs, bool& force) {
+  if (frameInFlight()) return false;
   if (force) {
     force = false;
     lastRenderMs = nowMs;
@@ -81,33 +97,6 @@ static inline bool shouldRenderNow(uint32_t nowMs, uint32_t& lastRenderMs, uint3
   return false;
 }
 
-// ---------------------------------------------------------
-// Controller helpers (Bluepad32 API surface varies by version/controller)
-// ---------------------------------------------------------
-// We intentionally use SFINAE to check for different APIs without hard-binding.
-struct ExitButton {
-  template <typename T>
-  static auto miscButtons(T* c, int) -> decltype(c->miscButtons(), uint16_t()) { return (uint16_t)c->miscButtons(); }
-  template <typename T>
-  static uint16_t miscButtons(T*, ...) { return 0; }
-
-  template <typename T>
-  static auto start(T* c, int) -> decltype(c->start(), bool()) { return (bool)c->start(); }
-  template <typename T>
-  static bool start(T*, ...) { return false; }
-};
-
-static inline bool isStartPressed(ControllerPtr ctl) {
-  if (!ctl) return false;
-  // Prefer a dedicated start() accessor if present.
-  if (ExitButton::start(ctl, 0)) return true;
-
-  // Otherwise fall back to miscButtons() bitmask (common in Bluepad32).
-  // Convention in Bluepad32: START is typically bit 0x04 in miscButtons().
-  const uint16_t misc = ExitButton::miscButtons(ctl, 0);
-  return (misc & 0x04) != 0;
-}
-
 // ---------------------------------------------------------
 // App State
 // ---------------------------------------------------------
@@ -122,6 +111,13 @@ enum AppState {
 };
 
 AppState currentState = STATE_NO_CONTROLLER;
+#if ENABLE_TRACE
+// TRACE_SCOPE names per AppState (same order).
+static const char* const STATE_TRACE_NAMES[] = {
+  "State.noController", "State.menu", "State.settings", "State.userSelect",
+  "State.leaderboard", "State.pause", "State.game"
+};
+#endif
 // When controllers disconnect, we show the NO_CONTROLLER screen, but we keep the
 // previous state so we can resume (especially important for in-progress games).
 AppState resumeStateAfterController = STATE_MENU;
@@ -136,8 +132,7 @@ static inline bool startPressedEdge(uint8_t padIndex, ControllerManager* input)
   static bool lastPressed[MAX_GAMEPADS] = { false, false, false, false };
   if (!input || padIndex >= MAX_GAMEPADS) return false;
 
-  ControllerPtr ctl = input->getController((int)padIndex);
-  const bool pressed = (ctl != nullptr) && isStartPressed(ctl);
+  const bool pressed = input->pad((int)padIndex).held(PadState::BTN_START);
   const bool edge = pressed && !lastPressed[padIndex];
   lastPressed[padIndex] = pressed;
   return edge;
@@ -147,8 +142,7 @@ static inline bool aPressedEdge(uint8_t padIndex, ControllerManager* input) {
   static bool lastPressed[MAX_GAMEPADS] = { false, false, false, false };
   if (!input || padIndex >= MAX_GAMEPADS) return false;
 
-  ControllerPtr ctl = input->getController((int)padIndex);
-  const bool pressed = (ctl != nullptr) && (bool)ctl->a();
+  const bool pressed = input->pad((int)padIndex).held(PadState::BTN_A);
   const bool edge = pressed && !lastPressed[padIndex];
   lastPressed[padIndex] = pressed;
   return edge;
@@ -158,8 +152,7 @@ static inline bool bPressedEdge(uint8_t padIndex, ControllerManager* input) {
   static bool lastPressed[MAX_GAMEPADS] = { false, false, false, false };
   if (!input || padIndex >= MAX_GAMEPADS) return false;
 
-  ControllerPtr ctl = input->getController((int)padIndex);
-  const bool pressed = (ctl != nullptr) && (bool)ctl->b();
+  const bool pressed = input->pad((int)padIndex).held(PadState::BTN_B);
   const bool edge = pressed && !lastPressed[padIndex];
   lastPressed[padIndex] = pressed;
   return edge;
@@ -189,12 +182,128 @@ static inline int8_t firstPadWithBEdge(ControllerManager* input) {
   return -1;
 }
 
+// ---------------------------------------------------------
+// Game factory (menu index -> new game instance)
+// ---------------------------------------------------------
+static GameBase* createGameForMenu(int selection, int players) {
+  switch (selection) {
+    case 0:  // Snake
+      return new SnakeGame();
+    case 1:  // Tron
+      return new TronGame();
+    case 2:  // Pong
+      return new PongGame();
+    case 3:  // Breakout
+      return new BreakoutGame();
+    case 4:  // Shooter
+      return new ShooterGame();
+    case 5:  // Labyrinth
+      return new LabyrinthGame();
+    case 6:  // Tetris (only visible with 1 player)
+      return (players == 1) ? new TetrisGame() : nullptr;
+    case 7:  // Asteroids (only visible with 1 player)
+      return (players == 1) ? new AsteroidsGame() : nullptr;
+    case 8:  // Music
+      return new MusicApp();
+    case 9:  // MVisual
+      return new MVisualApp();
+    case 10: // Bomber
+      return new BomberManGame();
+    case 11: // Simon
+      return new SimonGame();
+    case 12: // Dino
+      return new DinoRunGame();
+    case 13: // Mines
+      return new MinesweeperGame();
+    case 14: // Matrix
+      return new MatrixRainApp();
+    case 15: // Lava
+      return new LavaLampApp();
+    default:
+      return nullptr;
+  }
+}
+
+// ---------------------------------------------------------
+// Instant resume (see engine/ResumeStore.h)
+// ---------------------------------------------------------
+// Only called where the game is stopped anyway: an NVS write can stall the
+// loop for tens of milliseconds (see ResumeStore.h).
+static inline void resumeSaveNow() {
+#if ENABLE_RESUME
+  if (!currentGame || currentGameSlot < 0) return;
+  if (currentGame->snapshotVersion() == 0 || currentGame->isGameOver()) return;
+  ResumeStore::save((uint8_t)currentGameSlot, *currentGame);
+#endif
+}
+
+static inline void resumeForget() {
+#if ENABLE_RESUME
+  ResumeStore::clear();
+#endif
+}
+
+// ---------------------------------------------------------
+// Invariant checks (DEBUG_INVARIANTS)
+// ---------------------------------------------------------
+// Logs the first broken invariant per game instance and, every 10 s, how many
+// updates ran. Randomized soak runs of every game happen on the host instead
+// (test/soak: virtual clock, ASan/UBSan, one shard per core).
+static inline void checkGameInvariants(const GameBase* game, uint32_t nowMs) {
+#if DEBUG_INVARIANTS
+  static const GameBase* lastGame = nullptr;
+  static bool reported = false;
+  static uint32_t updates = 0;
+  static uint32_t windowStartMs = 0;
+  if (game != lastGame) {
+    lastGame = game;
+    reported = false;
+    updates = 0;
+    windowStartMs = nowMs;
+  }
+  updates++;
+  const char* id = game->leaderboardId()[0] ? game->leaderboardId() : "game";
+  if (!reported) {
+    const char* why = game->checkInvariants();
+    if (why) {
+      reported = true;
+      Serial.printf("[Invariant] %s: %s (update %lu)\n", id, why, (unsigned long)updates);
+    }
+  }
+  const uint32_t elapsed = nowMs - windowStartMs;
+  if (elapsed >= 10000) {
+    Serial.printf("[Invariant] %s: %lu updates/s, %s\n", id, (unsigned long)(updates * 1000u / elapsed),
+                  reported ? "FAILED" : "ok");
+    updates = 0;
+    windowStartMs = nowMs;
+  }
+#else
+  (void)game;
+  (void)nowMs;
+#endif
+}
+
 // ---------------------------------------------------------
 // Setup
 // ---------------------------------------------------------
+#if BOOT_PARALLEL_INIT
+// Bluetooth/WiFi bring-up, run next to the display init in setup().
+static TaskHandle_t bootSetupTask = nullptr;
+
+static void controllerInitTask(void*) {
+  globalControllerManager->setup();
+  BootProfile::mark("controllers");
+  xTaskNotifyGive(bootSetupTask);
+  vTaskDelete(nullptr);
+}
+#endif
+
 void setup() {
   Serial.begin(115200);
-  delay(1000);
+  #if BOOT_SERIAL_WAIT_MS > 0
+  delay(BOOT_SERIAL_WAIT_MS);
+  #endif
+  BootProfile::mark("serial");
   Serial.println("BOOT: setup() reached");
 
   // -----------------------------------------------------
@@ -204,7 +313,9 @@ void setup() {
     Serial.println(F("[Init] FATAL: EEPROM initialization failed!"));
     while (true) { delay(1000); } // Halt
   }
+  BootProfile::mark("eeprom");
 
+  #if DEBUG_EEPROM_DUMP
   // Quick EEPROM header dumps for debugging persistence across reboots.
   auto dumpRange = [&](int base, int len, const __FlashStringHelper* label) {
     Serial.print(F("[EEPROM] dump "));
@@ -223,13 +334,29 @@ void setup() {
   dumpRange(0, 16, F("settings"));
   dumpRange(64, 24, F("users"));
   dumpRange(128, 32, F("leaderboard"));
+  // Profiles and leaderboard otherwise load on first use.
+  Serial.print(F("[Init] Users="));
+  Serial.println(UserProfiles::userCount());
+  Serial.print(F("[Init] Leaderboard games="));
+  Serial.println(Leaderboard::gameCount());
+  #endif
 
   // -----------------------------------------------------
   // Bluetooth / Controllers
   // -----------------------------------------------------
+  // Nothing below touches the controllers until the join at the end of setup().
   globalControllerManager = new ControllerManager();
+  #if BOOT_PARALLEL_INIT
+  bootSetupTask = xTaskGetCurrentTaskHandle();
+  if (xTaskCreatePinnedToCore(controllerInitTask, "ctlInit", 4096, nullptr, 1, nullptr, 0) != pdPASS) {
+    bootSetupTask = nullptr;
+    globalControllerManager->setup();
+    BootProfile::mark("controllers");
+  }
+  #else
   globalControllerManager->setup();
-  Serial.println("[Init] Bluepad32 Service Started");
+  BootProfile::mark("controllers");
+  #endif
 
   // -----------------------------------------------------
   // DISPLAY CONFIG
@@ -258,6 +385,7 @@ void setup() {
 
   // Stability first
   mxconfig.double_buff = ENABLE_DOUBLE_BUFFER;
+  mxconfig.min_refresh_rate = PANEL_MIN_REFRESH_HZ;
   //mxconfig.driver = HUB75_I2S_CFG::FM6126A;
   mxconfig.i2sspeed = HUB75_I2S_CFG::HZ_8M;
 
@@ -276,10 +404,13 @@ void setup() {
     Serial.println("ERROR: Display begin() failed");
     while (true) {}
   }
+  beginPresent(dma_display);
+  BootProfile::mark("display");
   
   // Load settings and apply brightness
   Serial.println(F("[Init] Loading settings..."));
   globalSettings.load();
+  BootProfile::mark("settings");
 
   // -----------------------------------------------------
   // Audio (buzzer) - basic service init
@@ -295,12 +426,8 @@ void setup() {
   Serial.print(F(" soundEnabled="));
   Serial.println(globalSettings.isSoundEnabled() ? F("ON") : F("OFF"));
   #endif
+  BootProfile::mark("audio");
 
-  // Force-load user profiles and leaderboard once at boot for debug visibility.
-  Serial.print(F("[Init] Users="));
-  Serial.println(UserProfiles::userCount());
-  Serial.print(F("[Init] Leaderboard games="));
-  Serial.println(Leaderboard::gameCount());
   uint8_t startupBrightness = globalSettings.getBrightness();
   if (startupBrightness < 30) {
     Serial.print(F("[Init] Brightness from settings too low ("));
@@ -323,33 +450,107 @@ void setup() {
   presentFrame(dma_display);
 
   Serial.println("[Init] Display Service Started");
+
+  #if ENABLE_RESUME
+  // Instant resume: recreate the game that was running before the reboot and
+  // park it in the pause menu (shown once a controller has connected).
+  const int resumeSlot = ResumeStore::peekSlot();
+  if (resumeSlot >= 0) {
+    currentGame = createGameForMenu(resumeSlot, 1);
+    if (currentGame) {
+      currentGame->start();
+      globalQuality.reset(currentGame->preferredRenderFps());
+    }
+    if (currentGame && ResumeStore::restore(*currentGame)) {
+      Serial.print(F("[Init] Resuming game slot "));
+      Serial.println(resumeSlot);
+      currentGameSlot = resumeSlot;
+      currentGameRunId++;
+      pauseMenu.beginForPad(0);
+      resumeStateAfterController = STATE_PAUSE;
+    } else {
+      delete currentGame;
+      currentGame = nullptr;
+      ResumeStore::clear();
+    }
+  }
+  BootProfile::mark("resume");
+  #endif
+
+  #if BOOT_PARALLEL_INIT
+  if (bootSetupTask) ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+  #endif
+  Serial.println("[Init] Bluepad32 Service Started");
+  globalPower.begin(millis());
+  BootProfile::mark("ready");
+  BootProfile::report();
+
+  #if DEBUG_MEM
+  // Access cost of each buffer MemPolicy moves out of internal RAM, with its real size and pattern.
+  {
+    const size_t mazeCells = (size_t)LabyrinthGameConfig::MAX_MAZE_W * LabyrinthGameConfig::MAX_MAZE_H;
+    Mem::report();
+    Mem::benchmark("labyrinth stack", mazeCells * sizeof(uint16_t), false);
+    Mem::benchmark("labyrinth bfs q", mazeCells * sizeof(uint16_t), false);
+    Mem::benchmark("labyrinth dist", mazeCells * sizeof(int16_t), true);
+    Mem::benchmark("leaderboard", sizeof(Leaderboard::Storage), true);
+  }
+  #endif
+
+  #if DEBUG_GAME_STATS
+  AsteroidsGame::benchmarkBroadPhase();
+  #endif
 }
 
 // ---------------------------------------------------------
 // Main Loop
 // ---------------------------------------------------------
 void loop() {
+  TRACE_SCOPE("loop");
+#if ENABLE_TRACE
+  Trace::pollSerial();
+#endif
   // Frame pacing
   static uint32_t lastMenuRenderMs = 0;
   static uint32_t lastGameRenderMs = 0;
   static bool forceMenuRender = true;
   static bool forceGameRender = true;
   const uint32_t nowMs = millis();
-  const uint32_t menuIntervalMs = fpsToIntervalMs(MENU_RENDER_FPS);
+
+  // 1. Hardware/Protocol Updates
+  // Allow Bluepad32 to process incoming packets (Required)
+  {
+    TRACE_SCOPE("Input.update");
+    globalControllerManager->update();
+  }
+
+  // Power plan for what is on screen (clock, redraw cap, loop delay). Input
+  // seen this frame restores full speed before anything below runs.
+  globalPower.sampleInput(globalControllerManager, nowMs);
+  {
+    Power::Activity activity = Power::ACT_MENU;
+    if (currentState == STATE_NO_CONTROLLER) {
+      activity = attractGame ? Power::ACT_AMBIENT : Power::ACT_NO_CONTROLLER;
+    } else if (currentState == STATE_GAME_RUNNING && currentGame && !currentGame->isGameOver()) {
+      activity = currentGame->isAmbient() ? Power::ACT_AMBIENT : Power::ACT_GAME;
+    }
+    globalPower.update(activity, nowMs);
+  }
+
+  const uint32_t menuIntervalMs = globalPower.capInterval(fpsToIntervalMs(MENU_RENDER_FPS));
   // Game interval is selected per-game (see GameBase::preferredRenderFps()).
   uint32_t gameIntervalMs = fpsToIntervalMs(GAME_RENDER_FPS);
   if (currentGame) {
-    gameIntervalMs = fpsToIntervalMs(currentGame->preferredRenderFps());
+    gameIntervalMs = globalPower.capInterval(fpsToIntervalMs(currentGame->preferredRenderFps()));
   }
 
-  // 1. Hardware/Protocol Updates
-  // Allow Bluepad32 to process incoming packets (Required)
-  globalControllerManager->update();
-
   // Audio service tick (non-blocking)
   globalAudio.update();
 
   // 2. State Machine Logic
+#if ENABLE_TRACE
+  Trace::Scope stateScope(STATE_TRACE_NAMES[currentState]);
+#endif
   switch (currentState) {
 
     // --- STATE: NO CONTROLLER ---
@@ -360,12 +561,52 @@ void loop() {
         // UserSelectMenu will show either:
         // - a list of existing users + NEW (if any users are stored), or
         // - the 3-letter editor directly (if no users exist yet).
+        if (attractGame) {
+          delete attractGame;
+          attractGame = nullptr;
+          if (currentGame) globalQuality.reset(currentGame->preferredRenderFps());
+        }
+        attractIdleSinceMs = 0;
         nextStateAfterUserSelect = resumeStateAfterController;
         userSelectMenu.beginForPad(0);
         currentState = STATE_USER_SELECT;
         dma_display->clearScreen();
         forceMenuRender = true;
       } else {
+        #if ATTRACT_IDLE_MS > 0
+        if (attractIdleSinceMs == 0) attractIdleSinceMs = nowMs;
+        if (!attractGame && (uint32_t)(nowMs - attractIdleSinceMs) >= (uint32_t)ATTRACT_IDLE_MS) {
+          attractGame = new TetrisGame();
+          attractGame->setAutoplay(true);
+          attractGame->start();
+          globalQuality.reset(attractGame->preferredRenderFps());
+          forceGameRender = true;
+        }
+        if (attractGame) {
+          {
+            TRACE_SCOPE("Game.update");
+            const uint32_t workUs = micros();
+            attractGame->update(globalControllerManager);
+            globalQuality.addWork((uint32_t)micros() - workUs);
+          }
+          checkGameInvariants(attractGame, nowMs);
+          if (shouldRenderNow(nowMs, lastGameRenderMs, globalPower.capInterval(fpsToIntervalMs(attractGame->preferredRenderFps())), forceGameRender)) {
+            {
+              TRACE_SCOPE("Game.draw");
+              const uint32_t workUs = micros();
+              attractGame->draw(dma_display);
+              globalQuality.addWork((uint32_t)micros() - workUs);
+              globalQuality.endFrame();
+            }
+            // Top of the HUD column is free: label the demo and how to join.
+            if ((nowMs / 800) & 1) SmallFont::drawString(dma_display, 40, 6, "DEMO", COLOR_RED);
+            else SmallFont::drawString(dma_display, 34, 6, "PAIR BT", COLOR_BLUE);
+            presentFrame(dma_display);
+          }
+          break;
+        }
+        #endif
+
         // Render waiting screen with small font
         static unsigned long lastFrame = 0;
         if (millis() - lastFrame > 500) {  // Blink effect
@@ -411,68 +652,14 @@ void loop() {
           } else {
             if (currentGame != nullptr) delete currentGame;
             
-            switch (gameSelection) {
-              case 0:  // Snake
-                currentGame = new SnakeGame();
-                break;
-              case 1:  // Tron
-                currentGame = new TronGame();
-                break;
-              case 2:  // Pong
-                currentGame = new PongGame();
-                break;
-              case 3:  // Breakout
-                currentGame = new BreakoutGame();
-                break;
-              case 4:  // Shooter
-                currentGame = new ShooterGame();
-                break;
-              case 5:  // Labyrinth
-                currentGame = new LabyrinthGame();
-                break;
-              case 6:  // Tetris (only visible with 1 player)
-                if (players == 1) {
-                  currentGame = new TetrisGame();
-                }
-                break;
-              case 7:  // Asteroids (only visible with 1 player)
-                if (players == 1) {
-                  currentGame = new AsteroidsGame();
-                }
-                break;
-              case 8:  // Music
-                currentGame = new MusicApp();
-                break;
-              case 9:  // MVisual
-                currentGame = new MVisualApp();
-                break;
-              case 10: // Bomber
-                currentGame = new BomberManGame();
-                break;
-              case 11: // Simon
-                currentGame = new SimonGame();
-                break;
-              case 12: // Dino
-                currentGame = new DinoRunGame();
-                break;
-              case 13: // Mines
-                currentGame = new MinesweeperGame();
-                break;
-              case 14: // Matrix
-                currentGame = new MatrixRainApp();
-                break;
-              case 15: // Lava
-                currentGame = new LavaLampApp();
-                break;
-              default:
-                currentGame = nullptr;
-                break;
-            }
+            currentGame = createGameForMenu(gameSelection, players);
             
             if (currentGame != nullptr) {
               currentGame->start();
+              globalQuality.reset(currentGame->preferredRenderFps());
               // New game run started. Increment token (never rely on pointer equality).
               currentGameRunId++;
+              currentGameSlot = gameSelection;
               currentState = STATE_GAME_RUNNING;
               forceGameRender = true;
             }
@@ -565,9 +752,12 @@ void loop() {
         currentState = STATE_NO_CONTROLLER;
       } else if (currentGame) {
         // Render underlying game + overlay (capped FPS using game pacing).
-        gameIntervalMs = fpsToIntervalMs(currentGame->preferredRenderFps());
+        gameIntervalMs = globalPower.capInterval(fpsToIntervalMs(currentGame->preferredRenderFps()));
         if (shouldRenderNow(nowMs, lastGameRenderMs, gameIntervalMs, forceGameRender)) {
-          currentGame->draw(dma_display);
+          {
+            TRACE_SCOPE("Game.draw");
+            currentGame->draw(dma_display);
+          }
           pauseMenu.draw(dma_display);
           presentFrame(dma_display);
         }
@@ -589,6 +779,8 @@ void loop() {
         } else if (a == PauseMenu::ACTION_QUIT_TO_MENU) {
           delete currentGame;
           currentGame = nullptr;
+          currentGameSlot = -1;
+          resumeForget();
           currentState = STATE_MENU;
           dma_display->clearScreen();
           forceMenuRender = true;
@@ -608,15 +800,22 @@ void loop() {
       if (globalControllerManager->getConnectedCount() == 0) {
         // IMPORTANT: Do NOT delete the current game. We want to resume when the
         // controller comes back.
+        resumeSaveNow(); // checkpoint: the cabinet may be switched off next
         resumeStateAfterController = STATE_GAME_RUNNING;
         currentState = STATE_NO_CONTROLLER;
       } else {
         if (currentGame) {
           // Update per-game render pacing (some games prefer lower FPS).
-          gameIntervalMs = fpsToIntervalMs(currentGame->preferredRenderFps());
+          gameIntervalMs = globalPower.capInterval(fpsToIntervalMs(currentGame->preferredRenderFps()));
 
           // 1. Update Physics/Logic
-          currentGame->update(globalControllerManager);
+          {
+            TRACE_SCOPE("Game.update");
+            const uint32_t workUs = micros();
+            currentGame->update(globalControllerManager);
+            globalQuality.addWork((uint32_t)micros() - workUs);
+          }
+          checkGameInvariants(currentGame, nowMs);
 
           // -----------------------------------------------------
           // Auto-submit score to leaderboard once per game run
@@ -666,7 +865,13 @@ void loop() {
 
           // 2. Render Frame (capped FPS to reduce tearing/scanline artifacts)
           if (shouldRenderNow(nowMs, lastGameRenderMs, gameIntervalMs, forceGameRender)) {
-            currentGame->draw(dma_display);
+            {
+              TRACE_SCOPE("Game.draw");
+              const uint32_t workUs = micros();
+              currentGame->draw(dma_display);
+              globalQuality.addWork((uint32_t)micros() - workUs);
+              globalQuality.endFrame();
+            }
             presentFrame(dma_display);
           }
 
@@ -679,6 +884,9 @@ void loop() {
           // IMPORTANT: We still evaluate edges every frame so holding a button
           // doesn't trigger immediately when the game-over state appears.
           const bool isOver = currentGame->isGameOver();
+          #if ENABLE_RESUME
+          if (isOver) resumeForget(); // no-op once cleared
+          #endif
           const int8_t aPad = firstPadWithAEdge(globalControllerManager);
           const int8_t bPad = firstPadWithBEdge(globalControllerManager);
           const int8_t startPad = firstPadWithStartEdge(globalControllerManager);
@@ -693,6 +901,7 @@ void loop() {
               if (startPad >= 0) globalAudio.uiStartStop();
               delete currentGame;
               currentGame = nullptr;
+              currentGameSlot = -1;
               currentState = STATE_MENU;
               dma_display->clearScreen();
               forceMenuRender = true;
@@ -702,6 +911,7 @@ void loop() {
             // START in-game: open the pause menu (do NOT exit the game).
             if (startPad >= 0) {
               globalAudio.uiStartStop();
+              resumeSaveNow(); // natural checkpoint (the player may power off here)
               pauseMenu.beginForPad((uint8_t)startPad);
               currentState = STATE_PAUSE;
               forceGameRender = true;
@@ -714,6 +924,7 @@ void loop() {
   }
 
   // Small yield to feed Watchdog Timer (WDT)
-  // Bluepad32 and DMA lib usually play nice, but this is safe practice
-  delay(1);
+  // Bluepad32 and DMA lib usually play nice, but this is safe practice.
+  // Idle power plans poll less often.
+  delay(globalPower.plan().loopDelayMs);
 }
\ No newline at end of file
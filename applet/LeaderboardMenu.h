@@ -2,6 +2,7 @@
 #include <Arduino.h>
 #include <ESP32-HUB75-MatrixPanel-I2S-DMA.h>
 #include "../engine/ControllerManager.h"
+#include "../engine/Raster.h"
 #include "../component/SmallFont.h"
 #include "../component/ScrollableList.h"
 #include "../engine/Leaderboard.h"
@@ -28,7 +29,7 @@ public:
         display->fillScreen(0);
 
         // Common HUD divider
-        for (int x = 0; x < PANEL_RES_X; x += 2) display->drawPixel(x, HUD_H - 1, COLOR_BLUE);
+        Raster::dashedHLine(display, 0, HUD_H - 1, PANEL_RES_X, COLOR_BLUE);
 
         if (screen == SCREEN_GAMES) {
             SmallFont::drawString(display, 2, 6, "LEADERBD", COLOR_CYAN);
@@ -42,14 +43,14 @@ public:
      * Returns true if the user wants to exit back to the main menu.
      */
     bool update(ControllerManager* input) {
-        ControllerPtr ctl = input ? input->getController(0) : nullptr;
-        if (!ctl) return false;
+        const PadState& pad = input ? input->pad(0) : PadState();
+        if (!pad.connected) return false;
 
         const unsigned long now = millis();
 
         // Global back behavior within this applet.
         static unsigned long lastB = 0;
-        if (ctl->b() && (now - lastB > 200)) {
+        if (pad.held(PadState::BTN_B) && (now - lastB > 200)) {
             lastB = now;
             if (screen == SCREEN_SCORES) {
                 screen = SCREEN_GAMES;
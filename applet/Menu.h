@@ -3,6 +3,7 @@
 #include <math.h>
 #include <ESP32-HUB75-MatrixPanel-I2S-DMA.h>
 #include "../engine/ControllerManager.h"
+#include "../engine/Raster.h"
 #include "../component/SmallFont.h"
 #include "../engine/Settings.h"
 #include "../component/ScrollableList.h"
@@ -50,7 +51,7 @@ public:
         // HUD: "MENU" + player icons (P1..P4)
         // ----------------------
         SmallFont::drawString(d, 2, 6, "MENU", COLOR_CYAN);
-        for (int x = 0; x < PANEL_RES_X; x += 2) d->drawPixel(x, HUD_H - 1, COLOR_BLUE);
+        Raster::dashedHLine(d, 0, HUD_H - 1, PANEL_RES_X, COLOR_BLUE);
 
         const uint16_t pColors[MAX_GAMEPADS] = {
             globalSettings.getPlayerColor(),
@@ -72,7 +73,7 @@ public:
         // Fully flush-right: right edge at PANEL_RES_X.
         int px = PANEL_RES_X - totalW;
         for (int i = 0; i < MAX_GAMEPADS; i++) {
-            const bool connected = (input && input->getController(i) != nullptr);
+            const bool connected = (input && input->pad(i).connected);
             SmallFont::drawStringF(d, px, 6, connected ? pColors[i] : offC, "P%d", i + 1);
             px += tokenW - TOKEN_OVERLAP;
         }
@@ -91,11 +92,11 @@ public:
         const int sel = list.update(input, *this);
 
         // Cycle player color with Y button (debounced)
-        ControllerPtr ctl = input->getController(0);
+        const PadState& pad = input->pad(0);
         const unsigned long now = millis();
         static unsigned long lastColorChange = 0;
         // Bluepad32 exposes ABXY on most pads; if a controller doesn't have Y, this stays false.
-        if (ctl && ctl->y() && (now - lastColorChange > 200)) {
+        if (pad.held(PadState::BTN_Y) && (now - lastColorChange > 200)) {
             lastColorChange = now;
             globalSettings.cyclePlayerColor(1);
             globalSettings.save();
@@ -2,6 +2,7 @@
 #include <Arduino.h>
 #include <ESP32-HUB75-MatrixPanel-I2S-DMA.h>
 #include "../engine/ControllerManager.h"
+#include "../engine/Raster.h"
 #include "../component/SmallFont.h"
 #include "../component/ScrollableList.h"
 
@@ -40,7 +41,7 @@ public:
         // 1) HUD title (keeps the "paused" state obvious and reuses our UI convention)
         d->fillRect(0, 0, PANEL_RES_X, HUD_H, COLOR_BLACK);
         SmallFont::drawString(d, 2, 6, "PAUSED", COLOR_YELLOW);
-        for (int x = 0; x < PANEL_RES_X; x += 2) d->drawPixel(x, HUD_H - 1, COLOR_BLUE);
+        Raster::dashedHLine(d, 0, HUD_H - 1, PANEL_RES_X, COLOR_BLUE);
 
         // 2) Smallest centered modal containing only the 2 options.
         // TomThumb is tiny; approximate text width using a 4px per character stride.
@@ -56,7 +57,7 @@ public:
         const int modalY = HUD_H + (usableH - modalH) / 2;
 
         d->fillRect(modalX, modalY, modalW, modalH, COLOR_BLACK);
-        d->drawRect(modalX, modalY, modalW, modalH, COLOR_BLUE);
+        Raster::rect(d, modalX, modalY, modalW, modalH, COLOR_BLUE);
 
         ScrollableList::Layout lay;
         lay.hudH = 0; // unused when baseY is set explicitly
@@ -71,11 +72,11 @@ public:
     }
 
     Action update(ControllerManager* input) {
-        ControllerPtr ctl = input ? input->getController(targetPad) : nullptr;
-        if (!ctl) return ACTION_NONE;
+        const PadState& p = input ? input->pad(targetPad) : PadState();
+        if (!p.connected) return ACTION_NONE;
 
         // Quick resume on B (debounced in ScrollableList already, but we keep it explicit).
-        if (ctl->b()) return ACTION_RESUME;
+        if (p.held(PadState::BTN_B)) return ACTION_RESUME;
 
         const int sel = list.updateForPad(input, model, targetPad);
         if (sel == -1) return ACTION_NONE;
@@ -3,6 +3,7 @@
 #include <math.h>
 #include <ESP32-HUB75-MatrixPanel-I2S-DMA.h>
 #include "../engine/ControllerManager.h"
+#include "../engine/Raster.h"
 #include "../component/SmallFont.h"
 #include "../engine/Settings.h"
 #include "../component/ScrollableList.h"
@@ -51,19 +52,6 @@ public:
     static constexpr uint16_t DPAD_REPEAT_DELAY_MS = 450;
     static constexpr uint16_t DPAD_REPEAT_INTERVAL_MS = 180;
     
-    // Bluepad32 analog helper (SFINAE) so we don't hard-depend on a single API surface.
-    struct InputDetail {
-        template <typename T>
-        static auto axisX(T* c, int) -> decltype(c->axisX(), int16_t()) { return (int16_t)c->axisX(); }
-        template <typename T>
-        static int16_t axisX(T*, ...) { return 0; }
-
-        template <typename T>
-        static auto axisY(T* c, int) -> decltype(c->axisY(), int16_t()) { return (int16_t)c->axisY(); }
-        template <typename T>
-        static int16_t axisY(T*, ...) { return 0; }
-    };
-
     static inline float clampf(float v, float lo, float hi) { return (v < lo) ? lo : (v > hi) ? hi : v; }
     static inline float deadzone01(float v, float dz) {
         const float a = fabsf(v);
@@ -80,7 +68,7 @@ public:
         // HUD
         // ----------------------
         SmallFont::drawString(display, 2, 6, "SETTINGS", COLOR_CYAN);
-        for (int x = 0; x < PANEL_RES_X; x += 2) display->drawPixel(x, HUD_H - 1, COLOR_BLUE);
+        Raster::dashedHLine(display, 0, HUD_H - 1, PANEL_RES_X, COLOR_BLUE);
         
         // Keep widget selection in sync with our legacy `selected` field.
         list.selectedActual = constrain(selected, 0, NUM_SETTINGS - 1);
@@ -102,10 +90,10 @@ public:
      * Returns true if user wants to go back
      */
     bool update(ControllerManager* input) {
-        ControllerPtr ctl = input->getController(0);
-        if (!ctl) return false;
+        const PadState& pad = input->pad(0);
+        if (!pad.connected) return false;
         
-        const uint8_t dpad = ctl->dpad();
+        const uint8_t dpad = pad.dpad;
         const unsigned long now = millis();
 
         // ----------------------
@@ -145,7 +133,7 @@ public:
         }
 
         if (adjDir == 0 && !(left || right)) {
-            const float rawX = clampf((float)InputDetail::axisX(ctl, 0) / (float)AXIS_DIVISOR, -1.0f, 1.0f);
+            const float rawX = clampf((float)pad.axisX / (float)AXIS_DIVISOR, -1.0f, 1.0f);
             const float sx = deadzone01(rawX, STICK_DEADZONE);
             if (sx < 0) adjDir = -1;
             else if (sx > 0) adjDir = 1;
@@ -197,7 +185,7 @@ public:
         
         // Also allow B button to go back
         static unsigned long lastB = 0;
-        if (ctl->b() && (now - lastB > 200)) {
+        if (pad.held(PadState::BTN_B) && (now - lastB > 200)) {
             lastB = now;
             globalSettings.save();
             delay(200);
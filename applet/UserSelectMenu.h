@@ -2,6 +2,7 @@
 #include <Arduino.h>
 #include <ESP32-HUB75-MatrixPanel-I2S-DMA.h>
 #include "../engine/ControllerManager.h"
+#include "../engine/Raster.h"
 #include "../component/SmallFont.h"
 #include "../component/ScrollableList.h"
 #include "../engine/UserProfiles.h"
@@ -59,7 +60,7 @@ public:
 
         // HUD
         SmallFont::drawString(display, 2, 6, "USER", COLOR_CYAN);
-        for (int x = 0; x < PANEL_RES_X; x += 2) display->drawPixel(x, HUD_H - 1, COLOR_BLUE);
+        Raster::dashedHLine(display, 0, HUD_H - 1, PANEL_RES_X, COLOR_BLUE);
 
         if (mode == MODE_LIST) drawList(display);
         else drawEditor(display);
@@ -69,13 +70,13 @@ public:
      * Returns true when a user has been selected/created and bound to targetPad.
      */
     bool update(ControllerManager* input) {
-        ControllerPtr ctl = input ? input->getController(targetPad) : nullptr;
-        if (!ctl) return false;
+        const PadState& pad = input ? input->pad(targetPad) : PadState();
+        if (!pad.connected) return false;
 
         if (mode == MODE_LIST) {
             return updateList(input);
         } else {
-            return updateEditor(ctl);
+            return updateEditor(pad);
         }
     }
 
@@ -177,10 +178,10 @@ private:
         }
     }
 
-    bool updateEditor(ControllerPtr ctl) {
+    bool updateEditor(const PadState& pad) {
         const uint32_t now = (uint32_t)millis();
 
-        const uint8_t d = ctl->dpad();
+        const uint8_t d = pad.dpad;
         const bool up = (d & 0x01) != 0;
         const bool down = (d & 0x02) != 0;
         const bool right = (d & 0x04) != 0;
@@ -206,7 +207,7 @@ private:
         }
 
         // A: confirm and create + bind user.
-        if (now >= ignoreConfirmUntilMs && ctl->a() && (now - lastAms > 200)) {
+        if (now >= ignoreConfirmUntilMs && pad.held(PadState::BTN_A) && (now - lastAms > 200)) {
             lastAms = now;
             // Ensure uppercase + NUL.
             for (int i = 0; i < 3; i++) {
@@ -220,7 +221,7 @@ private:
         }
 
         // B: cancel back to list (if there are existing users).
-        if (ctl->b() && (now - lastBms > 200)) {
+        if (pad.held(PadState::BTN_B) && (now - lastBms > 200)) {
             lastBms = now;
             if (UserProfiles::userCount() > 0) {
                 mode = MODE_LIST;
@@ -229,11 +229,11 @@ public:
      * - -1 otherwise
      */
     int updateForPad(ControllerManager* input, const ListModel& model, uint8_t padIndex) {
-        ControllerPtr ctl = (input != nullptr) ? input->getController((int)padIndex) : nullptr;
-        if (!ctl) return -1;
+        const PadState& pad = (input != nullptr) ? input->pad((int)padIndex) : PadState();
+        if (!pad.connected) return -1;
 
         const uint32_t now = (uint32_t)millis();
-        const uint8_t dpad = ctl->dpad();
+        const uint8_t dpad = pad.dpad;
 
         // --- D-pad Up/Down (edge press + hold repeat) ---
         int navDir = 0;
@@ -262,7 +262,7 @@ public:
 
         // --- Analog (only when D-pad isn't held) ---
         if (navDir == 0 && !(dUp || dDown)) {
-            const float rawY = clampf((float)InputDetail::axisY(ctl, 0) / (float)cfg.axisDivisor, -1.0f, 1.0f);
+            const float rawY = clampf((float)pad.axisY / (float)cfg.axisDivisor, -1.0f, 1.0f);
             const float sy = deadzone01(rawY, cfg.stickDeadzone);
             if (sy < 0) navDir = -1;
             else if (sy > 0) navDir = 1;
@@ -296,7 +296,7 @@ public:
         }
 
         // Select with A button (debounced).
-        if (ctl->a() && (uint32_t)(now - lastSelectMs) > cfg.selectDebounceMs) {
+        if (pad.held(PadState::BTN_A) && (uint32_t)(now - lastSelectMs) > cfg.selectDebounceMs) {
             lastSelectMs = now;
             globalAudio.uiConfirmShoot();
             return selectedActual;
@@ -315,14 +315,6 @@ private:
     uint32_t lastAnalogMoveMs = 0;
     uint32_t lastSelectMs = 0;
 
-    // Bluepad32 analog helper (SFINAE) so we don't hard-depend on a single API surface.
-    struct InputDetail {
-        template <typename T>
-        static auto axisY(T* c, int) -> decltype(c->axisY(), int16_t()) { return (int16_t)c->axisY(); }
-        template <typename T>
-        static int16_t axisY(T*, ...) { return 0; }
-    };
-
     static inline float clampf(float v, float lo, float hi) { return (v < lo) ? lo : (v > hi) ? hi : v; }
     static inline float deadzone01(float v, float dz) {
         const float a = fabsf(v);
@@ -42,6 +42,31 @@ public:
         drawString(display, x, y, buffer, color);
     }
     
+    /**
+     * Calls fn(px, py) for each pixel drawString(x, y, str) would set, without
+     * a display (for baking labels into pre-rendered sprites).
+     */
+    template <typename Fn>
+    static void forEachPixel(int x, int y, const char* str, Fn fn) {
+        const GFXfont& font = TomThumb;
+        for (; *str; str++) {
+            const uint8_t c = (uint8_t)*str;
+            if (c < font.first || c > font.last) continue;
+            const GFXglyph& g = font.glyph[c - font.first];
+            const uint8_t* bitmap = &font.bitmap[g.bitmapOffset];
+            uint8_t bits = 0;
+            uint16_t bit = 0;
+            for (uint8_t yy = 0; yy < g.height; yy++) {
+                for (uint8_t xx = 0; xx < g.width; xx++, bit++) {
+                    if ((bit & 7) == 0) bits = bitmap[bit >> 3];
+                    if (bits & 0x80) fn(x + g.xOffset + xx, y + g.yOffset + yy);
+                    bits <<= 1;
+                }
+            }
+            x += g.xAdvance;
+        }
+    }
+
     /**
      * Draw a single character
      */
@@ -1,5 +1,6 @@
 #include "AudioManager.h"
 #include "Settings.h"
+#include "Trace.h"
 #include <math.h>
 
 // ESP32 LEDC API (Arduino-ESP32)
@@ -274,6 +275,7 @@ void AudioManager::begin() {
 
 void AudioManager::update() {
 #if ENABLE_AUDIO
+    TRACE_SCOPE("Audio.update");
     // If sound got disabled, silence immediately.
     if (!soundAllowed()) {
         #if DEBUG_AUDIO
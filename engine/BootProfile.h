@@ -0,0 +1,68 @@
+#pragma once
+#include <Arduino.h>
+#include "config.h"
+
+/**
+ * BootProfile
+ * -----------
+ * Timestamps for the boot phases in setup(), so boot-to-menu time can be
+ * tracked against BOOT_BUDGET_MS.
+ *
+ * mark() only stores (label, micros()) and is safe to call from the init task
+ * running next to setup(); labels must be string literals. report() prints
+ * the table once setup() is done (DEBUG_BOOT).
+ */
+namespace BootProfile {
+
+static constexpr uint8_t MAX_MARKS = 16;
+
+struct Mark {
+    const char* label;
+    uint32_t us;
+};
+
+namespace Detail {
+    inline Mark marks[MAX_MARKS];
+    inline volatile uint8_t count = 0;
+    inline portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+}
+
+static inline void mark(const char* label) {
+    const uint32_t us = (uint32_t)micros();
+    portENTER_CRITICAL(&Detail::mux);
+    const uint8_t i = Detail::count;
+    if (i < MAX_MARKS) {
+        Detail::marks[i].label = label;
+        Detail::marks[i].us = us;
+        Detail::count = (uint8_t)(i + 1);
+    }
+    portEXIT_CRITICAL(&Detail::mux);
+}
+
+static inline uint8_t markCount() { return Detail::count; }
+static inline const Mark& markAt(uint8_t i) { return Detail::marks[i]; }
+
+// Time from reset to the last mark.
+static inline uint32_t totalMs() {
+    const uint8_t n = Detail::count;
+    return n ? Detail::marks[n - 1].us / 1000u : 0;
+}
+
+static inline bool overBudget() { return BOOT_BUDGET_MS > 0 && totalMs() > (uint32_t)BOOT_BUDGET_MS; }
+
+static inline void report() {
+#if DEBUG_BOOT
+    const uint8_t n = Detail::count;
+    uint32_t prev = 0;
+    for (uint8_t i = 0; i < n; i++) {
+        const Mark& m = Detail::marks[i];
+        Serial.printf("[Boot] %-14s %6lu ms  (+%lu)\n", m.label,
+                      (unsigned long)(m.us / 1000u), (unsigned long)((m.us - prev) / 1000u));
+        prev = m.us;
+    }
+    Serial.printf("[Boot] total %lu ms (budget %lu)%s\n", (unsigned long)totalMs(),
+                  (unsigned long)BOOT_BUDGET_MS, overBudget() ? " OVER BUDGET" : "");
+#endif
+}
+
+} // namespace BootProfile
@@ -1,8 +1,158 @@
 #include "ControllerManager.h"
+#include "NetPlay.h"
 
 ControllerManager* globalControllerManager = nullptr;
 
-ControllerManager::ControllerManager() {
+namespace {
+
+// Connect/disconnect callbacks vs. update(): short critical sections around controllers[].
+portMUX_TYPE slotMux = portMUX_INITIALIZER_UNLOCKED;
+
+const PadState NO_PAD;
+
+// Bluepad32 API surface varies by version/controller (same SFINAE approach the games used).
+struct PadDetail {
+    template <typename T>
+    static auto axisX(T* c, int) -> decltype(c->axisX(), int32_t()) { return (int32_t)c->axisX(); }
+    template <typename T>
+    static int32_t axisX(T*, ...) { return 0; }
+
+    template <typename T>
+    static auto axisY(T* c, int) -> decltype(c->axisY(), int32_t()) { return (int32_t)c->axisY(); }
+    template <typename T>
+    static int32_t axisY(T*, ...) { return 0; }
+
+    template <typename T>
+    static auto axisRX(T* c, int) -> decltype(c->axisRX(), int32_t()) { return (int32_t)c->axisRX(); }
+    template <typename T>
+    static int32_t axisRX(T*, ...) { return 0; }
+
+    template <typename T>
+    static auto axisRY(T* c, int) -> decltype(c->axisRY(), int32_t()) { return (int32_t)c->axisRY(); }
+    template <typename T>
+    static int32_t axisRY(T*, ...) { return 0; }
+
+    template <typename T>
+    static auto brake(T* c, int) -> decltype(c->brake(), int32_t()) { return (int32_t)c->brake(); }
+    template <typename T>
+    static int32_t brake(T*, ...) { return 0; }
+
+    template <typename T>
+    static auto throttle(T* c, int) -> decltype(c->throttle(), int32_t()) { return (int32_t)c->throttle(); }
+    template <typename T>
+    static int32_t throttle(T*, ...) { return 0; }
+
+    template <typename T>
+    static auto l1(T* c, int) -> decltype(c->l1(), bool()) { return (bool)c->l1(); }
+    template <typename T>
+    static bool l1(T*, ...) { return false; }
+
+    template <typename T>
+    static auto r1(T* c, int) -> decltype(c->r1(), bool()) { return (bool)c->r1(); }
+    template <typename T>
+    static bool r1(T*, ...) { return false; }
+
+    template <typename T>
+    static auto lb(T* c, int) -> decltype(c->lb(), bool()) { return (bool)c->lb(); }
+    template <typename T>
+    static bool lb(T*, ...) { return false; }
+
+    template <typename T>
+    static auto rb(T* c, int) -> decltype(c->rb(), bool()) { return (bool)c->rb(); }
+    template <typename T>
+    static bool rb(T*, ...) { return false; }
+
+    template <typename T>
+    static auto l2(T* c, int) -> decltype(c->l2(), bool()) { return (bool)c->l2(); }
+    template <typename T>
+    static bool l2(T*, ...) { return false; }
+
+    template <typename T>
+    static auto r2(T* c, int) -> decltype(c->r2(), bool()) { return (bool)c->r2(); }
+    template <typename T>
+    static bool r2(T*, ...) { return false; }
+
+    template <typename T>
+    static auto thumbL(T* c, int) -> decltype(c->thumbL(), bool()) { return (bool)c->thumbL(); }
+    template <typename T>
+    static bool thumbL(T*, ...) { return false; }
+
+    template <typename T>
+    static auto thumbR(T* c, int) -> decltype(c->thumbR(), bool()) { return (bool)c->thumbR(); }
+    template <typename T>
+    static bool thumbR(T*, ...) { return false; }
+
+    template <typename T>
+    static auto start(T* c, int) -> decltype(c->start(), bool()) { return (bool)c->start(); }
+    template <typename T>
+    static bool start(T*, ...) { return false; }
+
+    template <typename T>
+    static auto select(T* c, int) -> decltype(c->select(), bool()) { return (bool)c->select(); }
+    template <typename T>
+    static bool select(T*, ...) { return false; }
+
+    template <typename T>
+    static auto back(T* c, int) -> decltype(c->back(), bool()) { return (bool)c->back(); }
+    template <typename T>
+    static bool back(T*, ...) { return false; }
+
+    template <typename T>
+    static auto miscButtons(T* c, int) -> decltype(c->miscButtons(), uint16_t()) { return (uint16_t)c->miscButtons(); }
+    template <typename T>
+    static uint16_t miscButtons(T*, ...) { return 0; }
+};
+
+// miscButtons() fallback bits (Bluepad32 convention). SELECT/BACK can vary by
+// controller mapping; if yours differs, tweak MISC_SELECT.
+constexpr uint16_t MISC_SYSTEM = 0x01;
+constexpr uint16_t MISC_SELECT = 0x02;
+constexpr uint16_t MISC_START = 0x04;
+
+inline int16_t clampAxis(int32_t v) {
+    return (int16_t)constrain(v, (int32_t)-PadState::AXIS_MAX - 1, (int32_t)PadState::AXIS_MAX);
+}
+
+inline uint16_t clampTrigger(int32_t v) {
+    return (uint16_t)constrain(v, (int32_t)0, (int32_t)PadState::TRIGGER_MAX);
+}
+
+// Current levels only; edges are filled in against the previous frame.
+void samplePad(ControllerPtr ctl, PadState& p) {
+    p = PadState();
+    if (!ctl || !ctl->isConnected()) return;
+    p.connected = true;
+    p.dpad = ctl->dpad();
+
+    const uint16_t misc = PadDetail::miscButtons(ctl, 0);
+    uint16_t b = 0;
+    if (ctl->a()) b |= PadState::BTN_A;
+    if (ctl->b()) b |= PadState::BTN_B;
+    if (ctl->x()) b |= PadState::BTN_X;
+    if (ctl->y()) b |= PadState::BTN_Y;
+    // Some Bluepad32 versions/controllers expose LB/RB as lb()/rb().
+    if (PadDetail::l1(ctl, 0) || PadDetail::lb(ctl, 0)) b |= PadState::BTN_L1;
+    if (PadDetail::r1(ctl, 0) || PadDetail::rb(ctl, 0)) b |= PadState::BTN_R1;
+    if (PadDetail::l2(ctl, 0)) b |= PadState::BTN_L2;
+    if (PadDetail::r2(ctl, 0)) b |= PadState::BTN_R2;
+    if (PadDetail::thumbL(ctl, 0)) b |= PadState::BTN_THUMB_L;
+    if (PadDetail::thumbR(ctl, 0)) b |= PadState::BTN_THUMB_R;
+    if (PadDetail::start(ctl, 0) || (misc & MISC_START)) b |= PadState::BTN_START;
+    if (PadDetail::select(ctl, 0) || PadDetail::back(ctl, 0) || (misc & MISC_SELECT)) b |= PadState::BTN_SELECT;
+    if (misc & MISC_SYSTEM) b |= PadState::BTN_SYSTEM;
+    p.buttons = b;
+
+    p.axisX = clampAxis(PadDetail::axisX(ctl, 0));
+    p.axisY = clampAxis(PadDetail::axisY(ctl, 0));
+    p.axisRX = clampAxis(PadDetail::axisRX(ctl, 0));
+    p.axisRY = clampAxis(PadDetail::axisRY(ctl, 0));
+    p.brake = clampTrigger(PadDetail::brake(ctl, 0));
+    p.throttle = clampTrigger(PadDetail::throttle(ctl, 0));
+}
+
+} // namespace
+
+ControllerManager::ControllerManager() : padSeq(0) {
     connectedCount = 0;
     for (int i = 0; i < MAX_GAMEPADS; i++) {
         controllers[i] = nullptr;
@@ -14,15 +164,60 @@ void ControllerManager::setup() {
     BP32.setup(&ControllerManager::onConnectedController,
                &ControllerManager::onDisconnectedController);
     BP32.enableVirtualDevice(false);
+    globalNetPlay.begin();
 }
 
 void ControllerManager::update() {
     BP32.update();
+
+    ControllerPtr live[MAX_GAMEPADS];
+    portENTER_CRITICAL(&slotMux);
+    for (int i = 0; i < MAX_GAMEPADS; i++) live[i] = controllers[i];
+    portEXIT_CRITICAL(&slotMux);
+
+    // Fill the back buffer, then publish it.
+    const uint32_t seq = padSeq.load(std::memory_order_relaxed);
+    const PadState* prev = padBuf[seq & 1];
+    PadState* next = padBuf[(seq + 1) & 1];
+    int count = 0;
+    for (int i = 0; i < MAX_GAMEPADS; i++) {
+        PadState& p = next[i];
+        samplePad(live[i], p);
+        // A pad that (re)connected this frame has no edges yet.
+        if (p.connected && prev[i].connected) {
+            p.pressed = (uint16_t)(p.buttons & ~prev[i].buttons);
+            p.released = (uint16_t)(prev[i].buttons & ~p.buttons);
+            p.dpadPressed = (uint8_t)(p.dpad & ~prev[i].dpad);
+        }
+        if (p.connected) count++;
+    }
+    padSeq.store(seq + 1, std::memory_order_release);
+    connectedCount = count;
+
+    globalNetPlay.update();
+}
+
+const PadState& ControllerManager::pad(int index) const {
+    if (index < 0 || index >= MAX_GAMEPADS) return NO_PAD;
+    return padBuf[padSeq.load(std::memory_order_relaxed) & 1][index];
+}
+
+void ControllerManager::readPads(PadState out[MAX_GAMEPADS]) const {
+    for (;;) {
+        const uint32_t seq = padSeq.load(std::memory_order_acquire);
+        memcpy(out, padBuf[seq & 1], sizeof(PadState) * MAX_GAMEPADS);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        // Unchanged sequence => update() did not start overwriting this buffer.
+        if (padSeq.load(std::memory_order_relaxed) == seq) return;
+    }
 }
 
 ControllerPtr ControllerManager::getController(int index) {
     if (index < 0 || index >= MAX_GAMEPADS) return nullptr;
-    return controllers[index];
+    portENTER_CRITICAL(&slotMux);
+    ControllerPtr ctl = controllers[index];
+    portEXIT_CRITICAL(&slotMux);
+    return ctl;
 }
 
 int ControllerManager::getConnectedCount() const {
@@ -32,23 +227,25 @@ int ControllerManager::getConnectedCount() const {
 void ControllerManager::onConnectedController(ControllerPtr ctl) {
     if (!globalControllerManager) return;
 
+    portENTER_CRITICAL(&slotMux);
     for (int i = 0; i < MAX_GAMEPADS; i++) {
         if (globalControllerManager->controllers[i] == nullptr) {
             globalControllerManager->controllers[i] = ctl;
-            globalControllerManager->connectedCount++;
             break;
         }
     }
+    portEXIT_CRITICAL(&slotMux);
 }
 
 void ControllerManager::onDisconnectedController(ControllerPtr ctl) {
     if (!globalControllerManager) return;
 
+    portENTER_CRITICAL(&slotMux);
     for (int i = 0; i < MAX_GAMEPADS; i++) {
         if (globalControllerManager->controllers[i] == ctl) {
             globalControllerManager->controllers[i] = nullptr;
-            globalControllerManager->connectedCount--;
             break;
         }
     }
+    portEXIT_CRITICAL(&slotMux);
 }
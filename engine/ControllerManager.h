@@ -1,8 +1,56 @@
 #pragma once
 #include <Arduino.h>
 #include <Bluepad32.h>
+#include <atomic>
 #include "config.h"
 
+/**
+ * One pad as seen by this frame (plain data, sampled once per loop in
+ * ControllerManager::update()). Games read these fields instead of calling
+ * into live Bluepad32 controller objects.
+ */
+struct PadState {
+    // buttons / pressed / released bits
+    static constexpr uint16_t BTN_A = 0x0001;
+    static constexpr uint16_t BTN_B = 0x0002;
+    static constexpr uint16_t BTN_X = 0x0004;
+    static constexpr uint16_t BTN_Y = 0x0008;
+    static constexpr uint16_t BTN_L1 = 0x0010;
+    static constexpr uint16_t BTN_R1 = 0x0020;
+    static constexpr uint16_t BTN_L2 = 0x0040;
+    static constexpr uint16_t BTN_R2 = 0x0080;
+    static constexpr uint16_t BTN_THUMB_L = 0x0100;
+    static constexpr uint16_t BTN_THUMB_R = 0x0200;
+    static constexpr uint16_t BTN_START = 0x0400;
+    static constexpr uint16_t BTN_SELECT = 0x0800;
+    static constexpr uint16_t BTN_SYSTEM = 0x1000;
+
+    // dpad bits (same as Controller::dpad())
+    static constexpr uint8_t DPAD_UP = 0x01;
+    static constexpr uint8_t DPAD_DOWN = 0x02;
+    static constexpr uint8_t DPAD_RIGHT = 0x04;
+    static constexpr uint8_t DPAD_LEFT = 0x08;
+
+    static constexpr int16_t AXIS_MAX = 511;   // sticks: Bluepad32 units, clamped to [-512..511]
+    static constexpr uint16_t TRIGGER_MAX = 1023;
+
+    bool connected = false;
+    uint8_t dpad = 0;
+    uint8_t dpadPressed = 0;  // dpad bits that went down this frame
+    uint16_t buttons = 0;     // BTN_* held
+    uint16_t pressed = 0;     // BTN_* that went down this frame
+    uint16_t released = 0;    // BTN_* that went up this frame
+    int16_t axisX = 0;
+    int16_t axisY = 0;
+    int16_t axisRX = 0;
+    int16_t axisRY = 0;
+    uint16_t brake = 0;       // L2 analog, 0..TRIGGER_MAX
+    uint16_t throttle = 0;    // R2 analog, 0..TRIGGER_MAX
+
+    bool held(uint16_t mask) const { return (buttons & mask) != 0; }
+    bool hit(uint16_t mask) const { return (pressed & mask) != 0; }
+};
+
 class ControllerManager {
 public:
     ControllerManager();
@@ -10,14 +58,28 @@ public:
     void setup();
     void update();
 
-    ControllerPtr getController(int index);
+    // Frame snapshot (loop task): stable from one update() to the next.
+    // Out-of-range indices read as a disconnected pad.
+    const PadState& pad(int index) const;
     int getConnectedCount() const;
 
+    // Copy of the latest snapshot for readers on other tasks (seqlock).
+    void readPads(PadState out[MAX_GAMEPADS]) const;
+
+    // Live Bluepad32 object, for output only (rumble). Input goes through pad().
+    ControllerPtr getController(int index);
+
     static void onConnectedController(ControllerPtr ctl);
     static void onDisconnectedController(ControllerPtr ctl);
 
 private:
+    // Written by the Bluetooth callbacks, guarded by slotMux.
     ControllerPtr controllers[MAX_GAMEPADS];
+
+    // Double-buffered snapshot: padSeq & 1 is the front buffer. update() fills
+    // the back buffer and then bumps padSeq to publish it.
+    PadState padBuf[2][MAX_GAMEPADS];
+    std::atomic<uint32_t> padSeq;
     int connectedCount;
 };
 
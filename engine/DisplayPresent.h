@@ -14,6 +14,7 @@
 
 #include <ESP32-HUB75-MatrixPanel-I2S-DMA.h>
 #include "config.h"
+#include "Trace.h"
 
 namespace DisplayPresentDetail {
   // Different versions of ESP32-HUB75-MatrixPanel-I2S-DMA expose different
@@ -28,15 +29,69 @@ namespace DisplayPresentDetail {
   static auto tryPresent(T* d, unsigned char) -> decltype(d->showDMABuffer(), void()) { d->showDMABuffer(); }
   template <typename T>
   static void tryPresent(T*, ...) {}
+
+  // Measured scanout rate, on library versions that publish it.
+  template <typename T>
+  static auto tryRefreshHz(T* d, int) -> decltype((uint32_t)d->calculated_refresh_rate) {
+    return (uint32_t)d->calculated_refresh_rate;
+  }
+  template <typename T>
+  static uint32_t tryRefreshHz(T*, ...) { return 0; }
+
+  struct Scanout {
+    uint32_t periodUs = 1000000UL / PANEL_MIN_REFRESH_HZ;
+    uint32_t flipUs = 0;
+    bool inFlight = false;
+  };
+
+  inline Scanout& scanout() {
+    static Scanout s;
+    return s;
+  }
+}
+
+/**
+ * Scanout pacing
+ * --------------
+ * flipDMABuffer() only relinks the DMA descriptor chain: the panel finishes the
+ * frame it is scanning from the old front buffer and switches at the frame
+ * boundary. The library hands that old front buffer back for drawing at once,
+ * so a frame drawn right after a present writes rows that are still being
+ * shown (the tearing/ghosting the render caps were hiding).
+ *
+ * The library keeps its end-of-frame interrupt to itself, so the boundary is
+ * taken from the scanout period: a present is "in flight" until one full
+ * period has passed (the worst case, a flip queued just after a boundary).
+ * The loop skips drawing while frameInFlight() and draws on a later pass;
+ * game updates keep running.
+ */
+static inline void beginPresent(MatrixPanel_I2S_DMA* d) {
+  const uint32_t hz = DisplayPresentDetail::tryRefreshHz(d, 0);
+  if (hz > 0) DisplayPresentDetail::scanout().periodUs = 1000000UL / hz;
+}
+
+static inline bool frameInFlight() {
+#if ENABLE_DOUBLE_BUFFER
+  DisplayPresentDetail::Scanout& s = DisplayPresentDetail::scanout();
+  if (!s.inFlight) return false;
+  if ((uint32_t)((uint32_t)micros() - s.flipUs) < s.periodUs) return true;
+  s.inFlight = false;
+#endif
+  return false;
 }
 
 /**
- * Present the back buffer if double buffering is enabled.
+ * Present the back buffer if double buffering is enabled (shown from the next
+ * scanout boundary; see frameInFlight()).
  * If the linked library doesn't support a present call, this becomes a no-op.
  */
 static inline void presentFrame(MatrixPanel_I2S_DMA* d) {
 #if ENABLE_DOUBLE_BUFFER
+  TRACE_SCOPE("presentFrame");
   DisplayPresentDetail::tryPresent(d, 0);
+  DisplayPresentDetail::Scanout& s = DisplayPresentDetail::scanout();
+  s.flipUs = (uint32_t)micros();
+  s.inFlight = true;
 #else
   (void)d;
 #endif
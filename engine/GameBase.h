@@ -3,6 +3,9 @@
 #include "ControllerManager.h"
 #include "config.h"
 
+class SnapshotWriter;
+class SnapshotReader;
+
 class GameBase {
 public:
     virtual void start() = 0;
@@ -34,5 +37,34 @@ public:
      * Default: use the global game render FPS.
      */
     virtual uint16_t preferredRenderFps() const { return GAME_RENDER_FPS; }
+
+    /**
+     * Ambient apps (screensaver-like, no gameplay) return true. The power
+     * governor lowers the clock and redraw rate for them once nobody has
+     * touched a pad for a while (engine/PowerGovernor.h).
+     */
+    virtual bool isAmbient() const { return false; }
+
+    // -----------------------------------------------------
+    // Optional: State snapshots (see engine/Snapshot.h)
+    // -----------------------------------------------------
+    // Games that can serialize their full state return a non-zero layout version
+    // (bump it whenever the payload changes) and implement save/load. The engine
+    // uses this for instant resume after a reboot (engine/ResumeStore.h).
+    // loadSnapshot() is called on a started game and returns false on bad data.
+    virtual uint8_t snapshotVersion() const { return 0; }
+    virtual void saveSnapshot(SnapshotWriter& /*w*/) const {}
+    virtual bool loadSnapshot(SnapshotReader& /*r*/) { return false; }
+
+    // -----------------------------------------------------
+    // Optional: Self-check (DEBUG_INVARIANTS)
+    // -----------------------------------------------------
+    // Returns nullptr while the game state is consistent, otherwise a short
+    // static description of the first broken invariant (pool counts, grid
+    // bounds, ...). Must be cheap and side-effect free: with DEBUG_INVARIANTS the
+    // sketch calls it after every update() and logs the first failure per run,
+    // and the host soak runner (test/soak) fails the shard on it.
+    virtual const char* checkInvariants() const { return nullptr; }
+
     virtual ~GameBase() {}
 };
@@ -2,6 +2,7 @@
 #include <Arduino.h>
 #include <EEPROM.h>
 #include "EepromManager.h"
+#include "MemPolicy.h"
 #include <stddef.h> // offsetof
 
 /**
@@ -81,15 +82,26 @@ static inline void safeCopyName(char out[NAME_LEN + 1], const char* name) {
     out[NAME_LEN] = '\0';
 }
 
-// In-memory cache (loaded on first use).
-static Storage gStore;
+// In-memory cache (loaded on first use). Only boot, score submits and the
+// leaderboard screens touch it, so it is cold data for MemPolicy: PSRAM when
+// the board has it. Allocated on first call, after the PSRAM driver is up.
+static inline Storage& store() {
+#if MEM_USE_PSRAM
+    static Storage* s = (Storage*)Mem::alloc(sizeof(Storage), Mem::EXTERNAL_BULK);
+    return *s;
+#else
+    static Storage s;
+    return s;
+#endif
+}
 static bool gLoaded = false;
 
 static inline void initEmpty() {
-    memset(&gStore, 0, sizeof(gStore));
-    gStore.magic = MAGIC;
-    gStore.version = VERSION;
-    gStore.gameCount = 0;
+    Storage& st = store();
+    memset(&st, 0, sizeof(Storage));
+    st.magic = MAGIC;
+    st.version = VERSION;
+    st.gameCount = 0;
 }
 
 // Forward declarations (Arduino header compilation order can be surprising).
@@ -100,7 +112,7 @@ static inline void ensureLoadedAndSane();
 static inline void save() {
     #if DEBUG_LEADERBOARD
     Serial.print(F("[Leaderboard] save() called: gameCount="));
-    Serial.println(gStore.gameCount);
+    Serial.println(store().gameCount);
     Serial.print(F("[Leaderboard] freeHeap="));
     Serial.println(ESP.getFreeHeap());
     #endif
@@ -115,10 +127,10 @@ static inline void save() {
     }
     
     // Compute checksum excluding checksum byte itself.
-    gStore.checksum = checksumXor((const uint8_t*)&gStore, CHECKSUM_LEN);
+    store().checksum = checksumXor((const uint8_t*)&store(), CHECKSUM_LEN);
     #if DEBUG_LEADERBOARD
     Serial.print(F("[Leaderboard] Computed checksum: 0x"));
-    Serial.println(gStore.checksum, HEX);
+    Serial.println(store().checksum, HEX);
     #endif
     
     const size_t bytes = sizeof(Storage);
@@ -138,7 +150,7 @@ static inline void save() {
     }
 
     // Write byte-by-byte (more predictable than EEPROM.put on some cores) + yield.
-    const uint8_t* p = (const uint8_t*)&gStore;
+    const uint8_t* p = (const uint8_t*)&store();
     for (size_t i = 0; i < bytes; i++) {
         EEPROM.write((int)(EEPROM_BASE_ADDR + i), p[i]);
         if ((i & 0x3F) == 0x3F) { // every 64 bytes
@@ -175,26 +187,26 @@ static inline void load() {
     Serial.println(EEPROM_BASE_ADDR);
     #endif
     
-    EEPROM.get(EEPROM_BASE_ADDR, gStore);
-    const uint8_t calc = checksumXor((const uint8_t*)&gStore, CHECKSUM_LEN);
+    EEPROM.get(EEPROM_BASE_ADDR, store());
+    const uint8_t calc = checksumXor((const uint8_t*)&store(), CHECKSUM_LEN);
 
     #if DEBUG_LEADERBOARD
     Serial.print(F("[Leaderboard] Read: magic=0x"));
-    Serial.print(gStore.magic, HEX);
+    Serial.print(store().magic, HEX);
     Serial.print(F(" ver="));
-    Serial.print(gStore.version);
+    Serial.print(store().version);
     Serial.print(F(" games="));
-    Serial.print(gStore.gameCount);
+    Serial.print(store().gameCount);
     Serial.print(F(" checksum=0x"));
-    Serial.print(gStore.checksum, HEX);
+    Serial.print(store().checksum, HEX);
     Serial.print(F(" calc=0x"));
     Serial.println(calc, HEX);
     #endif
 
-    const bool ok = (gStore.magic == MAGIC) &&
-                    (gStore.version == VERSION) &&
-                    (gStore.checksum == calc) &&
-                    (gStore.gameCount <= MAX_GAMES);
+    const bool ok = (store().magic == MAGIC) &&
+                    (store().version == VERSION) &&
+                    (store().checksum == calc) &&
+                    (store().gameCount <= MAX_GAMES);
 
     if (!ok) {
         #if DEBUG_LEADERBOARD
@@ -213,15 +225,16 @@ static inline void load() {
     } else {
         #if DEBUG_LEADERBOARD
         Serial.print(F("[Leaderboard] load() OK - games="));
-        Serial.println(gStore.gameCount);
+        Serial.println(store().gameCount);
         #endif
     }
 }
 
 static inline int findEntryIndex(uint32_t idHash) {
     load();
-    for (int i = 0; i < (int)gStore.gameCount; i++) {
-        if (gStore.entries[i].idHash == idHash) return i;
+    const Storage& st = store();
+    for (int i = 0; i < (int)st.gameCount; i++) {
+        if (st.entries[i].idHash == idHash) return i;
     }
     return -1;
 }
@@ -245,15 +258,16 @@ static inline void sortAndClamp(Entry& e) {
 }
 
 static inline bool isRamHeaderSane() {
-    if (gStore.magic != MAGIC) return false;
-    if (gStore.version != VERSION) return false;
-    if (gStore.gameCount > MAX_GAMES) return false;
+    const Storage& st = store();
+    if (st.magic != MAGIC) return false;
+    if (st.version != VERSION) return false;
+    if (st.gameCount > MAX_GAMES) return false;
     return true;
 }
 
 static inline bool isRamChecksumSane() {
-    const uint8_t calc = checksumXor((const uint8_t*)&gStore, CHECKSUM_LEN);
-    return (gStore.checksum == calc);
+    const uint8_t calc = checksumXor((const uint8_t*)&store(), CHECKSUM_LEN);
+    return (store().checksum == calc);
 }
 
 static inline void ensureLoadedAndSane() {
@@ -339,16 +353,16 @@ static inline void submitScore(const char* gameId, const char* gameName, uint32_
     if (idx < 0) {
         #if DEBUG_LEADERBOARD
         Serial.print(F("[Leaderboard] New game entry, current gameCount="));
-        Serial.println(gStore.gameCount);
+        Serial.println(store().gameCount);
         #endif
-        if (gStore.gameCount >= MAX_GAMES) {
+        if (store().gameCount >= MAX_GAMES) {
             #if DEBUG_LEADERBOARD
             Serial.println(F("[Leaderboard] ERROR: EEPROM full (MAX_GAMES reached), cannot add new game"));
             #endif
             return;
         }
-        idx = (int)gStore.gameCount++;
-        Entry& e = gStore.entries[idx];
+        idx = (int)store().gameCount++;
+        Entry& e = store().entries[idx];
         memset(&e, 0, sizeof(e));
         e.idHash = idHash;
         safeCopyName(e.name, gameName ? gameName : gameId);
@@ -360,7 +374,7 @@ static inline void submitScore(const char* gameId, const char* gameName, uint32_
         #endif
     }
 
-    Entry& e = gStore.entries[idx];
+    Entry& e = store().entries[idx];
     #if DEBUG_LEADERBOARD
     Serial.print(F("[Leaderboard] Working with entry: name="));
     Serial.print(e.name);
@@ -480,13 +494,13 @@ static inline void submitScore(const char* gameId, const char* gameName, uint32_
 
 static inline uint8_t gameCount() {
     ensureLoadedAndSane();
-    return gStore.gameCount;
+    return store().gameCount;
 }
 
 static inline const Entry* entryAt(uint8_t index) {
     ensureLoadedAndSane();
-    if (index >= gStore.gameCount) return nullptr;
-    return &gStore.entries[index];
+    if (index >= store().gameCount) return nullptr;
+    return &store().entries[index];
 }
 
 /**
@@ -498,7 +512,7 @@ static inline const Entry* entryForGameId(const char* gameId) {
     const uint32_t idHash = fnv1a32(gameId);
     const int idx = findEntryIndex(idHash);
     if (idx < 0) return nullptr;
-    return &gStore.entries[idx];
+    return &store().entries[idx];
 }
 
 /**
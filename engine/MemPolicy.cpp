@@ -0,0 +1,98 @@
+#include "MemPolicy.h"
+#include <esp_heap_caps.h>
+
+namespace Mem {
+
+namespace {
+
+uint32_t internalCaps(Placement where) {
+    return (where == DMA_CAPABLE ? MALLOC_CAP_DMA : MALLOC_CAP_INTERNAL) | MALLOC_CAP_8BIT;
+}
+
+#if DEBUG_MEM
+// Cycles per 32-bit read-modify-write over `words` words, 4 passes.
+uint32_t cyclesPerAccess(volatile uint32_t* buf, size_t words, bool randomAccess) {
+    constexpr uint8_t PASSES = 4;
+    uint32_t sum = 0;
+    uint32_t lcg = 1;
+    const uint32_t t0 = ESP.getCycleCount();
+    for (uint8_t pass = 0; pass < PASSES; pass++) {
+        for (size_t i = 0; i < words; i++) {
+            size_t j = i;
+            if (randomAccess) {
+                lcg = lcg * 1664525u + 1013904223u;
+                j = (lcg >> 8) % words;
+            }
+            sum += buf[j];
+            buf[j] = sum;
+        }
+    }
+    return (ESP.getCycleCount() - t0) / (uint32_t)(PASSES * words);
+}
+#endif
+
+} // namespace
+
+bool psramAvailable() {
+#if MEM_USE_PSRAM
+    return psramFound();
+#else
+    return false;
+#endif
+}
+
+void* tryAlloc(size_t bytes, Placement where) {
+    void* p = nullptr;
+#if MEM_USE_PSRAM
+    if (where == EXTERNAL_BULK && psramFound()) p = heap_caps_calloc(1, bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+#endif
+    if (!p) p = heap_caps_calloc(1, bytes, internalCaps(where));
+    if (!p) Serial.printf("[Mem] out of memory: %u bytes (placement %u)\n", (unsigned)bytes, (unsigned)where);
+    return p;
+}
+
+void* alloc(size_t bytes, Placement where) {
+    void* p = tryAlloc(bytes, where);
+    // Same contract as `new`: running on without the buffer is not an option.
+    if (!p) abort();
+    return p;
+}
+
+void release(void* p) {
+    heap_caps_free(p);
+}
+
+void benchmark(const char* label, size_t bytes, bool randomAccess) {
+#if DEBUG_MEM
+    const size_t words = bytes / 4;
+    if (words == 0) return;
+    uint32_t* in = (uint32_t*)heap_caps_calloc(1, words * 4, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    uint32_t* ex = nullptr;
+#if MEM_USE_PSRAM
+    if (psramFound()) ex = (uint32_t*)heap_caps_calloc(1, words * 4, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+#endif
+    const uint32_t ci = in ? cyclesPerAccess(in, words, randomAccess) : 0;
+    const uint32_t ce = ex ? cyclesPerAccess(ex, words, randomAccess) : 0;
+    Serial.printf("[Mem] %-18s %6u B %-6s internal %3lu cyc/access, psram %3lu%s\n", label, (unsigned)bytes,
+                  randomAccess ? "random" : "seq", (unsigned long)ci, (unsigned long)ce, ex ? "" : " (n/a)");
+    heap_caps_free(in);
+    heap_caps_free(ex);
+#else
+    (void)label;
+    (void)bytes;
+    (void)randomAccess;
+#endif
+}
+
+void report() {
+#if DEBUG_MEM
+    Serial.printf("[Mem] internal free %u B (largest %u B), DMA free %u B\n",
+                  (unsigned)heap_caps_get_free_size(MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT),
+                  (unsigned)heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT),
+                  (unsigned)heap_caps_get_free_size(MALLOC_CAP_DMA));
+    Serial.printf("[Mem] PSRAM %s, free %u B\n", psramAvailable() ? "in use" : "not used",
+                  psramAvailable() ? (unsigned)heap_caps_get_free_size(MALLOC_CAP_SPIRAM) : 0u);
+#endif
+}
+
+} // namespace Mem
@@ -0,0 +1,119 @@
+#pragma once
+#include <Arduino.h>
+#include "config.h"
+
+/**
+ * MemPolicy
+ * ---------
+ * Where large buffers live. Internal SRAM is shared by the HUB75 DMA
+ * framebuffers, Bluepad32 and the games; WROVER boards have 4-8 MB of PSRAM
+ * next to it that is slower (cached, over SPI) but plentiful.
+ *
+ * - INTERNAL_FAST: touched every tick or every frame (collision masks, grids).
+ * - DMA_CAPABLE:   handed to a DMA engine (internal, DMA-capable RAM).
+ * - EXTERNAL_BULK: cold or one-shot data (generator scratch, score tables).
+ *                  PSRAM when the build has it, internal heap otherwise.
+ *
+ * PSRAM is compiled in with ENABLE_PSRAM on a board build that defines
+ * BOARD_HAS_PSRAM (Tools > PSRAM: Enabled). Without it (MEM_USE_PSRAM 0),
+ * `ColdArray` keeps the old static storage, so nothing moves to the heap on
+ * boards that have no PSRAM.
+ *
+ * alloc()/Buffer treat failure like `new`: fatal, callers never see nullptr.
+ * ColdArray is softer: a PSRAM build on a board without the chip (or with a
+ * full heap) gets ok() == false and the owner skips that work.
+ */
+#if ENABLE_PSRAM && defined(BOARD_HAS_PSRAM)
+#define MEM_USE_PSRAM 1
+#else
+#define MEM_USE_PSRAM 0
+#endif
+
+namespace Mem {
+
+enum Placement : uint8_t {
+    INTERNAL_FAST = 0,
+    DMA_CAPABLE,
+    EXTERNAL_BULK
+};
+
+// PSRAM compiled in and found at boot.
+bool psramAvailable();
+
+// Zeroed block of `bytes`; falls back to internal RAM for EXTERNAL_BULK.
+void* alloc(size_t bytes, Placement where);
+// Same, but returns nullptr (and logs) instead of aborting.
+void* tryAlloc(size_t bytes, Placement where);
+void release(void* p);
+
+// DEBUG_MEM: heap summary, and cycles per access of a `bytes`-sized buffer in
+// internal RAM vs PSRAM (sequential or random pattern). No-ops otherwise.
+void report();
+void benchmark(const char* label, size_t bytes, bool randomAccess);
+
+/**
+ * Owning heap array, freed with the owner.
+ *   Mem::Buffer<uint16_t> q(cells, Mem::EXTERNAL_BULK);
+ */
+template <typename T>
+class Buffer {
+public:
+    Buffer(size_t count, Placement where) : p((T*)alloc(sizeof(T) * count, where)), n(count) {}
+    ~Buffer() { release(p); }
+
+    Buffer(const Buffer&) = delete;
+    Buffer& operator=(const Buffer&) = delete;
+
+    T* data() { return p; }
+    const T* data() const { return p; }
+    size_t size() const { return n; }
+    T& operator[](size_t i) { return p[i]; }
+    const T& operator[](size_t i) const { return p[i]; }
+
+private:
+    T* p;
+    size_t n;
+};
+
+/**
+ * Fixed-size scratch for cold code paths (generators, one-shot searches).
+ * With PSRAM: taken from PSRAM for the owner's lifetime (internal heap when
+ * psramFound() says no chip is fitted). Without: one static array per `Tag`,
+ * as before (no heap use, no fragmentation).
+ *   struct BfsQueueTag;
+ *   Mem::ColdArray<uint16_t, MAX_CELLS, BfsQueueTag> q;
+ *   if (!q.ok()) return false;
+ */
+template <typename T, size_t N, typename Tag>
+class ColdArray {
+public:
+#if MEM_USE_PSRAM
+    ColdArray() : p((T*)tryAlloc(sizeof(T) * N, EXTERNAL_BULK)) {}
+    ~ColdArray() { release(p); }
+#else
+    ColdArray() : p(storage()) {}
+#endif
+
+    ColdArray(const ColdArray&) = delete;
+    ColdArray& operator=(const ColdArray&) = delete;
+
+    // False if the block could not be had; do not index it then.
+    bool ok() const { return p != nullptr; }
+
+    T* data() { return p; }
+    static constexpr size_t size() { return N; }
+    T& operator[](size_t i) { return p[i]; }
+    const T& operator[](size_t i) const { return p[i]; }
+
+private:
+    T* p;
+
+#if !MEM_USE_PSRAM
+    static T* storage() {
+        static T buf[N];
+        return buf;
+    }
+#endif
+};
+
+} // namespace Mem
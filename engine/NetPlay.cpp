@@ -0,0 +1,374 @@
+#include "NetPlay.h"
+#include "ControllerManager.h"
+
+#if ENABLE_NETPLAY
+#include <WiFi.h>
+#include <esp_now.h>
+#endif
+
+NetPlay globalNetPlay;
+
+// -----------------------------
+// Internal helpers
+// -----------------------------
+namespace {
+
+constexpr uint8_t MAGIC0 = 'N';
+constexpr uint8_t MAGIC1 = 'P';
+constexpr uint32_t NO_FRAME = 0xFFFFFFFFu;
+
+inline void put32(uint8_t* p, uint32_t v) { memcpy(p, &v, 4); }
+inline uint32_t get32(const uint8_t* p) { uint32_t v; memcpy(&v, p, 4); return v; }
+
+#if ENABLE_NETPLAY
+portMUX_TYPE rxMux = portMUX_INITIALIZER_UNLOCKED;
+const uint8_t BROADCAST_MAC[6] = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
+
+void onEspNowRecv(const uint8_t* mac, const uint8_t* data, int len) {
+    globalNetPlay.onPacket(mac, data, len);
+}
+#endif
+
+} // namespace
+
+uint32_t NetPlay::nowMs() const {
+    if (link) return link->nowMs();
+    return millis();
+}
+
+NetInput NetInput::sample(const PadState& pad) {
+    NetInput in;
+    if (!pad.connected) return in;
+    in.dpad = pad.dpad;
+    if (pad.held(PadState::BTN_A)) in.buttons |= BTN_A;
+    if (pad.held(PadState::BTN_B)) in.buttons |= BTN_B;
+    if (pad.held(PadState::BTN_X)) in.buttons |= BTN_X;
+    if (pad.held(PadState::BTN_Y)) in.buttons |= BTN_Y;
+    in.axisY = (int8_t)constrain(pad.axisY / 4, -127, 127);
+    in.axisX = (int8_t)constrain(pad.axisX / 4, -127, 127);
+    return in;
+}
+
+// -----------------------------
+// Transport
+// -----------------------------
+void NetPlay::begin() {
+#if ENABLE_NETPLAY
+    if (started) return;
+    WiFi.mode(WIFI_STA);
+    WiFi.setChannel(NETPLAY_CHANNEL);
+    WiFi.macAddress(myMac);
+    if (esp_now_init() != ESP_OK) {
+        Serial.println(F("[NetPlay] esp_now_init failed"));
+        return;
+    }
+    esp_now_register_recv_cb(onEspNowRecv);
+    esp_now_peer_info_t peer = {};
+    memcpy(peer.peer_addr, BROADCAST_MAC, 6);
+    peer.channel = NETPLAY_CHANNEL;
+    peer.encrypt = false;
+    esp_now_add_peer(&peer);
+    started = true;
+    Serial.println(F("[NetPlay] ESP-NOW started"));
+#endif
+}
+
+void NetPlay::attachLink(Link* l, const uint8_t mac[6]) {
+    link = l;
+    memcpy(myMac, mac, 6);
+    started = true;
+}
+
+void NetPlay::sendRaw(const uint8_t* data, int len) {
+    if (link) {
+        link->send(myMac, data, len);
+        st.packetsOut++;
+        return;
+    }
+#if ENABLE_NETPLAY
+    if (!started) return;
+    esp_now_send(BROADCAST_MAC, data, (size_t)len);
+    st.packetsOut++;
+#else
+    (void)data;
+    (void)len;
+#endif
+}
+
+void NetPlay::onPacket(const uint8_t* mac, const uint8_t* data, int len) {
+    if (len < 3 || len > MAX_PACKET || data[0] != MAGIC0 || data[1] != MAGIC1) return;
+#if ENABLE_NETPLAY
+    portENTER_CRITICAL(&rxMux);
+#endif
+    const uint8_t next = (uint8_t)((rxHead + 1) % RX_QUEUE);
+    if (next != rxTail) { // drop when full; redundancy covers it
+        RxPacket& p = rxQueue[rxHead];
+        memcpy(p.mac, mac, 6);
+        p.len = (uint8_t)len;
+        memcpy(p.data, data, (size_t)len);
+        rxHead = next;
+    }
+#if ENABLE_NETPLAY
+    portEXIT_CRITICAL(&rxMux);
+#endif
+}
+
+void NetPlay::drainRx() {
+    for (;;) {
+        RxPacket p;
+#if ENABLE_NETPLAY
+        portENTER_CRITICAL(&rxMux);
+#endif
+        const bool empty = (rxTail == rxHead);
+        if (!empty) {
+            p = rxQueue[rxTail];
+            rxTail = (uint8_t)((rxTail + 1) % RX_QUEUE);
+        }
+#if ENABLE_NETPLAY
+        portEXIT_CRITICAL(&rxMux);
+#endif
+        if (empty) return;
+        handlePacket(p.mac, p.data, p.len);
+    }
+}
+
+// -----------------------------
+// Link / session
+// -----------------------------
+bool NetPlay::linked() const {
+    return havePeer && (uint32_t)(nowMs() - lastHeardMs) < (uint32_t)NETPLAY_PEER_TIMEOUT_MS;
+}
+
+void NetPlay::update() {
+    if (!started) return;
+    drainRx();
+
+    // HELLO doubles as keepalive and session handshake. Send fast while a
+    // session is being negotiated (or until the peer's first inputs arrive).
+    const uint32_t now = nowMs();
+    const bool negotiating = (requested && !running) || (running && remoteConfirmed < (int32_t)INPUT_DELAY);
+    const uint32_t interval = negotiating ? 100 : 500;
+    if ((uint32_t)(now - lastHelloMs) >= interval) sendHello();
+    // A game that stopped ticking (game over, pause) still owes the peer the
+    // inputs it needs to confirm the same frames.
+    if (running && (uint32_t)(now - lastInputsMs) >= 50) sendInputs();
+
+    if (running && !linked()) {
+        running = false;
+        requested = false;
+        lost = true;
+    }
+
+    #if DEBUG_NETPLAY
+    static uint32_t lastDump = 0;
+    if (running && !link && (uint32_t)(now - lastDump) >= 5000) {
+        lastDump = now;
+        Serial.printf("[NetPlay] f=%lu rb=%lu resim=%lu maxDepth=%u stalls=%lu resimMaxUs=%lu rtt=%ums in=%lu out=%lu\n",
+                      (unsigned long)curFrame, (unsigned long)st.rollbacks, (unsigned long)st.resimFrames,
+                      (unsigned)st.maxRollbackDepth, (unsigned long)st.stalls, (unsigned long)st.resimMaxUs,
+                      (unsigned)st.rttMs, (unsigned long)st.packetsIn, (unsigned long)st.packetsOut);
+    }
+    #endif
+}
+
+void NetPlay::resetSessionBuffers() {
+    for (uint8_t i = 0; i < INPUT_RING; i++) {
+        localIn[i] = InputSlot();
+        remoteIn[i] = InputSlot();
+        usedRemote[i] = 0;
+        sentAtMs[i] = 0;
+    }
+    // The first INPUT_DELAY frames have no input from anyone: neutral on both sides.
+    for (uint32_t f = 0; f < INPUT_DELAY; f++) {
+        localIn[f % INPUT_RING].frame = f;
+        remoteIn[f % INPUT_RING].frame = f;
+    }
+    curFrame = 0;
+    newestLocal = (INPUT_DELAY > 0) ? (uint32_t)(INPUT_DELAY - 1) : 0;
+    remoteConfirmed = (int32_t)INPUT_DELAY - 1;
+    lastRemoteInput = 0;
+    rollbackFrom = NO_FRAME;
+    peerAck = -1;
+    st = Stats();
+}
+
+void NetPlay::startSession(uint8_t id) {
+    gameId = id;
+    requested = true;
+    running = false;
+    lost = false;
+    sessionId = (uint8_t)(esp_random() | 1u);
+    localSeed = esp_random();
+    resetSessionBuffers();
+    sendHello();
+}
+
+void NetPlay::endSession() {
+    requested = false;
+    running = false;
+}
+
+void NetPlay::sendHello() {
+    // 'N' 'P' type gameId sessionId state seed[4] partnerSessionId
+    uint8_t pkt[11];
+    pkt[0] = MAGIC0;
+    pkt[1] = MAGIC1;
+    pkt[2] = PKT_HELLO;
+    pkt[3] = gameId;
+    pkt[4] = sessionId;
+    pkt[5] = running ? HELLO_RUNNING : requested ? HELLO_WAITING : HELLO_IDLE;
+    put32(&pkt[6], localSeed);
+    pkt[10] = running ? peerSessionId : 0;
+    sendRaw(pkt, sizeof(pkt));
+    lastHelloMs = nowMs();
+}
+
+void NetPlay::sendInputs() {
+    // 'N' 'P' type sessionId first[4] ack[4] inputs[n][4] (n implied by the length)
+    uint8_t pkt[12 + REDUNDANCY * 4];
+    // Start at the oldest input the peer has not acked: that is the one it may be
+    // stalled on. Once everything is acked, keep repeating the newest.
+    uint32_t first = (uint32_t)(peerAck + 1);
+    if (first > newestLocal) first = newestLocal;
+    const uint32_t count = min((uint32_t)REDUNDANCY, newestLocal - first + 1);
+    pkt[0] = MAGIC0;
+    pkt[1] = MAGIC1;
+    pkt[2] = PKT_INPUT;
+    pkt[3] = sessionId;
+    put32(&pkt[4], first);
+    put32(&pkt[8], (uint32_t)remoteConfirmed);
+    uint8_t* p = &pkt[12];
+    for (uint32_t i = 0; i < count; i++) {
+        put32(p, localIn[(first + i) % INPUT_RING].input);
+        p += 4;
+    }
+    sendRaw(pkt, (int)(12 + count * 4));
+    lastInputsMs = nowMs();
+}
+
+void NetPlay::handlePacket(const uint8_t* mac, const uint8_t* data, int len) {
+    if (havePeer && memcmp(mac, peerMac, 6) != 0) return; // a third cabinet: ignore
+    if (!havePeer) {
+        memcpy(peerMac, mac, 6);
+        havePeer = true;
+        side = (memcmp(myMac, peerMac, 6) < 0) ? 0 : 1;
+    }
+    lastHeardMs = nowMs();
+    st.packetsIn++;
+
+    if (data[2] == PKT_HELLO && len >= 11) {
+        const uint8_t peerGame = data[3];
+        const uint8_t peerSession = data[4];
+        const uint8_t peerState = data[5];
+        // Pair with a waiting peer, or with one that already paired with *this* session
+        // (it heard our WAITING hello before we heard its one).
+        const bool pairable = (peerState == HELLO_WAITING) || (peerState == HELLO_RUNNING && data[10] == sessionId);
+        if (requested && !running && pairable && peerGame == gameId) {
+            peerSessionId = peerSession;
+            seed = localSeed ^ get32(&data[6]);
+            running = true;
+            sendHello(); // make sure the peer sees our seed right away
+        } else if (running && (peerState == HELLO_IDLE || peerSession != peerSessionId)) {
+            // Peer left, or restarted into a new session while we were still in this one.
+            running = false;
+            requested = false;
+            lost = true;
+        }
+        return;
+    }
+
+    if (data[2] != PKT_INPUT || len < 12 || !running || data[3] != peerSessionId) return;
+
+    const uint32_t first = get32(&data[4]);
+    const int32_t ack = (int32_t)get32(&data[8]);
+    const uint32_t count = (uint32_t)(len - 12) / 4;
+
+    for (uint32_t i = 0; i < count; i++) {
+        const uint32_t f = first + i;
+        if ((int32_t)f <= remoteConfirmed) continue;
+        if (f >= curFrame + INPUT_RING - REDUNDANCY) break; // implausibly far ahead
+        InputSlot& slot = remoteIn[f % INPUT_RING];
+        if (slot.frame == f) continue;
+        slot.frame = f;
+        slot.input = get32(&data[12 + i * 4]);
+        // Already simulated on a prediction that turned out wrong -> roll back.
+        if (f < curFrame && usedRemote[f % INPUT_RING] != slot.input && f < rollbackFrom) rollbackFrom = f;
+    }
+    while (remoteIn[(uint32_t)(remoteConfirmed + 1) % INPUT_RING].frame == (uint32_t)(remoteConfirmed + 1)) {
+        remoteConfirmed++;
+        lastRemoteInput = remoteIn[(uint32_t)remoteConfirmed % INPUT_RING].input;
+    }
+
+    if (ack > peerAck) {
+        peerAck = ack;
+        const uint32_t sent = sentAtMs[(uint32_t)ack % INPUT_RING];
+        if (sent != 0 && localIn[(uint32_t)ack % INPUT_RING].frame == (uint32_t)ack) {
+            const uint16_t rtt = (uint16_t)min((uint32_t)(nowMs() - sent), (uint32_t)0xFFFF);
+            st.rttMs = (st.rttMs == 0) ? rtt : (uint16_t)((st.rttMs * 7u + rtt) / 8u);
+        }
+    }
+}
+
+// -----------------------------
+// Lockstep / rollback
+// -----------------------------
+uint32_t NetPlay::remoteInputFor(uint32_t f) const {
+    const InputSlot& s = remoteIn[f % INPUT_RING];
+    return (s.frame == f) ? s.input : lastRemoteInput;
+}
+
+bool NetPlay::tick(NetGame& game, const NetInput& local) {
+    drainRx();
+    if (!running) return false;
+
+    auto inputsFor = [&](uint32_t f, NetInput in[2]) {
+        const InputSlot& l = localIn[f % INPUT_RING];
+        const uint32_t remote = remoteInputFor(f);
+        usedRemote[f % INPUT_RING] = remote;
+        in[side] = NetInput::unpack((l.frame == f) ? l.input : 0);
+        in[side ^ 1u] = NetInput::unpack(remote);
+    };
+
+    // 1) Re-simulate from the oldest mispredicted frame.
+    if (rollbackFrom < curFrame) {
+        const uint32_t t0 = micros();
+        const uint32_t depth = curFrame - rollbackFrom;
+        game.netLoadState((uint8_t)(rollbackFrom % STATE_SLOTS));
+        for (uint32_t f = rollbackFrom; f < curFrame; f++) {
+            if (f != rollbackFrom) game.netSaveState((uint8_t)(f % STATE_SLOTS));
+            NetInput in[2];
+            inputsFor(f, in);
+            game.netStep(in, /*replaying=*/true);
+        }
+        st.rollbacks++;
+        st.resimFrames += depth;
+        if (depth > st.maxRollbackDepth) st.maxRollbackDepth = (uint8_t)min(depth, (uint32_t)255);
+        const uint32_t us = (uint32_t)(micros() - t0);
+        if (us > st.resimMaxUs) st.resimMaxUs = us;
+    }
+    rollbackFrom = NO_FRAME;
+
+    // 2) Never predict further than we can roll back.
+    if ((int32_t)curFrame - remoteConfirmed > (int32_t)MAX_ROLLBACK) {
+        st.stalls++;
+        if ((st.stalls & 7u) == 0) sendInputs(); // keep the peer fed while we wait
+        return false;
+    }
+
+    // 3) Schedule our input INPUT_DELAY frames ahead and simulate this frame.
+    const uint32_t lf = curFrame + INPUT_DELAY;
+    localIn[lf % INPUT_RING].frame = lf;
+    localIn[lf % INPUT_RING].input = local.pack();
+    sentAtMs[lf % INPUT_RING] = nowMs();
+    if (lf > newestLocal || curFrame == 0) newestLocal = lf;
+
+    game.netSaveState((uint8_t)(curFrame % STATE_SLOTS));
+    NetInput in[2];
+    inputsFor(curFrame, in);
+    game.netStep(in, /*replaying=*/false);
+    curFrame++;
+    st.framesRun++;
+
+    sendInputs();
+    return true;
+}
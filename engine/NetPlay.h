@@ -0,0 +1,258 @@
+#pragma once
+#include <Arduino.h>
+#include "config.h"
+
+struct PadState;
+
+/**
+ * NetPlay
+ * -------
+ * Two-cabinet link: deterministic lockstep with rollback, over ESP-NOW.
+ *
+ * Model (per linked game):
+ * - Both devices run the same fixed-tick simulation. Each tick the game hands
+ *   its local pad sample to `tick()`, which schedules it NETPLAY_INPUT_DELAY
+ *   frames ahead and sends the last few local inputs to the peer (redundant,
+ *   so a lost packet is repaired by the next one).
+ * - Frames whose remote input has not arrived yet run on a prediction (the
+ *   last confirmed remote input). When the real input arrives and differs,
+ *   the game is rolled back to that frame and re-simulated up to the present.
+ * - If the peer falls more than NETPLAY_MAX_ROLLBACK frames behind we stall
+ *   instead of predicting further.
+ *
+ * Games opt in by implementing `NetGame` (state slots + a pure step function).
+ * Anything random inside the step must come from a `DetRandom` that is part of
+ * the saved state and seeded from `sessionSeed()`.
+ *
+ * Hardware: ESP-NOW broadcast on NETPLAY_CHANNEL; the first cabinet heard
+ * becomes the peer. The lower MAC plays side 0 (left / P1).
+ * With ENABLE_NETPLAY == 0 everything compiles to "never linked".
+ *
+ * Linked games: Pong, Snake and Tron, one pad per cabinet (pad 0 drives side
+ * `localSide()`). Snake and Tron fill the other slots with CPU players whose
+ * choices depend only on the simulated state and the session DetRandom.
+ *
+ * Host tests (test/netplay) replace the radio with `attachLink()`: a loopback
+ * with injected delay, jitter and loss, and two forked cabinets running real
+ * games. DEBUG_NETPLAY prints link stats while a session runs.
+ */
+
+// ---------------------------------------------------------
+// Deterministic PRNG (xorshift32) for lockstep simulations
+// ---------------------------------------------------------
+struct DetRandom {
+    uint32_t state = 0x9E3779B9u;
+
+    void seed(uint32_t s) { state = s ? s : 0x9E3779B9u; }
+
+    uint32_t next() {
+        uint32_t x = state;
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        state = x;
+        return x;
+    }
+
+    // Same contract as Arduino random(lo, hi): lo..hi-1.
+    int32_t range(int32_t lo, int32_t hi) {
+        if (hi <= lo) return lo;
+        return lo + (int32_t)(next() % (uint32_t)(hi - lo));
+    }
+};
+
+// FNV-1a over individual fields, for NetGame::netChecksum() (hashing whole
+// structs would pick up padding bytes).
+struct NetHash {
+    uint32_t value = 2166136261u;
+
+    void u32(uint32_t v) {
+        for (uint8_t i = 0; i < 4; i++, v >>= 8) value = (value ^ (v & 0xFFu)) * 16777619u;
+    }
+    void f32(float v) {
+        uint32_t u;
+        memcpy(&u, &v, 4);
+        u32(u);
+    }
+};
+
+// ---------------------------------------------------------
+// Per-frame pad input (what actually crosses the link)
+// ---------------------------------------------------------
+struct NetInput {
+    static constexpr uint8_t BTN_A = 0x01;
+    static constexpr uint8_t BTN_B = 0x02;
+    static constexpr uint8_t BTN_X = 0x04;
+    static constexpr uint8_t BTN_Y = 0x08;
+
+    uint8_t dpad = 0;     // same bits as Controller::dpad()
+    uint8_t buttons = 0;  // BTN_*
+    int8_t axisY = 0;     // left stick Y / 4 (Bluepad32 range ~[-512..511])
+    int8_t axisX = 0;     // left stick X / 4
+
+    uint32_t pack() const {
+        return (uint32_t)dpad | ((uint32_t)buttons << 8) | ((uint32_t)(uint8_t)axisY << 16) |
+               ((uint32_t)(uint8_t)axisX << 24);
+    }
+    static NetInput unpack(uint32_t v) {
+        NetInput in;
+        in.dpad = (uint8_t)(v & 0xFF);
+        in.buttons = (uint8_t)((v >> 8) & 0xFF);
+        in.axisY = (int8_t)(uint8_t)((v >> 16) & 0xFF);
+        in.axisX = (int8_t)(uint8_t)((v >> 24) & 0xFF);
+        return in;
+    }
+    bool operator==(const NetInput& o) const { return pack() == o.pack(); }
+    bool operator!=(const NetInput& o) const { return pack() != o.pack(); }
+
+    static NetInput sample(const PadState& pad);
+};
+
+/**
+ * Implemented by games that support linked play.
+ * Slots are 0..NetPlay::STATE_SLOTS-1; the game stores one full snapshot per slot.
+ */
+class NetGame {
+public:
+    virtual void netSaveState(uint8_t slot) = 0;
+    virtual void netLoadState(uint8_t slot) = 0;
+    // Advance exactly one simulation frame. `in[0]` = side 0 (left/P1), `in[1]` = side 1.
+    // `replaying` is true while re-simulating after a rollback (skip audio/effects).
+    virtual void netStep(const NetInput in[2], bool replaying) = 0;
+    // Hash of the simulated state (not cosmetics such as colours), for desync
+    // checks: equal on both cabinets once the same frames are confirmed. 0 = not provided.
+    virtual uint32_t netChecksum() const { return 0; }
+    virtual ~NetGame() {}
+};
+
+class NetPlay {
+public:
+    static constexpr uint8_t INPUT_DELAY = NETPLAY_INPUT_DELAY;
+    static constexpr uint8_t MAX_ROLLBACK = NETPLAY_MAX_ROLLBACK;
+    static constexpr uint8_t STATE_SLOTS = MAX_ROLLBACK + 2;
+    static constexpr uint8_t REDUNDANCY = 8;   // local inputs per packet (oldest unacked first)
+    static constexpr uint8_t INPUT_RING = 64;  // must exceed MAX_ROLLBACK + INPUT_DELAY + REDUNDANCY
+    static_assert(INPUT_RING > MAX_ROLLBACK + INPUT_DELAY + REDUNDANCY, "NetPlay: input ring too small");
+
+    struct Stats {
+        uint32_t framesRun = 0;       // frames simulated for the first time
+        uint32_t rollbacks = 0;       // mispredictions corrected
+        uint32_t resimFrames = 0;     // frames re-simulated by rollbacks
+        uint8_t maxRollbackDepth = 0; // deepest rollback seen (frames)
+        uint32_t stalls = 0;          // ticks spent waiting for the peer
+        uint32_t resimMaxUs = 0;      // worst rollback cost (microseconds)
+        uint32_t packetsIn = 0;
+        uint32_t packetsOut = 0;
+        uint16_t rttMs = 0;           // smoothed round trip (input -> ack)
+    };
+
+    void begin();
+    void update();
+
+    // Peer heard recently.
+    bool linked() const;
+    // 0 = left/P1, 1 = right/P2 (decided by MAC order).
+    uint8_t localSide() const { return side; }
+
+    // Session lifecycle (one per game run). Both cabinets must start the same gameId.
+    void startSession(uint8_t gameId);
+    void endSession();
+    bool sessionRunning() const { return running; }
+    bool sessionLost() const { return lost; }
+    uint32_t sessionSeed() const { return seed; }
+    uint32_t frame() const { return curFrame; }
+    // Every frame <= this was simulated with final inputs from both sides (no rollback can reach it).
+    int32_t confirmedFrame() const {
+        return (rollbackFrom <= (uint32_t)remoteConfirmed) ? (int32_t)rollbackFrom - 1 : remoteConfirmed;
+    }
+
+    /**
+     * Advance the linked game by (at most) one frame: apply any rollback, then
+     * simulate the current frame with `local` scheduled INPUT_DELAY frames ahead.
+     * Returns false when stalled waiting for the peer.
+     */
+    bool tick(NetGame& game, const NetInput& local);
+
+    const Stats& stats() const { return st; }
+
+    // Transport entry point (ESP-NOW receive callback).
+    void onPacket(const uint8_t* mac, const uint8_t* data, int len);
+
+    // Replacement transport and clock (host tests): packets go to `send()`
+    // instead of ESP-NOW and link timing uses `nowMs()`. The peer's packets are
+    // fed back through onPacket().
+    class Link {
+    public:
+        virtual uint32_t nowMs() = 0;
+        virtual void send(const uint8_t* fromMac, const uint8_t* data, int len) = 0;
+        virtual ~Link() {}
+    };
+    // Use `link` from now on, as the cabinet with WiFi MAC `mac` (decides the side).
+    void attachLink(Link* link, const uint8_t mac[6]);
+
+private:
+    enum PacketType : uint8_t { PKT_HELLO = 1, PKT_INPUT = 2 };
+    enum HelloState : uint8_t { HELLO_IDLE = 0, HELLO_WAITING = 1, HELLO_RUNNING = 2 };
+
+    struct InputSlot {
+        uint32_t frame = 0xFFFFFFFFu;
+        uint32_t input = 0;
+    };
+
+    // Received packets are queued by the radio task and drained in update()/tick().
+    static constexpr uint8_t RX_QUEUE = 8;
+    static constexpr uint8_t MAX_PACKET = 64;
+    struct RxPacket {
+        uint8_t mac[6];
+        uint8_t len;
+        uint8_t data[MAX_PACKET];
+    };
+    RxPacket rxQueue[RX_QUEUE];
+    volatile uint8_t rxHead = 0;
+    volatile uint8_t rxTail = 0;
+
+    bool started = false;
+    uint8_t myMac[6] = { 0 };
+    uint8_t peerMac[6] = { 0 };
+    bool havePeer = false;
+    uint32_t lastHeardMs = 0;
+    uint32_t lastHelloMs = 0;
+    uint32_t lastInputsMs = 0;
+    uint8_t side = 0;
+
+    // Session
+    bool requested = false;   // startSession() called (stays set while running)
+    bool running = false;
+    bool lost = false;
+    uint8_t gameId = 0;
+    uint8_t sessionId = 0;    // local nonce, echoed by the peer
+    uint8_t peerSessionId = 0;
+    uint32_t localSeed = 0;
+    uint32_t seed = 0;
+
+    uint32_t curFrame = 0;            // next frame to simulate
+    InputSlot localIn[INPUT_RING];
+    InputSlot remoteIn[INPUT_RING];
+    uint32_t usedRemote[INPUT_RING];  // remote input each simulated frame actually used
+    int32_t remoteConfirmed = -1;     // all remote inputs <= this are known
+    uint32_t lastRemoteInput = 0;     // prediction source
+    uint32_t rollbackFrom = 0xFFFFFFFFu;
+    uint32_t newestLocal = 0;
+    int32_t peerAck = -1;             // highest local frame the peer confirmed
+    uint32_t sentAtMs[INPUT_RING];
+
+    Stats st;
+
+    Link* link = nullptr; // attachLink(): replaces ESP-NOW and millis()
+
+    uint32_t nowMs() const;
+    void drainRx();
+    void handlePacket(const uint8_t* mac, const uint8_t* data, int len);
+    void sendHello();
+    void sendInputs();
+    void sendRaw(const uint8_t* data, int len);
+    void resetSessionBuffers();
+    uint32_t remoteInputFor(uint32_t f) const;
+};
+
+extern NetPlay globalNetPlay;
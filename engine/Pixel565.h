@@ -0,0 +1,370 @@
+#pragma once
+#include <Arduino.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define PIXEL565_SIMD 1
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define PIXEL565_SIMD 1
+#else
+#define PIXEL565_SIMD 0
+#endif
+
+/**
+ * Pixel565
+ * --------
+ * Shared RGB565 pixel math.
+ *
+ * - Colour helpers (constexpr, so constant colours are shaded at compile time):
+ *   scale, saturating add, 50% average, alpha blend.
+ * - Buffer kernels over uint16_t pixel arrays (trail buffers, sprite/line
+ *   buffers, offscreen layers): fill, copy, scale, addSat, avg, blend and a
+ *   per-pixel blend with an 8-bit mask through an alpha LUT.
+ *
+ * The buffer kernels run two pixels per 32-bit word (SWAR; pixel 0 in the low
+ * half). Each channel of both pixels is moved into its own 16-bit lane (R, G,
+ * B in turn), so products and sums never carry into the neighbour, and the
+ * divide by 255 is (x + (x >> 8) + 1) >> 8, exact for the products that occur
+ * (at most 63 * 255). Results are bit-identical to the colour helpers.
+ *
+ * Host builds with SSE2 or NEON (test/pixel) run the same lane math eight
+ * pixels per vector (`simd`) and hand the tail to the word kernels (`swar`).
+ * The firmware's classic ESP32 has no vector unit (PIE is ESP32-S3 only), so
+ * it always takes the word kernels.
+ *
+ * Alpha and scale factors are 0..255 (255 = source / unchanged); channels
+ * round down, like the per-game dim helpers this replaces.
+ */
+namespace Pixel565 {
+
+// ---------------------------------------------------------
+// Single colours
+// ---------------------------------------------------------
+constexpr uint16_t r5(uint16_t c) { return (uint16_t)((c >> 11) & 0x1F); }
+constexpr uint16_t g6(uint16_t c) { return (uint16_t)((c >> 5) & 0x3F); }
+constexpr uint16_t b5(uint16_t c) { return (uint16_t)(c & 0x1F); }
+constexpr uint16_t pack(uint16_t r, uint16_t g, uint16_t b) { return (uint16_t)((r << 11) | (g << 5) | b); }
+constexpr uint16_t clampTo(int v, int hi) { return (uint16_t)((v > hi) ? hi : v); }
+
+// Each channel * m / 255.
+constexpr uint16_t scale(uint16_t c, uint8_t m) {
+    return pack((uint16_t)(r5(c) * m / 255), (uint16_t)(g6(c) * m / 255), (uint16_t)(b5(c) * m / 255));
+}
+
+// Per channel a + b, clamped (additive glow).
+constexpr uint16_t addSat(uint16_t a, uint16_t b) {
+    return pack(clampTo(r5(a) + r5(b), 31), clampTo(g6(a) + g6(b), 63), clampTo(b5(a) + b5(b), 31));
+}
+
+// Per channel (a + b) / 2, rounded down.
+constexpr uint16_t avg(uint16_t a, uint16_t b) {
+    return (uint16_t)((((a ^ b) & 0xF7DEu) >> 1) + (a & b));
+}
+
+// Per channel (src * alpha + dst * (255 - alpha)) / 255.
+constexpr uint16_t blend(uint16_t dst, uint16_t src, uint8_t alpha) {
+    return pack((uint16_t)((r5(src) * alpha + r5(dst) * (255 - alpha)) / 255),
+                (uint16_t)((g6(src) * alpha + g6(dst) * (255 - alpha)) / 255),
+                (uint16_t)((b5(src) * alpha + b5(dst) * (255 - alpha)) / 255));
+}
+
+// ---------------------------------------------------------
+// Two pixels per word (SWAR)
+// ---------------------------------------------------------
+namespace swar {
+
+constexpr uint32_t LANE5 = 0x001F001Fu;
+constexpr uint32_t LANE6 = 0x003F003Fu;
+constexpr uint32_t LANE8 = 0x00FF00FFu;
+constexpr uint32_t ONES = 0x00010001u;
+
+// x / 255 in both 16-bit lanes (each lane < 65280).
+constexpr uint32_t div255(uint32_t x) { return ((x + ((x >> 8) & LANE8) + ONES) >> 8) & LANE8; }
+
+// Clamp lanes that overflowed into bit `bits` back to all-ones.
+constexpr uint32_t saturate(uint32_t x, uint8_t bits) {
+    return (x | ((x & (ONES << bits)) - ((x & (ONES << bits)) >> bits))) & ((ONES << bits) - ONES);
+}
+
+constexpr uint32_t splat(uint16_t c) { return (uint32_t)c * ONES; }
+
+constexpr uint32_t scale2(uint32_t w, uint8_t m) {
+    return (div255(((w >> 11) & LANE5) * m) << 11) | (div255(((w >> 5) & LANE6) * m) << 5) | div255((w & LANE5) * m);
+}
+
+constexpr uint32_t addSat2(uint32_t a, uint32_t b) {
+    return (saturate(((a >> 11) & LANE5) + ((b >> 11) & LANE5), 5) << 11) |
+           (saturate(((a >> 5) & LANE6) + ((b >> 5) & LANE6), 6) << 5) |
+           saturate((a & LANE5) + (b & LANE5), 5);
+}
+
+constexpr uint32_t avg2(uint32_t a, uint32_t b) { return (((a ^ b) & 0xF7DEF7DEu) >> 1) + (a & b); }
+
+constexpr uint32_t blendLane(uint32_t d, uint32_t s, uint8_t alpha, uint8_t shift, uint32_t mask) {
+    return div255(((s >> shift) & mask) * alpha + ((d >> shift) & mask) * (uint32_t)(255 - alpha)) << shift;
+}
+
+constexpr uint32_t blend2(uint32_t d, uint32_t s, uint8_t alpha) {
+    return blendLane(d, s, alpha, 11, LANE5) | blendLane(d, s, alpha, 5, LANE6) | blendLane(d, s, alpha, 0, LANE5);
+}
+
+// Word access to pixel pairs; p must be 4-byte aligned.
+inline uint32_t load(const uint16_t* p) {
+    uint32_t w;
+    memcpy(&w, __builtin_assume_aligned(p, 4), 4);
+    return w;
+}
+inline void store(uint16_t* p, uint32_t w) { memcpy(__builtin_assume_aligned(p, 4), &w, 4); }
+
+// Pair from two halves, for a source that is not aligned like the destination.
+inline uint32_t loadHalves(const uint16_t* p) { return (uint32_t)p[0] | ((uint32_t)p[1] << 16); }
+
+inline bool aligned(const void* p) { return ((uintptr_t)p & 3u) == 0; }
+
+/**
+ * dst[i] = px(dst[i], src[i]) for n pixels, two at a time through word(d, s).
+ * dst is aligned first (one scalar pixel); src is read as words when it then
+ * lines up too, as halves otherwise.
+ */
+template <typename Word, typename Px>
+inline void zip(uint16_t* dst, const uint16_t* src, size_t n, Word word, Px px) {
+    if (n > 0 && !aligned(dst)) {
+        *dst = px(*dst, *src);
+        dst++;
+        src++;
+        n--;
+    }
+    size_t i = 0;
+    if (aligned(src)) {
+        for (; i + 2 <= n; i += 2) store(dst + i, word(load(dst + i), load(src + i)));
+    } else {
+        for (; i + 2 <= n; i += 2) store(dst + i, word(load(dst + i), loadHalves(src + i)));
+    }
+    if (i < n) dst[i] = px(dst[i], src[i]);
+}
+
+// dst[i] = px(dst[i]) in place.
+template <typename Word, typename Px>
+inline void map(uint16_t* dst, size_t n, Word word, Px px) {
+    if (n > 0 && !aligned(dst)) {
+        *dst = px(*dst);
+        dst++;
+        n--;
+    }
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) store(dst + i, word(load(dst + i)));
+    if (i < n) dst[i] = px(dst[i]);
+}
+
+// Buffer kernels, word path only (see the unprefixed ones below).
+inline void fill(uint16_t* dst, size_t n, uint16_t c) {
+    const uint32_t w = splat(c);
+    map(dst, n, [w](uint32_t) { return w; }, [c](uint16_t) { return c; });
+}
+
+inline void scale(uint16_t* dst, size_t n, uint8_t m) {
+    map(dst, n, [m](uint32_t w) { return scale2(w, m); }, [m](uint16_t c) { return Pixel565::scale(c, m); });
+}
+
+inline void addSat(uint16_t* dst, const uint16_t* src, size_t n) {
+    zip(dst, src, n, addSat2, [](uint16_t d, uint16_t s) { return Pixel565::addSat(d, s); });
+}
+
+inline void avg(uint16_t* dst, const uint16_t* src, size_t n) {
+    zip(dst, src, n, avg2, [](uint16_t d, uint16_t s) { return Pixel565::avg(d, s); });
+}
+
+inline void blend(uint16_t* dst, const uint16_t* src, size_t n, uint8_t alpha) {
+    zip(dst, src, n, [alpha](uint32_t d, uint32_t s) { return blend2(d, s, alpha); },
+        [alpha](uint16_t d, uint16_t s) { return Pixel565::blend(d, s, alpha); });
+}
+
+// Masks are mostly flat (0 outside a sprite, 255 inside, a soft edge), so
+// pairs with one alpha take the word path and 0 / 255 skip the math.
+inline void blendMask(uint16_t* dst, const uint16_t* src, const uint8_t* mask, size_t n, const uint8_t* lut) {
+    size_t i = 0;
+    if (n > 0 && !aligned(dst)) {
+        dst[0] = Pixel565::blend(dst[0], src[0], lut ? lut[mask[0]] : mask[0]);
+        i = 1;
+    }
+    const bool srcAligned = aligned(src + i);
+    for (; i + 2 <= n; i += 2) {
+        const uint8_t a0 = lut ? lut[mask[i]] : mask[i];
+        const uint8_t a1 = lut ? lut[mask[i + 1]] : mask[i + 1];
+        if (a0 != a1) {
+            dst[i] = Pixel565::blend(dst[i], src[i], a0);
+            dst[i + 1] = Pixel565::blend(dst[i + 1], src[i + 1], a1);
+        } else if (a0 == 255) {
+            dst[i] = src[i];
+            dst[i + 1] = src[i + 1];
+        } else if (a0 != 0) {
+            const uint32_t s = srcAligned ? load(src + i) : loadHalves(src + i);
+            store(dst + i, blend2(load(dst + i), s, a0));
+        }
+    }
+    if (i < n) dst[i] = Pixel565::blend(dst[i], src[i], lut ? lut[mask[i]] : mask[i]);
+}
+
+} // namespace swar
+
+// ---------------------------------------------------------
+// Eight pixels per vector (host SSE2 / NEON)
+// ---------------------------------------------------------
+#if PIXEL565_SIMD
+namespace simd {
+
+// Unaligned 8 x uint16 loads/stores and the lane ops the kernels need.
+#if defined(__SSE2__)
+using V = __m128i;
+inline V load(const uint16_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+inline void store(uint16_t* p, V v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+inline V splat(uint16_t c) { return _mm_set1_epi16((short)c); }
+template <int K> inline V shr(V v) { return _mm_srli_epi16(v, K); }
+template <int K> inline V shl(V v) { return _mm_slli_epi16(v, K); }
+inline V andV(V a, V b) { return _mm_and_si128(a, b); }
+inline V orV(V a, V b) { return _mm_or_si128(a, b); }
+inline V xorV(V a, V b) { return _mm_xor_si128(a, b); }
+inline V add(V a, V b) { return _mm_add_epi16(a, b); }
+inline V mul(V a, V b) { return _mm_mullo_epi16(a, b); }
+inline V minV(V a, V b) { return _mm_min_epi16(a, b); } // lanes stay below 0x8000
+inline V alphas(const uint8_t* a) {
+    return _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(a)), _mm_setzero_si128());
+}
+#else
+using V = uint16x8_t;
+inline V load(const uint16_t* p) { return vld1q_u16(p); }
+inline void store(uint16_t* p, V v) { vst1q_u16(p, v); }
+inline V splat(uint16_t c) { return vdupq_n_u16(c); }
+template <int K> inline V shr(V v) { return vshrq_n_u16(v, K); }
+template <int K> inline V shl(V v) { return vshlq_n_u16(v, K); }
+inline V andV(V a, V b) { return vandq_u16(a, b); }
+inline V orV(V a, V b) { return vorrq_u16(a, b); }
+inline V xorV(V a, V b) { return veorq_u16(a, b); }
+inline V add(V a, V b) { return vaddq_u16(a, b); }
+inline V mul(V a, V b) { return vmulq_u16(a, b); }
+inline V minV(V a, V b) { return vminq_u16(a, b); }
+inline V alphas(const uint8_t* a) { return vmovl_u8(vld1_u8(a)); }
+#endif
+
+constexpr size_t LANES = 8;
+
+inline V r5(V v) { return shr<11>(v); }
+inline V g6(V v) { return andV(shr<5>(v), splat(0x3F)); }
+inline V b5(V v) { return andV(v, splat(0x1F)); }
+inline V pack(V r, V g, V b) { return orV(orV(shl<11>(r), shl<5>(g)), b); }
+inline V div255(V x) { return shr<8>(add(add(x, shr<8>(x)), splat(1))); }
+
+inline V scale8(V v, V m) { return pack(div255(mul(r5(v), m)), div255(mul(g6(v), m)), div255(mul(b5(v), m))); }
+
+inline V addSat8(V a, V b) {
+    return pack(minV(add(r5(a), r5(b)), splat(31)), minV(add(g6(a), g6(b)), splat(63)),
+                minV(add(b5(a), b5(b)), splat(31)));
+}
+
+inline V avg8(V a, V b) { return add(shr<1>(andV(xorV(a, b), splat(0xF7DE))), andV(a, b)); }
+
+// `ia` = 255 - alpha, per lane.
+inline V blend8(V d, V s, V a, V ia) {
+    return pack(div255(add(mul(r5(s), a), mul(r5(d), ia))), div255(add(mul(g6(s), a), mul(g6(d), ia))),
+                div255(add(mul(b5(s), a), mul(b5(d), ia))));
+}
+
+inline void scale(uint16_t* dst, size_t n, uint8_t m) {
+    const V mv = splat(m);
+    size_t i = 0;
+    for (; i + LANES <= n; i += LANES) store(dst + i, scale8(load(dst + i), mv));
+    swar::scale(dst + i, n - i, m);
+}
+
+inline void addSat(uint16_t* dst, const uint16_t* src, size_t n) {
+    size_t i = 0;
+    for (; i + LANES <= n; i += LANES) store(dst + i, addSat8(load(dst + i), load(src + i)));
+    swar::addSat(dst + i, src + i, n - i);
+}
+
+inline void avg(uint16_t* dst, const uint16_t* src, size_t n) {
+    size_t i = 0;
+    for (; i + LANES <= n; i += LANES) store(dst + i, avg8(load(dst + i), load(src + i)));
+    swar::avg(dst + i, src + i, n - i);
+}
+
+inline void blend(uint16_t* dst, const uint16_t* src, size_t n, uint8_t alpha) {
+    const V a = splat(alpha), ia = splat((uint16_t)(255 - alpha));
+    size_t i = 0;
+    for (; i + LANES <= n; i += LANES) store(dst + i, blend8(load(dst + i), load(src + i), a, ia));
+    swar::blend(dst + i, src + i, n - i, alpha);
+}
+
+// Eight alphas at a time; a run that is all 0 is skipped, all 255 copied.
+inline void blendMask(uint16_t* dst, const uint16_t* src, const uint8_t* mask, size_t n, const uint8_t* lut) {
+    size_t i = 0;
+    for (; i + LANES <= n; i += LANES) {
+        uint8_t a8[LANES];
+        if (lut) {
+            for (size_t k = 0; k < LANES; k++) a8[k] = lut[mask[i + k]];
+        } else {
+            memcpy(a8, mask + i, LANES);
+        }
+        uint64_t run;
+        memcpy(&run, a8, sizeof(run));
+        if (run == 0) continue;
+        if (run == ~(uint64_t)0) {
+            memcpy(dst + i, src + i, LANES * sizeof(uint16_t));
+            continue;
+        }
+        const V a = alphas(a8);
+        store(dst + i, blend8(load(dst + i), load(src + i), a, xorV(a, splat(0xFF))));
+    }
+    swar::blendMask(dst + i, src + i, mask + i, n - i, lut);
+}
+
+} // namespace simd
+#endif
+
+// ---------------------------------------------------------
+// Buffer kernels
+// ---------------------------------------------------------
+// Widest path this build has: simd when PIXEL565_SIMD, else swar.
+#if PIXEL565_SIMD
+namespace kernels = simd;
+#else
+namespace kernels = swar;
+#endif
+
+inline void fill(uint16_t* dst, size_t n, uint16_t c) { swar::fill(dst, n, c); }
+
+inline void copy(uint16_t* dst, const uint16_t* src, size_t n) { memcpy(dst, src, n * sizeof(uint16_t)); }
+
+inline void scale(uint16_t* dst, size_t n, uint8_t m) {
+    if (m == 255) return;
+    if (m == 0) {
+        fill(dst, n, 0);
+        return;
+    }
+    kernels::scale(dst, n, m);
+}
+
+// dst = addSat(dst, src)
+inline void addSat(uint16_t* dst, const uint16_t* src, size_t n) { kernels::addSat(dst, src, n); }
+
+// dst = avg(dst, src)
+inline void avg(uint16_t* dst, const uint16_t* src, size_t n) { kernels::avg(dst, src, n); }
+
+// dst = blend(dst, src, alpha)
+inline void blend(uint16_t* dst, const uint16_t* src, size_t n, uint8_t alpha) {
+    if (alpha == 0) return;
+    if (alpha == 255) {
+        copy(dst, src, n);
+        return;
+    }
+    kernels::blend(dst, src, n, alpha);
+}
+
+// dst[i] = blend(dst[i], src[i], lut[mask[i]]) (lut == nullptr: alpha = mask).
+inline void blendMask(uint16_t* dst, const uint16_t* src, const uint8_t* mask, size_t n, const uint8_t* lut = nullptr) {
+    kernels::blendMask(dst, src, mask, n, lut);
+}
+
+} // namespace Pixel565
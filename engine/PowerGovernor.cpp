@@ -0,0 +1,131 @@
+#include "PowerGovernor.h"
+#include "ControllerManager.h"
+#include "Trace.h"
+
+#if defined(CONFIG_PM_ENABLE)
+#include <esp_pm.h>
+#include <esp_idf_version.h>
+#endif
+
+PowerGovernor globalPower;
+
+namespace {
+
+// Stick deflection that counts as input (drifting sticks stay below it).
+constexpr int16_t STICK_INPUT = PadState::AXIS_MAX / 2;
+
+void applyCpuMhz(uint16_t mhz) {
+#if defined(CONFIG_PM_ENABLE)
+    // Pin the clock through the power manager when the core has it, so its
+    // locks (Bluetooth, APB users) stay in charge of the details.
+#if ESP_IDF_VERSION_MAJOR >= 5
+    esp_pm_config_t cfg = {};
+#else
+    esp_pm_config_esp32_t cfg = {};
+#endif
+    cfg.max_freq_mhz = mhz;
+    cfg.min_freq_mhz = mhz;
+    cfg.light_sleep_enable = false;
+    if (esp_pm_configure(&cfg) != ESP_OK) setCpuFrequencyMhz(mhz);
+#else
+    setCpuFrequencyMhz(mhz);
+#endif
+    // CCOUNT now ticks at the new rate; trace timestamps follow it.
+    Trace::noteCpuClock((uint16_t)ESP.getCpuFreqMHz());
+}
+
+#if DEBUG_POWER
+uint8_t clockIndex(uint16_t mhz) { return (mhz >= 240) ? 0 : (mhz >= 160) ? 1 : 2; }
+
+const char* const ACTIVITY_NAMES[Power::ACT_COUNT] = { "game", "ambient", "menu", "no pad" };
+const uint16_t CLOCK_MHZ[3] = { 240, 160, 80 };
+const uint16_t CLOCK_MW[3] = { POWER_EST_MW_240, POWER_EST_MW_160, POWER_EST_MW_80 };
+#endif
+
+} // namespace
+
+void PowerGovernor::begin(uint32_t nowMs) {
+    lastInputMs = nowMs;
+    current = Power::FULL;
+    applyCpuMhz(current.cpuMhz);
+#if DEBUG_POWER
+    lastAccountMs = nowMs;
+    lastReportMs = nowMs;
+#endif
+}
+
+void PowerGovernor::sampleInput(ControllerManager* input, uint32_t nowMs) {
+    if (!input) return;
+    const int connected = input->getConnectedCount();
+    bool active = connected != lastConnected;
+    lastConnected = connected;
+    for (int i = 0; i < MAX_GAMEPADS && !active; i++) {
+        const PadState& p = input->pad(i);
+        if (!p.connected) continue;
+        if (p.pressed || p.dpadPressed || p.dpad) active = true;
+        else if (abs(p.axisX) > STICK_INPUT || abs(p.axisY) > STICK_INPUT) active = true;
+    }
+    if (active) noteInput(nowMs);
+}
+
+void PowerGovernor::noteInput(uint32_t nowMs) {
+    lastInputMs = nowMs;
+    update(activity, nowMs);
+}
+
+void PowerGovernor::update(Power::Activity a, uint32_t nowMs) {
+#if DEBUG_POWER
+    account(nowMs);
+#endif
+    activity = a;
+    const Power::Plan next = Power::decide(a, (uint32_t)(nowMs - lastInputMs));
+    if (next != current) apply(next);
+}
+
+uint32_t PowerGovernor::capInterval(uint32_t intervalMs) const {
+    if (current.maxRenderFps == 0) return intervalMs;
+    return max(intervalMs, (uint32_t)(1000UL / current.maxRenderFps));
+}
+
+void PowerGovernor::apply(const Power::Plan& p) {
+    if (p.cpuMhz != current.cpuMhz) applyCpuMhz(p.cpuMhz);
+    current = p;
+}
+
+#if DEBUG_POWER
+void PowerGovernor::account(uint32_t nowMs) {
+    msIn[activity][clockIndex(current.cpuMhz)] += (uint32_t)(nowMs - lastAccountMs);
+    lastAccountMs = nowMs;
+    if ((uint32_t)(nowMs - lastReportMs) >= (uint32_t)POWER_REPORT_MS) {
+        report();
+        lastReportMs = nowMs;
+    }
+}
+
+void PowerGovernor::report() {
+    uint32_t totalMs = 0;
+    for (uint8_t a = 0; a < Power::ACT_COUNT; a++)
+        for (uint8_t c = 0; c < 3; c++) totalMs += msIn[a][c];
+    if (totalMs == 0) return;
+
+    // mWh per hour in a state = its average power in mW.
+    uint64_t allMwMs = 0;
+    for (uint8_t a = 0; a < Power::ACT_COUNT; a++) {
+        uint32_t ms = 0;
+        uint64_t mwMs = 0;
+        uint64_t mhzMs = 0;
+        for (uint8_t c = 0; c < 3; c++) {
+            ms += msIn[a][c];
+            mwMs += (uint64_t)msIn[a][c] * CLOCK_MW[c];
+            mhzMs += (uint64_t)msIn[a][c] * CLOCK_MHZ[c];
+        }
+        allMwMs += mwMs;
+        if (ms == 0) continue;
+        Serial.printf("[Power] %-8s %3lu%% of time, avg %3lu MHz, ~%lu mWh/h\n", ACTIVITY_NAMES[a],
+                      (unsigned long)((uint64_t)ms * 100u / totalMs), (unsigned long)(mhzMs / ms),
+                      (unsigned long)(mwMs / ms));
+    }
+    Serial.printf("[Power] overall ~%lu mWh/h (full clock: %u)\n", (unsigned long)(allMwMs / totalMs),
+                  (unsigned)POWER_EST_MW_240);
+}
+#endif
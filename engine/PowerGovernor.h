@@ -0,0 +1,109 @@
+#pragma once
+#include <Arduino.h>
+#include "config.h"
+
+class ControllerManager;
+
+/**
+ * PowerGovernor
+ * -------------
+ * Drops the CPU clock, the render rate and the loop's polling rate while the
+ * screen on show is idle: menus nobody touches, ambient apps (LavaLamp,
+ * MatrixRain), the NO GAMEPAD screen and its attract demo. Any pad input puts
+ * the full-speed plan back before that frame is handled.
+ *
+ * The HUB75 refresh itself is fixed when the DMA driver starts; what scales
+ * here is how often the sketch redraws and presents.
+ *
+ * Power::decide() is the whole policy, as a pure function of (activity, time
+ * since the last input). The sketch reports the activity every loop via
+ * update(); the governor applies the resulting plan when it changes.
+ *
+ * DEBUG_POWER: time is accounted per activity and clock, and every
+ * POWER_REPORT_MS an estimated energy per hour by activity is printed
+ * (POWER_EST_MW_* are rough module figures, panel LEDs not included).
+ */
+namespace Power {
+
+enum Activity : uint8_t {
+    ACT_GAME = 0,       // a game in play
+    ACT_AMBIENT,        // ambient app or attract demo
+    ACT_MENU,           // menus, pause, game-over screens
+    ACT_NO_CONTROLLER,  // waiting for a pad
+    ACT_COUNT
+};
+
+struct Plan {
+    uint16_t cpuMhz;        // 240 / 160 / 80
+    uint16_t maxRenderFps;  // 0 = no cap beyond the state's own
+    uint8_t loopDelayMs;    // delay at the end of loop()
+
+    bool operator==(const Plan& o) const {
+        return cpuMhz == o.cpuMhz && maxRenderFps == o.maxRenderFps && loopDelayMs == o.loopDelayMs;
+    }
+    bool operator!=(const Plan& o) const { return !(*this == o); }
+};
+
+static constexpr Plan FULL = { 240, 0, 1 };
+
+inline Plan decide(Activity a, uint32_t msSinceInput) {
+#if ENABLE_POWER_GOVERNOR
+    const bool idle = msSinceInput >= (uint32_t)POWER_IDLE_AFTER_MS;
+    switch (a) {
+        case ACT_GAME:
+            return FULL;
+        case ACT_AMBIENT:
+            // Still animating: keep enough clock for the effect, cap the redraws.
+            return idle ? Plan{ 160, POWER_AMBIENT_IDLE_FPS, 5 } : FULL;
+        case ACT_MENU:
+            return idle ? Plan{ 80, POWER_MENU_IDLE_FPS, 10 } : FULL;
+        case ACT_NO_CONTROLLER:
+            // Nobody can give input; the pairing screen blinks at 2 Hz.
+            return Plan{ 80, 0, 20 };
+        default:
+            return FULL;
+    }
+#else
+    (void)a;
+    (void)msSinceInput;
+    return FULL;
+#endif
+}
+
+} // namespace Power
+
+class PowerGovernor {
+public:
+    void begin(uint32_t nowMs);
+
+    // Pad activity (button/dpad edges, sticks off centre, pads coming or going)
+    // counts as input; re-applies the plan right away.
+    void sampleInput(ControllerManager* input, uint32_t nowMs);
+    void noteInput(uint32_t nowMs);
+
+    void update(Power::Activity a, uint32_t nowMs);
+
+    const Power::Plan& plan() const { return current; }
+
+    // A state's render interval, stretched to the plan's fps cap.
+    uint32_t capInterval(uint32_t intervalMs) const;
+
+private:
+    Power::Plan current = Power::FULL;
+    Power::Activity activity = Power::ACT_MENU;
+    uint32_t lastInputMs = 0;
+    int lastConnected = -1;
+
+    void apply(const Power::Plan& p);
+
+#if DEBUG_POWER
+    // ms per activity at each clock (index: 240 / 160 / 80 MHz).
+    uint32_t msIn[Power::ACT_COUNT][3] = {};
+    uint32_t lastAccountMs = 0;
+    uint32_t lastReportMs = 0;
+    void account(uint32_t nowMs);
+    void report();
+#endif
+};
+
+extern PowerGovernor globalPower;
@@ -0,0 +1,70 @@
+#include "QualityGovernor.h"
+
+QualityGovernor globalQuality;
+
+namespace {
+
+// Moving average weight of a new frame: 1 / 2^AVG_SHIFT.
+constexpr uint8_t AVG_SHIFT = 2;
+
+// Frames after a level change before the counters run again.
+constexpr uint16_t SETTLE_FRAMES = (uint16_t)(QUALITY_DROP_FRAMES * 2);
+
+} // namespace
+
+void QualityGovernor::reset(uint16_t targetFps) {
+    intervalUs = 1000000UL / (uint32_t)max<uint16_t>(1, targetFps);
+    budget = intervalUs / 100u * QUALITY_BUDGET_PCT;
+    raiseBelowUs = intervalUs / 100u * QUALITY_RAISE_PCT;
+    pendingUs = 0;
+    avgUs = 0;
+    overFrames = 0;
+    underFrames = 0;
+    settleFrames = 0;
+    currentLevel = MAX_LEVEL;
+    primed = false;
+}
+
+void QualityGovernor::endFrame() {
+    const uint32_t work = pendingUs;
+    pendingUs = 0;
+#if ENABLE_QUALITY_GOVERNOR
+    if (intervalUs == 0) return;
+    if (!primed) {
+        avgUs = work;
+        primed = true;
+    } else {
+        avgUs = avgUs - (avgUs >> AVG_SHIFT) + (work >> AVG_SHIFT);
+    }
+
+    if (settleFrames > 0) {
+        settleFrames--;
+        return;
+    }
+
+    if (avgUs > budget) {
+        underFrames = 0;
+        if (++overFrames >= QUALITY_DROP_FRAMES && currentLevel > 0) setLevel((uint8_t)(currentLevel - 1));
+    } else if (avgUs < raiseBelowUs) {
+        overFrames = 0;
+        if (++underFrames >= QUALITY_RAISE_FRAMES && currentLevel < MAX_LEVEL) setLevel((uint8_t)(currentLevel + 1));
+    } else {
+        // Inside the dead band: hold.
+        overFrames = 0;
+        underFrames = 0;
+    }
+#else
+    (void)work;
+#endif
+}
+
+void QualityGovernor::setLevel(uint8_t lvl) {
+#if DEBUG_QUALITY
+    Serial.printf("[Quality] level %u -> %u (avg %lu us, budget %lu us)\n", (unsigned)currentLevel, (unsigned)lvl,
+                  (unsigned long)avgUs, (unsigned long)budget);
+#endif
+    currentLevel = lvl;
+    overFrames = 0;
+    underFrames = 0;
+    settleFrames = SETTLE_FRAMES;
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <Arduino.h>
+#include "config.h"
+
+/**
+ * QualityGovernor
+ * ---------------
+ * Keeps a game's update()+draw() time inside a share of its frame interval
+ * (preferredRenderFps()) by stepping a quality level between 0 and
+ * QUALITY_MAX_LEVEL. Games read the level to size optional work: particle
+ * bursts, background layers, effect columns, AI lookahead. Gameplay must not
+ * depend on it.
+ *
+ * The host sketch feeds it:
+ * - addWork(us) after every update() and draw() of the running game;
+ * - endFrame() after each rendered frame (sums the work since the last one
+ *   into a moving average);
+ * - reset() when a game starts (back to full quality).
+ *
+ * Hysteresis: the level drops after QUALITY_DROP_FRAMES frames in a row over
+ * budget, and rises after QUALITY_RAISE_FRAMES frames in a row under
+ * QUALITY_RAISE_PCT of the interval. After every change the counters are
+ * held for a settle window so the average catches up with the new load.
+ */
+class QualityGovernor {
+public:
+    static constexpr uint8_t MAX_LEVEL = QUALITY_MAX_LEVEL;
+
+    void reset(uint16_t targetFps);
+
+    void addWork(uint32_t us) { pendingUs += us; }
+    void endFrame();
+
+    uint8_t level() const { return currentLevel; }
+
+    // `full` at MAX_LEVEL down to `minimum` at level 0, linear in between.
+    uint16_t scale(uint16_t full, uint16_t minimum = 1) const {
+        if (full <= minimum) return full;
+        return (uint16_t)(minimum + (uint32_t)(full - minimum) * currentLevel / MAX_LEVEL);
+    }
+
+    uint32_t averageUs() const { return avgUs; }
+    uint32_t budgetUs() const { return budget; }
+
+private:
+    uint32_t intervalUs = 0;
+    uint32_t budget = 0;
+    uint32_t raiseBelowUs = 0;
+    uint32_t pendingUs = 0;
+    uint32_t avgUs = 0;
+    uint16_t overFrames = 0;
+    uint16_t underFrames = 0;
+    uint16_t settleFrames = 0;
+    uint8_t currentLevel = MAX_LEVEL;
+    bool primed = false;
+
+    void setLevel(uint8_t lvl);
+};
+
+extern QualityGovernor globalQuality;
@@ -0,0 +1,308 @@
+#pragma once
+#include <Arduino.h>
+#include <ESP32-HUB75-MatrixPanel-I2S-DMA.h>
+#include "config.h"
+
+/**
+ * Raster
+ * ------
+ * Drop-in replacements for the Adafruit GFX primitives the games use, drawn as
+ * panel spans instead of pixels.
+ *
+ * GFX lines and circles go through writePixel() once per pixel, and each
+ * pixel is clipped again. Here every primitive clips once against the panel
+ * and emits runs: a run of pixels with the same y becomes one drawFastHLine(),
+ * a run with the same x becomes one drawFastVLine() (single pixels fall back to
+ * drawPixel()). The pixels are the same as GFX's: line() keeps its Bresenham
+ * error term (it can start in the middle of a line), and circle(),
+ * fillCircle() and fillTriangle() follow GFX's stepping.
+ */
+namespace Raster {
+
+// ---------------------------------------------------------
+// Spans (inclusive ends, any order, clipped)
+// ---------------------------------------------------------
+inline void hspan(MatrixPanel_I2S_DMA* d, int x0, int x1, int y, uint16_t c) {
+    if (y < 0 || y >= PANEL_RES_Y) return;
+    if (x0 > x1) { const int t = x0; x0 = x1; x1 = t; }
+    if (x0 < 0) x0 = 0;
+    if (x1 >= PANEL_RES_X) x1 = PANEL_RES_X - 1;
+    if (x0 > x1) return;
+    if (x0 == x1) d->drawPixel(x0, y, c);
+    else d->drawFastHLine(x0, y, x1 - x0 + 1, c);
+}
+
+inline void vspan(MatrixPanel_I2S_DMA* d, int x, int y0, int y1, uint16_t c) {
+    if (x < 0 || x >= PANEL_RES_X) return;
+    if (y0 > y1) { const int t = y0; y0 = y1; y1 = t; }
+    if (y0 < 0) y0 = 0;
+    if (y1 >= PANEL_RES_Y) y1 = PANEL_RES_Y - 1;
+    if (y0 > y1) return;
+    if (y0 == y1) d->drawPixel(x, y0, c);
+    else d->drawFastVLine(x, y0, y1 - y0 + 1, c);
+}
+
+// Rectangle outline (same edges as GFX drawRect()).
+inline void rect(MatrixPanel_I2S_DMA* d, int x, int y, int w, int h, uint16_t c) {
+    if (w <= 0 || h <= 0) return;
+    hspan(d, x, x + w - 1, y, c);
+    hspan(d, x, x + w - 1, y + h - 1, c);
+    vspan(d, x, y, y + h - 1, c);
+    vspan(d, x + w - 1, y, y + h - 1, c);
+}
+
+/**
+ * Horizontal dashes starting at x: `on` pixels drawn, `off` skipped, over w
+ * pixels. on = off = 1 is the dotted HUD divider.
+ */
+inline void dashedHLine(MatrixPanel_I2S_DMA* d, int x, int y, int w, uint16_t c, uint8_t on = 1, uint8_t off = 1) {
+    if (y < 0 || y >= PANEL_RES_Y || w <= 0 || on == 0) return;
+    const int period = on + off;
+    const int end = min(x + w, PANEL_RES_X);
+    int start = x;
+    // First dash that can reach the panel.
+    if (start < 0) start += ((-start) / period) * period;
+    for (; start < end; start += period) hspan(d, start, min(start + on, end) - 1, y, c);
+}
+
+// ---------------------------------------------------------
+// Lines
+// ---------------------------------------------------------
+namespace Detail {
+
+// Emits runs along the major axis: rows for shallow lines, columns for steep
+// ones (coordinates are swapped back here).
+struct RunEmitter {
+    MatrixPanel_I2S_DMA* d;
+    bool steep;
+    uint16_t c;
+    int runMinor = 0;
+    int runStart = 0;
+    int runEnd = -1;
+
+    void add(int major, int minor) {
+        if (runEnd >= runStart && minor == runMinor && major == runEnd + 1) { runEnd = major; return; }
+        flush();
+        runMinor = minor;
+        runStart = runEnd = major;
+    }
+
+    void flush() {
+        if (runEnd < runStart) return;
+        if (steep) vspan(d, runMinor, runStart, runEnd, c);
+        else hspan(d, runStart, runEnd, runMinor, c);
+        runEnd = runStart - 1;
+    }
+};
+
+// ceil(a / b) for b > 0.
+inline int32_t ceilDiv(int32_t a, int32_t b) { return (a >= 0) ? (a + b - 1) / b : -((-a) / b); }
+// floor(a / b) for b > 0.
+inline int32_t floorDiv(int32_t a, int32_t b) { return (a >= 0) ? a / b : -((-a + b - 1) / b); }
+
+} // namespace Detail
+
+/**
+ * Line from (x0, y0) to (x1, y1), both ends included. Same pixels as GFX
+ * drawLine(): major axis walked left to right, error term starting at dx/2.
+ *
+ * Clip once: after i steps the minor axis has moved k(i) = ceil((i*dy - dx/2) / dx)
+ * times (k >= 0), so the visible step range comes out of the panel bounds
+ * directly and the walk starts there.
+ */
+inline void line(MatrixPanel_I2S_DMA* d, int x0, int y0, int x1, int y1, uint16_t c) {
+    const bool steep = abs(y1 - y0) > abs(x1 - x0);
+    if (steep) {
+        int t = x0; x0 = y0; y0 = t;
+        t = x1; x1 = y1; y1 = t;
+    }
+    if (x0 > x1) {
+        int t = x0; x0 = x1; x1 = t;
+        t = y0; y0 = y1; y1 = t;
+    }
+    // (x = major, y = minor) from here on.
+    const int32_t dx = x1 - x0;
+    const int32_t dy = abs(y1 - y0);
+    const int ystep = (y0 < y1) ? 1 : -1;
+    const int32_t half = dx / 2;
+    const int majorLimit = steep ? PANEL_RES_Y : PANEL_RES_X;
+    const int minorLimit = steep ? PANEL_RES_X : PANEL_RES_Y;
+
+    // Steps i in [0, dx] whose major coordinate is on the panel.
+    int32_t iFirst = max<int32_t>(0, -x0);
+    int32_t iLast = min<int32_t>(dx, (int32_t)majorLimit - 1 - x0);
+    if (iFirst > iLast) return;
+
+    // Minor axis bounds as a step range: k(i) in [kLo, kHi].
+    if (dy > 0) {
+        const int32_t kLo = (ystep > 0) ? -y0 : y0 - (minorLimit - 1);
+        const int32_t kHi = (ystep > 0) ? (minorLimit - 1) - y0 : y0;
+        if (kHi < 0) return;
+        // k(i) >= K  <=>  i*dy > (K-1)*dx + half
+        if (kLo > 0) iFirst = max<int32_t>(iFirst, Detail::floorDiv((kLo - 1) * dx + half, dy) + 1);
+        // k(i) <= K  <=>  i*dy <= K*dx + half
+        iLast = min<int32_t>(iLast, Detail::floorDiv(kHi * dx + half, dy));
+        if (iFirst > iLast) return;
+    } else if (y0 < 0 || y0 >= minorLimit) {
+        return;
+    }
+
+    // Bresenham state at step iFirst.
+    const int32_t k = (dy > 0) ? max<int32_t>(0, Detail::ceilDiv(iFirst * dy - half, dx)) : 0;
+    int32_t err = half - iFirst * dy + k * dx;
+    int y = y0 + ystep * (int)k;
+
+    Detail::RunEmitter out{d, steep, c};
+    for (int32_t i = iFirst; i <= iLast; i++) {
+        out.add(x0 + (int)i, y);
+        err -= dy;
+        if (err < 0) {
+            y += ystep;
+            err += dx;
+        }
+    }
+    out.flush();
+}
+
+inline void triangle(MatrixPanel_I2S_DMA* d, int x0, int y0, int x1, int y1, int x2, int y2, uint16_t c) {
+    line(d, x0, y0, x1, y1, c);
+    line(d, x1, y1, x2, y2, c);
+    line(d, x2, y2, x0, y0, c);
+}
+
+// ---------------------------------------------------------
+// Circles
+// ---------------------------------------------------------
+namespace Detail {
+
+/**
+ * Walks GFX's midpoint circle (one octant, from (0, r) until x >= y) and calls
+ * fn(v, a, b) once per distinct y value v with the x range [a, b] that octant
+ * covers at that y. The other octants are mirrors of it.
+ */
+template <typename Fn>
+inline void circleRuns(int r, Fn fn) {
+    int f = 1 - r;
+    int ddFx = 1;
+    int ddFy = -2 * r;
+    int x = 0;
+    int y = r;
+    int runStart = 0;
+    while (x < y) {
+        if (f >= 0) {
+            fn(y, runStart, x);
+            y--;
+            ddFy += 2;
+            f += ddFy;
+            runStart = x + 1;
+        }
+        x++;
+        ddFx += 2;
+        f += ddFx;
+    }
+    fn(y, runStart, x);
+}
+
+} // namespace Detail
+
+// Circle outline (same pixels as GFX drawCircle()).
+inline void circle(MatrixPanel_I2S_DMA* d, int cx, int cy, int r, uint16_t c) {
+    if (r < 0) return;
+    if (cx + r < 0 || cx - r >= PANEL_RES_X || cy + r < 0 || cy - r >= PANEL_RES_Y) return;
+    Detail::circleRuns(r, [&](int v, int a, int b) {
+        // Top/bottom octants: rows cy +- v, columns +-[a, b] (one span when a == 0).
+        // Left/right octants: the transpose, as columns.
+        if (a == 0) {
+            hspan(d, cx - b, cx + b, cy - v, c);
+            hspan(d, cx - b, cx + b, cy + v, c);
+            vspan(d, cx - v, cy - b, cy + b, c);
+            vspan(d, cx + v, cy - b, cy + b, c);
+            return;
+        }
+        hspan(d, cx + a, cx + b, cy - v, c);
+        hspan(d, cx - b, cx - a, cy - v, c);
+        hspan(d, cx + a, cx + b, cy + v, c);
+        hspan(d, cx - b, cx - a, cy + v, c);
+        vspan(d, cx + v, cy + a, cy + b, c);
+        vspan(d, cx + v, cy - b, cy - a, c);
+        vspan(d, cx - v, cy + a, cy + b, c);
+        vspan(d, cx - v, cy - b, cy - a, c);
+    });
+}
+
+/**
+ * Filled circle (same pixels as GFX fillCircle()), one span per row: rows
+ * cy +- x get half-width y from the steep octant, rows cy +- v the widest x
+ * of the flat octant (for rows the steep octant has not covered).
+ */
+inline void fillCircle(MatrixPanel_I2S_DMA* d, int cx, int cy, int r, uint16_t c) {
+    if (r < 0) return;
+    if (cx + r < 0 || cx - r >= PANEL_RES_X || cy + r < 0 || cy - r >= PANEL_RES_Y) return;
+    int lastSideRow = -1;
+    Detail::circleRuns(r, [&](int v, int a, int b) {
+        for (int x = a; x <= b; x++) {
+            if (x == 0) hspan(d, cx - v, cx + v, cy, c);
+            else {
+                hspan(d, cx - v, cx + v, cy - x, c);
+                hspan(d, cx - v, cx + v, cy + x, c);
+            }
+            lastSideRow = x;
+        }
+    });
+    Detail::circleRuns(r, [&](int v, int a, int b) {
+        (void)a;
+        if (v <= lastSideRow) return;
+        hspan(d, cx - b, cx + b, cy - v, c);
+        hspan(d, cx - b, cx + b, cy + v, c);
+    });
+}
+
+// ---------------------------------------------------------
+// Filled triangle
+// ---------------------------------------------------------
+/**
+ * Same pixels as GFX fillTriangle(): rows from the top vertex down, the two
+ * edge x positions interpolated with integer accumulators. Rows outside the
+ * panel are not walked; the accumulators jump straight to the first visible row.
+ */
+inline void fillTriangle(MatrixPanel_I2S_DMA* d, int x0, int y0, int x1, int y1, int x2, int y2, uint16_t c) {
+    // Sort by y (y0 <= y1 <= y2)
+    if (y0 > y1) { int t = y0; y0 = y1; y1 = t; t = x0; x0 = x1; x1 = t; }
+    if (y1 > y2) { int t = y2; y2 = y1; y1 = t; t = x2; x2 = x1; x1 = t; }
+    if (y0 > y1) { int t = y0; y0 = y1; y1 = t; t = x0; x0 = x1; x1 = t; }
+    if (y2 < 0 || y0 >= PANEL_RES_Y) return;
+
+    if (y0 == y2) {
+        // Single row
+        int a = x0, b = x0;
+        if (x1 < a) a = x1; else if (x1 > b) b = x1;
+        if (x2 < a) a = x2; else if (x2 > b) b = x2;
+        hspan(d, a, b, y0, c);
+        return;
+    }
+
+    const int32_t dx01 = x1 - x0, dy01 = y1 - y0;
+    const int32_t dx02 = x2 - x0, dy02 = y2 - y0;
+    const int32_t dx12 = x2 - x1, dy12 = y2 - y1;
+
+    // Upper part: rows y0..last (y1 included only for a flat bottom edge).
+    const int last = (y1 == y2) ? y1 : y1 - 1;
+    int y = max(y0, 0);
+    const int upperEnd = min(last, PANEL_RES_Y - 1);
+    for (; y <= upperEnd; y++) {
+        const int32_t sa = dx01 * (y - y0);
+        const int32_t sb = dx02 * (y - y0);
+        hspan(d, x0 + (int)(sa / dy01), x0 + (int)(sb / dy02), y, c);
+    }
+
+    // Lower part: rows last+1..y2.
+    y = max(last + 1, 0);
+    const int lowerEnd = min(y2, PANEL_RES_Y - 1);
+    for (; y <= lowerEnd; y++) {
+        const int32_t sa = dx12 * (y - y1);
+        const int32_t sb = dx02 * (y - y0);
+        hspan(d, x1 + (int)(sa / dy12), x0 + (int)(sb / dy02), y, c);
+    }
+}
+
+} // namespace Raster
@@ -0,0 +1,152 @@
+#include "ResumeStore.h"
+#include "Snapshot.h"
+#include "MemPolicy.h"
+#include <Preferences.h>
+
+namespace ResumeStore {
+
+// NVS keys (namespace "resume"): slot (u8), base (blob), delta (blob).
+static const char* NS = "resume";
+
+// What is in flash, without the blobs. The blobs are read into scratch taken
+// from the heap (PSRAM when fitted) only while save()/restore() run, so the
+// store costs no RAM between checkpoints.
+static size_t gBaseLen = 0;
+static size_t gDeltaLen = 0;
+static uint32_t gDeltaHash = 0; // of the delta in flash; 0 = unknown (rewrite next time)
+static int gSlot = -1;
+static bool gLoaded = false;
+
+// base | current | delta, one RESUME_MAX_BYTES region each.
+struct Scratch {
+  uint8_t* p;
+  Scratch() : p((uint8_t*)Mem::tryAlloc(3 * RESUME_MAX_BYTES, Mem::EXTERNAL_BULK)) {}
+  ~Scratch() { Mem::release(p); }
+  Scratch(const Scratch&) = delete;
+  Scratch& operator=(const Scratch&) = delete;
+  uint8_t* region(int i) { return p + (size_t)i * RESUME_MAX_BYTES; }
+};
+
+static uint32_t hashBytes(const uint8_t* p, size_t n) {
+  uint32_t h = 2166136261u;
+  for (size_t i = 0; i < n; i++) h = (h ^ p[i]) * 16777619u;
+  return h ? h : 1u;
+}
+
+static void loadMeta() {
+  if (gLoaded) return;
+  gLoaded = true;
+  Preferences prefs;
+  if (!prefs.begin(NS, true)) return;
+  const int slot = prefs.isKey("slot") ? (int)prefs.getUChar("slot", 0xFF) : -1;
+  const size_t baseLen = prefs.isKey("base") ? prefs.getBytesLength("base") : 0;
+  const size_t deltaLen = prefs.isKey("delta") ? prefs.getBytesLength("delta") : 0;
+  if (slot >= 0 && slot != 0xFF && baseLen > 0 && baseLen <= RESUME_MAX_BYTES && deltaLen <= RESUME_MAX_BYTES) {
+    gSlot = slot;
+    gBaseLen = baseLen;
+    gDeltaLen = deltaLen;
+  }
+  prefs.end();
+}
+
+bool save(uint8_t slot, const GameBase& game) {
+  loadMeta();
+  Scratch s;
+  if (!s.p) return false;
+  uint8_t* base = s.region(0);
+  uint8_t* cur = s.region(1);
+  uint8_t* delta = s.region(2);
+  const size_t len = Snapshot::capture(game, cur, RESUME_MAX_BYTES);
+  if (len == 0) return false;
+
+  const uint32_t t0 = micros();
+  Preferences prefs;
+  if (!prefs.begin(NS, false)) return false;
+
+  bool ok = true;
+  const char* wrote = "none";
+  size_t dLen = 0;
+  if ((int)slot == gSlot && gBaseLen > 0 && prefs.getBytes("base", base, RESUME_MAX_BYTES) == gBaseLen) {
+    dLen = Snapshot::encodeDelta(base, gBaseLen, cur, len, delta, RESUME_MAX_BYTES);
+  }
+  if (dLen > 0 && dLen <= len / 2) {
+    const uint32_t h = hashBytes(delta, dLen);
+    if (dLen != gDeltaLen || h != gDeltaHash) {
+      ok = prefs.putBytes("delta", delta, dLen) == dLen;
+      gDeltaLen = ok ? dLen : 0;
+      gDeltaHash = ok ? h : 0;
+      wrote = "delta";
+    }
+  } else {
+    // New game, or drifted too far from the base: rewrite the base.
+    if (prefs.isKey("delta")) prefs.remove("delta");
+    gDeltaLen = 0;
+    gDeltaHash = 0;
+    ok = prefs.putBytes("base", cur, len) == len;
+    gBaseLen = ok ? len : 0;
+    if (ok && (int)slot != gSlot) ok = prefs.putUChar("slot", slot) == 1;
+    gSlot = ok ? (int)slot : -1;
+    wrote = "base";
+  }
+  prefs.end();
+
+  #if DEBUG_RESUME
+  Serial.printf("[Resume] save slot=%u full=%u wrote=%s delta=%u us=%lu ok=%d\n",
+                (unsigned)slot, (unsigned)len, wrote, (unsigned)gDeltaLen,
+                (unsigned long)(micros() - t0), (int)ok);
+  #else
+  (void)t0;
+  (void)wrote;
+  #endif
+  return ok;
+}
+
+int peekSlot() {
+  loadMeta();
+  return gSlot;
+}
+
+bool restore(GameBase& game) {
+  loadMeta();
+  if (gSlot < 0) return false;
+  Scratch s;
+  if (!s.p) return false;
+  uint8_t* base = s.region(0);
+  uint8_t* out = s.region(1);
+  uint8_t* delta = s.region(2);
+
+  Preferences prefs;
+  if (!prefs.begin(NS, true)) return false;
+  bool ok = prefs.getBytes("base", base, RESUME_MAX_BYTES) == gBaseLen;
+  if (ok && gDeltaLen > 0) ok = prefs.getBytes("delta", delta, RESUME_MAX_BYTES) == gDeltaLen;
+  prefs.end();
+
+  size_t len = gBaseLen;
+  const uint8_t* src = base;
+  if (ok && gDeltaLen > 0) {
+    gDeltaHash = hashBytes(delta, gDeltaLen);
+    len = Snapshot::applyDelta(base, gBaseLen, delta, gDeltaLen, out, RESUME_MAX_BYTES);
+    src = out;
+  }
+  ok = ok && (len > 0) && Snapshot::restore(game, src, len);
+  #if DEBUG_RESUME
+  Serial.printf("[Resume] restore slot=%d bytes=%u ok=%d\n", gSlot, (unsigned)len, (int)ok);
+  #endif
+  return ok;
+}
+
+void clear() {
+  loadMeta();
+  if (gSlot < 0 && gBaseLen == 0) return;
+  Preferences prefs;
+  if (prefs.begin(NS, false)) {
+    prefs.clear();
+    prefs.end();
+  }
+  gSlot = -1;
+  gBaseLen = 0;
+  gDeltaLen = 0;
+  gDeltaHash = 0;
+}
+
+} // namespace ResumeStore
@@ -0,0 +1,37 @@
+#pragma once
+#include <Arduino.h>
+#include "config.h"
+#include "GameBase.h"
+
+/**
+ * ResumeStore
+ * -----------
+ * Keeps the running game's latest snapshot in NVS so a reboot or power blip
+ * can drop the player back into it (see engine/Snapshot.h).
+ *
+ * Flash wear: the first save stores a full "base" snapshot; later saves store
+ * only a delta against that base. The base is rewritten when the delta grows
+ * past half a full snapshot. Saves that change nothing are skipped.
+ *
+ * RAM: nothing between calls. save()/restore() borrow 3 x RESUME_MAX_BYTES of
+ * scratch (PSRAM when fitted, else internal heap) and return it.
+ *
+ * Cost: save() is an NVS read plus one blob write, and a write that needs a
+ * page erase can stall for tens of milliseconds. The sketch therefore saves
+ * only where the game is stopped anyway (pause menu, pad dropped), never on a
+ * timer during play.
+ */
+namespace ResumeStore {
+  // Store a snapshot of `game` (a no-op for games without snapshot support).
+  // `slot` is the menu entry that recreates the game on boot.
+  bool save(uint8_t slot, const GameBase& game);
+
+  // Menu slot of the stored game, or -1 if there is nothing to resume.
+  int peekSlot();
+
+  // Load the stored snapshot into a freshly started game of that slot.
+  bool restore(GameBase& game);
+
+  // Forget the stored game (game over, quit to menu).
+  void clear();
+}
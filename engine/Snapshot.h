@@ -0,0 +1,309 @@
+#pragma once
+#include <Arduino.h>
+#include "GameBase.h"
+
+/**
+ * Snapshot
+ * --------
+ * Compact binary game-state snapshots (instant resume after a reboot/power blip).
+ *
+ * Layout of a full snapshot:
+ *   'G' 'S' format gameVersion  tag[4]  payloadLen[2]  checksum[2]  payload...
+ * - `tag` is an FNV-1a hash of the game's leaderboardId(), so a snapshot is never
+ *   loaded into the wrong game.
+ * - `gameVersion` is GameBase::snapshotVersion(); games bump it whenever the
+ *   payload layout changes and old snapshots are then simply ignored.
+ *
+ * Payload encoding is up to each game, using SnapshotWriter/SnapshotReader:
+ * little-endian scalars, a bit packer for small fields, byte-run RLE for sparse
+ * grids and `time()` for millis() stamps (stored relative to "now" and rebased
+ * on load, so timers keep running correctly after a reboot).
+ *
+ * Deltas: `encodeDelta()` XORs a snapshot against a previous one and stores only
+ * the changed byte runs. Consecutive snapshots of a running game differ in a few
+ * cells, so this is what gets written to flash most of the time (ResumeStore).
+ */
+
+class SnapshotWriter {
+public:
+    SnapshotWriter(uint8_t* buf, size_t cap) : buf(buf), cap(cap) {}
+
+    void u8(uint8_t v) { flushBits(); put(v); }
+    void u16(uint16_t v) { u8((uint8_t)v); u8((uint8_t)(v >> 8)); }
+    void u32(uint32_t v) { u16((uint16_t)v); u16((uint16_t)(v >> 16)); }
+    void i16(int16_t v) { u16((uint16_t)v); }
+    void i32(int32_t v) { u32((uint32_t)v); }
+    void f32(float v) { uint32_t u; memcpy(&u, &v, 4); u32(u); }
+    void boolean(bool v) { bits(v ? 1u : 0u, 1); }
+
+    void bytes(const void* src, size_t n) {
+        flushBits();
+        const uint8_t* p = (const uint8_t*)src;
+        for (size_t i = 0; i < n; i++) put(p[i]);
+    }
+
+    // Small unsigned fields, LSB first. Byte-level writes start on a fresh byte.
+    void bits(uint32_t v, uint8_t n) {
+        for (uint8_t i = 0; i < n; i++) {
+            if (bitCount == 8) flushBits();
+            if (v & (1u << i)) bitAcc |= (uint8_t)(1u << bitCount);
+            bitCount++;
+        }
+    }
+
+    // Byte-run RLE: [count-1][value] pairs, runs of up to 256. Good for grids that
+    // are mostly empty (trails, boards, tile maps).
+    void rle(const uint8_t* src, size_t n) {
+        flushBits();
+        size_t i = 0;
+        while (i < n) {
+            const uint8_t v = src[i];
+            size_t run = 1;
+            while (i + run < n && run < 256 && src[i + run] == v) run++;
+            put((uint8_t)(run - 1));
+            put(v);
+            i += run;
+        }
+    }
+
+    // millis() timestamp. 0 ("unset" in most games) survives as 0.
+    void time(uint32_t t) {
+        if (t == 0) { i32(INT32_MIN); return; }
+        int32_t rel = (int32_t)(t - (uint32_t)millis());
+        if (rel == INT32_MIN) rel++;
+        i32(rel);
+    }
+
+    size_t size() { flushBits(); return pos; }
+    bool ok() const { return !overflow; }
+
+private:
+    uint8_t* buf;
+    size_t cap;
+    size_t pos = 0;
+    bool overflow = false;
+    uint8_t bitAcc = 0;
+    uint8_t bitCount = 0;
+
+    void put(uint8_t v) {
+        if (pos < cap) buf[pos++] = v;
+        else overflow = true;
+    }
+    void flushBits() {
+        if (bitCount == 0) return;
+        put(bitAcc);
+        bitAcc = 0;
+        bitCount = 0;
+    }
+};
+
+class SnapshotReader {
+public:
+    SnapshotReader(const uint8_t* buf, size_t len) : buf(buf), len(len) {}
+
+    uint8_t u8() { bitCount = 0; return get(); }
+    uint16_t u16() { const uint16_t lo = u8(); return (uint16_t)(lo | ((uint16_t)u8() << 8)); }
+    uint32_t u32() { const uint32_t lo = u16(); return lo | ((uint32_t)u16() << 16); }
+    int16_t i16() { return (int16_t)u16(); }
+    int32_t i32() { return (int32_t)u32(); }
+    float f32() { const uint32_t u = u32(); float v; memcpy(&v, &u, 4); return v; }
+    bool boolean() { return bits(1) != 0; }
+
+    void bytes(void* dst, size_t n) {
+        bitCount = 0;
+        uint8_t* p = (uint8_t*)dst;
+        for (size_t i = 0; i < n; i++) p[i] = get();
+    }
+
+    uint32_t bits(uint8_t n) {
+        uint32_t v = 0;
+        for (uint8_t i = 0; i < n; i++) {
+            if (bitCount == 0) { bitAcc = get(); bitCount = 8; }
+            if (bitAcc & (1u << (8 - bitCount))) v |= (1u << i);
+            bitCount--;
+        }
+        return v;
+    }
+
+    void rle(uint8_t* dst, size_t n) {
+        bitCount = 0;
+        size_t i = 0;
+        while (i < n && !underflow) {
+            const size_t run = (size_t)get() + 1;
+            const uint8_t v = get();
+            if (i + run > n) { underflow = true; return; }
+            memset(dst + i, v, run);
+            i += run;
+        }
+    }
+
+    uint32_t time() {
+        const int32_t rel = i32();
+        if (rel == INT32_MIN) return 0;
+        const uint32_t t = (uint32_t)millis() + (uint32_t)rel;
+        return t ? t : 1;
+    }
+
+    // Range-checked enum/index helper: out-of-range values mark the snapshot bad.
+    uint8_t below(uint8_t limit) {
+        const uint8_t v = u8();
+        if (v >= limit) underflow = true;
+        return v;
+    }
+
+    bool ok() const { return !underflow; }
+    bool atEnd() const { return pos == len; }
+
+private:
+    const uint8_t* buf;
+    size_t len;
+    size_t pos = 0;
+    bool underflow = false;
+    uint8_t bitAcc = 0;
+    uint8_t bitCount = 0;
+
+    uint8_t get() {
+        if (pos < len) return buf[pos++];
+        underflow = true;
+        return 0;
+    }
+};
+
+namespace Snapshot {
+
+static constexpr uint8_t FORMAT = 1;
+static constexpr size_t HEADER_SIZE = 12;
+
+inline uint32_t fnv1a(const char* s) {
+    uint32_t h = 2166136261u;
+    while (*s) { h ^= (uint8_t)*s++; h *= 16777619u; }
+    return h;
+}
+
+// Fletcher-16 over the payload (cheap, catches torn/partial writes).
+inline uint16_t checksum(const uint8_t* p, size_t n) {
+    uint16_t a = 0, b = 0;
+    for (size_t i = 0; i < n; i++) {
+        a = (uint16_t)((a + p[i]) % 255);
+        b = (uint16_t)((b + a) % 255);
+    }
+    return (uint16_t)((b << 8) | a);
+}
+
+/**
+ * Serialize `game` into `buf` (header + payload). Returns total bytes, or 0 if
+ * the game does not support snapshots or the buffer is too small.
+ */
+inline size_t capture(const GameBase& game, uint8_t* buf, size_t cap) {
+    const uint8_t version = game.snapshotVersion();
+    if (version == 0 || cap <= HEADER_SIZE) return 0;
+    SnapshotWriter w(buf + HEADER_SIZE, cap - HEADER_SIZE);
+    game.saveSnapshot(w);
+    const size_t payload = w.size();
+    if (!w.ok() || payload > 0xFFFF) return 0;
+
+    const uint32_t tag = fnv1a(game.leaderboardId());
+    const uint16_t sum = checksum(buf + HEADER_SIZE, payload);
+    buf[0] = 'G';
+    buf[1] = 'S';
+    buf[2] = FORMAT;
+    buf[3] = version;
+    memcpy(&buf[4], &tag, 4);
+    buf[8] = (uint8_t)payload;
+    buf[9] = (uint8_t)(payload >> 8);
+    buf[10] = (uint8_t)sum;
+    buf[11] = (uint8_t)(sum >> 8);
+    return HEADER_SIZE + payload;
+}
+
+/**
+ * Validate a full snapshot and load it into `game`. On failure the game may be
+ * partially overwritten; callers restart it (start()) in that case.
+ */
+inline bool restore(GameBase& game, const uint8_t* buf, size_t len) {
+    if (len < HEADER_SIZE || buf[0] != 'G' || buf[1] != 'S' || buf[2] != FORMAT) return false;
+    if (buf[3] == 0 || buf[3] != game.snapshotVersion()) return false;
+    uint32_t tag;
+    memcpy(&tag, &buf[4], 4);
+    if (tag != fnv1a(game.leaderboardId())) return false;
+    const size_t payload = (size_t)buf[8] | ((size_t)buf[9] << 8);
+    if (HEADER_SIZE + payload != len) return false;
+    if (checksum(buf + HEADER_SIZE, payload) != (uint16_t)(buf[10] | (buf[11] << 8))) return false;
+
+    SnapshotReader r(buf + HEADER_SIZE, payload);
+    return game.loadSnapshot(r) && r.ok() && r.atEnd();
+}
+
+// -----------------------------
+// Delta encoding (XOR + zero-run skipping)
+// -----------------------------
+// delta := varint(curLen) { varint(skip) varint(count) count*(cur ^ base) }
+// Bytes past the end of `base` are XORed against 0.
+namespace detail {
+inline bool putVar(uint8_t* out, size_t cap, size_t& pos, uint32_t v) {
+    do {
+        if (pos >= cap) return false;
+        out[pos++] = (uint8_t)((v & 0x7F) | (v > 0x7F ? 0x80 : 0));
+        v >>= 7;
+    } while (v);
+    return true;
+}
+inline bool getVar(const uint8_t* in, size_t len, size_t& pos, uint32_t& v) {
+    v = 0;
+    for (uint8_t shift = 0; shift < 32; shift += 7) {
+        if (pos >= len) return false;
+        const uint8_t b = in[pos++];
+        v |= (uint32_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+inline uint8_t at(const uint8_t* p, size_t n, size_t i) { return (i < n) ? p[i] : 0; }
+} // namespace detail
+
+// Returns the delta size, or 0 if it would not fit in `cap`.
+inline size_t encodeDelta(const uint8_t* base, size_t baseLen, const uint8_t* cur, size_t curLen,
+                          uint8_t* out, size_t cap) {
+    size_t pos = 0;
+    if (!detail::putVar(out, cap, pos, (uint32_t)curLen)) return 0;
+    size_t i = 0;
+    while (i < curLen) {
+        const size_t skipStart = i;
+        while (i < curLen && cur[i] == detail::at(base, baseLen, i)) i++;
+        if (i == curLen) break;
+        // A literal run ends at the next stretch of >= 3 unchanged bytes (cheaper to skip).
+        const size_t litStart = i;
+        size_t same = 0;
+        while (i < curLen && same < 3) {
+            same = (cur[i] == detail::at(base, baseLen, i)) ? same + 1 : 0;
+            i++;
+        }
+        const size_t litEnd = i - same;
+        i = litEnd;
+        if (!detail::putVar(out, cap, pos, (uint32_t)(litStart - skipStart))) return 0;
+        if (!detail::putVar(out, cap, pos, (uint32_t)(litEnd - litStart))) return 0;
+        if (pos + (litEnd - litStart) > cap) return 0;
+        for (size_t k = litStart; k < litEnd; k++) out[pos++] = (uint8_t)(cur[k] ^ detail::at(base, baseLen, k));
+    }
+    return pos;
+}
+
+// Rebuilds the snapshot `delta` was made from. Returns its size, or 0 on a malformed delta.
+inline size_t applyDelta(const uint8_t* base, size_t baseLen, const uint8_t* delta, size_t deltaLen,
+                         uint8_t* out, size_t cap) {
+    size_t pos = 0;
+    uint32_t curLen;
+    if (!detail::getVar(delta, deltaLen, pos, curLen) || curLen > cap) return 0;
+    for (size_t i = 0; i < curLen; i++) out[i] = detail::at(base, baseLen, i);
+    size_t i = 0;
+    while (pos < deltaLen) {
+        uint32_t skip, count;
+        if (!detail::getVar(delta, deltaLen, pos, skip) || !detail::getVar(delta, deltaLen, pos, count)) return 0;
+        i += skip;
+        if (i + count > curLen || pos + count > deltaLen) return 0;
+        for (uint32_t k = 0; k < count; k++) out[i++] ^= delta[pos++];
+    }
+    return curLen;
+}
+
+} // namespace Snapshot
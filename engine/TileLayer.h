@@ -0,0 +1,307 @@
+#pragma once
+#include <Arduino.h>
+#include <ESP32-HUB75-MatrixPanel-I2S-DMA.h>
+#include "config.h"
+#include "Trace.h"
+#include "Pixel565.h"
+
+/**
+ * TileLayer
+ * ---------
+ * Packed tile sets and scrolling tile layers, drawn as horizontal spans.
+ *
+ * Format: tiles are up to 16 px wide, 2 bits per pixel (0 = transparent,
+ * 1..3 = palette entry), one uint32_t per tile row (pixel x at bits 2x..2x+1).
+ * `PackedTiles` builds that at compile time from readable byte arrays.
+ *
+ * Drawing never goes pixel by pixel to the panel: `SpanWriter` merges
+ * neighbouring pixels of the same colour - across tile boundaries too - into
+ * one drawFastHLine() per run. A layer row costs one wrap (modulo) for the
+ * first visible map column; after that the walk is [first..mapW) then [0..),
+ * i.e. two straight spans of the map row.
+ *
+ * Free-moving sprites use `SpriteRuns` instead: the same 0..3 bitmaps, cut into
+ * runs of one palette index at compile time, so a sprite row is one clipped
+ * span per run. `Palette` shades a base colour into entries 1..3, also at
+ * compile time when the colour is constant.
+ */
+namespace TileGfx {
+
+static constexpr uint8_t MAX_TILE_W = 16;
+
+constexpr uint16_t rgb565(uint8_t r, uint8_t g, uint8_t b) {
+    return (uint16_t)(((uint16_t)(r & 0xF8) << 8) | ((uint16_t)(g & 0xFC) << 3) | (b >> 3));
+}
+
+/**
+ * Sprite palette: entries 1..3 are `base` scaled by m1..m3, entry 0 is unused
+ * (transparent).
+ *   static constexpr TileGfx::Palette RED_SHIP(COLOR_RED, 80, 160, 255);
+ */
+struct Palette {
+    uint16_t c[4];
+
+    constexpr Palette() : c{ 0, 0, 0, 0 } {}
+    constexpr Palette(uint16_t base, uint8_t m1, uint8_t m2, uint8_t m3)
+        : c{ 0, Pixel565::scale(base, m1), Pixel565::scale(base, m2), Pixel565::scale(base, m3) } {}
+
+    operator const uint16_t*() const { return c; }
+};
+
+/**
+ * N tiles of W x H pixels (source: one byte per pixel, values 0..3), packed.
+ *   inline constexpr TileGfx::PackedTiles<3, 4, 4> CELL_TILES_PACKED(CELL_TILES_4);
+ */
+template <int N, int H, int W>
+struct PackedTiles {
+    static_assert(W >= 1 && W <= MAX_TILE_W, "TileGfx: tiles are at most 16 px wide");
+    uint32_t rows[N * H] = {};
+
+    constexpr PackedTiles(const uint8_t (&src)[N][H][W]) {
+        for (int t = 0; t < N; t++) {
+            for (int y = 0; y < H; y++) {
+                uint32_t bits = 0;
+                for (int x = 0; x < W; x++) bits |= (uint32_t)(src[t][y][x] & 3u) << (2 * x);
+                rows[t * H + y] = bits;
+            }
+        }
+    }
+};
+
+/**
+ * Horizontal run of one palette index inside a sprite row.
+ */
+struct Run {
+    uint8_t x;
+    uint8_t len;
+    uint8_t v;  // 1..3
+};
+
+template <typename Px>
+constexpr int countRunsOf(int n, int h, int w, Px px) {
+    int runs = 0;
+    for (int t = 0; t < n; t++) {
+        for (int y = 0; y < h; y++) {
+            uint8_t prev = 0;
+            for (int x = 0; x < w; x++) {
+                const uint8_t v = (uint8_t)(px(t, y, x) & 3u);
+                if (v && v != prev) runs++;
+                prev = v;
+            }
+        }
+    }
+    return (runs > 0) ? runs : 1;
+}
+
+// Run count of a sprite sheet (the R argument of SpriteRuns).
+template <int N, int H, int W>
+constexpr int countRuns(const uint8_t (&src)[N][H][W]) {
+    return countRunsOf(N, H, W, [&](int t, int y, int x) { return src[t][y][x]; });
+}
+template <int H, int W>
+constexpr int countRuns(const uint8_t (&src)[H][W]) {
+    return countRunsOf(1, H, W, [&](int, int y, int x) { return src[y][x]; });
+}
+
+/**
+ * N sprites of W x H pixels (one byte per pixel, 0..3) as runs, built at
+ * compile time. Sprite t, row y owns runs[rowStart[t * H + y] .. rowStart[t * H + y + 1]).
+ *   static constexpr int SHIP_RUN_COUNT = TileGfx::countRuns(SHIP_SPRITE);
+ *   static constexpr TileGfx::SpriteRuns<1, 5, 5, SHIP_RUN_COUNT> SHIP_RUNS(SHIP_SPRITE);
+ */
+template <int N, int H, int W, int R>
+struct SpriteRuns {
+    static_assert(W >= 1 && W <= 255, "TileGfx: sprite rows are at most 255 px");
+    Run runs[R] = {};
+    uint16_t rowStart[N * H + 1] = {};
+
+    constexpr SpriteRuns(const uint8_t (&src)[N][H][W]) {
+        build([&](int t, int y, int x) { return src[t][y][x]; });
+    }
+    constexpr SpriteRuns(const uint8_t (&src)[H][W]) {
+        build([&](int, int y, int x) { return src[y][x]; });
+    }
+
+private:
+    template <typename Px>
+    constexpr void build(Px px) {
+        int n = 0;
+        for (int t = 0; t < N; t++) {
+            for (int y = 0; y < H; y++) {
+                rowStart[t * H + y] = (uint16_t)n;
+                uint8_t prev = 0;
+                for (int x = 0; x < W; x++) {
+                    const uint8_t v = (uint8_t)(px(t, y, x) & 3u);
+                    if (v && v == prev) {
+                        runs[n - 1].len++;
+                    } else if (v) {
+                        runs[n].x = (uint8_t)x;
+                        runs[n].len = 1;
+                        runs[n].v = v;
+                        n++;
+                    }
+                    prev = v;
+                }
+            }
+        }
+        rowStart[N * H] = (uint16_t)n;
+    }
+};
+
+struct SpriteSet {
+    const Run* runs;
+    const uint16_t* rowStart;  // count * h + 1 entries
+    uint8_t h;
+    uint8_t count;
+
+    template <int N, int H, int W, int R>
+    constexpr SpriteSet(const SpriteRuns<N, H, W, R>& s)
+        : runs(s.runs), rowStart(s.rowStart), h((uint8_t)H), count((uint8_t)N) {}
+};
+
+struct TileSet {
+    const uint32_t* rows;  // count * h packed rows
+    uint8_t w;
+    uint8_t h;
+    uint8_t count;
+
+    uint32_t row(uint8_t tile, uint8_t y) const { return rows[(uint16_t)tile * h + y]; }
+};
+
+/**
+ * Collects pixels of one screen row into runs, clipped to [x0, x1).
+ * Pixels must be pushed left to right.
+ */
+class SpanWriter {
+public:
+    SpanWriter(MatrixPanel_I2S_DMA* d, int y, int x0 = 0, int x1 = PANEL_RES_X) : d(d), y(y), x0(x0), x1(x1) {}
+    ~SpanWriter() { flush(); }
+
+    void pixel(int x, uint16_t color) {
+        if (x < x0 || x >= x1) return;
+        if (len > 0 && x == start + len && color == runColor) { len++; return; }
+        flush();
+        start = x;
+        len = 1;
+        runColor = color;
+    }
+
+    // One packed tile row at screen x (transparent pixels break runs).
+    void tileRow(uint32_t bits, int w, int x, const uint16_t* palette) {
+        for (int i = 0; bits != 0 && i < w; i++, bits >>= 2) {
+            const uint8_t v = (uint8_t)(bits & 3u);
+            if (v) pixel(x + i, palette[v]);
+        }
+    }
+
+    void flush() {
+        if (len == 0 || !d) return;
+        if (len == 1) d->drawPixel(start, y, runColor);
+        else d->drawFastHLine(start, y, len, runColor);
+        len = 0;
+    }
+
+private:
+    MatrixPanel_I2S_DMA* d;
+    int y;
+    int x0, x1;
+    int start = 0;
+    int len = 0;
+    uint16_t runColor = 0;
+};
+
+/**
+ * Sprite at (x, y), clipped to the panel: one span per run, colour palette[v].
+ */
+inline void drawSprite(MatrixPanel_I2S_DMA* d, const SpriteSet& set, uint8_t sprite, int x, int y,
+                       const uint16_t* palette) {
+    if (sprite >= set.count || x >= PANEL_RES_X) return;
+    const uint16_t* rowStart = &set.rowStart[(uint16_t)sprite * set.h];
+    for (uint8_t ty = 0; ty < set.h; ty++) {
+        const int py = y + ty;
+        if (py < 0 || py >= PANEL_RES_Y) continue;
+        for (uint16_t i = rowStart[ty]; i < rowStart[ty + 1]; i++) {
+            const Run& r = set.runs[i];
+            int x0 = x + r.x;
+            int x1 = x0 + r.len;  // exclusive
+            if (x0 < 0) x0 = 0;
+            if (x1 > PANEL_RES_X) x1 = PANEL_RES_X;
+            if (x0 >= x1) continue;
+            if (x1 - x0 == 1) d->drawPixel(x0, py, palette[r.v]);
+            else d->drawFastHLine(x0, py, x1 - x0, palette[r.v]);
+        }
+    }
+}
+
+/**
+ * A map of tile indices drawn into a screen rectangle with a scroll offset.
+ * Scroll is in pixels; the map repeats on wrapping axes and is empty elsewhere.
+ */
+struct TileLayer {
+    const TileSet* set = nullptr;
+    const uint8_t* map = nullptr;  // mapW * mapH tile indices, row-major
+    uint8_t mapW = 0;
+    uint8_t mapH = 0;
+    bool wrapX = false;
+    bool wrapY = false;
+    int16_t scrollX = 0;
+    int16_t scrollY = 0;
+    // Screen rectangle
+    int16_t viewX = 0;
+    int16_t viewY = 0;
+    int16_t viewW = PANEL_RES_X;
+    int16_t viewH = PANEL_RES_Y;
+    const uint16_t* palette = nullptr;  // 4 entries, [0] unused
+
+    static int wrap(int v, int n) {
+        v %= n;
+        return (v < 0) ? v + n : v;
+    }
+
+    void draw(MatrixPanel_I2S_DMA* d) const {
+        TRACE_SCOPE("TileLayer.draw");
+        if (!set || !map || !palette || mapW == 0 || mapH == 0) return;
+        const int tw = set->w;
+        const int th = set->h;
+        const int pxW = mapW * tw;
+        const int pxH = mapH * th;
+        const int clipX0 = max(0, (int)viewX);
+        const int clipX1 = min(PANEL_RES_X, (int)viewX + viewW);
+        const int clipY0 = max(0, (int)viewY);
+        const int clipY1 = min(PANEL_RES_Y, (int)viewY + viewH);
+        if (clipX0 >= clipX1) return;
+
+        for (int sy = clipY0; sy < clipY1; sy++) {
+            int my = sy - viewY + scrollY;
+            if (wrapY) my = wrap(my, pxH);
+            else if (my < 0 || my >= pxH) continue;
+            const uint8_t* mapRow = &map[(my / th) * mapW];
+            const uint8_t ty = (uint8_t)(my % th);
+
+            // First map pixel column under the left clip edge.
+            int mx = clipX0 - viewX + scrollX;
+            int sx = clipX0;
+            if (wrapX) mx = wrap(mx, pxW);
+            else if (mx < 0) { sx -= mx; mx = 0; }
+            int col = mx / tw;
+            sx -= mx % tw; // screen x of that tile's left edge (may be left of the clip)
+
+            SpanWriter span(d, sy, clipX0, clipX1);
+            while (sx < clipX1) {
+                if (col >= mapW) {
+                    if (!wrapX) break;
+                    col = 0;
+                }
+                const uint8_t tile = mapRow[col];
+                if (tile < set->count) {
+                    const uint32_t bits = set->row(tile, ty);
+                    if (bits) span.tileRow(bits, tw, sx, palette);
+                }
+                sx += tw;
+                col++;
+            }
+        }
+    }
+};
+
+} // namespace TileGfx
@@ -0,0 +1,154 @@
+#include "Trace.h"
+
+namespace Trace {
+
+#if ENABLE_TRACE
+
+namespace {
+
+Event ring[CAPACITY];
+
+// Cores the JSON is split by (tid); CCOUNT is per core.
+constexpr uint8_t MAX_CORES = 2;
+
+const char* const CLOCK_EVENT_NAME = "cpu clock";
+
+void writeText(Print& out, const char* s) {
+    out.write((const uint8_t*)s, strlen(s));
+}
+
+uint16_t currentMhz() {
+    uint16_t mhz = Detail::cpuMhz.load(std::memory_order_relaxed);
+    if (mhz == 0) {
+        mhz = (uint16_t)ESP.getCpuFreqMHz();
+        Detail::cpuMhz.store(mhz, std::memory_order_relaxed);
+    }
+    return mhz;
+}
+
+void push(const char* name, uint32_t start, uint32_t cycles, bool clockChange, uint16_t mhz) {
+    const uint32_t i = Detail::head.fetch_add(1, std::memory_order_relaxed) & (CAPACITY - 1);
+    Event& e = ring[i];
+    e.name.store(nullptr, std::memory_order_relaxed);
+    e.start = start;
+    e.cycles = cycles;
+    e.core = (uint8_t)xPortGetCoreID();
+    e.clockChange = clockChange;
+    e.mhz = mhz;
+    e.name.store(name, std::memory_order_release);
+}
+
+} // namespace
+
+void Detail::record(const char* name, uint32_t start, uint32_t cycles) {
+    push(name, start, cycles, false, currentMhz());
+}
+
+void noteCpuClock(uint16_t mhz) {
+    if (mhz == 0) return;
+    const uint16_t was = currentMhz();
+    Detail::cpuMhz.store(mhz, std::memory_order_relaxed);
+    // The instant carries the old rate: the cycles leading up to it ran at that clock.
+    if (isRecording() && mhz != was) push(CLOCK_EVENT_NAME, ESP.getCycleCount(), mhz, true, was);
+}
+
+void setRecording(bool on) {
+    Detail::recording.store(on, std::memory_order_relaxed);
+}
+
+void clear() {
+    const bool was = isRecording();
+    setRecording(false);
+    for (uint32_t i = 0; i < CAPACITY; i++) ring[i].name.store(nullptr, std::memory_order_relaxed);
+    Detail::head.store(0, std::memory_order_relaxed);
+    setRecording(was);
+}
+
+void dumpChromeJson(Print& out) {
+    setRecording(false);
+    // Let scopes that already passed the recording check finish their store.
+    delay(2);
+
+    const uint32_t total = Detail::head.load(std::memory_order_acquire);
+    const uint32_t n = (total < CAPACITY) ? total : CAPACITY;
+    const uint32_t first = total - n;
+    uint32_t clockChanges = 0;
+
+    // 32-bit CCOUNT wraps every ~18 s at 240 MHz. Events are stored in
+    // completion order, so neighbouring starts are close (nested scopes finish
+    // before their parent, hence signed deltas). Each delta is converted to ns
+    // at the clock of the event that closes it and summed per core; only a gap
+    // that spans a clock change on the other core is off, by at most that gap.
+    uint64_t lastNs[MAX_CORES] = {};
+    uint32_t lastRaw[MAX_CORES] = {};
+    bool seen[MAX_CORES] = {};
+
+    char buf[128];
+    writeText(out, "{\"traceEvents\":[");
+    bool comma = false;
+    for (uint32_t k = 0; k < n; k++) {
+        const Event& e = ring[(first + k) & (CAPACITY - 1)];
+        const char* name = e.name.load(std::memory_order_acquire);
+        if (!name) continue;
+        const uint8_t core = (e.core < MAX_CORES) ? e.core : 0;
+        const int64_t mhz = max<uint16_t>(1, e.mhz);
+        if (!seen[core]) {
+            seen[core] = true;
+            lastNs[core] = (uint64_t)e.start * 1000u / (uint64_t)mhz;
+        } else {
+            lastNs[core] += (int64_t)(int32_t)(e.start - lastRaw[core]) * 1000 / mhz;
+        }
+        lastRaw[core] = e.start;
+
+        const uint64_t tsNs = lastNs[core];
+        int len;
+        if (e.clockChange) {
+            clockChanges++;
+            len = snprintf(buf, sizeof(buf),
+                           "%s\n{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"g\",\"ts\":%llu.%03u,\"pid\":0,\"tid\":%u,\"args\":{\"MHz\":%lu}}",
+                           comma ? "," : "", name,
+                           (unsigned long long)(tsNs / 1000u), (unsigned)(tsNs % 1000u),
+                           (unsigned)core, (unsigned long)e.cycles);
+        } else {
+            const uint64_t durNs = (uint64_t)e.cycles * 1000u / (uint64_t)mhz;
+            len = snprintf(buf, sizeof(buf),
+                           "%s\n{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%llu.%03u,\"dur\":%lu.%03u,\"pid\":0,\"tid\":%u}",
+                           comma ? "," : "", name,
+                           (unsigned long long)(tsNs / 1000u), (unsigned)(tsNs % 1000u),
+                           (unsigned long)(durNs / 1000u), (unsigned)(durNs % 1000u),
+                           (unsigned)core);
+        }
+        if (len > 0) out.write((const uint8_t*)buf, min((size_t)len, sizeof(buf) - 1));
+        comma = true;
+    }
+    snprintf(buf, sizeof(buf), "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"clockChanges\":%lu,\"recorded\":%lu,\"dropped\":%lu}}\n",
+             (unsigned long)clockChanges, (unsigned long)total, (unsigned long)(total - n));
+    writeText(out, buf);
+}
+
+void pollSerial() {
+    while (Serial.available() > 0) {
+        const int c = Serial.read();
+        if (c == 't') {
+            setRecording(!isRecording());
+            if (isRecording()) clear();
+            Serial.printf("[Trace] %s\n", isRecording() ? "recording" : "stopped");
+        } else if (c == 'd') {
+            dumpChromeJson(Serial);
+            clear();
+        }
+    }
+}
+
+#else
+
+void Detail::record(const char*, uint32_t, uint32_t) {}
+void noteCpuClock(uint16_t) {}
+void setRecording(bool) {}
+void clear() {}
+void dumpChromeJson(Print&) {}
+void pollSerial() {}
+
+#endif
+
+} // namespace Trace
@@ -0,0 +1,106 @@
+#pragma once
+#include <Arduino.h>
+#include <atomic>
+#include "config.h"
+
+/**
+ * Trace
+ * -----
+ * Scoped cycle-count timers for finding frame spikes:
+ *
+ *   void handleCollisions(uint32_t now) {
+ *       TRACE_SCOPE("Shooter.handleCollisions");
+ *       ...
+ *   }
+ *
+ * Each scope that closes while recording is on becomes one event
+ * {name, start cycles, duration, core, CPU MHz} in a ring of
+ * TRACE_BUFFER_EVENTS (oldest events are overwritten). dumpChromeJson() writes
+ * the ring as a Chrome trace_event file (load it in chrome://tracing or
+ * ui.perfetto.dev).
+ *
+ * CCOUNT runs at the CPU clock, which PowerGovernor changes at run time, so
+ * each event keeps the clock it was recorded at and is converted with it.
+ * noteCpuClock() (called by whoever changes the clock) updates that rate and
+ * drops a "cpu clock" instant event into the trace.
+ *
+ * Cost:
+ * - ENABLE_TRACE 0: TRACE_SCOPE expands to nothing.
+ * - compiled in, not recording: one load + branch per scope.
+ * - recording: two CCOUNT reads and one 16-byte store into the ring.
+ *
+ * Names must be string literals (only the pointer is stored, and it is written
+ * to JSON unescaped). Safe to record from both cores and from tasks; not from ISRs.
+ *
+ * Serial commands (pollSerial(), called from loop()):
+ *   't'  start/stop recording     'd'  dump the ring as JSON and clear it
+ */
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+#if ENABLE_TRACE
+#define TRACE_SCOPE(name) Trace::Scope TRACE_CONCAT(traceScope_, __LINE__)(name)
+#else
+#define TRACE_SCOPE(name) do {} while (0)
+#endif
+
+namespace Trace {
+
+static constexpr uint32_t CAPACITY = TRACE_BUFFER_EVENTS;
+static_assert(CAPACITY > 0 && (CAPACITY & (CAPACITY - 1)) == 0, "TRACE_BUFFER_EVENTS must be a power of two");
+
+struct Event {
+    std::atomic<const char*> name;  // published last; nullptr = slot never written
+    uint32_t start;                 // CCOUNT of the core that recorded it
+    uint32_t cycles;                // duration; new MHz for a clock change
+    uint8_t core;
+    bool clockChange;               // instant event from noteCpuClock()
+    uint16_t mhz;                   // CCOUNT rate up to this event
+};
+
+namespace Detail {
+    inline std::atomic<bool> recording{false};
+    inline std::atomic<uint32_t> head{0};  // total events claimed (ring index = head & (CAPACITY-1))
+    inline std::atomic<uint16_t> cpuMhz{0};  // current clock; 0 = not read yet
+
+    void record(const char* name, uint32_t start, uint32_t cycles);
+}
+
+static inline bool isRecording() { return Detail::recording.load(std::memory_order_relaxed); }
+void setRecording(bool on);
+
+// Events recorded since the last clear (may exceed CAPACITY; only the newest fit).
+static inline uint32_t eventCount() { return Detail::head.load(std::memory_order_relaxed); }
+void clear();
+
+// Stops recording, writes the ring as {"traceEvents":[...]} and leaves it
+// stopped. Works with any Print (Serial, an SD/SPIFFS File, ...).
+void dumpChromeJson(Print& out);
+
+// Call after changing the CPU clock (mhz = the clock now in effect).
+void noteCpuClock(uint16_t mhz);
+
+// Handles the 't' / 'd' serial commands. No-op unless ENABLE_TRACE.
+void pollSerial();
+
+class Scope {
+public:
+    explicit Scope(const char* name) : name(nullptr), start(0) {
+        if (!isRecording()) return;
+        this->name = name;
+        start = ESP.getCycleCount();
+    }
+    ~Scope() {
+        if (name) Detail::record(name, start, ESP.getCycleCount() - start);
+    }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+private:
+    const char* name;
+    uint32_t start;
+};
+
+} // namespace Trace
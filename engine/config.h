@@ -26,6 +26,13 @@
 #define MENU_RENDER_FPS 30
 #define GAME_RENDER_FPS 30
 
+// Lowest scanout rate the panel driver is asked for (HUB75_I2S_CFG
+// min_refresh_rate; 60 is the library default). With double buffering a
+// present counts as in flight for one scanout period, taken from the
+// library's measured rate when it has one, from this bound otherwise
+// (engine/DisplayPresent.h).
+#define PANEL_MIN_REFRESH_HZ 60
+
 // HUB75 Pins
 #define R1_PIN 25
 #define G1_PIN 26
@@ -72,6 +79,91 @@
 #define TRON_SPEED_MS 80
 #define GRID_SIZE 1
 
+// Attract mode: after this long on the "NO GAMEPAD" screen, a Tetris bot plays
+// a demo game until a controller connects (0 disables it).
+#define ATTRACT_IDLE_MS 20000
+
+// =======================================================
+// Resume (engine/ResumeStore.h)
+// =======================================================
+// Snapshot-capable games are saved to NVS when paused (or when the last pad
+// drops out) and are offered again (paused) after a reboot.
+#define ENABLE_RESUME 1
+#define RESUME_MAX_BYTES 2048
+#define DEBUG_RESUME 0
+
+// =======================================================
+// Netplay (two linked cabinets, see engine/NetPlay.h)
+// =======================================================
+// ESP-NOW needs the WiFi radio next to Bluetooth (coexistence costs RAM and
+// some BT latency), so linked play is opt-in.
+#define ENABLE_NETPLAY 0
+#define NETPLAY_CHANNEL 1
+#define NETPLAY_INPUT_DELAY 2        // frames of local input delay (fewer rollbacks)
+#define NETPLAY_MAX_ROLLBACK 8       // frames we may predict before stalling
+#define NETPLAY_PEER_TIMEOUT_MS 1500
+#define DEBUG_NETPLAY 0
+
+// =======================================================
+// Boot (engine/BootProfile.h)
+// =======================================================
+// Bluetooth (and the NetPlay radio) come up on a core-0 task while setup()
+// initializes the display, settings and audio.
+#define BOOT_PARALLEL_INIT 1
+// Wait this long for a serial monitor before the first log line (0 = don't).
+#define BOOT_SERIAL_WAIT_MS 0
+// Boot-to-menu target; DEBUG_BOOT flags boots that go over it.
+#define BOOT_BUDGET_MS 800
+
+// =======================================================
+// Tracing (engine/Trace.h)
+// =======================================================
+// Compiles the TRACE_SCOPE() timers in. They only record after the 't' serial
+// command; 'd' dumps the ring as Chrome trace JSON. Costs RAM (16 bytes per
+// event) and a load + branch per scope while not recording.
+#define ENABLE_TRACE 0
+#define TRACE_BUFFER_EVENTS 1024     // power of two
+
+// =======================================================
+// Quality governor (engine/QualityGovernor.h)
+// =======================================================
+// Games scale optional effects by globalQuality.level() so that update()+draw()
+// stay within QUALITY_BUDGET_PCT of the frame interval (the rest is Bluetooth,
+// audio and present). 0 pins the level at QUALITY_MAX_LEVEL.
+#define ENABLE_QUALITY_GOVERNOR 1
+#define QUALITY_MAX_LEVEL 3
+#define QUALITY_BUDGET_PCT 70
+#define QUALITY_RAISE_PCT 45         // raise again only when clearly under budget
+#define QUALITY_DROP_FRAMES 6        // consecutive frames over budget before dropping
+#define QUALITY_RAISE_FRAMES 90      // consecutive frames under QUALITY_RAISE_PCT before raising
+#define DEBUG_QUALITY 0
+
+// =======================================================
+// Power (engine/PowerGovernor.h)
+// =======================================================
+// Lower CPU clock, render rate and loop polling while the screen is idle (menus
+// without input, ambient apps, NO GAMEPAD). Pad input restores full speed.
+#define ENABLE_POWER_GOVERNOR 1
+#define POWER_IDLE_AFTER_MS 8000     // no input for this long = idle
+#define POWER_MENU_IDLE_FPS 10
+#define POWER_AMBIENT_IDLE_FPS 20
+// DEBUG_POWER estimate: rough ESP32 module draw per clock with Bluetooth up
+// (panel LEDs not included), and how often to print it.
+#define POWER_EST_MW_240 330
+#define POWER_EST_MW_160 250
+#define POWER_EST_MW_80 170
+#define POWER_REPORT_MS 60000
+#define DEBUG_POWER 0
+
+// =======================================================
+// Memory (engine/MemPolicy.h)
+// =======================================================
+// Put cold bulk buffers (maze generator scratch, leaderboard cache) in PSRAM
+// on boards built with it (BOARD_HAS_PSRAM). No effect on plain ESP32 boards.
+#define ENABLE_PSRAM 1
+// Print heap figures and internal-vs-PSRAM access costs at boot.
+#define DEBUG_MEM 0
+
 // RGB565 Colors
 #define COLOR_BLACK   0x0000
 #define COLOR_WHITE   0xFFFF
@@ -88,4 +180,20 @@
 // Debug toggles
 // =======================================================
 // Set to 1 to enable verbose serial logs for leaderboard/EEPROM flows.
-#define DEBUG_LEADERBOARD 0
\ No newline at end of file
+#define DEBUG_LEADERBOARD 0
+
+// Set to 1 to run GameBase::checkInvariants() after every game update (also
+// for the attract-mode demo) and log the first failure per run plus the
+// update rate to serial. Soak runs happen on the host: test/soak.
+#define DEBUG_INVARIANTS 0
+
+// Set to 1 to run the per-game measurement hooks (bot decision costs, broad
+// phase benchmarks) and print their numbers to serial.
+#define DEBUG_GAME_STATS 0
+
+// Set to 1 to print the boot phase timings (BootProfile) after setup().
+#define DEBUG_BOOT 0
+
+// Set to 1 to dump the EEPROM settings/users/leaderboard headers at boot
+// (also forces the lazily loaded profiles and leaderboard in early).
+#define DEBUG_EEPROM_DUMP 0
\ No newline at end of file
@@ -0,0 +1,139 @@
+// Arduino.h (host build)
+// -----------------------------------------------------------------------------
+// The slice of the ESP32 Arduino core the sketch uses, for building games and
+// engine code on a PC (test/). Definitions live in HostRuntime.cpp.
+//
+// - millis()/micros() read a virtual clock that the test drivers advance
+//   (Host::advanceMs), so a "10 minute" round runs in milliseconds.
+// - random()/randomSeed() are a per-process LCG: a run is reproducible from
+//   its seed.
+// - Serial goes to stdout only when Host::setSerialEcho(true).
+// -----------------------------------------------------------------------------
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <ctype.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+using std::abs;
+using std::max;
+using std::min;
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define PROGMEM
+#define IRAM_ATTR
+#define HEX 16
+#define DEC 10
+#define INPUT 0
+#define OUTPUT 1
+#define LOW 0
+#define HIGH 1
+
+class __FlashStringHelper;
+#define F(s) ((const __FlashStringHelper*)(s))
+#define pgm_read_byte(p) (*(const uint8_t*)(p))
+#define pgm_read_word(p) (*(const uint16_t*)(p))
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+// Time (virtual, see HostRuntime.h)
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+// Random
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+uint32_t esp_random();
+long map(long x, long inMin, long inMax, long outMin, long outMax);
+
+// GPIO / LEDC (no-ops)
+void pinMode(int pin, int mode);
+void digitalWrite(int pin, int val);
+int analogRead(int pin);
+double ledcSetup(uint8_t chan, double freq, uint8_t bits);
+void ledcAttachPin(uint8_t pin, uint8_t chan);
+void ledcWrite(uint8_t chan, uint32_t duty);
+double ledcWriteTone(uint8_t chan, double freq);
+
+// CPU
+bool setCpuFrequencyMhz(uint32_t mhz);
+uint32_t getCpuFrequencyMhz();
+bool psramFound();
+
+struct EspClass {
+    uint32_t getFreeHeap();
+    uint32_t getFreePsram();
+    uint32_t getPsramSize();
+    uint32_t getCpuFreqMHz();
+    uint32_t getCycleCount(); // virtual clock * CPU MHz
+    void restart();
+};
+extern EspClass ESP;
+
+// FreeRTOS (single task on the host)
+typedef int portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED 0
+#define portENTER_CRITICAL(m) ((void)(m))
+#define portEXIT_CRITICAL(m) ((void)(m))
+typedef void* TaskHandle_t;
+typedef void (*TaskFunction_t)(void*);
+#define pdPASS 1
+#define pdTRUE 1
+#define portMAX_DELAY 0xFFFFFFFFu
+int xTaskCreatePinnedToCore(TaskFunction_t fn, const char* name, uint32_t stack, void* arg, unsigned prio,
+                            TaskHandle_t* handle, int core);
+TaskHandle_t xTaskGetCurrentTaskHandle();
+void xTaskNotifyGive(TaskHandle_t task);
+uint32_t ulTaskNotifyTake(int clear, uint32_t ticks);
+void vTaskDelete(TaskHandle_t task);
+int xPortGetCoreID();
+
+// Serial
+struct Print {
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buf, size_t n) = 0;
+    virtual ~Print() {}
+};
+
+struct HardwareSerial : Print {
+    void begin(unsigned long baud);
+    void flush();
+    int available();
+    int read();
+    explicit operator bool() const { return true; }
+
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buf, size_t n) override;
+    int printf(const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+
+    size_t print(const __FlashStringHelper* s) { return print((const char*)s); }
+    size_t print(const char* s) { return write((const uint8_t*)s, strlen(s)); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(int v, int base = DEC) { return print((long)v, base); }
+    size_t print(unsigned v, int base = DEC) { return print((unsigned long)v, base); }
+    size_t print(long v, int base = DEC) { return printf(base == HEX ? "%lx" : "%ld", v); }
+    size_t print(unsigned long v, int base = DEC) { return printf(base == HEX ? "%lx" : "%lu", v); }
+    size_t print(uint8_t v, int base = DEC) { return print((unsigned long)v, base); }
+    size_t print(uint16_t v, int base = DEC) { return print((unsigned long)v, base); }
+    size_t print(int16_t v, int base = DEC) { return print((long)v, base); }
+    size_t print(double v, int digits = 2) { return printf("%.*f", digits, v); }
+
+    size_t println() { return print("\n"); }
+    template <typename T>
+    size_t println(T v) { return print(v) + println(); }
+    template <typename T>
+    size_t println(T v, int base) { return print(v, base) + println(); }
+};
+extern HardwareSerial Serial;
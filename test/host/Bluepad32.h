@@ -0,0 +1,54 @@
+// Bluepad32.h (host build)
+// -----------------------------------------------------------------------------
+// Controllers are plain structs the test drivers fill in (Host::setPad); the
+// real engine/ControllerManager samples them like live Bluepad32 pads.
+// -----------------------------------------------------------------------------
+#pragma once
+
+#include <Arduino.h>
+
+class Controller {
+public:
+    bool connected = false;
+    uint8_t dpadBits = 0;
+    bool btnA = false, btnB = false, btnX = false, btnY = false;
+    bool btnL1 = false, btnR1 = false, btnL2 = false, btnR2 = false;
+    bool btnThumbL = false, btnThumbR = false;
+    uint16_t misc = 0;
+    int32_t lx = 0, ly = 0, rx = 0, ry = 0;
+    int32_t brakeValue = 0, throttleValue = 0;
+
+    bool isConnected() const { return connected; }
+    bool isGamepad() const { return true; }
+    uint8_t dpad() const { return dpadBits; }
+    uint16_t miscButtons() const { return misc; }
+    bool a() const { return btnA; }
+    bool b() const { return btnB; }
+    bool x() const { return btnX; }
+    bool y() const { return btnY; }
+    bool l1() const { return btnL1; }
+    bool r1() const { return btnR1; }
+    bool l2() const { return btnL2; }
+    bool r2() const { return btnR2; }
+    bool thumbL() const { return btnThumbL; }
+    bool thumbR() const { return btnThumbR; }
+    int32_t axisX() const { return lx; }
+    int32_t axisY() const { return ly; }
+    int32_t axisRX() const { return rx; }
+    int32_t axisRY() const { return ry; }
+    int32_t brake() const { return brakeValue; }
+    int32_t throttle() const { return throttleValue; }
+
+    void setRumble(uint8_t, uint8_t) {}
+    void playDualRumble(uint16_t, uint16_t, uint8_t, uint8_t) {}
+};
+typedef Controller* ControllerPtr;
+typedef void (*GamepadCallback)(ControllerPtr);
+
+struct Bluepad32 {
+    void setup(GamepadCallback onConnect, GamepadCallback onDisconnect);
+    bool update() { return true; }
+    void enableVirtualDevice(bool) {}
+    void forgetBluetoothKeys() {}
+};
+extern Bluepad32 BP32;
@@ -0,0 +1,35 @@
+// EEPROM.h (host build): byte array in RAM, erased (0xFF) at start.
+#pragma once
+
+#include <Arduino.h>
+
+struct EEPROMClass {
+    static constexpr size_t CAPACITY = 4096;
+    uint8_t bytes[CAPACITY];
+    size_t used = 0;
+
+    EEPROMClass() { memset(bytes, 0xFF, sizeof(bytes)); }
+    bool begin(size_t size) {
+        used = (size < CAPACITY) ? size : CAPACITY;
+        return true;
+    }
+    bool commit() { return true; }
+    uint8_t read(int addr) const { return inRange(addr, 1) ? bytes[addr] : 0xFF; }
+    void write(int addr, uint8_t v) {
+        if (inRange(addr, 1)) bytes[addr] = v;
+    }
+    template <typename T>
+    T& get(int addr, T& t) const {
+        if (inRange(addr, sizeof(T))) memcpy((void*)&t, &bytes[addr], sizeof(T));
+        return t;
+    }
+    template <typename T>
+    const T& put(int addr, const T& t) {
+        if (inRange(addr, sizeof(T))) memcpy(&bytes[addr], (const void*)&t, sizeof(T));
+        return t;
+    }
+
+private:
+    bool inRange(int addr, size_t n) const { return addr >= 0 && (size_t)addr + n <= used; }
+};
+extern EEPROMClass EEPROM;
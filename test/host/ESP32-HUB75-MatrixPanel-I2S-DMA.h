@@ -0,0 +1,114 @@
+// ESP32-HUB75-MatrixPanel-I2S-DMA.h (host build)
+// -----------------------------------------------------------------------------
+// The panel as a plain RGB565 framebuffer. Drawing is clipped like the real
+// library, and every call is counted (Host::panelStats) so benchmarks can
+// report draw calls and pixels per frame. Definitions in HostPanel.cpp.
+// -----------------------------------------------------------------------------
+#pragma once
+
+#include <Arduino.h>
+#include <Fonts/TomThumb.h>
+
+struct HUB75_I2S_CFG {
+    enum clk_speed { HZ_8M, HZ_10M, HZ_15M, HZ_20M };
+    enum shift_driver { SHIFTREG, FM6124, FM6126A };
+    struct {
+        int r1, g1, b1, r2, g2, b2, a, b, c, d, e, lat, oe, clk;
+    } gpio = {};
+    bool double_buff = false;
+    clk_speed i2sspeed = HZ_10M;
+    bool clkphase = true;
+    shift_driver driver = SHIFTREG;
+    uint8_t latch_blanking = 1;
+    uint16_t min_refresh_rate = 60;
+    int mx_width, mx_height, chain_length;
+
+    HUB75_I2S_CFG(int w = 64, int h = 64, int chain = 1) : mx_width(w), mx_height(h), chain_length(chain) {}
+};
+
+class MatrixPanel_I2S_DMA {
+public:
+    explicit MatrixPanel_I2S_DMA(const HUB75_I2S_CFG& cfg = HUB75_I2S_CFG());
+    ~MatrixPanel_I2S_DMA();
+    MatrixPanel_I2S_DMA(const MatrixPanel_I2S_DMA&) = delete;
+    MatrixPanel_I2S_DMA& operator=(const MatrixPanel_I2S_DMA&) = delete;
+
+    bool begin() { return true; }
+    void setBrightness8(uint8_t b) { brightness = b; }
+    void flipDMABuffer() { flips++; }
+
+    static uint16_t color565(uint8_t r, uint8_t g, uint8_t b) {
+        return (uint16_t)(((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3));
+    }
+
+    void clearScreen() { fillScreen(0); }
+    void fillScreen(uint16_t c);
+    void drawPixel(int16_t x, int16_t y, uint16_t c);
+    void drawPixelRGB888(int16_t x, int16_t y, uint8_t r, uint8_t g, uint8_t b) { drawPixel(x, y, color565(r, g, b)); }
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t c);
+    void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t c);
+    void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t c);
+    void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t c);
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t c);
+    void drawRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t c);
+    void fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t c);
+    void drawCircle(int16_t x, int16_t y, int16_t r, uint16_t c);
+    void fillCircle(int16_t x, int16_t y, int16_t r, uint16_t c);
+
+    // Text (GFX font path only)
+    void setFont(const GFXfont* f) { font = f; }
+    void setTextColor(uint16_t c) { textColor = c; }
+    void setTextSize(uint8_t) {}
+    void setTextWrap(bool) {}
+    void setCursor(int16_t x, int16_t y) {
+        cursorX = x;
+        cursorY = y;
+    }
+    void getTextBounds(const char* s, int16_t x, int16_t y, int16_t* x1, int16_t* y1, uint16_t* w, uint16_t* h);
+    size_t print(const char* s);
+    size_t print(char c) {
+        const char s[2] = { c, 0 };
+        return print(s);
+    }
+    size_t print(int v) { return printNumber(v); }
+    size_t print(unsigned v) { return printNumber((long)v); }
+    size_t print(long v) { return printNumber(v); }
+    size_t print(unsigned long v) { return printNumber((long)v); }
+    template <typename T>
+    size_t println(T v) {
+        const size_t n = print(v);
+        cursorY += font ? font->yAdvance : 8;
+        cursorX = 0;
+        return n;
+    }
+
+    int16_t width() const { return w; }
+    int16_t height() const { return h; }
+
+    // Host side
+    const uint16_t* pixels() const { return fb; }
+    uint16_t pixel(int x, int y) const { return (x >= 0 && x < w && y >= 0 && y < h) ? fb[y * w + x] : 0; }
+    uint32_t hash() const; // FNV-1a over the framebuffer
+
+    struct Stats {
+        uint32_t calls = 0;   // draw calls (fillScreen excluded)
+        uint32_t pixels = 0;  // pixels those calls covered before clipping
+        uint32_t fills = 0;   // fillScreen/clearScreen
+    };
+    Stats stats;
+    uint32_t flips = 0;
+
+private:
+    int16_t w, h;
+    uint16_t* fb;
+    uint8_t brightness = 255;
+    const GFXfont* font = nullptr;
+    uint16_t textColor = 0xFFFF;
+    int16_t cursorX = 0, cursorY = 0;
+
+    void plot(int x, int y, uint16_t c) {
+        if (x >= 0 && x < w && y >= 0 && y < h) fb[y * w + x] = c;
+    }
+    void span(int x0, int x1, int y, uint16_t c);
+    size_t printNumber(long v);
+};
@@ -0,0 +1,28 @@
+// Fonts/TomThumb.h (host build)
+// -----------------------------------------------------------------------------
+// Adafruit GFX font types plus a stand-in for the 3x5 TomThumb font: same
+// character range, box and advance, glyph bits derived from the character
+// code. Enough for layout and pixel-count checks, not for reading.
+// -----------------------------------------------------------------------------
+#pragma once
+
+#include <stdint.h>
+
+typedef struct {
+    uint16_t bitmapOffset;
+    uint8_t width;
+    uint8_t height;
+    uint8_t xAdvance;
+    int8_t xOffset;
+    int8_t yOffset;
+} GFXglyph;
+
+typedef struct {
+    uint8_t* bitmap;
+    GFXglyph* glyph;
+    uint16_t first;
+    uint16_t last;
+    uint8_t yAdvance;
+} GFXfont;
+
+extern const GFXfont TomThumb;
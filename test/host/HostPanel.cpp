@@ -0,0 +1,210 @@
+// HostPanel.cpp
+// -----------------------------------------------------------------------------
+// Framebuffer MatrixPanel_I2S_DMA and the stand-in TomThumb font.
+// -----------------------------------------------------------------------------
+#include <ESP32-HUB75-MatrixPanel-I2S-DMA.h>
+
+// -----------------------------
+// TomThumb stand-in
+// -----------------------------
+namespace {
+
+constexpr uint16_t FONT_FIRST = 0x20;
+constexpr uint16_t FONT_LAST = 0x7E;
+constexpr int GLYPHS = FONT_LAST - FONT_FIRST + 1;
+
+// 3x5 cells, one byte per row (bits 2..0). Space is blank; everything else
+// gets a pattern derived from the character so different strings draw
+// different pixels.
+struct FontData {
+    uint8_t bitmap[GLYPHS * 5];
+    GFXglyph glyph[GLYPHS];
+
+    FontData() {
+        for (int i = 0; i < GLYPHS; i++) {
+            const uint8_t ch = (uint8_t)(FONT_FIRST + i);
+            for (int r = 0; r < 5; r++) {
+                bitmap[i * 5 + r] = (ch == ' ') ? 0 : (uint8_t)(((ch * 7u + r * 13u) % 7u) + 1u);
+            }
+            glyph[i] = { (uint16_t)(i * 5), 3, 5, 4, 0, -5 };
+        }
+    }
+};
+
+FontData& fontData() {
+    static FontData d;
+    return d;
+}
+
+} // namespace
+
+const GFXfont TomThumb = { fontData().bitmap, fontData().glyph, FONT_FIRST, FONT_LAST, 6 };
+
+// -----------------------------
+// Panel
+// -----------------------------
+MatrixPanel_I2S_DMA::MatrixPanel_I2S_DMA(const HUB75_I2S_CFG& cfg)
+    : w((int16_t)(cfg.mx_width * cfg.chain_length)), h((int16_t)cfg.mx_height) {
+    fb = new uint16_t[(size_t)w * h]();
+}
+
+MatrixPanel_I2S_DMA::~MatrixPanel_I2S_DMA() { delete[] fb; }
+
+void MatrixPanel_I2S_DMA::fillScreen(uint16_t c) {
+    stats.fills++;
+    for (int i = 0; i < w * h; i++) fb[i] = c;
+}
+
+void MatrixPanel_I2S_DMA::span(int x0, int x1, int y, uint16_t c) {
+    if (y < 0 || y >= h) return;
+    if (x0 < 0) x0 = 0;
+    if (x1 >= w) x1 = w - 1;
+    for (int x = x0; x <= x1; x++) fb[y * w + x] = c;
+}
+
+void MatrixPanel_I2S_DMA::drawPixel(int16_t x, int16_t y, uint16_t c) {
+    stats.calls++;
+    stats.pixels++;
+    plot(x, y, c);
+}
+
+void MatrixPanel_I2S_DMA::drawFastHLine(int16_t x, int16_t y, int16_t len, uint16_t c) {
+    stats.calls++;
+    if (len <= 0) return;
+    stats.pixels += (uint32_t)len;
+    span(x, x + len - 1, y, c);
+}
+
+void MatrixPanel_I2S_DMA::drawFastVLine(int16_t x, int16_t y, int16_t len, uint16_t c) {
+    stats.calls++;
+    if (len <= 0) return;
+    stats.pixels += (uint32_t)len;
+    for (int i = 0; i < len; i++) plot(x, y + i, c);
+}
+
+void MatrixPanel_I2S_DMA::fillRect(int16_t x, int16_t y, int16_t rw, int16_t rh, uint16_t c) {
+    stats.calls++;
+    if (rw <= 0 || rh <= 0) return;
+    stats.pixels += (uint32_t)rw * (uint32_t)rh;
+    for (int j = 0; j < rh; j++) span(x, x + rw - 1, y + j, c);
+}
+
+void MatrixPanel_I2S_DMA::drawRect(int16_t x, int16_t y, int16_t rw, int16_t rh, uint16_t c) {
+    stats.calls++;
+    if (rw <= 0 || rh <= 0) return;
+    stats.pixels += 2u * (uint32_t)(rw + rh);
+    span(x, x + rw - 1, y, c);
+    span(x, x + rw - 1, y + rh - 1, c);
+    for (int j = 0; j < rh; j++) {
+        plot(x, y + j, c);
+        plot(x + rw - 1, y + j, c);
+    }
+}
+
+void MatrixPanel_I2S_DMA::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t c) {
+    stats.calls++;
+    int dx = abs(x1 - x0), sx = x0 < x1 ? 1 : -1;
+    int dy = -abs(y1 - y0), sy = y0 < y1 ? 1 : -1;
+    int err = dx + dy;
+    int x = x0, y = y0;
+    for (;;) {
+        stats.pixels++;
+        plot(x, y, c);
+        if (x == x1 && y == y1) break;
+        const int e2 = 2 * err;
+        if (e2 >= dy) {
+            err += dy;
+            x += sx;
+        }
+        if (e2 <= dx) {
+            err += dx;
+            y += sy;
+        }
+    }
+}
+
+void MatrixPanel_I2S_DMA::drawRoundRect(int16_t x, int16_t y, int16_t rw, int16_t rh, int16_t, uint16_t c) {
+    drawRect(x, y, rw, rh, c);
+}
+
+void MatrixPanel_I2S_DMA::fillRoundRect(int16_t x, int16_t y, int16_t rw, int16_t rh, int16_t, uint16_t c) {
+    fillRect(x, y, rw, rh, c);
+}
+
+void MatrixPanel_I2S_DMA::drawCircle(int16_t cx, int16_t cy, int16_t r, uint16_t c) {
+    stats.calls++;
+    for (int a = 0; a < 64; a++) {
+        const double t = a * (2.0 * M_PI / 64.0);
+        stats.pixels++;
+        plot(cx + (int)lround(r * cos(t)), cy + (int)lround(r * sin(t)), c);
+    }
+}
+
+void MatrixPanel_I2S_DMA::fillCircle(int16_t cx, int16_t cy, int16_t r, uint16_t c) {
+    stats.calls++;
+    for (int dy = -r; dy <= r; dy++) {
+        const int half = (int)sqrt((double)(r * r - dy * dy));
+        stats.pixels += (uint32_t)(2 * half + 1);
+        span(cx - half, cx + half, cy + dy, c);
+    }
+}
+
+void MatrixPanel_I2S_DMA::getTextBounds(const char* s, int16_t x, int16_t y, int16_t* x1, int16_t* y1, uint16_t* bw,
+                                        uint16_t* bh) {
+    const size_t n = strlen(s);
+    const int adv = font ? 4 : 6;
+    const int ht = font ? 5 : 8;
+    *x1 = x;
+    *y1 = (int16_t)(font ? y - 5 : y);
+    *bw = (uint16_t)(n ? n * adv - 1 : 0);
+    *bh = (uint16_t)(n ? ht : 0);
+}
+
+size_t MatrixPanel_I2S_DMA::print(const char* s) {
+    size_t n = 0;
+    for (; *s; s++, n++) {
+        const uint8_t ch = (uint8_t)*s;
+        if (ch == '\n') {
+            cursorX = 0;
+            cursorY += font ? font->yAdvance : 8;
+            continue;
+        }
+        if (!font) {
+            // Built-in 5x7: a filled box is enough for layout checks.
+            stats.calls++;
+            stats.pixels += 35;
+            for (int j = 0; j < 7; j++) span(cursorX, cursorX + 4, cursorY + j, textColor);
+            cursorX += 6;
+            continue;
+        }
+        if (ch < font->first || ch > font->last) continue;
+        const GFXglyph& g = font->glyph[ch - font->first];
+        const uint8_t* rows = font->bitmap + g.bitmapOffset;
+        stats.calls++;
+        for (int r = 0; r < g.height; r++) {
+            for (int col = 0; col < g.width; col++) {
+                if (rows[r] & (1u << (g.width - 1 - col))) {
+                    stats.pixels++;
+                    plot(cursorX + g.xOffset + col, cursorY + g.yOffset + r, textColor);
+                }
+            }
+        }
+        cursorX += g.xAdvance;
+    }
+    return n;
+}
+
+size_t MatrixPanel_I2S_DMA::printNumber(long v) {
+    char buf[24];
+    snprintf(buf, sizeof(buf), "%ld", v);
+    return print(buf);
+}
+
+uint32_t MatrixPanel_I2S_DMA::hash() const {
+    uint32_t hv = 2166136261u;
+    for (int i = 0; i < w * h; i++) {
+        hv = (hv ^ (fb[i] & 0xFF)) * 16777619u;
+        hv = (hv ^ (fb[i] >> 8)) * 16777619u;
+    }
+    return hv;
+}
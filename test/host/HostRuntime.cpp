@@ -0,0 +1,280 @@
+// HostRuntime.cpp
+// -----------------------------------------------------------------------------
+// Definitions behind the host stub headers (Arduino core, Bluepad32, NVS,
+// heap caps) and the Host:: driver API.
+// -----------------------------------------------------------------------------
+#include "HostRuntime.h"
+
+#include <Bluepad32.h>
+#include <EEPROM.h>
+#include <Preferences.h>
+#include <WiFi.h>
+#include <esp_heap_caps.h>
+#include <stdarg.h>
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "engine/AudioManager.h"
+#include "engine/EepromManager.h"
+#include "engine/Settings.h"
+
+HardwareSerial Serial;
+EspClass ESP;
+EEPROMClass EEPROM;
+WiFiClass WiFi;
+Bluepad32 BP32;
+
+// -----------------------------
+// Internal state
+// -----------------------------
+namespace {
+
+constexpr uint32_t CPU_MHZ = 240;
+
+uint64_t gNowUs = 1000000; // start at 1 s: some games treat a 0 timestamp as "unset"
+bool gWallClock = false;
+bool gWallMicros = false;
+bool gSerialEcho = false;
+uint32_t gRandom = 1;
+uint32_t gCpuMhz = CPU_MHZ;
+
+GamepadCallback gOnConnect = nullptr;
+GamepadCallback gOnDisconnect = nullptr;
+Controller gPads[MAX_GAMEPADS];
+
+// NVS: namespace -> key -> blob.
+std::map<std::string, std::map<std::string, std::vector<uint8_t>>> gNvs;
+
+const auto gWallStart = std::chrono::steady_clock::now();
+
+} // namespace
+
+// -----------------------------
+// Host:: driver API
+// -----------------------------
+namespace Host {
+
+void begin() {
+    EepromManager::begin();
+    globalSettings.load();
+    static ControllerManager controllers;
+    controllers.setup();
+    globalAudio.begin();
+}
+
+uint64_t nowUs() { return gNowUs; }
+void advanceUs(uint64_t us) { gNowUs += us; }
+void useWallClock(bool on) { gWallClock = on; }
+void useWallMicros(bool on) { gWallMicros = on; }
+
+uint64_t wallUs() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - gWallStart)
+        .count();
+}
+
+void setPad(int index, const PadState& s) {
+    if (index < 0 || index >= MAX_GAMEPADS) return;
+    Controller& c = gPads[index];
+    const bool was = c.connected;
+    c.connected = s.connected;
+    c.dpadBits = s.dpad;
+    c.btnA = s.held(PadState::BTN_A);
+    c.btnB = s.held(PadState::BTN_B);
+    c.btnX = s.held(PadState::BTN_X);
+    c.btnY = s.held(PadState::BTN_Y);
+    c.btnL1 = s.held(PadState::BTN_L1);
+    c.btnR1 = s.held(PadState::BTN_R1);
+    c.btnL2 = s.held(PadState::BTN_L2);
+    c.btnR2 = s.held(PadState::BTN_R2);
+    c.btnThumbL = s.held(PadState::BTN_THUMB_L);
+    c.btnThumbR = s.held(PadState::BTN_THUMB_R);
+    // miscButtons() convention: 0x01 system, 0x02 select, 0x04 start.
+    c.misc = (uint16_t)((s.held(PadState::BTN_SYSTEM) ? 0x01 : 0) | (s.held(PadState::BTN_SELECT) ? 0x02 : 0) |
+                        (s.held(PadState::BTN_START) ? 0x04 : 0));
+    c.lx = s.axisX;
+    c.ly = s.axisY;
+    c.rx = s.axisRX;
+    c.ry = s.axisRY;
+    c.brakeValue = s.brake;
+    c.throttleValue = s.throttle;
+    if (s.connected && !was && gOnConnect) gOnConnect(&c);
+    if (!s.connected && was && gOnDisconnect) gOnDisconnect(&c);
+}
+
+MatrixPanel_I2S_DMA& panel() {
+    static MatrixPanel_I2S_DMA p(HUB75_I2S_CFG(64, 64, 1));
+    return p;
+}
+
+void setSerialEcho(bool on) { gSerialEcho = on; }
+
+} // namespace Host
+
+// -----------------------------
+// Arduino core
+// -----------------------------
+unsigned long millis() { return (unsigned long)(uint32_t)((gWallClock ? Host::wallUs() : gNowUs) / 1000u); }
+
+unsigned long micros() {
+    if (gWallClock || gWallMicros) return (unsigned long)(uint32_t)Host::wallUs();
+    return (unsigned long)(uint32_t)(gNowUs++);
+}
+
+void delay(unsigned long ms) { Host::advanceMs((uint32_t)ms); }
+void delayMicroseconds(unsigned int us) { Host::advanceUs(us); }
+void yield() {}
+
+long random(long howbig) {
+    if (howbig <= 0) return 0;
+    gRandom = gRandom * 1664525u + 1013904223u;
+    return (long)((gRandom >> 8) % (uint32_t)howbig);
+}
+
+long random(long howsmall, long howbig) {
+    if (howsmall >= howbig) return howsmall;
+    return howsmall + random(howbig - howsmall);
+}
+
+void randomSeed(unsigned long seed) { gRandom = (uint32_t)seed ? (uint32_t)seed : 1u; }
+
+uint32_t esp_random() {
+    gRandom = gRandom * 1664525u + 1013904223u;
+    return gRandom ^ (gRandom >> 16);
+}
+
+long map(long x, long inMin, long inMax, long outMin, long outMax) {
+    if (inMax == inMin) return outMin;
+    return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+void pinMode(int, int) {}
+void digitalWrite(int, int) {}
+int analogRead(int) { return 0; }
+double ledcSetup(uint8_t, double freq, uint8_t) { return freq; }
+void ledcAttachPin(uint8_t, uint8_t) {}
+void ledcWrite(uint8_t, uint32_t) {}
+double ledcWriteTone(uint8_t, double freq) { return freq; }
+
+bool setCpuFrequencyMhz(uint32_t mhz) {
+    gCpuMhz = mhz;
+    return true;
+}
+uint32_t getCpuFrequencyMhz() { return gCpuMhz; }
+bool psramFound() { return false; }
+
+uint32_t EspClass::getFreeHeap() { return 160 * 1024; }
+uint32_t EspClass::getFreePsram() { return 0; }
+uint32_t EspClass::getPsramSize() { return 0; }
+uint32_t EspClass::getCpuFreqMHz() { return gCpuMhz; }
+uint32_t EspClass::getCycleCount() { return (uint32_t)(micros() * gCpuMhz); }
+void EspClass::restart() {
+    fprintf(stderr, "ESP.restart() called\n");
+    abort();
+}
+
+int xTaskCreatePinnedToCore(TaskFunction_t, const char*, uint32_t, void*, unsigned, TaskHandle_t*, int) { return 0; }
+TaskHandle_t xTaskGetCurrentTaskHandle() { return nullptr; }
+void xTaskNotifyGive(TaskHandle_t) {}
+uint32_t ulTaskNotifyTake(int, uint32_t) { return 1; }
+void vTaskDelete(TaskHandle_t) {}
+int xPortGetCoreID() { return 1; }
+
+// -----------------------------
+// Serial
+// -----------------------------
+void HardwareSerial::begin(unsigned long) {}
+void HardwareSerial::flush() { fflush(stdout); }
+int HardwareSerial::available() { return 0; }
+int HardwareSerial::read() { return -1; }
+
+size_t HardwareSerial::write(uint8_t c) {
+    if (gSerialEcho) fputc(c, stdout);
+    return 1;
+}
+
+size_t HardwareSerial::write(const uint8_t* buf, size_t n) {
+    if (gSerialEcho) fwrite(buf, 1, n, stdout);
+    return n;
+}
+
+int HardwareSerial::printf(const char* fmt, ...) {
+    char buf[256];
+    va_list args;
+    va_start(args, fmt);
+    const int n = vsnprintf(buf, sizeof(buf), fmt, args);
+    va_end(args);
+    if (n > 0) write((const uint8_t*)buf, strlen(buf));
+    return n;
+}
+
+// -----------------------------
+// Bluepad32
+// -----------------------------
+void Bluepad32::setup(GamepadCallback onConnect, GamepadCallback onDisconnect) {
+    gOnConnect = onConnect;
+    gOnDisconnect = onDisconnect;
+}
+
+// -----------------------------
+// Heap caps
+// -----------------------------
+void* heap_caps_malloc(size_t bytes, uint32_t) { return malloc(bytes); }
+void* heap_caps_calloc(size_t n, size_t size, uint32_t) { return calloc(n, size); }
+void heap_caps_free(void* p) { free(p); }
+size_t heap_caps_get_free_size(uint32_t) { return 160 * 1024; }
+size_t heap_caps_get_largest_free_block(uint32_t) { return 110 * 1024; }
+
+// -----------------------------
+// Preferences (NVS)
+// -----------------------------
+bool Preferences::begin(const char* name, bool ro) {
+    snprintf(ns, sizeof(ns), "%s", name);
+    readOnly = ro;
+    open = true;
+    return true;
+}
+
+void Preferences::end() { open = false; }
+
+bool Preferences::clear() {
+    if (!open || readOnly) return false;
+    gNvs[ns].clear();
+    return true;
+}
+
+bool Preferences::remove(const char* key) {
+    if (!open || readOnly) return false;
+    return gNvs[ns].erase(key) > 0;
+}
+
+bool Preferences::isKey(const char* key) { return open && gNvs[ns].count(key) > 0; }
+
+size_t Preferences::putUChar(const char* key, uint8_t v) { return putBytes(key, &v, 1); }
+
+uint8_t Preferences::getUChar(const char* key, uint8_t defaultValue) {
+    uint8_t v = defaultValue;
+    getBytes(key, &v, 1);
+    return v;
+}
+
+size_t Preferences::putBytes(const char* key, const void* v, size_t len) {
+    if (!open || readOnly) return 0;
+    const uint8_t* p = (const uint8_t*)v;
+    gNvs[ns][key].assign(p, p + len);
+    return len;
+}
+
+size_t Preferences::getBytesLength(const char* key) {
+    if (!isKey(key)) return 0;
+    return gNvs[ns][key].size();
+}
+
+size_t Preferences::getBytes(const char* key, void* buf, size_t maxLen) {
+    if (!isKey(key)) return 0;
+    const std::vector<uint8_t>& blob = gNvs[ns][key];
+    if (blob.size() > maxLen) return 0;
+    memcpy(buf, blob.data(), blob.size());
+    return blob.size();
+}
@@ -0,0 +1,55 @@
+// HostRuntime.h
+// -----------------------------------------------------------------------------
+// What test drivers (test/soak, test/netplay, ...) use to run sketch code on a
+// PC: the virtual clock, scripted pads and the framebuffer panel.
+//
+// One process = one "cabinet": the clock, RNG, pads, EEPROM and NVS are
+// process globals, like on the device. Drivers that want several independent
+// runs in parallel fork (see test/soak/SoakRunner.cpp).
+// -----------------------------------------------------------------------------
+#pragma once
+
+#include <Arduino.h>
+#include <ESP32-HUB75-MatrixPanel-I2S-DMA.h>
+#include "engine/ControllerManager.h"
+
+namespace Host {
+
+// EEPROM, settings, audio and the controller manager, in setup() order.
+void begin();
+
+// ---------------------------------------------------------
+// Virtual clock
+// ---------------------------------------------------------
+// millis()/micros() return this; it only moves when a driver advances it (and
+// by 1 us per micros() call, so polled time budgets still expire). delay()
+// advances it too.
+uint64_t nowUs();
+void advanceUs(uint64_t us);
+inline void advanceMs(uint32_t ms) { advanceUs((uint64_t)ms * 1000u); }
+
+// Benchmarks: micros() reads the real monotonic clock instead.
+void useWallClock(bool on);
+// Cost measurements inside a virtual-clock run: only micros() reads the real
+// clock, millis() stays virtual (and deterministic).
+void useWallMicros(bool on);
+// Real monotonic clock in microseconds, whatever the mode.
+uint64_t wallUs();
+
+// ---------------------------------------------------------
+// Pads
+// ---------------------------------------------------------
+// Sets what pad `index` reports from the next ControllerManager::update():
+// connected, dpad, buttons (PadState::BTN_*), sticks and triggers. Edges are
+// derived by the controller manager. Changing `connected` goes through the
+// Bluepad32 connect/disconnect callbacks.
+void setPad(int index, const PadState& state);
+
+// ---------------------------------------------------------
+// Output
+// ---------------------------------------------------------
+MatrixPanel_I2S_DMA& panel();
+// Serial output to stdout (off by default).
+void setSerialEcho(bool on);
+
+} // namespace Host
@@ -0,0 +1,23 @@
+// Preferences.h (host build): NVS namespaces as in-memory key/blob maps.
+#pragma once
+
+#include <Arduino.h>
+
+class Preferences {
+public:
+    bool begin(const char* name, bool readOnly = false);
+    void end();
+    bool clear();
+    bool remove(const char* key);
+    bool isKey(const char* key);
+    size_t putUChar(const char* key, uint8_t v);
+    uint8_t getUChar(const char* key, uint8_t defaultValue = 0);
+    size_t putBytes(const char* key, const void* v, size_t len);
+    size_t getBytesLength(const char* key);
+    size_t getBytes(const char* key, void* buf, size_t maxLen);
+
+private:
+    char ns[16] = { 0 };
+    bool open = false;
+    bool readOnly = true;
+};
@@ -0,0 +1,58 @@
+// RandomPlayer.h
+// -----------------------------------------------------------------------------
+// Scripted random input for host drivers, reproducible from a seed and
+// independent of the game's own random() stream.
+// -----------------------------------------------------------------------------
+#pragma once
+
+#include "HostRuntime.h"
+
+struct XorShift {
+    uint32_t s;
+    explicit XorShift(uint32_t seed) : s(seed ? seed : 0x9E3779B9u) {}
+    uint32_t next() {
+        s ^= s << 13;
+        s ^= s >> 17;
+        s ^= s << 5;
+        return s;
+    }
+    uint32_t range(uint32_t n) { return n ? next() % n : 0; }
+};
+
+// Holds a button/dpad/stick combination for a while, then picks another.
+// START/SELECT/SYSTEM stay up (they open the pause menu, not the game).
+class RandomPlayer {
+public:
+    explicit RandomPlayer(uint32_t seed) : rng(seed) {}
+
+    // Input for the next frame.
+    const PadState& next() {
+        if (holdFrames == 0) {
+            constexpr uint16_t GAME_BUTTONS = PadState::BTN_A | PadState::BTN_B | PadState::BTN_X | PadState::BTN_Y |
+                                              PadState::BTN_L1 | PadState::BTN_R1 | PadState::BTN_L2 |
+                                              PadState::BTN_R2 | PadState::BTN_THUMB_L | PadState::BTN_THUMB_R;
+            static const uint8_t DPADS[] = { 0, PadState::DPAD_UP, PadState::DPAD_DOWN, PadState::DPAD_LEFT,
+                                             PadState::DPAD_RIGHT, PadState::DPAD_UP | PadState::DPAD_LEFT };
+            pad.connected = true;
+            pad.buttons = (uint16_t)(rng.range(3) == 0 ? (rng.next() & GAME_BUTTONS) : 0);
+            pad.dpad = DPADS[rng.range(sizeof(DPADS))];
+            pad.axisX = (int16_t)((int)rng.range(1024) - 512);
+            pad.axisY = (int16_t)((int)rng.range(1024) - 512);
+            pad.axisRX = (int16_t)((int)rng.range(1024) - 512);
+            pad.axisRY = (int16_t)((int)rng.range(1024) - 512);
+            pad.brake = (uint16_t)rng.range(PadState::TRIGGER_MAX + 1);
+            pad.throttle = (uint16_t)rng.range(PadState::TRIGGER_MAX + 1);
+            holdFrames = 1 + rng.range(rng.range(4) == 0 ? 400 : 40);
+        }
+        holdFrames--;
+        return pad;
+    }
+
+    // One-in-`n` chance per call; drivers use it for rare events (pad drops).
+    bool chance(uint32_t n) { return rng.range(n) == 0; }
+
+private:
+    XorShift rng;
+    PadState pad;
+    uint32_t holdFrames = 0;
+};
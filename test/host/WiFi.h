@@ -0,0 +1,16 @@
+// WiFi.h (host build): station mode with a fixed MAC. No radio.
+#pragma once
+
+#include <Arduino.h>
+
+enum { WIFI_STA = 1 };
+
+struct WiFiClass {
+    void mode(int) {}
+    void setChannel(int) {}
+    void macAddress(uint8_t* mac) {
+        static const uint8_t HOST_MAC[6] = { 0x02, 0, 0, 0, 0, 0x01 };
+        memcpy(mac, HOST_MAC, 6);
+    }
+};
+extern WiFiClass WiFi;
@@ -0,0 +1,515 @@
+// NetPlayTest.cpp
+// -----------------------------------------------------------------------------
+// NetPlay rollback under injected delay, jitter and loss (engine/NetPlay.h).
+//
+// 1. Sweep: two NetPlay instances in this process, linked by a queue that
+//    delays every packet by a random amount (so jitter also reorders) or drops
+//    it. A hash game folds both inputs into its state every frame; the hash of
+//    every confirmed frame must match on both sides.
+// 2. Matches: Pong, Tron and Snake, each side a forked "cabinet" with its own
+//    globalNetPlay, linked over a socketpair. Pad 0 plays random input. The
+//    cabinets run in lockstep on the virtual clock (both finish a step before
+//    either starts the next), so a run is reproducible from its seed. A step
+//    that ends on a fully confirmed frame records netChecksum(); both cabinets
+//    must agree on every frame they both recorded and on the final state at
+//    game over.
+//
+// Rollback cost (resim us) is real time: micros() reads the wall clock.
+//
+//   netplay_test                        sweep + all matches
+//   netplay_test --game tron --seed 7   one match (printed on failure)
+//   netplay_test --frames 3000          sweep length
+// -----------------------------------------------------------------------------
+#include "HostRuntime.h"
+#include "RandomPlayer.h"
+
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+#include "engine/NetPlay.h"
+#include "Games/Pong/PongGame.h"
+#include "Games/Tron/TronGame.h"
+#include "Games/Snake/SnakeGame.h"
+
+namespace {
+
+const uint8_t MAC_A[6] = { 0x02, 0, 0, 0, 0, 0xA1 };
+const uint8_t MAC_B[6] = { 0x02, 0, 0, 0, 0, 0xB2 };
+
+// One-way delay range and loss applied to every packet.
+struct Profile {
+    const char* name;
+    uint16_t minDelayMs;
+    uint16_t maxDelayMs;
+    uint8_t lossPct;
+};
+
+const Profile SWEEP[] = {
+    { "lan", 2, 8, 0 },       { "lan", 2, 8, 10 },      { "wifi", 20, 60, 0 },   { "wifi", 20, 60, 10 },
+    { "wifi", 20, 60, 40 },   { "wifi", 20, 60, 70 },   { "far", 50, 150, 0 },   { "far", 50, 150, 10 },
+};
+
+const Profile MATCH_PROFILES[] = {
+    { "lan", 2, 8, 0 },
+    { "wifi", 20, 60, 10 },
+};
+
+void printStats(const NetPlay::Stats& a, const NetPlay::Stats& b) {
+    printf("  rollbacks %u/%u  depth %u/%u  resim %u/%u frames, worst %u/%u us  stalls %u/%u  rtt %u/%u ms\n",
+           (unsigned)a.rollbacks, (unsigned)b.rollbacks, (unsigned)a.maxRollbackDepth, (unsigned)b.maxRollbackDepth,
+           (unsigned)a.resimFrames, (unsigned)b.resimFrames, (unsigned)a.resimMaxUs, (unsigned)b.resimMaxUs,
+           (unsigned)a.stalls, (unsigned)b.stalls, (unsigned)a.rttMs, (unsigned)b.rttMs);
+}
+
+// -----------------------------
+// 1. In-process sweep
+// -----------------------------
+
+// Every packet lands in the other instance after a random delay, or never.
+struct LoopLink {
+    struct InFlight {
+        uint32_t dueMs;
+        NetPlay* to;
+        uint8_t mac[6];
+        uint8_t len;
+        uint8_t data[64];
+    };
+
+    // NetPlay::Link for one end.
+    struct End : NetPlay::Link {
+        LoopLink* loop = nullptr;
+        NetPlay* peer = nullptr;
+        uint32_t nowMs() override { return loop->nowMs; }
+        void send(const uint8_t* fromMac, const uint8_t* data, int len) override {
+            loop->send(peer, fromMac, data, len);
+        }
+    };
+
+    std::vector<InFlight> q;
+    uint32_t nowMs = 1;
+    Profile profile;
+    DetRandom rng;
+
+    void send(NetPlay* to, const uint8_t* mac, const uint8_t* data, int len) {
+        if ((uint32_t)rng.range(0, 100) < profile.lossPct) return;
+        InFlight p;
+        p.dueMs = nowMs + (uint32_t)rng.range(profile.minDelayMs, profile.maxDelayMs + 1);
+        p.to = to;
+        memcpy(p.mac, mac, 6);
+        p.len = (uint8_t)len;
+        memcpy(p.data, data, (size_t)len);
+        q.push_back(p);
+    }
+
+    void deliver() {
+        for (size_t i = 0; i < q.size();) {
+            if ((int32_t)(nowMs - q[i].dueMs) < 0) {
+                i++;
+                continue;
+            }
+            const InFlight p = q[i];
+            q[i] = q.back();
+            q.pop_back();
+            p.to->onPacket(p.mac, p.data, p.len);
+        }
+    }
+};
+
+// Hashes both inputs and its own DetRandom every frame; any divergence between
+// the two instances shows up in the per-frame hash.
+struct HashGame : NetGame {
+    struct State {
+        uint32_t hash = 2166136261u;
+        uint32_t frame = 0;
+        DetRandom rng;
+    };
+    State cur;
+    State slots[NetPlay::STATE_SLOTS];
+    uint32_t hashAt[256] = { 0 };
+
+    void netSaveState(uint8_t slot) override { slots[slot] = cur; }
+    void netLoadState(uint8_t slot) override { cur = slots[slot]; }
+    void netStep(const NetInput in[2], bool) override {
+        cur.hash = (cur.hash ^ in[0].pack()) * 16777619u;
+        cur.hash = (cur.hash ^ in[1].pack()) * 16777619u;
+        cur.hash ^= cur.rng.next();
+        hashAt[cur.frame & 255u] = cur.hash;
+        cur.frame++;
+    }
+};
+
+// Held for a random 1..20 frames, like a player tapping and holding the d-pad.
+struct ScriptedPad {
+    DetRandom rng;
+    NetInput in;
+    uint8_t holdFrames = 0;
+
+    NetInput next() {
+        if (holdFrames == 0) {
+            in.dpad = (uint8_t)rng.range(0, 16);
+            in.buttons = (uint8_t)rng.range(0, 16);
+            in.axisY = (int8_t)rng.range(-127, 128);
+            in.axisX = (int8_t)rng.range(-127, 128);
+            holdFrames = (uint8_t)rng.range(1, 21);
+        }
+        holdFrames--;
+        return in;
+    }
+};
+
+bool runSweep(const Profile& prof, uint32_t frames) {
+    constexpr uint32_t TICK_MS = 16;
+    const uint32_t giveUpMs = frames * TICK_MS * 20;
+
+    static NetPlay a, b;
+    static HashGame ga, gb;
+    a = NetPlay();
+    b = NetPlay();
+    ga = HashGame();
+    gb = HashGame();
+    LoopLink loop;
+    loop.profile = prof;
+    loop.rng.seed(0xC0FFEEu + prof.lossPct * 131u + prof.maxDelayMs);
+    LoopLink::End endA, endB;
+    endA.loop = endB.loop = &loop;
+    endA.peer = &b;
+    endB.peer = &a;
+    a.attachLink(&endA, MAC_A);
+    b.attachLink(&endB, MAC_B);
+    ScriptedPad padA, padB;
+    padA.rng.seed(1);
+    padB.rng.seed(2);
+
+    a.startSession(1);
+    b.startSession(1);
+    uint32_t checked = 0, mismatches = 0;
+    int32_t confirmed = -1;
+    while (confirmed < (int32_t)frames && loop.nowMs < giveUpMs) {
+        loop.nowMs += TICK_MS;
+        loop.deliver();
+        a.update();
+        b.update();
+        if (a.sessionRunning()) a.tick(ga, a.frame() < frames ? padA.next() : NetInput());
+        if (b.sessionRunning()) b.tick(gb, b.frame() < frames ? padB.next() : NetInput());
+
+        // A confirmed frame is final on both sides, so its hash must match.
+        const int32_t ca = a.confirmedFrame(), cb = b.confirmedFrame();
+        const int32_t both = (ca < cb) ? ca : cb;
+        for (; confirmed < both; confirmed++, checked++) {
+            const uint8_t i = (uint8_t)(confirmed + 1);
+            if (ga.hashAt[i] != gb.hashAt[i]) mismatches++;
+        }
+    }
+
+    const bool gaveUp = confirmed < (int32_t)frames;
+    printf("%-5s %3u-%3u ms %2u%% loss: %u frames checked, %u mismatches, %u ms%s\n", prof.name,
+           (unsigned)prof.minDelayMs, (unsigned)prof.maxDelayMs, (unsigned)prof.lossPct, (unsigned)checked,
+           (unsigned)mismatches, (unsigned)loop.nowMs, gaveUp ? " (GAVE UP)" : "");
+    printStats(a.stats(), b.stats());
+    return mismatches == 0 && !gaveUp;
+}
+
+// -----------------------------
+// 2. Linked matches (one process per cabinet)
+// -----------------------------
+struct GameEntry {
+    const char* name;
+    GameBase* (*create)();
+};
+
+const GameEntry GAMES[] = {
+    { "pong", [] { return (GameBase*)new PongGame(); } },
+    { "tron", [] { return (GameBase*)new TronGame(); } },
+    { "snake", [] { return (GameBase*)new SnakeGame(); } },
+};
+constexpr int GAME_COUNT = (int)(sizeof(GAMES) / sizeof(GAMES[0]));
+
+constexpr uint32_t STEP_MS = 4;             // virtual time per loop() iteration
+constexpr uint32_t LINK_GIVE_UP_MS = 5000;  // no HELLO answer by then = broken link
+constexpr uint32_t MATCH_CAP_MS = 600000;   // ten virtual minutes
+constexpr int MAX_SAMPLES = 16384;
+
+// Datagram between cabinets: one packet, or the end-of-step marker.
+struct Wire {
+    uint32_t step;    // packet: deliver at the start of this step; marker: step finished
+    uint8_t marker;   // 1 = end of step
+    uint8_t done;     // marker: this cabinet is finished (game over, or gave up)
+    uint8_t mac[6];
+    uint8_t len;
+    uint8_t data[64];
+};
+
+// Packets go out over the socket with a due step; the peer holds them until then.
+struct SocketLink : NetPlay::Link {
+    int fd = -1;
+    uint32_t step = 0;
+    Profile profile;
+    DetRandom rng;
+
+    uint32_t nowMs() override { return millis(); }
+    void send(const uint8_t* fromMac, const uint8_t* data, int len) override {
+        if ((uint32_t)rng.range(0, 100) < profile.lossPct) return;
+        Wire w = {};
+        const uint32_t delayMs = (uint32_t)rng.range(profile.minDelayMs, profile.maxDelayMs + 1);
+        w.step = step + 1 + delayMs / STEP_MS;
+        memcpy(w.mac, fromMac, 6);
+        w.len = (uint8_t)len;
+        memcpy(w.data, data, (size_t)len);
+        write(fd, &w, sizeof(w));
+    }
+};
+
+struct Sample {
+    uint32_t frame;
+    uint32_t checksum;
+};
+
+struct CabinetResult {
+    uint8_t side = 0;
+    bool linked = false;
+    bool over = false;
+    bool lost = false;
+    uint32_t endFrame = 0;
+    uint32_t finalChecksum = 0;
+    uint32_t simMs = 0;
+    NetPlay::Stats stats;
+    uint32_t samples = 0;
+    Sample sample[MAX_SAMPLES];
+};
+
+// Ends step `step` and waits for the peer to end it too; its packets are
+// queued on the way. Returns the peer's done flag (true also if it vanished).
+bool barrier(SocketLink& link, std::vector<Wire>& pending, uint32_t step, bool done) {
+    Wire m = {};
+    m.step = step;
+    m.marker = 1;
+    m.done = done ? 1 : 0;
+    write(link.fd, &m, sizeof(m));
+    for (;;) {
+        Wire w;
+        if (read(link.fd, &w, sizeof(w)) != (ssize_t)sizeof(w)) return true;
+        if (!w.marker) {
+            pending.push_back(w);
+            continue;
+        }
+        return w.done != 0;
+    }
+}
+
+void deliverDue(std::vector<Wire>& pending, uint32_t step) {
+    for (size_t i = 0; i < pending.size();) {
+        if (pending[i].step > step) {
+            i++;
+            continue;
+        }
+        globalNetPlay.onPacket(pending[i].mac, pending[i].data, pending[i].len);
+        pending.erase(pending.begin() + (long)i);
+    }
+}
+
+CabinetResult runCabinet(const GameEntry& entry, const Profile& prof, uint32_t seed, int side, int fd) {
+    CabinetResult r;
+    randomSeed(seed * 2u + (uint32_t)side);
+    Host::begin();
+    Host::useWallMicros(true);
+    SocketLink link;
+    link.fd = fd;
+    link.profile = prof;
+    link.rng.seed(seed * 7919u + (uint32_t)side);
+    globalNetPlay.attachLink(&link, side ? MAC_B : MAC_A);
+    RandomPlayer player(seed * 2654435761u + (uint32_t)side);
+    PadState idle;
+    idle.connected = true;
+    Host::setPad(0, idle);
+
+    std::vector<Wire> pending;
+    GameBase* game = nullptr;
+    NetGame* net = nullptr;
+    bool peerDone = false;
+    const uint32_t startMs = millis();
+    for (uint32_t step = 0;; step++) {
+        Host::advanceMs(STEP_MS);
+        link.step = step;
+        deliverDue(pending, step);
+
+        PadState pad = game ? player.next() : idle;
+        // B on the "WAIT PEER" screen means "play locally instead".
+        if (!globalNetPlay.sessionRunning()) pad.buttons &= (uint16_t)~PadState::BTN_B;
+        Host::setPad(0, pad);
+        globalControllerManager->update();
+
+        const uint32_t elapsed = millis() - startMs;
+        if (!game && globalNetPlay.linked()) {
+            game = entry.create();
+            net = dynamic_cast<NetGame*>(game);
+            game->start();
+            r.linked = true;
+        }
+        if (game) {
+            game->update(globalControllerManager);
+            // Current state fully confirmed: record it for the cross-check.
+            const uint32_t f = globalNetPlay.frame();
+            if (f > 0 && (int32_t)(f - 1) <= globalNetPlay.confirmedFrame() && r.samples < MAX_SAMPLES &&
+                (r.samples == 0 || r.sample[r.samples - 1].frame != f - 1)) {
+                r.sample[r.samples++] = { f - 1, net->netChecksum() };
+            }
+        }
+
+        r.over = game && game->isGameOver();
+        const bool done = r.over || (!game && elapsed >= LINK_GIVE_UP_MS) || elapsed >= MATCH_CAP_MS;
+        peerDone = barrier(link, pending, step, done);
+        if (done && peerDone) break;
+    }
+
+    r.side = globalNetPlay.localSide();
+    r.lost = globalNetPlay.sessionLost();
+    r.endFrame = globalNetPlay.frame();
+    r.finalChecksum = net ? net->netChecksum() : 0;
+    r.simMs = millis() - startMs;
+    r.stats = globalNetPlay.stats();
+    delete game;
+    return r;
+}
+
+bool runMatch(const GameEntry& entry, const Profile& prof, uint32_t seed) {
+    int sv[2];
+    int res[2][2];
+    if (socketpair(AF_UNIX, SOCK_DGRAM, 0, sv) != 0 || pipe(res[0]) != 0 || pipe(res[1]) != 0) {
+        perror("netplay_test");
+        return false;
+    }
+    fflush(stdout);
+    pid_t pids[2];
+    for (int side = 0; side < 2; side++) {
+        pids[side] = fork();
+        if (pids[side] == 0) {
+            close(sv[1 - side]);
+            static CabinetResult r;
+            r = runCabinet(entry, prof, seed, side, sv[side]);
+            const char* p = (const char*)&r;
+            for (size_t n = 0; n < sizeof(r);) {
+                const ssize_t w = write(res[side][1], p + n, sizeof(r) - n);
+                if (w <= 0) break;
+                n += (size_t)w;
+            }
+            _exit(0);
+        }
+    }
+    close(sv[0]);
+    close(sv[1]);
+
+    static CabinetResult r[2];
+    bool got[2] = { false, false };
+    for (int side = 0; side < 2; side++) {
+        close(res[side][1]);
+        char* p = (char*)&r[side];
+        size_t n = 0;
+        while (n < sizeof(CabinetResult)) {
+            const ssize_t got = read(res[side][0], p + n, sizeof(CabinetResult) - n);
+            if (got <= 0) break;
+            n += (size_t)got;
+        }
+        got[side] = (n == sizeof(CabinetResult));
+        close(res[side][0]);
+        int status = 0;
+        waitpid(pids[side], &status, 0);
+    }
+
+    printf("%-5s %-4s seed %u: ", entry.name, prof.name, (unsigned)seed);
+    if (!got[0] || !got[1]) {
+        printf("FAIL: cabinet crashed\n");
+        return false;
+    }
+    if (!r[0].linked || !r[1].linked) {
+        printf("FAIL: never linked\n");
+        return false;
+    }
+
+    // Per-frame cross-check on frames both cabinets recorded (sorted by frame).
+    uint32_t checked = 0, mismatches = 0, firstBad = 0;
+    for (uint32_t i = 0, j = 0; i < r[0].samples && j < r[1].samples;) {
+        const Sample& s0 = r[0].sample[i];
+        const Sample& s1 = r[1].sample[j];
+        if (s0.frame < s1.frame) {
+            i++;
+        } else if (s1.frame < s0.frame) {
+            j++;
+        } else {
+            if (s0.checksum != s1.checksum && mismatches++ == 0) firstBad = s0.frame;
+            checked++;
+            i++;
+            j++;
+        }
+    }
+    bool ok = mismatches == 0;
+    const bool bothOver = r[0].over && r[1].over && !r[0].lost && !r[1].lost;
+    if (bothOver && r[0].finalChecksum != r[1].finalChecksum) ok = false;
+
+    printf("%s, %u frames, %u ms, %u confirmed frames cross-checked", bothOver ? "game over" : "CAP", (unsigned)r[0].endFrame,
+           (unsigned)r[0].simMs, (unsigned)checked);
+    if (mismatches) printf(", %u MISMATCHES (first at frame %u)", (unsigned)mismatches, (unsigned)firstBad);
+    if (bothOver) printf(", final %08x/%08x", (unsigned)r[0].finalChecksum, (unsigned)r[1].finalChecksum);
+    printf("%s\n", ok ? "" : "  FAIL");
+    printStats(r[0].stats, r[1].stats);
+    if (r[0].lost || r[1].lost) {
+        printf("  FAIL: session lost\n");
+        return false;
+    }
+    return ok;
+}
+
+int findGame(const char* name) {
+    for (int i = 0; i < GAME_COUNT; i++) {
+        if (!strcmp(GAMES[i].name, name)) return i;
+    }
+    return -1;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int onlyGame = -1;
+    uint32_t seedBase = 1;
+    uint32_t seeds = 2;
+    uint32_t frames = 1200;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (!strcmp(argv[i], "--game")) {
+            onlyGame = findGame(argv[i + 1]);
+            if (onlyGame < 0) {
+                fprintf(stderr, "netplay_test: unknown game '%s'\n", argv[i + 1]);
+                return 2;
+            }
+        } else if (!strcmp(argv[i], "--seed")) {
+            seedBase = (uint32_t)strtoul(argv[i + 1], nullptr, 0);
+            seeds = 1;
+        } else if (!strcmp(argv[i], "--seeds")) {
+            seeds = (uint32_t)strtoul(argv[i + 1], nullptr, 0);
+        } else if (!strcmp(argv[i], "--frames")) {
+            frames = (uint32_t)strtoul(argv[i + 1], nullptr, 0);
+        }
+    }
+
+    int failures = 0;
+    if (onlyGame < 0) {
+        printf("-- sweep: %u frames per profile, %u ms tick\n", (unsigned)frames, 16u);
+        Host::useWallMicros(true);
+        for (const Profile& p : SWEEP) {
+            if (!runSweep(p, frames)) failures++;
+        }
+    }
+
+    printf("-- linked matches: %u ms steps\n", (unsigned)STEP_MS);
+    for (int g = 0; g < GAME_COUNT; g++) {
+        if (onlyGame >= 0 && g != onlyGame) continue;
+        for (const Profile& p : MATCH_PROFILES) {
+            for (uint32_t s = 0; s < seeds; s++) {
+                if (!runMatch(GAMES[g], p, seedBase + s)) failures++;
+            }
+        }
+    }
+
+    printf("%s\n", failures ? "FAIL" : "OK");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,101 @@
+// PixelBench.cpp
+// -----------------------------------------------------------------------------
+// Pixel565 kernel throughput in pixels per microsecond (engine/Pixel565.h):
+// a per-pixel loop over the colour helpers (what the games did before), the
+// two-pixels-per-word kernels (what the ESP32 runs) and, when the build has
+// SSE2/NEON, the eight-pixel vector kernels. One panel-sized buffer (64x64),
+// real time. Built with -fno-tree-vectorize, so the scalar and word columns
+// are the loops the ESP32 runs, not the compiler's own SIMD versions of them.
+//
+//   pixel_bench [--passes N]
+// -----------------------------------------------------------------------------
+#include "HostRuntime.h"
+#include "RandomPlayer.h"
+
+#include "engine/Pixel565.h"
+
+namespace {
+
+constexpr size_t PIXELS = PANEL_RES_X * PANEL_RES_Y;
+
+alignas(16) uint16_t gDst[PIXELS];
+alignas(16) uint16_t gSrc[PIXELS];
+uint8_t gMask[PIXELS];
+uint8_t gLut[256];
+volatile uint16_t gSink;
+
+template <typename Fn>
+double pixelsPerUs(uint32_t passes, Fn fn) {
+    const uint64_t t0 = Host::wallUs();
+    for (uint32_t p = 0; p < passes; p++) fn();
+    const uint64_t us = Host::wallUs() - t0;
+    gSink = gDst[passes % PIXELS];
+    return us ? (double)PIXELS * passes / (double)us : 0.0;
+}
+
+void scalarScale(uint8_t m) {
+    for (size_t i = 0; i < PIXELS; i++) gDst[i] = Pixel565::scale(gDst[i], m);
+}
+void scalarAddSat() {
+    for (size_t i = 0; i < PIXELS; i++) gDst[i] = Pixel565::addSat(gDst[i], gSrc[i]);
+}
+void scalarAvg() {
+    for (size_t i = 0; i < PIXELS; i++) gDst[i] = Pixel565::avg(gDst[i], gSrc[i]);
+}
+void scalarBlend(uint8_t a) {
+    for (size_t i = 0; i < PIXELS; i++) gDst[i] = Pixel565::blend(gDst[i], gSrc[i], a);
+}
+void scalarBlendMask() {
+    for (size_t i = 0; i < PIXELS; i++) gDst[i] = Pixel565::blend(gDst[i], gSrc[i], gLut[gMask[i]]);
+}
+
+void row(const char* label, double scalar, double word, double vec) {
+    printf("%-10s %8.0f %8.0f", label, scalar, word);
+    if (PIXEL565_SIMD && vec >= 0) printf(" %8.0f", vec);
+    else if (PIXEL565_SIMD) printf(" %8s", "-");
+    printf("\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    uint32_t passes = 2000;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (!strcmp(argv[i], "--passes")) passes = (uint32_t)strtoul(argv[i + 1], nullptr, 0);
+    }
+
+    XorShift rng(1);
+    for (size_t i = 0; i < PIXELS; i++) {
+        gDst[i] = (uint16_t)rng.next();
+        gSrc[i] = (uint16_t)rng.next();
+        // 64-pixel rows: soft edge, sprite body, outside.
+        gMask[i] = (i % 64 < 8) ? (uint8_t)(i % 64 * 32) : (i % 64 < 40 ? 255 : 0);
+    }
+    for (int i = 0; i < 256; i++) gLut[i] = (uint8_t)(i * i / 255);
+
+    uint16_t* d = gDst;
+    const uint16_t* s = gSrc;
+    const size_t n = PIXELS;
+    printf("px/us, %zu-pixel buffer, %u passes\n", n, (unsigned)passes);
+    printf("%-10s %8s %8s%s\n", "kernel", "scalar", "word", PIXEL565_SIMD ? "   vector" : "");
+#if PIXEL565_SIMD
+#define VEC(expr) pixelsPerUs(passes, [&] { expr; })
+#else
+#define VEC(expr) 0.0
+#endif
+    row("fill", pixelsPerUs(passes, [&] { for (size_t i = 0; i < n; i++) d[i] = 0x1234; }),
+        pixelsPerUs(passes, [&] { Pixel565::swar::fill(d, n, 0x1234); }), -1.0); // no vector fill
+    row("scale", pixelsPerUs(passes, [] { scalarScale(200); }),
+        pixelsPerUs(passes, [&] { Pixel565::swar::scale(d, n, 200); }), VEC(Pixel565::simd::scale(d, n, 200)));
+    row("addSat", pixelsPerUs(passes, [] { scalarAddSat(); }),
+        pixelsPerUs(passes, [&] { Pixel565::swar::addSat(d, s, n); }), VEC(Pixel565::simd::addSat(d, s, n)));
+    row("avg", pixelsPerUs(passes, [] { scalarAvg(); }),
+        pixelsPerUs(passes, [&] { Pixel565::swar::avg(d, s, n); }), VEC(Pixel565::simd::avg(d, s, n)));
+    row("blend", pixelsPerUs(passes, [] { scalarBlend(100); }),
+        pixelsPerUs(passes, [&] { Pixel565::swar::blend(d, s, n, 100); }), VEC(Pixel565::simd::blend(d, s, n, 100)));
+    row("blendMask", pixelsPerUs(passes, [] { scalarBlendMask(); }),
+        pixelsPerUs(passes, [&] { Pixel565::swar::blendMask(d, s, gMask, n, gLut); }),
+        VEC(Pixel565::simd::blendMask(d, s, gMask, n, gLut)));
+#undef VEC
+    return 0;
+}
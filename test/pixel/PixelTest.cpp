@@ -0,0 +1,280 @@
+// PixelTest.cpp
+// -----------------------------------------------------------------------------
+// Pixel565 kernels against a plain per-channel reference (engine/Pixel565.h).
+//
+// Every backend this build has (swar, simd when PIXEL565_SIMD, and the public
+// kernels that dispatch between them) must be bit-identical to the reference:
+// - scale: every colour x every factor;
+// - addSat, avg: every colour against a permuted every-colour buffer, plus
+//   every channel pair;
+// - blend: every channel pair x every alpha, every colour at a sweep of alphas;
+// - blendMask: random soft-edged masks, with and without a LUT;
+// - all of them at every dst/src alignment for lengths 0..40, with guard
+//   pixels around dst that must stay untouched.
+// The colour helpers themselves and div255 over its range are checked too.
+// -----------------------------------------------------------------------------
+#include "HostRuntime.h"
+#include "RandomPlayer.h"
+
+#include <vector>
+
+#include "engine/Pixel565.h"
+
+namespace {
+
+// -----------------------------
+// Reference (no shared code with Pixel565)
+// -----------------------------
+struct Rgb {
+    int r, g, b;
+};
+Rgb split(uint16_t c) { return { c >> 11, (c >> 5) & 63, c & 31 }; }
+uint16_t join(int r, int g, int b) { return (uint16_t)((r << 11) | (g << 5) | b); }
+
+uint16_t refScale(uint16_t c, int m) {
+    const Rgb x = split(c);
+    return join(x.r * m / 255, x.g * m / 255, x.b * m / 255);
+}
+uint16_t refAddSat(uint16_t a, uint16_t b) {
+    const Rgb x = split(a), y = split(b);
+    return join(std::min(x.r + y.r, 31), std::min(x.g + y.g, 63), std::min(x.b + y.b, 31));
+}
+uint16_t refAvg(uint16_t a, uint16_t b) {
+    const Rgb x = split(a), y = split(b);
+    return join((x.r + y.r) / 2, (x.g + y.g) / 2, (x.b + y.b) / 2);
+}
+uint16_t refBlend(uint16_t d, uint16_t s, int a) {
+    const Rgb x = split(d), y = split(s);
+    return join((y.r * a + x.r * (255 - a)) / 255, (y.g * a + x.g * (255 - a)) / 255,
+                (y.b * a + x.b * (255 - a)) / 255);
+}
+
+// -----------------------------
+// Backends
+// -----------------------------
+struct Backend {
+    const char* name;
+    void (*fill)(uint16_t*, size_t, uint16_t);
+    void (*scale)(uint16_t*, size_t, uint8_t);
+    void (*addSat)(uint16_t*, const uint16_t*, size_t);
+    void (*avg)(uint16_t*, const uint16_t*, size_t);
+    void (*blend)(uint16_t*, const uint16_t*, size_t, uint8_t);
+    void (*blendMask)(uint16_t*, const uint16_t*, const uint8_t*, size_t, const uint8_t*);
+};
+
+const Backend BACKENDS[] = {
+    { "swar", Pixel565::swar::fill, Pixel565::swar::scale, Pixel565::swar::addSat, Pixel565::swar::avg,
+      Pixel565::swar::blend, Pixel565::swar::blendMask },
+#if PIXEL565_SIMD
+    { "simd", Pixel565::swar::fill, Pixel565::simd::scale, Pixel565::simd::addSat, Pixel565::simd::avg,
+      Pixel565::simd::blend, Pixel565::simd::blendMask },
+#endif
+    { "public", Pixel565::fill, Pixel565::scale, Pixel565::addSat, Pixel565::avg, Pixel565::blend,
+      [](uint16_t* d, const uint16_t* s, const uint8_t* m, size_t n, const uint8_t* lut) {
+          Pixel565::blendMask(d, s, m, n, lut);
+      } },
+};
+
+uint64_t gChecks = 0;
+uint32_t gFailures = 0;
+
+void expect(bool ok, const char* what, const char* backend, size_t i, uint32_t got, uint32_t want) {
+    gChecks++;
+    if (ok) return;
+    if (gFailures++ < 10) {
+        printf("  FAIL %s [%s] at %zu: got %04x, want %04x\n", what, backend, i, (unsigned)got, (unsigned)want);
+    }
+}
+
+// got[i] == want(i) for i < n.
+template <typename Want>
+void expectAll(const char* what, const char* backend, const uint16_t* got, size_t n, Want want) {
+    for (size_t i = 0; i < n; i++) {
+        const uint16_t w = want(i);
+        expect(got[i] == w, what, backend, i, got[i], w);
+    }
+}
+
+constexpr size_t ALL = 65536;
+
+// Every channel value of `a` against every one of `b`: pixel k pairs
+// x = k / 64 with y = k % 64 in all three channels (R and B wrap at 32).
+void channelPairs(std::vector<uint16_t>& a, std::vector<uint16_t>& b) {
+    a.resize(4096);
+    b.resize(4096);
+    for (int k = 0; k < 4096; k++) {
+        const int x = k >> 6, y = k & 63;
+        a[k] = join(x & 31, x, (x * 7) & 31);
+        b[k] = join(y & 31, y, (y * 7) & 31);
+    }
+}
+
+// -----------------------------
+// Cases
+// -----------------------------
+void testHelpers() {
+    for (uint32_t x = 0; x <= 63u * 255u; x++) {
+        const uint32_t lanes = x | (x << 16);
+        const uint32_t q = Pixel565::swar::div255(lanes);
+        expect(q == ((x / 255) | ((x / 255) << 16)), "div255", "swar", x, q, x / 255);
+    }
+    for (uint32_t c = 0; c < ALL; c++) {
+        for (int m = 0; m < 256; m += 17) {
+            expect(Pixel565::scale((uint16_t)c, (uint8_t)m) == refScale((uint16_t)c, m), "scale(c)", "helper", c,
+                   Pixel565::scale((uint16_t)c, (uint8_t)m), refScale((uint16_t)c, m));
+        }
+        const uint16_t o = (uint16_t)(c * 40503u);
+        expect(Pixel565::addSat((uint16_t)c, o) == refAddSat((uint16_t)c, o), "addSat(c)", "helper", c,
+               Pixel565::addSat((uint16_t)c, o), refAddSat((uint16_t)c, o));
+        expect(Pixel565::avg((uint16_t)c, o) == refAvg((uint16_t)c, o), "avg(c)", "helper", c,
+               Pixel565::avg((uint16_t)c, o), refAvg((uint16_t)c, o));
+        expect(Pixel565::blend((uint16_t)c, o, (uint8_t)c) == refBlend((uint16_t)c, o, c & 255), "blend(c)", "helper",
+               c, Pixel565::blend((uint16_t)c, o, (uint8_t)c), refBlend((uint16_t)c, o, c & 255));
+    }
+}
+
+void testScale(const Backend& be) {
+    std::vector<uint16_t> buf(ALL);
+    for (int m = 0; m < 256; m++) {
+        for (size_t i = 0; i < ALL; i++) buf[i] = (uint16_t)i;
+        be.scale(buf.data(), ALL, (uint8_t)m);
+        expectAll("scale", be.name, buf.data(), ALL, [m](size_t i) { return refScale((uint16_t)i, m); });
+    }
+}
+
+void testBinary(const Backend& be) {
+    std::vector<uint16_t> a(ALL), b(ALL), d;
+    for (uint32_t mul : { 40503u, 1u, 65535u, 2654435761u }) {
+        for (size_t i = 0; i < ALL; i++) {
+            a[i] = (uint16_t)i;
+            b[i] = (uint16_t)(i * mul + 12345u);
+        }
+        d = a;
+        be.addSat(d.data(), b.data(), ALL);
+        expectAll("addSat", be.name, d.data(), ALL, [&](size_t i) { return refAddSat(a[i], b[i]); });
+        d = a;
+        be.avg(d.data(), b.data(), ALL);
+        expectAll("avg", be.name, d.data(), ALL, [&](size_t i) { return refAvg(a[i], b[i]); });
+        for (int alpha = 1; alpha < 255; alpha += 11) {
+            d = a;
+            be.blend(d.data(), b.data(), ALL, (uint8_t)alpha);
+            expectAll("blend", be.name, d.data(), ALL, [&](size_t i) { return refBlend(a[i], b[i], alpha); });
+        }
+    }
+
+    channelPairs(a, b);
+    d = a;
+    be.addSat(d.data(), b.data(), a.size());
+    expectAll("addSat pairs", be.name, d.data(), a.size(), [&](size_t i) { return refAddSat(a[i], b[i]); });
+    d = a;
+    be.avg(d.data(), b.data(), a.size());
+    expectAll("avg pairs", be.name, d.data(), a.size(), [&](size_t i) { return refAvg(a[i], b[i]); });
+    for (int alpha = 0; alpha < 256; alpha++) {
+        d = a;
+        be.blend(d.data(), b.data(), a.size(), (uint8_t)alpha);
+        expectAll("blend pairs", be.name, d.data(), a.size(), [&](size_t i) { return refBlend(a[i], b[i], alpha); });
+    }
+}
+
+// Soft-edged sprite rows: runs of 0 and 255 with ramps between, some noise.
+void makeMask(XorShift& rng, uint8_t* mask, size_t n) {
+    size_t i = 0;
+    while (i < n) {
+        const int kind = (int)rng.range(4);
+        const size_t run = 1 + rng.range(24);
+        for (size_t k = 0; k < run && i < n; k++, i++) {
+            mask[i] = kind == 0 ? 0 : kind == 1 ? 255 : kind == 2 ? (uint8_t)(k * 255 / run) : (uint8_t)rng.next();
+        }
+    }
+}
+
+void testBlendMask(const Backend& be) {
+    XorShift rng(73);
+    uint8_t lut[256];
+    for (int i = 0; i < 256; i++) lut[i] = (uint8_t)(i * i / 255); // gamma-ish ramp, lut[0] = 0, lut[255] = 255
+    uint8_t shifted[256];
+    for (int i = 0; i < 256; i++) shifted[i] = (uint8_t)(255 - i);   // inverts: 0 -> full source
+    const uint8_t* luts[] = { nullptr, lut, shifted };
+    std::vector<uint16_t> a(ALL), b(ALL), d;
+    std::vector<uint8_t> mask(ALL);
+    for (const uint8_t* l : luts) {
+        for (size_t i = 0; i < ALL; i++) {
+            a[i] = (uint16_t)rng.next();
+            b[i] = (uint16_t)rng.next();
+        }
+        makeMask(rng, mask.data(), ALL);
+        d = a;
+        be.blendMask(d.data(), b.data(), mask.data(), ALL, l);
+        expectAll("blendMask", be.name, d.data(), ALL,
+                  [&](size_t i) { return refBlend(a[i], b[i], l ? l[mask[i]] : mask[i]); });
+    }
+}
+
+// Heads and tails: every dst/src offset and short lengths, with guards.
+void testEdges(const Backend& be) {
+    constexpr size_t MAX_N = 40;
+    constexpr uint16_t GUARD = 0xBEEF;
+    XorShift rng(5);
+    alignas(16) uint16_t dstBuf[MAX_N + 16];
+    alignas(16) uint16_t srcBuf[MAX_N + 16];
+    alignas(16) uint16_t orig[MAX_N + 16];
+    uint8_t mask[MAX_N + 16];
+    for (size_t dOff = 1; dOff <= 4; dOff++) {
+        for (size_t sOff = 0; sOff <= 3; sOff++) {
+            for (size_t n = 0; n <= MAX_N; n++) {
+                for (int op = 0; op < 6; op++) {
+                    for (size_t i = 0; i < MAX_N + 16; i++) {
+                        orig[i] = (uint16_t)rng.next();
+                        srcBuf[i] = (uint16_t)rng.next();
+                        mask[i] = (uint8_t)(rng.range(3) == 0 ? rng.next() : rng.range(2) * 255);
+                    }
+                    for (size_t i = 0; i < MAX_N + 16; i++) dstBuf[i] = GUARD;
+                    memcpy(dstBuf + dOff, orig + dOff, n * sizeof(uint16_t));
+                    uint16_t* d = dstBuf + dOff;
+                    const uint16_t* s = srcBuf + sOff;
+                    const uint8_t* m = mask + sOff;
+                    const uint8_t alpha = (uint8_t)(1 + rng.range(254));
+                    switch (op) {
+                        case 0: be.fill(d, n, 0x5A5A); break;
+                        case 1: be.scale(d, n, alpha); break;
+                        case 2: be.addSat(d, s, n); break;
+                        case 3: be.avg(d, s, n); break;
+                        case 4: be.blend(d, s, n, alpha); break;
+                        default: be.blendMask(d, s, m, n, nullptr); break;
+                    }
+                    for (size_t i = 0; i < n; i++) {
+                        const uint16_t o = orig[dOff + i];
+                        const uint16_t want = op == 0 ? 0x5A5A
+                                              : op == 1 ? refScale(o, alpha)
+                                              : op == 2 ? refAddSat(o, s[i])
+                                              : op == 3 ? refAvg(o, s[i])
+                                              : op == 4 ? refBlend(o, s[i], alpha)
+                                                        : refBlend(o, s[i], m[i]);
+                        expect(d[i] == want, "edges", be.name, i, d[i], want);
+                    }
+                    expectAll("guard before", be.name, dstBuf, dOff, [](size_t) { return GUARD; });
+                    expectAll("guard after", be.name, d + n, MAX_N + 16 - dOff - n, [](size_t) { return GUARD; });
+                }
+            }
+        }
+    }
+}
+
+} // namespace
+
+int main() {
+    printf("Pixel565: SIMD path %s\n", PIXEL565_SIMD ? "on" : "off");
+    testHelpers();
+    for (const Backend& be : BACKENDS) {
+        const uint64_t before = gChecks;
+        const uint32_t failuresBefore = gFailures;
+        testScale(be);
+        testBinary(be);
+        testBlendMask(be);
+        testEdges(be);
+        printf("%-6s %10llu checks, %u mismatches\n", be.name, (unsigned long long)(gChecks - before),
+               (unsigned)(gFailures - failuresBefore));
+    }
+    printf("%llu checks, %s\n", (unsigned long long)gChecks, gFailures ? "FAIL" : "OK");
+    return gFailures ? 1 : 0;
+}
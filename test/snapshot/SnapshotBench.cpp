@@ -0,0 +1,165 @@
+// SnapshotBench.cpp
+// -----------------------------------------------------------------------------
+// Per-game cost of the instant-resume path (engine/Snapshot.h,
+// engine/ResumeStore.h) on mid-game states:
+//
+// - capture / restore time (target: well under 1 ms per call),
+// - snapshot and delta sizes against RESUME_MAX_BYTES,
+// - round trip: restore(capture(g)) into a fresh game captures the same bytes,
+//   and ResumeStore::save()/restore() through NVS does too.
+//
+// Each game is played with random input to a few checkpoints. Fails (exit 1)
+// on a round-trip mismatch or a snapshot that does not fit.
+//
+//   snapshot_bench [--frames N] [--reps N]
+// -----------------------------------------------------------------------------
+#include "HostRuntime.h"
+#include "RandomPlayer.h"
+
+#include <vector>
+
+#include "engine/ResumeStore.h"
+#include "engine/Snapshot.h"
+#include "Games/Snake/SnakeGame.h"
+#include "Games/Tron/TronGame.h"
+#include "Games/Tetris/TetrisGame.h"
+#include "Games/BomberMan/BomberManGame.h"
+#include "Games/Minesweeper/MinesweeperGame.h"
+
+namespace {
+
+// Menu slots as in createGameForMenu().
+struct GameEntry {
+    const char* name;
+    uint8_t slot;
+    GameBase* (*create)();
+};
+
+const GameEntry GAMES[] = {
+    { "snake", 0, [] { return (GameBase*)new SnakeGame(); } },
+    { "tron", 1, [] { return (GameBase*)new TronGame(); } },
+    { "tetris", 6, [] { return (GameBase*)new TetrisGame(); } },
+    { "bomber", 10, [] { return (GameBase*)new BomberManGame(); } },
+    { "mines", 13, [] { return (GameBase*)new MinesweeperGame(); } },
+};
+
+constexpr uint32_t STEP_MS = 2;
+constexpr int CHECKPOINTS = 4;
+
+struct Stats {
+    double captureUs = 0, restoreUs = 0, maxCaptureUs = 0, maxRestoreUs = 0;
+    size_t maxBytes = 0, maxDelta = 0;
+    int samples = 0;
+};
+
+void play(GameBase& g, RandomPlayer& player, uint32_t frames) {
+    for (uint32_t i = 0; i < frames && !g.isGameOver(); i++) {
+        Host::advanceMs(STEP_MS);
+        Host::setPad(0, player.next());
+        globalControllerManager->update();
+        g.update(globalControllerManager);
+    }
+}
+
+bool same(const uint8_t* a, size_t aLen, const uint8_t* b, size_t bLen) {
+    return aLen == bLen && memcmp(a, b, aLen) == 0;
+}
+
+// One checkpoint: time capture and restore, check both round trips.
+bool measure(const GameEntry& e, GameBase& g, const uint8_t* prev, size_t prevLen, uint8_t* snap, size_t& len,
+             int reps, Stats& st) {
+    static uint8_t again[RESUME_MAX_BYTES];
+    static uint8_t delta[RESUME_MAX_BYTES];
+
+    uint64_t t0 = Host::wallUs();
+    for (int i = 0; i < reps; i++) len = Snapshot::capture(g, snap, RESUME_MAX_BYTES);
+    const double capUs = (double)(Host::wallUs() - t0) / reps;
+    if (len == 0) {
+        printf("FAIL %s: capture failed (snapshot larger than RESUME_MAX_BYTES=%d?)\n", e.name, RESUME_MAX_BYTES);
+        return false;
+    }
+
+    GameBase* fresh = e.create();
+    fresh->start();
+    bool ok = true;
+    t0 = Host::wallUs();
+    for (int i = 0; i < reps && ok; i++) ok = Snapshot::restore(*fresh, snap, len);
+    const double resUs = (double)(Host::wallUs() - t0) / reps;
+    const size_t againLen = ok ? Snapshot::capture(*fresh, again, sizeof(again)) : 0;
+    delete fresh;
+    if (!ok || !same(snap, len, again, againLen)) {
+        printf("FAIL %s: restore(capture()) does not round-trip (%zu vs %zu bytes)\n", e.name, len, againLen);
+        return false;
+    }
+
+    // Through NVS, as after a reboot.
+    if (!ResumeStore::save(e.slot, g) || ResumeStore::peekSlot() != e.slot) {
+        printf("FAIL %s: ResumeStore::save failed\n", e.name);
+        return false;
+    }
+    fresh = e.create();
+    fresh->start();
+    ok = ResumeStore::restore(*fresh);
+    const size_t nvsLen = ok ? Snapshot::capture(*fresh, again, sizeof(again)) : 0;
+    delete fresh;
+    if (!ok || !same(snap, len, again, nvsLen)) {
+        printf("FAIL %s: ResumeStore round trip differs\n", e.name);
+        return false;
+    }
+
+    const size_t dLen = prevLen ? Snapshot::encodeDelta(prev, prevLen, snap, len, delta, sizeof(delta)) : 0;
+    st.captureUs += capUs;
+    st.restoreUs += resUs;
+    st.maxCaptureUs = std::max(st.maxCaptureUs, capUs);
+    st.maxRestoreUs = std::max(st.maxRestoreUs, resUs);
+    st.maxBytes = std::max(st.maxBytes, len);
+    st.maxDelta = std::max(st.maxDelta, dLen);
+    st.samples++;
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    uint32_t frames = 15000; // between checkpoints (30 s of play)
+    int reps = 200;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (!strcmp(argv[i], "--frames")) frames = (uint32_t)strtoul(argv[i + 1], nullptr, 0);
+        else if (!strcmp(argv[i], "--reps")) reps = std::max(1, atoi(argv[i + 1]));
+    }
+
+    randomSeed(1);
+    Host::begin();
+    RandomPlayer player(12345);
+    Host::setPad(0, player.next());
+    globalControllerManager->update();
+
+    printf("%-8s %8s %8s %8s %8s %8s %8s\n", "game", "bytes", "delta", "cap us", "max", "rest us", "max");
+    int failures = 0;
+    for (const GameEntry& e : GAMES) {
+        GameBase* g = e.create();
+        g->start();
+        Stats st;
+        std::vector<uint8_t> prev(RESUME_MAX_BYTES), snap(RESUME_MAX_BYTES);
+        size_t prevLen = 0;
+        bool ok = true;
+        for (int c = 0; c < CHECKPOINTS && ok; c++) {
+            play(*g, player, c == 0 ? frames / 10 : frames);
+            if (g->isGameOver()) g->reset();
+            size_t len = 0;
+            ok = measure(e, *g, prev.data(), prevLen, snap.data(), len, reps, st);
+            prev.swap(snap);
+            prevLen = len;
+        }
+        delete g;
+        ResumeStore::clear();
+        if (!ok) {
+            failures++;
+            continue;
+        }
+        printf("%-8s %8zu %8zu %8.2f %8.2f %8.2f %8.2f\n", e.name, st.maxBytes, st.maxDelta,
+               st.captureUs / st.samples, st.maxCaptureUs, st.restoreUs / st.samples, st.maxRestoreUs);
+    }
+    printf("(host timings; on the device DEBUG_RESUME logs each save with its NVS time)\n");
+    return failures ? 1 : 0;
+}
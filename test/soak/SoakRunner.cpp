@@ -0,0 +1,328 @@
+// SoakRunner.cpp
+// -----------------------------------------------------------------------------
+// Runs every game under random pad input on the virtual clock, with ASan/UBSan,
+// and checks GameBase::checkInvariants() after every update.
+//
+// One shard = one (game, seed) pair in its own forked process, so a crash or a
+// sanitizer report kills only that shard and the rest keep going. Shards run
+// -j at a time (default: one per core).
+//
+//   soak                         all games, 4 seeds, 200k frames each
+//   soak --game tron --seeds 16  one game, more seeds
+//   soak --game tron --seed 7    reproduce one shard (printed on failure)
+//
+// A frame is one loop() iteration of the sketch: input update, game update,
+// invariant check, draw at the game's preferred render rate, then the loop
+// delay. On game over the score is submitted, the GAME OVER screen stays up
+// for a second and the game is reset(), as if A was pressed.
+// -----------------------------------------------------------------------------
+#include "HostRuntime.h"
+#include "RandomPlayer.h"
+
+#include <sys/wait.h>
+#include <unistd.h>
+#include <thread>
+#include <vector>
+
+#include "engine/Leaderboard.h"
+#include "Games/Snake/SnakeGame.h"
+#include "Games/Tron/TronGame.h"
+#include "Games/Pong/PongGame.h"
+#include "Games/Breakout/BreakoutGame.h"
+#include "Games/Shooter/ShooterGame.h"
+#include "Games/Labyrinth/LabyrinthGame.h"
+#include "Games/Tetris/TetrisGame.h"
+#include "Games/Asteroids/AsteroidsGame.h"
+#include "Games/Music/MusicApp.h"
+#include "Games/MVisual/MVisualApp.h"
+#include "Games/BomberMan/BomberManGame.h"
+#include "Games/Simon/SimonGame.h"
+#include "Games/DinoRun/DinoRunGame.h"
+#include "Games/Minesweeper/MinesweeperGame.h"
+#include "Games/MatrixRain/MatrixRainApp.h"
+#include "Games/LavaLamp/LavaLampApp.h"
+
+namespace {
+
+// Same order as createGameForMenu() in the sketch.
+struct GameEntry {
+    const char* name;
+    GameBase* (*create)();
+};
+
+const GameEntry GAMES[] = {
+    { "snake", [] { return (GameBase*)new SnakeGame(); } },
+    { "tron", [] { return (GameBase*)new TronGame(); } },
+    { "pong", [] { return (GameBase*)new PongGame(); } },
+    { "breakout", [] { return (GameBase*)new BreakoutGame(); } },
+    { "shooter", [] { return (GameBase*)new ShooterGame(); } },
+    { "labyrinth", [] { return (GameBase*)new LabyrinthGame(); } },
+    { "tetris", [] { return (GameBase*)new TetrisGame(); } },
+    { "asteroids", [] { return (GameBase*)new AsteroidsGame(); } },
+    { "music", [] { return (GameBase*)new MusicApp(); } },
+    { "mvisual", [] { return (GameBase*)new MVisualApp(); } },
+    { "bomber", [] { return (GameBase*)new BomberManGame(); } },
+    { "simon", [] { return (GameBase*)new SimonGame(); } },
+    { "dino", [] { return (GameBase*)new DinoRunGame(); } },
+    { "mines", [] { return (GameBase*)new MinesweeperGame(); } },
+    { "matrix", [] { return (GameBase*)new MatrixRainApp(); } },
+    { "lava", [] { return (GameBase*)new LavaLampApp(); } },
+};
+constexpr int GAME_COUNT = (int)(sizeof(GAMES) / sizeof(GAMES[0]));
+
+struct Options {
+    int game = -1;          // -1 = all
+    uint32_t seedBase = 1;
+    uint32_t seeds = 4;
+    uint32_t frames = 200000;
+    uint32_t stepMs = 2;    // virtual time per frame (loop work + loop delay)
+    unsigned jobs = 0;      // 0 = hardware concurrency
+};
+
+struct ShardResult {
+    uint32_t frames = 0;
+    uint32_t draws = 0;
+    uint32_t gameOvers = 0;
+    uint64_t wallUs = 0;
+    uint64_t simMs = 0;
+    char failure[160] = { 0 }; // empty = passed
+};
+
+void fail(ShardResult& r, const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+void fail(ShardResult& r, const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(r.failure, sizeof(r.failure), fmt, args);
+    va_end(args);
+}
+
+ShardResult runShard(const GameEntry& entry, uint32_t seed, const Options& opt) {
+    ShardResult r;
+    randomSeed(seed);
+    Host::begin();
+    RandomPlayer player(seed * 2654435761u);
+    PadState second; // pad 1 occasionally connects or drops out mid-game
+    Host::setPad(0, player.next());
+    globalControllerManager->update();
+
+    MatrixPanel_I2S_DMA& panel = Host::panel();
+    GameBase* game = entry.create();
+    game->start();
+
+    const uint64_t wallStart = Host::wallUs();
+    const uint64_t simStart = Host::nowUs();
+    uint32_t lastRenderMs = millis();
+    uint32_t overSinceMs = 0;
+    bool submitted = false;
+
+    for (r.frames = 0; r.frames < opt.frames; r.frames++) {
+        Host::advanceMs(opt.stepMs);
+        const uint32_t nowMs = millis();
+        Host::setPad(0, player.next());
+        if (player.chance(20000)) {
+            second.connected = !second.connected;
+            Host::setPad(1, second);
+        }
+        globalControllerManager->update();
+        globalAudio.update();
+
+        game->update(globalControllerManager);
+        if (const char* why = game->checkInvariants()) {
+            fail(r, "invariant: %s (frame %u)", why, (unsigned)r.frames);
+            break;
+        }
+
+        const uint16_t fps = game->preferredRenderFps();
+        if (fps == 0 || (uint32_t)(nowMs - lastRenderMs) >= 1000u / fps) {
+            lastRenderMs = nowMs;
+            game->draw(&panel);
+            r.draws++;
+        }
+
+        if (!game->isGameOver()) {
+            overSinceMs = 0;
+            submitted = false;
+            continue;
+        }
+        if (!submitted) {
+            submitted = true;
+            r.gameOvers++;
+            overSinceMs = nowMs;
+            if (game->leaderboardEnabled()) {
+                Leaderboard::submitScore(game->leaderboardId(), game->leaderboardName(), game->leaderboardScore(),
+                                         "SOK");
+            }
+        } else if ((uint32_t)(nowMs - overSinceMs) >= 1000) {
+            game->reset();
+            Host::advanceMs(250); // the sketch's post-reset debounce
+        }
+    }
+
+    r.wallUs = Host::wallUs() - wallStart;
+    r.simMs = (Host::nowUs() - simStart) / 1000u;
+    delete game;
+    return r;
+}
+
+void usage() {
+    fprintf(stderr,
+            "usage: soak [--game NAME] [--seed N | --seeds N [--seed-base N]] [--frames N] [--step-ms N] [-j N]\n"
+            "games:");
+    for (const GameEntry& g : GAMES) fprintf(stderr, " %s", g.name);
+    fprintf(stderr, "\n");
+}
+
+bool parseArgs(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; i++) {
+        const char* a = argv[i];
+        const char* v = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (!strcmp(a, "--game") && v) {
+            opt.game = -1;
+            for (int g = 0; g < GAME_COUNT; g++) {
+                if (!strcmp(v, GAMES[g].name)) opt.game = g;
+            }
+            if (opt.game < 0) return false;
+        } else if (!strcmp(a, "--seed") && v) {
+            opt.seedBase = (uint32_t)strtoul(v, nullptr, 0);
+            opt.seeds = 1;
+        } else if (!strcmp(a, "--seeds") && v) {
+            opt.seeds = (uint32_t)strtoul(v, nullptr, 0);
+        } else if (!strcmp(a, "--seed-base") && v) {
+            opt.seedBase = (uint32_t)strtoul(v, nullptr, 0);
+        } else if (!strcmp(a, "--frames") && v) {
+            opt.frames = (uint32_t)strtoul(v, nullptr, 0);
+        } else if (!strcmp(a, "--step-ms") && v) {
+            opt.stepMs = (uint32_t)strtoul(v, nullptr, 0);
+        } else if (!strcmp(a, "-j") && v) {
+            opt.jobs = (unsigned)strtoul(v, nullptr, 0);
+        } else {
+            return false;
+        }
+        i++;
+    }
+    return opt.seeds > 0 && opt.stepMs > 0;
+}
+
+struct Shard {
+    int game;
+    uint32_t seed;
+    pid_t pid = -1;
+    int fd = -1;
+    ShardResult result;
+    bool crashed = false;
+    int status = 0;
+};
+
+void startShard(Shard& s, const Options& opt) {
+    int fds[2];
+    if (pipe(fds) != 0) {
+        perror("pipe");
+        exit(2);
+    }
+    fflush(stdout);
+    fflush(stderr);
+    const pid_t pid = fork();
+    if (pid < 0) {
+        perror("fork");
+        exit(2);
+    }
+    if (pid == 0) {
+        close(fds[0]);
+        const ShardResult r = runShard(GAMES[s.game], s.seed, opt);
+        const ssize_t n = write(fds[1], &r, sizeof(r));
+        _exit((n == (ssize_t)sizeof(r) && !r.failure[0]) ? 0 : 1);
+    }
+    close(fds[1]);
+    s.pid = pid;
+    s.fd = fds[0];
+}
+
+void finishShard(Shard& s, int status) {
+    s.status = status;
+    const ssize_t n = read(s.fd, &s.result, sizeof(s.result));
+    close(s.fd);
+    s.crashed = (n != (ssize_t)sizeof(s.result));
+    if (s.crashed) {
+        if (WIFSIGNALED(status)) {
+            snprintf(s.result.failure, sizeof(s.result.failure), "crashed (signal %d)", WTERMSIG(status));
+        } else {
+            snprintf(s.result.failure, sizeof(s.result.failure), "crashed (exit %d, see sanitizer report above)",
+                     WIFEXITED(status) ? WEXITSTATUS(status) : -1);
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        usage();
+        return 2;
+    }
+    if (opt.jobs == 0) opt.jobs = std::max(1u, std::thread::hardware_concurrency());
+
+    std::vector<Shard> shards;
+    for (int g = 0; g < GAME_COUNT; g++) {
+        if (opt.game >= 0 && g != opt.game) continue;
+        for (uint32_t i = 0; i < opt.seeds; i++) {
+            Shard s;
+            s.game = g;
+            s.seed = opt.seedBase + i;
+            shards.push_back(s);
+        }
+    }
+
+    printf("soak: %zu shards x %u frames (%u ms/frame), %u jobs\n", shards.size(), (unsigned)opt.frames,
+           (unsigned)opt.stepMs, opt.jobs);
+
+    const uint64_t wallStart = Host::wallUs();
+    size_t next = 0, running = 0, done = 0;
+    while (done < shards.size()) {
+        while (running < opt.jobs && next < shards.size()) {
+            startShard(shards[next++], opt);
+            running++;
+        }
+        int status = 0;
+        const pid_t pid = wait(&status);
+        if (pid < 0) break;
+        for (Shard& s : shards) {
+            if (s.pid != pid) continue;
+            finishShard(s, status);
+            running--;
+            done++;
+            const ShardResult& r = s.result;
+            if (r.failure[0]) {
+                printf("FAIL %-10s seed %-6u %s\n", GAMES[s.game].name, (unsigned)s.seed, r.failure);
+            } else {
+                const double fps = r.wallUs ? r.frames * 1e6 / (double)r.wallUs : 0.0;
+                printf("ok   %-10s seed %-6u %u frames, %u draws, %u game overs, %llu s simulated, %.0f frames/s\n",
+                       GAMES[s.game].name, (unsigned)s.seed, (unsigned)r.frames, (unsigned)r.draws,
+                       (unsigned)r.gameOvers, (unsigned long long)(r.simMs / 1000u), fps);
+            }
+            fflush(stdout);
+            break;
+        }
+    }
+    const uint64_t wallUs = Host::wallUs() - wallStart;
+
+    uint64_t frames = 0;
+    int failures = 0;
+    for (const Shard& s : shards) {
+        frames += s.result.frames;
+        if (s.result.failure[0]) failures++;
+    }
+    printf("soak: %llu frames in %.1f s, %.0f simulated frames/s across %u jobs\n", (unsigned long long)frames,
+           wallUs / 1e6, wallUs ? frames * 1e6 / (double)wallUs : 0.0, opt.jobs);
+
+    if (failures) {
+        printf("soak: %d shard(s) failed. Reproduce one with:\n", failures);
+        for (const Shard& s : shards) {
+            if (!s.result.failure[0]) continue;
+            printf("  soak --game %s --seed %u --frames %u --step-ms %u -j 1\n", GAMES[s.game].name,
+                   (unsigned)s.seed, (unsigned)opt.frames, (unsigned)opt.stepMs);
+        }
+        return 1;
+    }
+    return 0;
+}
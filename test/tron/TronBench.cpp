@@ -0,0 +1,120 @@
+// TronBench.cpp
+// -----------------------------------------------------------------------------
+// Tron trail grid memory, draw calls per frame and tick cost per arena and
+// rider count (Games/Tron/TronTrailGrid.h).
+//
+// Matches are set up through the real setup screen (pad 0), then played with
+// random input on pad 0 and AI for the other riders. Every update() is one
+// game tick. "1 B/cell" is the unpacked uint8_t grid the packed one replaced.
+//
+//   tron_bench [--ticks N]
+// -----------------------------------------------------------------------------
+#include "HostRuntime.h"
+#include "RandomPlayer.h"
+
+#include "Games/Tron/TronGame.h"
+
+namespace {
+
+struct Config {
+    int riders;
+    int arena; // TronGameConfig::ARENAS index
+};
+
+const Config CONFIGS[] = {
+    { 2, 1 },
+    { 4, 1 },
+    { 8, 1 },
+    { 4, 2 },
+    { 8, 2 },
+};
+
+void press(TronGame& g, uint8_t dpad, uint16_t buttons) {
+    PadState p;
+    p.connected = true;
+    p.dpad = dpad;
+    p.buttons = buttons;
+    Host::setPad(0, p);
+    globalControllerManager->update();
+    g.update(globalControllerManager);
+    Host::setPad(0, PadState{ true });
+    globalControllerManager->update();
+    g.update(globalControllerManager);
+}
+
+// Default setup is DEFAULT_RIDERS on DEFAULT_ARENA.
+void setUp(TronGame& g, const Config& c) {
+    g.start();
+    for (int r = TronGameConfig::DEFAULT_RIDERS; r < c.riders; r++) press(g, PadState::DPAD_RIGHT, 0);
+    press(g, PadState::DPAD_DOWN, 0);
+    for (int a = TronGameConfig::DEFAULT_ARENA; a < c.arena; a++) press(g, PadState::DPAD_RIGHT, 0);
+    press(g, 0, PadState::BTN_A);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    uint32_t ticks = 20000;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (!strcmp(argv[i], "--ticks")) ticks = (uint32_t)strtoul(argv[i + 1], nullptr, 0);
+    }
+
+    randomSeed(7);
+    Host::begin();
+    Host::setPad(0, PadState{ true });
+    globalControllerManager->update();
+    MatrixPanel_I2S_DMA& panel = Host::panel();
+
+    printf("%-6s %7s %7s %7s %8s %8s %9s %9s %9s %8s\n", "riders", "arena", "1B/cell", "packed", "calls/fr",
+           "max", "px/frame", "us/tick", "max", "us/draw");
+    int failures = 0;
+    for (const Config& c : CONFIGS) {
+        const TronGameConfig::Arena& a = TronGameConfig::ARENAS[c.arena];
+        TronTrailGrid grid;
+        grid.resize(a.w, a.h);
+
+        TronGame game;
+        setUp(game, c);
+        RandomPlayer player(99);
+
+        uint64_t tickUs = 0, drawUs = 0, calls = 0, pixels = 0;
+        uint64_t maxTickUs = 0;
+        uint32_t maxCalls = 0, frames = 0;
+        for (uint32_t t = 0; t < ticks; t++) {
+            Host::advanceMs(TRON_SPEED_MS);
+            Host::setPad(0, player.next());
+            globalControllerManager->update();
+            uint64_t t0 = Host::wallUs();
+            game.update(globalControllerManager);
+            const uint64_t dt = Host::wallUs() - t0;
+            tickUs += dt;
+            maxTickUs = std::max(maxTickUs, dt);
+            if (const char* why = game.checkInvariants()) {
+                printf("FAIL %d riders %s: %s\n", c.riders, a.name, why);
+                failures++;
+                break;
+            }
+            if (game.isGameOver()) {
+                game.reset();
+                continue;
+            }
+
+            panel.stats = MatrixPanel_I2S_DMA::Stats();
+            t0 = Host::wallUs();
+            game.draw(&panel);
+            drawUs += Host::wallUs() - t0;
+            calls += panel.stats.calls;
+            pixels += panel.stats.pixels;
+            maxCalls = std::max(maxCalls, panel.stats.calls);
+            frames++;
+        }
+        frames = std::max(frames, 1u);
+        char arena[12];
+        snprintf(arena, sizeof(arena), "%dx%d", a.w, a.h);
+        printf("%-6d %7s %7d %7zu %8.0f %8u %9.0f %9.2f %9llu %8.2f\n", c.riders, arena, a.w * a.h, grid.bytes(),
+               (double)calls / frames, (unsigned)maxCalls, (double)pixels / frames, (double)tickUs / ticks,
+               (unsigned long long)maxTickUs, (double)drawUs / frames);
+    }
+    printf("(host timings; draw calls and bytes are what the device sees)\n");
+    return failures ? 1 : 0;
+}